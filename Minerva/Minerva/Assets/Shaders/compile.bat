@@ -1,3 +1,11 @@
 C:/VulkanSDK/1.2.198.1/Bin/glslc.exe triangle.vert -o vert.spv
 C:/VulkanSDK/1.2.198.1/Bin/glslc.exe triangle.frag -o frag.spv
+C:/VulkanSDK/1.2.198.1/Bin/glslc.exe meshlet_cull.comp -o meshlet_cull.spv
+C:/VulkanSDK/1.2.198.1/Bin/glslc.exe skinned.vert -o skinned.spv
+C:/VulkanSDK/1.2.198.1/Bin/glslc.exe skin.comp -o skin.spv
+C:/VulkanSDK/1.2.198.1/Bin/glslc.exe object_cull.comp -o object_cull.spv
+C:/VulkanSDK/1.2.198.1/Bin/glslc.exe object.vert -o object.spv
+C:/VulkanSDK/1.2.198.1/Bin/glslc.exe hiz_build.comp -o hiz_build.spv
+C:/VulkanSDK/1.2.198.1/Bin/glslc.exe occlusion_cull.comp -o occlusion_cull.spv
+C:/VulkanSDK/1.2.198.1/Bin/glslc.exe depth_prepass.vert -o depth_prepass.spv
 pause
\ No newline at end of file
@@ -0,0 +1,16 @@
+#version 450
+
+// Depth only vertex shader for depth prepasses, fed by Minerva::Mesh::GetPositionBuffer.
+// Color passes drawn after it with EQUAL depth testing must also declare gl_Position invariant
+layout( push_constant ) uniform constants
+{
+	mat4 MVP;
+} PushConstants;
+
+layout(location = 0) in vec3 inPosition;
+
+invariant gl_Position;
+
+void main() {
+	gl_Position = PushConstants.MVP * vec4(inPosition, 1.0);
+}
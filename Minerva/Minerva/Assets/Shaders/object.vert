@@ -0,0 +1,35 @@
+#version 450
+
+// Vertex shader for ObjectCuller draws, firstInstance is the object index
+struct Object
+{
+	mat4 model;
+	vec4 sphere;
+	uint firstIndex;
+	uint indexCount;
+	int vertexOffset;
+	uint padding;
+};
+
+layout(std430, binding = 0) readonly buffer Objects { Object objects[]; };
+
+layout( push_constant ) uniform constants
+{
+	mat4 viewProjection;
+} PushConstants;
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inNormal;
+layout(location = 2) in vec2 inTexCoord;
+
+layout(location = 0) out vec4 fragColor;
+layout(location = 1) out vec2 fragTexCoord;
+
+void main() {
+	mat4 model = objects[gl_InstanceIndex].model;
+	gl_Position = PushConstants.viewProjection * model * vec4(inPosition, 1.0);
+
+	vec3 normal = normalize(mat3(model) * inNormal);
+	fragColor = vec4(normal * 0.5 + 0.5, 1.0);
+	fragTexCoord = inTexCoord;
+}
@@ -0,0 +1,35 @@
+#version 450
+
+// Linear blend skinning from the per frame joint palette. Palettes are in world space and stored back to back,
+// so instance i of an instanced draw reads matrices [i * JointCount, (i + 1) * JointCount)
+layout( push_constant ) uniform constants
+{
+	mat4 ViewProjection;
+	uint JointCount;
+} PushConstants;
+
+layout(std430, binding = 0) readonly buffer JointPalette { mat4 jointMatrices[]; };
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inNormal;
+layout(location = 2) in vec2 inTexCoord;
+layout(location = 3) in uvec4 inJoints;
+layout(location = 4) in vec4 inWeights;
+
+layout(location = 0) out vec4 fragColor;
+layout(location = 1) out vec2 fragTexCoord;
+
+void main() {
+	uint base = uint(gl_InstanceIndex) * PushConstants.JointCount;
+
+	mat4 skin = inWeights.x * jointMatrices[base + inJoints.x] +
+	            inWeights.y * jointMatrices[base + inJoints.y] +
+	            inWeights.z * jointMatrices[base + inJoints.z] +
+	            inWeights.w * jointMatrices[base + inJoints.w];
+
+	vec3 normal = normalize(mat3(skin) * inNormal);
+
+	gl_Position = PushConstants.ViewProjection * skin * vec4(inPosition, 1.0);
+	fragColor = vec4(normal * 0.5 + 0.5, 1.0);
+	fragTexCoord = inTexCoord;
+}
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "minerva_vulkan_logger.h"
+#include "minerva_vulkan_barrier.h"
+#include "minerva_vulkan_layoutcache.h"
+#include "minerva_vulkan_renderpasscache.h"
 #include "minerva_vulkan_instance.h"
 #include "minerva_vulkan_device.h"
 #include "minerva_vulkan_input.h"
@@ -9,7 +12,10 @@
 #include "minerva_vulkan_shader.h"
 #include "minerva_vulkan_vertex_descriptor.h"
 #include "minerva_vulkan_texture.h"
+#include "minerva_vulkan_buffer.h"
 #include "minerva_vulkan_descriptorset.h"
 #include "minerva_vulkan_pipeline.h"
-#include "minerva_vulkan_buffer.h"
+#include "minerva_vulkan_pipelinelibrary.h"
 #include "minerva_vulkan_cmdbuffer.h"
+#include "minerva_vulkan_depthpyramid.h"
+#include "minerva_vulkan_rendergraph.h"
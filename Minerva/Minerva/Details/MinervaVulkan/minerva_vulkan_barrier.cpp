@@ -0,0 +1,229 @@
+namespace Minerva::Vulkan
+{
+	BarrierBatch::SyncState BarrierBatch::GetLayoutSyncState(VkImageLayout _layout)
+	{
+		switch (_layout)
+		{
+		case VK_IMAGE_LAYOUT_UNDEFINED:
+		case VK_IMAGE_LAYOUT_PREINITIALIZED:                    return SyncState{ VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0 };
+		case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:              return SyncState{ VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT };
+		case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:              return SyncState{ VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT };
+		case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:          return SyncState{ VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT };
+		case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:          return SyncState{ VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT };
+		case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:  return SyncState{ VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT };
+		case VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL:   return SyncState{ VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_SHADER_READ_BIT };
+		case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR:                   return SyncState{ VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0 };
+		case VK_IMAGE_LAYOUT_GENERAL:
+		default:                                                return SyncState{ VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT };
+		}
+	}
+
+	void BarrierBatch::AddImageBarrier(VkImage _image, const VkImageSubresourceRange& _range, VkImageLayout _oldLayout, VkImageLayout _newLayout,
+		const SyncState& _source, const SyncState& _destination)
+	{
+		m_VKSourceStages |= _source.m_VKStages;
+		m_VKDestinationStages |= _destination.m_VKStages;
+
+		m_VKImageBarriers.push_back(VkImageMemoryBarrier{
+			.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+			.pNext = nullptr,
+			.srcAccessMask = _source.m_VKAccess,
+			.dstAccessMask = _destination.m_VKAccess,
+			.oldLayout = _oldLayout,
+			.newLayout = _newLayout,
+			.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+			.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+			.image = _image,
+			.subresourceRange = _range
+		});
+	}
+
+	void BarrierBatch::AddMemoryBarrier(const SyncState& _source, const SyncState& _destination)
+	{
+		// Global memory barriers are merged, vendors recommend them over per buffer barriers
+		m_VKSourceStages |= _source.m_VKStages;
+		m_VKDestinationStages |= _destination.m_VKStages;
+		m_VKMemoryBarrier.srcAccessMask |= _source.m_VKAccess;
+		m_VKMemoryBarrier.dstAccessMask |= _destination.m_VKAccess;
+		m_HasMemoryBarrier = true;
+	}
+
+	void BarrierBatch::Record(VkCommandBuffer _commandBuffer) const
+	{
+		if (IsEmpty()) return;
+
+		vkCmdPipelineBarrier(_commandBuffer,
+			m_VKSourceStages ? m_VKSourceStages : static_cast<VkPipelineStageFlags>(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT),
+			m_VKDestinationStages ? m_VKDestinationStages : static_cast<VkPipelineStageFlags>(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT),
+			0,
+			m_HasMemoryBarrier ? 1u : 0u, m_HasMemoryBarrier ? &m_VKMemoryBarrier : nullptr,
+			0, nullptr,
+			static_cast<uint32_t>(m_VKImageBarriers.size()), m_VKImageBarriers.data());
+	}
+
+	void BarrierBatch::Clear()
+	{
+		m_VKSourceStages = 0;
+		m_VKDestinationStages = 0;
+		m_VKMemoryBarrier.srcAccessMask = 0;
+		m_VKMemoryBarrier.dstAccessMask = 0;
+		m_HasMemoryBarrier = false;
+		m_VKImageBarriers.clear();
+	}
+
+	void ResourceTracker::AdvanceEpoch()
+	{
+		++m_Epoch;
+		m_UnsyncedWrites = BarrierBatch::SyncState{};
+		m_GraphicsReads = BarrierBatch::SyncState{};
+		m_VKGraphicsReadsWaited = 0;
+	}
+
+	void ResourceTracker::AddWrite(const BarrierBatch::SyncState& _sync)
+	{
+		m_UnsyncedWrites.m_VKStages |= _sync.m_VKStages;
+		m_UnsyncedWrites.m_VKAccess |= _sync.m_VKAccess;
+	}
+
+	void ResourceTracker::BeginGraphics(BarrierBatch& _batch)
+	{
+		// Nothing was written since the draws last synchronized, no barrier
+		if (m_UnsyncedWrites.IsEmpty()) return;
+
+		_batch.AddMemoryBarrier(m_UnsyncedWrites, GRAPHICS_READ);
+		m_UnsyncedWrites = BarrierBatch::SyncState{};
+	}
+
+	void ResourceTracker::EndGraphics()
+	{
+		m_GraphicsReads = GRAPHICS_READ;
+		m_VKGraphicsReadsWaited = 0;
+	}
+
+	BarrierBatch::SyncState ResourceTracker::TakeGraphicsReads(VkPipelineStageFlags _stages)
+	{
+		// A compute write waiting on the draws does not order a later transfer write, every destination stage waits once
+		if (m_GraphicsReads.IsEmpty() || (_stages & ~m_VKGraphicsReadsWaited) == 0)
+			return BarrierBatch::SyncState{};
+
+		m_VKGraphicsReadsWaited |= _stages;
+		return m_GraphicsReads;
+	}
+
+	ResourceState::ResourceState(ResourceTracker& _tracker) :
+		m_Tracker{ &_tracker }, m_VKImage{ VK_NULL_HANDLE }, m_VKAspect{ 0 }, m_MipCount{ 1 }, m_LayerCount{ 1 }, m_Subresources(1)
+	{
+	}
+
+	ResourceState::ResourceState(ResourceTracker& _tracker, VkImage _image, VkImageAspectFlags _aspect, uint32_t _mipCount, uint32_t _layerCount) :
+		m_Tracker{ &_tracker }, m_VKImage{ _image }, m_VKAspect{ _aspect }, m_MipCount{ _mipCount }, m_LayerCount{ _layerCount },
+		m_Subresources(static_cast<size_t>(_mipCount) * _layerCount)
+	{
+	}
+
+	void ResourceState::Reset(VkImage _image, VkImageAspectFlags _aspect, uint32_t _mipCount, uint32_t _layerCount)
+	{
+		m_VKImage = _image;
+		m_VKAspect = _aspect;
+		m_MipCount = _mipCount;
+		m_LayerCount = _layerCount;
+		m_Subresources.assign(static_cast<size_t>(_mipCount) * _layerCount, Subresource{});
+	}
+
+	void ResourceState::Use(BarrierBatch& _batch, const BarrierBatch::SyncState& _sync, bool _write)
+	{
+		BarrierBatch::SyncState source{};
+		VkImageLayout oldLayout{ VK_IMAGE_LAYOUT_UNDEFINED };
+		if (Access(m_Subresources[0], VK_IMAGE_LAYOUT_UNDEFINED, _sync, _write, source, oldLayout))
+			_batch.AddMemoryBarrier(source, _sync);
+	}
+
+	void ResourceState::Use(BarrierBatch& _batch, uint32_t _baseMip, uint32_t _mipCount, uint32_t _baseLayer, uint32_t _layerCount,
+		VkImageLayout _layout, const BarrierBatch::SyncState& _sync, bool _write)
+	{
+		_mipCount = std::min(_mipCount, m_MipCount - std::min(_baseMip, m_MipCount));
+		_layerCount = std::min(_layerCount, m_LayerCount - std::min(_baseLayer, m_LayerCount));
+
+		for (uint32_t layer{ _baseLayer }; layer < _baseLayer + _layerCount; ++layer)
+		{
+			// Open run of mips needing the same barrier
+			uint32_t runStart{ 0 };
+			uint32_t runCount{ 0 };
+			BarrierBatch::SyncState runSource{};
+			VkImageLayout runLayout{ VK_IMAGE_LAYOUT_UNDEFINED };
+
+			auto FlushRun = [&]()
+			{
+				if (runCount == 0) return;
+				_batch.AddImageBarrier(m_VKImage, VkImageSubresourceRange{ m_VKAspect, runStart, runCount, layer, 1 }, runLayout, _layout, runSource, _sync);
+				runCount = 0;
+			};
+
+			for (uint32_t mip{ _baseMip }; mip < _baseMip + _mipCount; ++mip)
+			{
+				BarrierBatch::SyncState source{};
+				VkImageLayout oldLayout{ VK_IMAGE_LAYOUT_UNDEFINED };
+				if (!Access(m_Subresources[layer * m_MipCount + mip], _layout, _sync, _write, source, oldLayout))
+				{
+					FlushRun();
+					continue;
+				}
+
+				const bool extendsRun{ runCount > 0 && oldLayout == runLayout &&
+					source.m_VKStages == runSource.m_VKStages && source.m_VKAccess == runSource.m_VKAccess };
+				if (!extendsRun)
+				{
+					FlushRun();
+					runStart = mip;
+					runSource = source;
+					runLayout = oldLayout;
+				}
+				++runCount;
+			}
+			FlushRun();
+		}
+	}
+
+	bool ResourceState::Access(Subresource& _subresource, VkImageLayout _layout, const BarrierBatch::SyncState& _sync, bool _write,
+		BarrierBatch::SyncState& _source, VkImageLayout& _oldLayout) const
+	{
+		// Accesses of an earlier epoch have completed, only the layout is left
+		if (_subresource.m_Epoch != m_Tracker->GetEpoch())
+		{
+			_subresource.m_Sync = BarrierBatch::SyncState{};
+			_subresource.m_Write = false;
+			_subresource.m_Epoch = m_Tracker->GetEpoch();
+		}
+
+		// Layout transitions write the image as well. Writes after a render pass wait for its draws, which are not tracked per resource
+		const bool layoutChange{ _subresource.m_VKLayout != _layout };
+		const BarrierBatch::SyncState graphicsReads{ (_write || layoutChange) ? m_Tracker->TakeGraphicsReads(_sync.m_VKStages) : BarrierBatch::SyncState{} };
+		const bool hazard{ !_subresource.m_Sync.IsEmpty() && (_subresource.m_Write || _write) };
+
+		if (_write)
+			m_Tracker->AddWrite(_sync);
+
+		if (!layoutChange && !hazard && graphicsReads.IsEmpty())
+		{
+			// Reads after reads share the barrier that made the last write visible, later writers wait for all of them
+			_subresource.m_Sync.m_VKStages |= _sync.m_VKStages;
+			_subresource.m_Sync.m_VKAccess |= _sync.m_VKAccess;
+			_subresource.m_Write = _write;
+			return false;
+		}
+
+		_source = BarrierBatch::SyncState{
+			_subresource.m_Sync.m_VKStages | graphicsReads.m_VKStages,
+			_subresource.m_Sync.m_VKAccess | graphicsReads.m_VKAccess
+		};
+		if (_source.IsEmpty())
+			_source.m_VKStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+		_oldLayout = _subresource.m_VKLayout;
+
+		_subresource.m_VKLayout = _layout;
+		_subresource.m_Sync = _sync;
+		_subresource.m_Write = _write;
+		return true;
+	}
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+namespace Minerva::Vulkan
+{
+	// Collects image and memory barriers so a whole group of transitions is recorded with a single vkCmdPipelineBarrier
+	class BarrierBatch
+	{
+	public:
+		// Pipeline stages and accesses on one side of a barrier
+		struct SyncState
+		{
+			VkPipelineStageFlags m_VKStages{ 0 };
+			VkAccessFlags m_VKAccess{ 0 };
+
+			inline bool IsEmpty() const { return m_VKStages == 0; }
+		};
+
+		// Stages and accesses that typically use an image in _layout. For one-off transitions that do not track their actual users
+		static SyncState GetLayoutSyncState(VkImageLayout _layout);
+
+		void AddImageBarrier(VkImage _image, const VkImageSubresourceRange& _range, VkImageLayout _oldLayout, VkImageLayout _newLayout,
+			const SyncState& _source, const SyncState& _destination);
+		void AddMemoryBarrier(const SyncState& _source, const SyncState& _destination);
+
+		// Records every barrier added so far. The batch is kept, so a precomputed batch can be recorded every frame
+		void Record(VkCommandBuffer _commandBuffer) const;
+		void Clear();
+
+		inline bool IsEmpty() const { return m_VKImageBarriers.empty() && !m_HasMemoryBarrier; }
+		inline size_t GetImageBarrierCount() const { return m_VKImageBarriers.size(); }
+
+	private:
+		VkPipelineStageFlags m_VKSourceStages{ 0 };
+		VkPipelineStageFlags m_VKDestinationStages{ 0 };
+		VkMemoryBarrier m_VKMemoryBarrier{ .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+		bool m_HasMemoryBarrier{ false };
+		std::vector<VkImageMemoryBarrier> m_VKImageBarriers;
+	};
+
+	// Synchronization between work recorded outside of render passes and the draws of the window render pass. Barriers are not
+	// allowed inside a render pass, so draws are not tracked per resource: writes made before a render pass begins are made
+	// visible to every graphics stage at once, and the first write of each pipeline stage after it ends waits for every graphics stage.
+	// One per device, frames are recorded one at a time and end with a queue wait
+	class ResourceTracker
+	{
+	public:
+		// Stages and accesses of draws reading buffers and images
+		static constexpr BarrierBatch::SyncState GRAPHICS_READ{
+			VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+			VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT
+		};
+
+		// Accesses recorded before the current epoch have completed
+		inline uint64_t GetEpoch() const { return m_Epoch; }
+		void AdvanceEpoch();
+
+		void AddWrite(const BarrierBatch::SyncState& _sync);
+		// Before a render pass begins or resumes
+		void BeginGraphics(BarrierBatch& _batch);
+		// After a render pass ends or is suspended
+		void EndGraphics();
+		// Draws a write in _stages has to wait for. Empty once each of _stages has waited, later commands of a stage are ordered by its barrier
+		BarrierBatch::SyncState TakeGraphicsReads(VkPipelineStageFlags _stages);
+
+	private:
+		uint64_t m_Epoch{ 1 };
+		BarrierBatch::SyncState m_UnsyncedWrites{};
+		BarrierBatch::SyncState m_GraphicsReads{};
+		VkPipelineStageFlags m_VKGraphicsReadsWaited{ 0 }; // Destination stages already ordered after m_GraphicsReads
+	};
+
+	// Layout and pending accesses of every mip and layer of an image, or of a whole buffer. Use appends the barriers a new access needs:
+	// none for reads following reads in the same layout, or when the previous access belongs to a completed epoch
+	class ResourceState
+	{
+	public:
+		// Buffer
+		explicit ResourceState(ResourceTracker& _tracker);
+		// Image, every subresource starts undefined
+		ResourceState(ResourceTracker& _tracker, VkImage _image, VkImageAspectFlags _aspect, uint32_t _mipCount, uint32_t _layerCount = 1);
+
+		// The image was (re)created, its contents are undefined
+		void Reset(VkImage _image, VkImageAspectFlags _aspect, uint32_t _mipCount, uint32_t _layerCount = 1);
+
+		void Use(BarrierBatch& _batch, const BarrierBatch::SyncState& _sync, bool _write);
+		// Consecutive mips of a layer sharing their previous state are transitioned by one barrier
+		void Use(BarrierBatch& _batch, uint32_t _baseMip, uint32_t _mipCount, uint32_t _baseLayer, uint32_t _layerCount,
+			VkImageLayout _layout, const BarrierBatch::SyncState& _sync, bool _write);
+
+		inline VkImageLayout GetLayout(uint32_t _mip = 0, uint32_t _layer = 0) const { return m_Subresources[_layer * m_MipCount + _mip].m_VKLayout; }
+		inline uint32_t GetMipCount() const { return m_MipCount; }
+		inline uint32_t GetLayerCount() const { return m_LayerCount; }
+
+	private:
+		struct Subresource
+		{
+			VkImageLayout m_VKLayout{ VK_IMAGE_LAYOUT_UNDEFINED };
+			BarrierBatch::SyncState m_Sync{}; // Accesses since the last barrier, all reads unless m_Write
+			bool m_Write{ false };
+			uint64_t m_Epoch{ 0 };
+		};
+
+		ResourceTracker* m_Tracker; // Owned by the device, which outlives its resources
+		VkImage m_VKImage;
+		VkImageAspectFlags m_VKAspect;
+		uint32_t m_MipCount;
+		uint32_t m_LayerCount;
+		std::vector<Subresource> m_Subresources; // Layer major
+
+		// Updates _subresource for the access. Returns whether a barrier is needed, with its source accesses and old layout
+		bool Access(Subresource& _subresource, VkImageLayout _layout, const BarrierBatch::SyncState& _sync, bool _write,
+			BarrierBatch::SyncState& _source, VkImageLayout& _oldLayout) const;
+	};
+}
+
+#include "minerva_vulkan_barrier.cpp"
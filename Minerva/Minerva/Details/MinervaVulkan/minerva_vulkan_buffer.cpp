@@ -1,8 +1,9 @@
 namespace Minerva::Vulkan
 {
 
-	Buffer::Buffer(std::shared_ptr<Minerva::Vulkan::Device> _device, Minerva::Buffer::Type _type, const void* _data, uint32_t _size) :
-        m_VKDeviceHandle{ _device }, m_VKBuffer{ VK_NULL_HANDLE }, m_VKMemory{ VK_NULL_HANDLE }, m_VKSize{_size}, m_Type{ _type }
+	Buffer::Buffer(std::shared_ptr<Minerva::Vulkan::Device> _device, Minerva::Buffer::Type _type, const void* _data, uint32_t _size, Minerva::Buffer::IndexType _indexType) :
+        m_VKDeviceHandle{ _device }, m_VKBuffer{ VK_NULL_HANDLE }, m_VKMemory{ VK_NULL_HANDLE }, m_VKSize{_size}, m_MappedData{ nullptr },
+        m_State{ _device->GetResourceTracker() }, m_Type{ _type }, m_IndexType{ _indexType }
 	{
         // Get UsageType based on Minerva::Buffer::Type
         auto UsageType = [](auto UsageType) constexpr
@@ -11,6 +12,9 @@ namespace Minerva::Vulkan
             {
             case Minerva::Buffer::Type::VERTEX:               return (VkBufferUsageFlagBits)(VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
             case Minerva::Buffer::Type::INDEX:                return (VkBufferUsageFlagBits)(VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+            case Minerva::Buffer::Type::STORAGE:              return (VkBufferUsageFlagBits)(VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT);
+            case Minerva::Buffer::Type::DYNAMIC_STORAGE:      return VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+            case Minerva::Buffer::Type::INDIRECT:             return (VkBufferUsageFlagBits)(VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
             //case Minerva::Buffer::Type::UNIFORM:               return VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
             }
         }(m_Type);
@@ -21,7 +25,10 @@ namespace Minerva::Vulkan
             switch (Properties)
             {
             case Minerva::Buffer::Type::VERTEX:
-            case Minerva::Buffer::Type::INDEX:                return VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+            case Minerva::Buffer::Type::INDEX:
+            case Minerva::Buffer::Type::STORAGE:
+            case Minerva::Buffer::Type::INDIRECT:             return VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+            case Minerva::Buffer::Type::DYNAMIC_STORAGE:      return (VkMemoryPropertyFlagBits)(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
                 //case Minerva::Buffer::Type::UNIFORM:               return VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
 
             }
@@ -31,33 +38,73 @@ namespace Minerva::Vulkan
         {
         case Minerva::Buffer::Type::VERTEX:
         case Minerva::Buffer::Type::INDEX:
+        case Minerva::Buffer::Type::STORAGE:
+        case Minerva::Buffer::Type::INDIRECT:
         {
-            VkBuffer stagingBuffer;
-            VkDeviceMemory  stagingBufferMemory;
-            CreateBuffer(m_VKSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                stagingBuffer, stagingBufferMemory);
-
-            // Fill staging buffer
-            void* data;
-            vkMapMemory(m_VKDeviceHandle->GetVKDevice(), stagingBufferMemory, 0, m_VKSize, 0, &data);
-            memcpy(data, _data, static_cast<size_t>(m_VKSize));
-            vkUnmapMemory(m_VKDeviceHandle->GetVKDevice(), stagingBufferMemory);
-
-            CreateBuffer(m_VKSize, UsageType, Properties,
-                m_VKBuffer, m_VKMemory);
-
-            m_VKDeviceHandle->CopyBuffer(stagingBuffer, m_VKBuffer, m_VKSize);
-            
+            CreateBuffer(m_VKSize, UsageType, Properties, m_VKBuffer, m_VKMemory);
+
+            // Without initial data the buffer is filled later by the GPU or through Upload
+            if (_data != nullptr)
+                Upload(_data, 0, m_VKSize);
+        }break;
+        case Minerva::Buffer::Type::DYNAMIC_STORAGE:
+        {
+            CreateBuffer(m_VKSize, UsageType, Properties, m_VKBuffer, m_VKMemory);
+
+            // Stays mapped for the lifetime of the buffer, coherent memory needs no flushes
+            if (vkMapMemory(m_VKDeviceHandle->GetVKDevice(), m_VKMemory, 0, m_VKSize, 0, &m_MappedData) != VK_SUCCESS)
+            {
+                Logger::Log_Error("Unable to create Buffer. vkMapMemory failed.");
+                throw std::runtime_error("Unable to create Buffer. vkMapMemory failed.");
+            }
+
+            if (_data != nullptr)
+                Upload(_data, 0, m_VKSize);
         }break;
         }
 	}
 
     Buffer::~Buffer()
     {
+        if (m_MappedData != nullptr)
+            vkUnmapMemory(m_VKDeviceHandle->GetVKDevice(), m_VKMemory);
+
         vkDestroyBuffer(m_VKDeviceHandle->GetVKDevice(), m_VKBuffer, nullptr);
         vkFreeMemory(m_VKDeviceHandle->GetVKDevice(), m_VKMemory, nullptr);
     }
 
+    void Buffer::Upload(const void* _data, VkDeviceSize _offset, VkDeviceSize _size)
+    {
+        if (_offset + _size > m_VKSize)
+        {
+            Logger::Log_Error("Unable to upload to Buffer. Range exceeds the buffer size.");
+            throw std::runtime_error("Unable to upload to Buffer. Range exceeds the buffer size.");
+        }
+
+        if (m_MappedData != nullptr)
+        {
+            memcpy(static_cast<uint8_t*>(m_MappedData) + _offset, _data, static_cast<size_t>(_size));
+            return;
+        }
+
+        VkBuffer stagingBuffer;
+        VkDeviceMemory  stagingBufferMemory;
+        CreateBuffer(_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            stagingBuffer, stagingBufferMemory);
+
+        // Fill staging buffer
+        void* data;
+        vkMapMemory(m_VKDeviceHandle->GetVKDevice(), stagingBufferMemory, 0, _size, 0, &data);
+        memcpy(data, _data, static_cast<size_t>(_size));
+        vkUnmapMemory(m_VKDeviceHandle->GetVKDevice(), stagingBufferMemory);
+
+        m_VKDeviceHandle->CopyBuffer(stagingBuffer, m_VKBuffer, _size, _offset);
+
+        // Copy is complete once CopyBuffer returns
+        vkDestroyBuffer(m_VKDeviceHandle->GetVKDevice(), stagingBuffer, nullptr);
+        vkFreeMemory(m_VKDeviceHandle->GetVKDevice(), stagingBufferMemory, nullptr);
+    }
+
     uint32_t Buffer::FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties)
     {
         VkPhysicalDeviceMemoryProperties memProperties;
@@ -5,12 +5,20 @@ namespace Minerva::Vulkan
 	class Buffer
 	{
 	public:
-		Buffer(std::shared_ptr<Minerva::Vulkan::Device> _device, Minerva::Buffer::Type _type, const void* _data, uint32_t _size);
+		Buffer(std::shared_ptr<Minerva::Vulkan::Device> _device, Minerva::Buffer::Type _type, const void* _data, uint32_t _size, Minerva::Buffer::IndexType _indexType = Minerva::Buffer::IndexType::UINT16);
 		~Buffer();
 
+		// Copies _size bytes of _data to _offset through a staging buffer. Returns once the copy has completed.
+		// DYNAMIC_STORAGE buffers are persistently mapped and written with a plain memcpy
+		void Upload(const void* _data, VkDeviceSize _offset, VkDeviceSize _size);
+
+		inline std::shared_ptr<Minerva::Vulkan::Device> GetVKDeviceHandle() const { return m_VKDeviceHandle; }
 		inline Minerva::Buffer::Type GetType() const { return m_Type; }
+		inline Minerva::Buffer::IndexType GetIndexType() const { return m_IndexType; }
 		inline VkBuffer GetVKBuffer() const { return m_VKBuffer; }
 		inline VkDeviceSize GetVKSize() const { return m_VKSize; }
+		inline VkIndexType GetVKIndexType() const { return m_IndexType == Minerva::Buffer::IndexType::UINT32 ? VK_INDEX_TYPE_UINT32 : VK_INDEX_TYPE_UINT16; }
+		inline ResourceState& GetResourceState() { return m_State; }
 
 	private:
 		// Private Handles
@@ -20,9 +28,12 @@ namespace Minerva::Vulkan
 		VkBuffer m_VKBuffer;
 		VkDeviceMemory m_VKMemory;
 		VkDeviceSize m_VKSize;
+		void* m_MappedData; // DYNAMIC_STORAGE only
+		ResourceState m_State; // Accesses recorded through CommandBuffer
 
 		// Minerva properties
 		Minerva::Buffer::Type m_Type;
+		Minerva::Buffer::IndexType m_IndexType;
 
 		// Helper function
 		uint32_t FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
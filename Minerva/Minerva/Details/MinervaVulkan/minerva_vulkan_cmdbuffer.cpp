@@ -1,39 +1,216 @@
 namespace Minerva::Vulkan
 {
-	CommandBuffer::CommandBuffer(std::shared_ptr<Minerva::Vulkan::Renderpass> _renderpass, VkCommandBuffer _vkCommandBuffer, VkExtent2D _extent, int _index) :
-		m_VKCommandBuffer{ _vkCommandBuffer }, m_VKRenderpassHandle{ _renderpass }
+	CommandBuffer::CommandBuffer(std::shared_ptr<Minerva::Vulkan::Renderpass> _renderpass, VkCommandBuffer _vkCommandBuffer, VkExtent2D _extent, int _index, bool _isRecording,
+		VkSubpassContents _contents, Minerva::Vulkan::Window* _window) :
+		m_VKCommandBuffer{ _vkCommandBuffer }, m_VKRenderpassHandle{ _renderpass }, m_VKWindow{ _window }, m_VKContents{ _contents }, m_FramebufferIndex{ _index },
+		m_Subpass{ 0 }, m_InsideRenderpass{ false }, m_TrackResources{ true }, m_Statistics{}
 	{
-		// Describe command buffer
-		VkCommandBufferBeginInfo beginInfo{};
-		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		ResetBoundState();
 
-		// Begin command buffer
-		if (vkBeginCommandBuffer(m_VKCommandBuffer, &beginInfo) != VK_SUCCESS) {
-			Logger::Log_Error("Failed to being recording Command Buffer.");
-			throw std::runtime_error("Failed to being recording Command Buffer.");
+		if (!_isRecording)
+		{
+			// Describe command buffer
+			VkCommandBufferBeginInfo beginInfo{};
+			beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+
+			// Begin command buffer
+			if (vkBeginCommandBuffer(m_VKCommandBuffer, &beginInfo) != VK_SUCCESS) {
+				Logger::Log_Error("Failed to being recording Command Buffer.");
+				throw std::runtime_error("Failed to being recording Command Buffer.");
+			}
 		}
 
-		// Describe Render pass being info
-		VkClearValue clearValue{ m_VKRenderpassHandle->GetVkClearValue() };
+		// Compute only, no render pass
+		if (!m_VKRenderpassHandle) return;
 
-		VkRenderPassBeginInfo renderPassInfo{};
-		renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-		renderPassInfo.renderPass = m_VKRenderpassHandle->GetVKRenderPass();
-		renderPassInfo.framebuffer = m_VKRenderpassHandle->GetVKFramebuffers()[_index];
-		renderPassInfo.renderArea.offset = { 0, 0 };
-		renderPassInfo.renderArea.extent = _extent;
-		renderPassInfo.clearValueCount = 1;
-		renderPassInfo.pClearValues = &clearValue;
+		// Offscreen render passes are recorded by a RenderGraph, which issues its own barriers
+		if (m_VKRenderpassHandle->IsOffscreen())
+			m_TrackResources = false;
+		else
+			BeginGraphics();
 
-		// Begin render pass
-		vkCmdBeginRenderPass(m_VKCommandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+		// Begin render pass, over the whole framebuffer
+		m_VKRenderpassHandle->Begin(m_VKCommandBuffer, _index, m_VKContents, false);
+		m_InsideRenderpass = true;
+	}
+
+	CommandBuffer::CommandBuffer(std::shared_ptr<Minerva::Vulkan::Renderpass> _renderpass, VkCommandBuffer _vkSecondaryCommandBuffer, int _index, uint32_t _subpass) :
+		m_VKCommandBuffer{ _vkSecondaryCommandBuffer }, m_VKRenderpassHandle{ _renderpass }, m_VKWindow{ nullptr }, m_VKContents{ VK_SUBPASS_CONTENTS_INLINE }, m_FramebufferIndex{ _index },
+		m_Subpass{ _subpass }, m_InsideRenderpass{ true }, m_TrackResources{ false }, m_Statistics{}
+	{
+		// Secondary command buffers inherit no bound state from the primary
+		ResetBoundState();
+
+		// With dynamic rendering the secondary command buffer inherits attachment formats instead of a render pass
+		const std::span<const VkFormat> colorFormats{ m_VKRenderpassHandle->GetVKColorFormats() };
+		VkCommandBufferInheritanceRenderingInfoKHR inheritanceRenderingInfo{
+			.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO_KHR,
+			.pNext = nullptr,
+			.flags = 0,
+			.viewMask = 0,
+			.colorAttachmentCount = static_cast<uint32_t>(colorFormats.size()),
+			.pColorAttachmentFormats = colorFormats.data(),
+			.depthAttachmentFormat = m_VKRenderpassHandle->HasDepthAttachment() ? m_VKRenderpassHandle->GetVKDepthFormat() : VK_FORMAT_UNDEFINED,
+			.stencilAttachmentFormat = m_VKRenderpassHandle->HasStencil() ? m_VKRenderpassHandle->GetVKDepthFormat() : VK_FORMAT_UNDEFINED,
+			.rasterizationSamples = m_VKRenderpassHandle->GetVKSamples()
+		};
+
+		// Render pass state the secondary command buffer continues
+		const bool dynamicRendering{ m_VKRenderpassHandle->IsDynamicRendering() };
+		VkCommandBufferInheritanceInfo inheritanceInfo{
+			.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+			.pNext = dynamicRendering ? &inheritanceRenderingInfo : nullptr,
+			.renderPass = m_VKRenderpassHandle->GetVKRenderPass(),
+			.subpass = m_Subpass,
+			.framebuffer = dynamicRendering ? VK_NULL_HANDLE : m_VKRenderpassHandle->GetVKFramebuffers()[_index],
+			.occlusionQueryEnable = VK_FALSE,
+			.queryFlags = 0,
+			.pipelineStatistics = 0
+		};
+
+		VkCommandBufferBeginInfo beginInfo{
+			.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+			.pNext = nullptr,
+			.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+			.pInheritanceInfo = &inheritanceInfo
+		};
+
+		if (vkBeginCommandBuffer(m_VKCommandBuffer, &beginInfo) != VK_SUCCESS)
+		{
+			Logger::Log_Error("Failed to begin recording secondary Command Buffer.");
+			throw std::runtime_error("Failed to begin recording secondary Command Buffer.");
+		}
+	}
+
+	std::shared_ptr<Minerva::Vulkan::CommandBuffer> CommandBuffer::BeginSecondary(size_t _worker)
+	{
+		if (!m_VKWindow || !m_VKRenderpassHandle || m_VKContents != VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS)
+		{
+			Logger::Log_Error("Unable to begin secondary Command Buffer. Use Window::GetParallelCommandBuffer.");
+			throw std::runtime_error("Unable to begin secondary Command Buffer. Use Window::GetParallelCommandBuffer.");
+		}
+
+		return std::make_shared<Minerva::Vulkan::CommandBuffer>(m_VKRenderpassHandle, m_VKWindow->AcquireSecondaryCommandBuffer(_worker), m_FramebufferIndex, m_Subpass);
+	}
+
+	void CommandBuffer::ExecuteCommands(std::span<const std::shared_ptr<Minerva::Vulkan::CommandBuffer>> _secondaryCommandBuffers)
+	{
+		std::vector<VkCommandBuffer> commandBuffers;
+		commandBuffers.reserve(_secondaryCommandBuffers.size());
+		for (const auto& secondaryCommandBuffer : _secondaryCommandBuffers)
+		{
+			if (!secondaryCommandBuffer) continue;
+			commandBuffers.push_back(secondaryCommandBuffer->m_VKCommandBuffer);
+			m_Statistics += secondaryCommandBuffer->m_Statistics;
+		}
+
+		if (!commandBuffers.empty())
+			vkCmdExecuteCommands(m_VKCommandBuffer, static_cast<uint32_t>(commandBuffers.size()), commandBuffers.data());
+
+		// State set by the secondaries is undefined afterwards
+		ResetBoundState();
+	}
+
+	void CommandBuffer::SuspendRenderpass()
+	{
+		if (!m_InsideRenderpass || !m_VKWindow)
+		{
+			Logger::Log_Error("Unable to suspend render pass. Command buffer is not inside a primary render pass.");
+			throw std::runtime_error("Unable to suspend render pass. Command buffer is not inside a primary render pass.");
+		}
+
+		// Resuming would restart at the first subpass, and neither the G-buffer of a deferred pass, multisampled attachments nor a discarded depth are stored
+		if (m_VKRenderpassHandle->GetSubpassCount() > 1 || m_VKRenderpassHandle->IsMultisampled() || m_VKRenderpassHandle->IsDepthDiscarded())
+		{
+			Logger::Log_Error("Unable to suspend render pass. Render passes with several subpasses, multisampling or a discarded depth cannot be suspended.");
+			throw std::runtime_error("Unable to suspend render pass. Render passes with several subpasses, multisampling or a discarded depth cannot be suspended.");
+		}
+
+		m_VKRenderpassHandle->End(m_VKCommandBuffer, m_FramebufferIndex);
+		m_InsideRenderpass = false;
+
+		if (m_TrackResources)
+			m_VKRenderpassHandle->GetVKDeviceHandle()->GetResourceTracker().EndGraphics();
+	}
+
+	void CommandBuffer::ResumeRenderpass()
+	{
+		if (m_InsideRenderpass || !m_VKRenderpassHandle)
+		{
+			Logger::Log_Error("Unable to resume render pass. Render pass was not suspended.");
+			throw std::runtime_error("Unable to resume render pass. Render pass was not suspended.");
+		}
+
+		BeginGraphics();
+
+		// Attachments are loaded, nothing is cleared
+		m_VKRenderpassHandle->Begin(m_VKCommandBuffer, m_FramebufferIndex, m_VKContents, true);
+		m_InsideRenderpass = true;
+	}
+
+	void CommandBuffer::NextSubpass()
+	{
+		if (!m_InsideRenderpass || !m_VKWindow || m_Subpass + 1 >= m_VKRenderpassHandle->GetSubpassCount())
+		{
+			Logger::Log_Error("Unable to start next subpass. Command buffer is not inside a primary render pass with another subpass.");
+			throw std::runtime_error("Unable to start next subpass. Command buffer is not inside a primary render pass with another subpass.");
+		}
+
+		// Bound state stays valid, but pipelines are created for one subpass, so the next draws bind their own
+		vkCmdNextSubpass(m_VKCommandBuffer, m_VKContents);
+		++m_Subpass;
+	}
+
+	void CommandBuffer::End()
+	{
+		if (vkEndCommandBuffer(m_VKCommandBuffer) != VK_SUCCESS)
+		{
+			Logger::Log_Error("Failed to record secondary Command Buffer.");
+			throw std::runtime_error("Failed to record secondary Command Buffer.");
+		}
 	}
 
 	void CommandBuffer::BindGraphicsPipeline(std::shared_ptr<Minerva::Vulkan::Pipeline> _pipeline)
 	{
+		// Pipelines of a PipelineLibrary may still be compiling, their handle must not be read yet. Skipping the bind would record the
+		// following draws against the previously bound pipeline
+		if (!_pipeline->IsReady())
+		{
+			Logger::Log_Error("Unable to bind graphics pipeline. Graphics Pipeline is not compiled yet, check Pipeline::IsReady.");
+			throw std::runtime_error("Unable to bind graphics pipeline. Graphics Pipeline is not compiled yet, check Pipeline::IsReady.");
+		}
+
 		if (_pipeline->GetGraphicsPipeline() == VK_NULL_HANDLE)
+		{
 			Logger::Log_Error("Unable to bind graphics pipeline. Graphics Pipeline does not exist.");
+			throw std::runtime_error("Unable to bind graphics pipeline. Graphics Pipeline does not exist.");
+		}
+
+		if (_pipeline->GetGraphicsPipeline() == m_BoundGraphicsPipeline)
+		{
+			++m_Statistics.m_SkippedPipelineBinds;
+			return;
+		}
+
 		vkCmdBindPipeline(m_VKCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, _pipeline->GetGraphicsPipeline());
+		m_BoundGraphicsPipeline = _pipeline->GetGraphicsPipeline();
+		++m_Statistics.m_PipelineBinds;
+	}
+
+	void CommandBuffer::BindComputePipeline(std::shared_ptr<Minerva::Vulkan::Pipeline> _pipeline)
+	{
+		if (_pipeline->GetType() != Minerva::Pipeline::Type::COMPUTE || _pipeline->GetVKPipeline() == VK_NULL_HANDLE)
+			Logger::Log_Error("Unable to bind compute pipeline. Compute Pipeline does not exist.");
+
+		if (_pipeline->GetVKPipeline() == m_BoundComputePipeline)
+		{
+			++m_Statistics.m_SkippedPipelineBinds;
+			return;
+		}
+
+		vkCmdBindPipeline(m_VKCommandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, _pipeline->GetVKPipeline());
+		m_BoundComputePipeline = _pipeline->GetVKPipeline();
+		++m_Statistics.m_PipelineBinds;
 	}
 
 	void CommandBuffer::BindBuffer(std::shared_ptr<Minerva::Vulkan::Buffer> _buffer)
@@ -42,42 +219,259 @@ namespace Minerva::Vulkan
 		{
 		case Minerva::Buffer::Type::VERTEX:
 		{
-			std::array<VkBuffer, 1> vertexBuffers = { _buffer->GetVKBuffer() };
-			std::array<VkDeviceSize, 1> deviceOffsets = { 0 };
-			vkCmdBindVertexBuffers(m_VKCommandBuffer, 0, 1, vertexBuffers.data(), deviceOffsets.data());
+			BindVertexBuffer(_buffer, 0);
 		}break;
 
 		case Minerva::Buffer::Type::INDEX:
+		case Minerva::Buffer::Type::STORAGE: // Compute written indices
 		{
-			vkCmdBindIndexBuffer(m_VKCommandBuffer, _buffer->GetVKBuffer(), 0, VK_INDEX_TYPE_UINT16);
+			BindIndexBuffer(_buffer->GetVKBuffer(), _buffer->GetVKIndexType());
 		} break;
 		}
 
 	}
 
+	void CommandBuffer::BindVertexBuffer(std::shared_ptr<Minerva::Vulkan::Buffer> _buffer, VkDeviceSize _offset)
+	{
+		if (_buffer->GetVKBuffer() == m_BoundVertexBuffer && _offset == m_BoundVertexOffset)
+		{
+			++m_Statistics.m_SkippedVertexBufferBinds;
+			return;
+		}
+
+		std::array<VkBuffer, 1> vertexBuffers = { _buffer->GetVKBuffer() };
+		std::array<VkDeviceSize, 1> deviceOffsets = { _offset };
+		vkCmdBindVertexBuffers(m_VKCommandBuffer, 0, 1, vertexBuffers.data(), deviceOffsets.data());
+
+		m_BoundVertexBuffer = _buffer->GetVKBuffer();
+		m_BoundVertexOffset = _offset;
+		++m_Statistics.m_VertexBufferBinds;
+	}
+
 	void CommandBuffer::BindDescriptorSet(std::shared_ptr<Minerva::Vulkan::Pipeline> _pipeline, std::shared_ptr<Minerva::Vulkan::DescriptorSet> _descriptorSet)
 	{
 		VkDescriptorSet tmpDescSet{ _descriptorSet->GetVKDescriptorSet() };
 
+		// Bound sets are only reusable through the layout they were bound with
+		BoundDescriptorSet& bound{ _pipeline->GetVKBindPoint() == VK_PIPELINE_BIND_POINT_COMPUTE ? m_BoundComputeDescriptorSet : m_BoundGraphicsDescriptorSet };
+		if (bound.m_VKDescriptorSet == tmpDescSet && bound.m_VKPipelineLayout == _pipeline->GetVKPipelineLayout())
+		{
+			if (_pipeline->GetVKBindPoint() == VK_PIPELINE_BIND_POINT_COMPUTE)
+				m_BoundComputeDescriptorSetHandle = _descriptorSet;
+			++m_Statistics.m_SkippedDescriptorSetBinds;
+			return;
+		}
+
 		vkCmdBindDescriptorSets(m_VKCommandBuffer,
-			VK_PIPELINE_BIND_POINT_GRAPHICS,
+			_pipeline->GetVKBindPoint(),
 			_pipeline->GetVKPipelineLayout(),
 			0,
 			1,
 			&tmpDescSet,
 			0,
 			nullptr);
+
+		bound = BoundDescriptorSet{ tmpDescSet, _pipeline->GetVKPipelineLayout() };
+		++m_Statistics.m_DescriptorSetBinds;
+
+		if (_pipeline->GetVKBindPoint() == VK_PIPELINE_BIND_POINT_COMPUTE)
+			m_BoundComputeDescriptorSetHandle = _descriptorSet;
 	}
 
 	void CommandBuffer::Draw(int _vertexCount, int _instanceCount, int _firstIndex, int _firstInstance)
 	{
+		SetViewportAndScissor();
+
 		vkCmdDraw(m_VKCommandBuffer, _vertexCount, _instanceCount, _firstIndex, _firstInstance);
 	}
 
 	void CommandBuffer::DrawIndexed(uint32_t _indexCount, uint32_t _instanceCount, uint32_t _firstIndex, int32_t _vertexOffset, uint32_t _firstInstance)
 	{
-		// Setup viewport
+		SetViewportAndScissor();
+
+		// Draw
+		vkCmdDrawIndexed(m_VKCommandBuffer, _indexCount, _instanceCount, _firstIndex, _vertexOffset, _firstInstance);
+	}
+
+	void CommandBuffer::DrawIndirect(std::shared_ptr<Minerva::Vulkan::Buffer> _buffer, uint32_t _offset, uint32_t _drawCount, uint32_t _stride)
+	{
+		ValidateIndirectBuffer(_buffer);
+		SetViewportAndScissor();
+
+		if (_drawCount <= 1 || _buffer->GetVKDeviceHandle()->IsMultiDrawIndirectSupported())
+		{
+			vkCmdDrawIndirect(m_VKCommandBuffer, _buffer->GetVKBuffer(), _offset, _drawCount, _stride);
+			return;
+		}
+
+		// Without multiDrawIndirect every call may only read one command
+		for (uint32_t i{ 0 }; i < _drawCount; ++i)
+			vkCmdDrawIndirect(m_VKCommandBuffer, _buffer->GetVKBuffer(), _offset + static_cast<VkDeviceSize>(i) * _stride, 1, _stride);
+	}
+
+	void CommandBuffer::DrawIndexedIndirect(std::shared_ptr<Minerva::Vulkan::Buffer> _buffer, uint32_t _offset, uint32_t _drawCount, uint32_t _stride)
+	{
+		ValidateIndirectBuffer(_buffer);
+		SetViewportAndScissor();
+
+		if (_drawCount <= 1 || _buffer->GetVKDeviceHandle()->IsMultiDrawIndirectSupported())
+		{
+			vkCmdDrawIndexedIndirect(m_VKCommandBuffer, _buffer->GetVKBuffer(), _offset, _drawCount, _stride);
+			return;
+		}
+
+		for (uint32_t i{ 0 }; i < _drawCount; ++i)
+			vkCmdDrawIndexedIndirect(m_VKCommandBuffer, _buffer->GetVKBuffer(), _offset + static_cast<VkDeviceSize>(i) * _stride, 1, _stride);
+	}
+
+	void CommandBuffer::DrawIndirectCount(std::shared_ptr<Minerva::Vulkan::Buffer> _buffer, uint32_t _offset, std::shared_ptr<Minerva::Vulkan::Buffer> _countBuffer, uint32_t _countOffset,
+		uint32_t _maxDrawCount, uint32_t _stride)
+	{
+		ValidateIndirectBuffer(_buffer);
+		ValidateIndirectBuffer(_countBuffer);
+		if (!_buffer->GetVKDeviceHandle()->IsDrawIndirectCountSupported())
+		{
+			Logger::Log_Error("Unable to record DrawIndirectCount. drawIndirectCount is not supported by the device.");
+			throw std::runtime_error("Unable to record DrawIndirectCount. drawIndirectCount is not supported by the device.");
+		}
+
+		SetViewportAndScissor();
+
+		vkCmdDrawIndirectCount(m_VKCommandBuffer, _buffer->GetVKBuffer(), _offset, _countBuffer->GetVKBuffer(), _countOffset, _maxDrawCount, _stride);
+	}
+
+	void CommandBuffer::DrawIndexedIndirectCount(std::shared_ptr<Minerva::Vulkan::Buffer> _buffer, uint32_t _offset, std::shared_ptr<Minerva::Vulkan::Buffer> _countBuffer, uint32_t _countOffset,
+		uint32_t _maxDrawCount, uint32_t _stride)
+	{
+		ValidateIndirectBuffer(_buffer);
+		ValidateIndirectBuffer(_countBuffer);
+		if (!_buffer->GetVKDeviceHandle()->IsDrawIndirectCountSupported())
+		{
+			Logger::Log_Error("Unable to record DrawIndexedIndirectCount. drawIndirectCount is not supported by the device.");
+			throw std::runtime_error("Unable to record DrawIndexedIndirectCount. drawIndirectCount is not supported by the device.");
+		}
+
+		SetViewportAndScissor();
+
+		vkCmdDrawIndexedIndirectCount(m_VKCommandBuffer, _buffer->GetVKBuffer(), _offset, _countBuffer->GetVKBuffer(), _countOffset, _maxDrawCount, _stride);
+	}
+
+	void CommandBuffer::ValidateIndirectBuffer(const std::shared_ptr<Minerva::Vulkan::Buffer>& _buffer)
+	{
+		// Only these buffer types are created with VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT
+		if (_buffer->GetType() != Minerva::Buffer::Type::INDIRECT && _buffer->GetType() != Minerva::Buffer::Type::STORAGE)
+		{
+			Logger::Log_Error("Unable to record indirect command. Argument and count buffers must be INDIRECT or STORAGE buffers.");
+			throw std::runtime_error("Unable to record indirect command. Argument and count buffers must be INDIRECT or STORAGE buffers.");
+		}
+	}
+
+	void CommandBuffer::Dispatch(uint32_t _groupCountX, uint32_t _groupCountY, uint32_t _groupCountZ)
+	{
+		BeginDispatch("Dispatch");
+		FlushBarriers();
+
+		vkCmdDispatch(m_VKCommandBuffer, _groupCountX, _groupCountY, _groupCountZ);
+	}
+
+	void CommandBuffer::DispatchIndirect(std::shared_ptr<Minerva::Vulkan::Buffer> _buffer, uint32_t _offset)
+	{
+		ValidateIndirectBuffer(_buffer);
+		if (_offset % 4 != 0)
+		{
+			Logger::Log_Error("Unable to record DispatchIndirect. Offset must be a multiple of 4.");
+			throw std::runtime_error("Unable to record DispatchIndirect. Offset must be a multiple of 4.");
+		}
+
+		BeginDispatch("DispatchIndirect");
+
+		// Group counts written by an earlier dispatch, e.g. a culling or emission pass, are visible to the indirect read
+		UseBuffer(_buffer, { VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT }, false);
+		FlushBarriers();
+
+		vkCmdDispatchIndirect(m_VKCommandBuffer, _buffer->GetVKBuffer(), _offset);
+	}
+
+	void CommandBuffer::UpdateBuffer(std::shared_ptr<Minerva::Vulkan::Buffer> _buffer, uint32_t _offset, uint32_t _size, const void* _pData)
+	{
+		// Waits for earlier reads of this frame only, readers of the update wait for it when they use the buffer
+		UseBuffer(_buffer, { VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT }, true);
+		FlushBarriers();
+
+		// Inline update, _size must be a multiple of 4 and at most 65536 bytes
+		vkCmdUpdateBuffer(m_VKCommandBuffer, _buffer->GetVKBuffer(), _offset, _size, _pData);
+	}
+
+	void CommandBuffer::UseBuffer(std::shared_ptr<Minerva::Vulkan::Buffer> _buffer, const BarrierBatch::SyncState& _sync, bool _write)
+	{
+		if (m_TrackResources)
+			_buffer->GetResourceState().Use(m_PendingBarriers, _sync, _write);
+	}
+
+	void CommandBuffer::UseImage(ResourceState& _state, uint32_t _baseMip, uint32_t _mipCount, VkImageLayout _layout, const BarrierBatch::SyncState& _sync, bool _write)
+	{
+		if (m_TrackResources)
+			_state.Use(m_PendingBarriers, _baseMip, _mipCount, 0, _state.GetLayerCount(), _layout, _sync, _write);
+	}
+
+	void CommandBuffer::FlushBarriers()
+	{
+		if (m_PendingBarriers.IsEmpty()) return;
+
+		if (m_InsideRenderpass)
+		{
+			Logger::Log_Error("Unable to record barriers inside a render pass. Resources must be used before the render pass begins.");
+			m_PendingBarriers.Clear();
+			return;
+		}
+
+		m_PendingBarriers.Record(m_VKCommandBuffer);
+		m_PendingBarriers.Clear();
+		++m_Statistics.m_PipelineBarriers;
+	}
+
+	void CommandBuffer::BeginDispatch(const char* _command)
+	{
+		if (m_InsideRenderpass)
+		{
+			std::stringstream ss;
+			ss << _command << " recorded inside a render pass. Use Window::GetComputeCommandBuffer before GetCommandBuffer, or SuspendRenderpass.";
+			Logger::Log_Error(ss.str());
+		}
+
+		if (m_BoundComputePipeline == VK_NULL_HANDLE)
+		{
+			std::stringstream ss;
+			ss << "Unable to record " << _command << ". No compute pipeline is bound.";
+			Logger::Log_Error(ss.str());
+			throw std::runtime_error(ss.str());
+		}
+
+		// Storage buffers and images of the bound set wait for earlier writers
+		if (m_TrackResources && m_BoundComputeDescriptorSetHandle)
+			m_BoundComputeDescriptorSetHandle->AddComputeUses(m_PendingBarriers);
+	}
+
+	void CommandBuffer::BeginGraphics()
+	{
+		if (!m_TrackResources) return;
+
+		// Writes recorded before the render pass become visible to its draws, together with anything still pending
+		m_VKRenderpassHandle->GetVKDeviceHandle()->GetResourceTracker().BeginGraphics(m_PendingBarriers);
+		FlushBarriers();
+	}
+
+	void CommandBuffer::SetViewportAndScissor()
+	{
+		// Viewport and scissor cover the whole framebuffer, which cannot change within a render pass
 		VkExtent2D frambufferExtent{ m_VKRenderpassHandle->GetFramebufferExtent() };
+		if (frambufferExtent.width == m_ViewportExtent.width && frambufferExtent.height == m_ViewportExtent.height)
+		{
+			++m_Statistics.m_SkippedDynamicStateSets;
+			return;
+		}
+
+		// Setup viewport
 		VkViewport viewport{
 			.x = 0.f,
 			.y = 0.f,
@@ -97,22 +491,80 @@ namespace Minerva::Vulkan
 		vkCmdSetViewport(m_VKCommandBuffer, 0, 1, &viewport);
 		vkCmdSetScissor(m_VKCommandBuffer, 0, 1, &scissors);
 
-		// Draw
-		vkCmdDrawIndexed(m_VKCommandBuffer, _indexCount, _instanceCount, _firstIndex, _vertexOffset, _firstInstance);
+		m_ViewportExtent = frambufferExtent;
+		++m_Statistics.m_DynamicStateSets;
+	}
+
+	void CommandBuffer::ResetBoundState()
+	{
+		m_BoundGraphicsPipeline = VK_NULL_HANDLE;
+		m_BoundComputePipeline = VK_NULL_HANDLE;
+		m_BoundGraphicsDescriptorSet = BoundDescriptorSet{};
+		m_BoundComputeDescriptorSet = BoundDescriptorSet{};
+		m_BoundVertexBuffer = VK_NULL_HANDLE;
+		m_BoundVertexOffset = 0;
+		m_BoundIndexBuffer = VK_NULL_HANDLE;
+		m_BoundIndexType = VK_INDEX_TYPE_UINT16;
+		m_ViewportExtent = VkExtent2D{ 0, 0 };
+	}
+
+	void CommandBuffer::BindIndexBuffer(VkBuffer _buffer, VkIndexType _indexType)
+	{
+		if (_buffer == m_BoundIndexBuffer && _indexType == m_BoundIndexType)
+		{
+			++m_Statistics.m_SkippedIndexBufferBinds;
+			return;
+		}
+
+		vkCmdBindIndexBuffer(m_VKCommandBuffer, _buffer, 0, _indexType);
+		m_BoundIndexBuffer = _buffer;
+		m_BoundIndexType = _indexType;
+		++m_Statistics.m_IndexBufferBinds;
 	}
 
 	void CommandBuffer::PushConstant(std::shared_ptr<Minerva::Vulkan::Pipeline> _pipeline, Minerva::Shader::Type _stage, uint32_t _offset, uint32_t _size, const void* _pValue)
 	{
-		auto ShaderStage = [](auto ShaderStage) constexpr
+		// Stages come from the pipeline's reflected range rather than _stage, vkCmdPushConstants must name every stage sharing the range
+		const VkPushConstantRange& range{ _pipeline->GetVKPushConstantRange() };
+		if (range.size == 0 || _offset < range.offset || _offset >= range.offset + range.size)
 		{
-			switch (ShaderStage)
-			{
-			case Minerva::Shader::Type::VERTEX:				return VK_SHADER_STAGE_VERTEX_BIT;
-			case Minerva::Shader::Type::FRAGMENT:			return VK_SHADER_STAGE_FRAGMENT_BIT;
-				//case Minerva::Buffer::Type::UNIFORM:               return VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
-			}
-		}(_stage);
+			Logger::Log_Error("Unable to push constants. The pipeline's shaders do not read push constants at this offset.");
+			throw std::runtime_error("Unable to push constants. The pipeline's shaders do not read push constants at this offset.");
+		}
+
+		// _stage still has to be one of them
+		VkShaderStageFlags stageFlags{ 0 };
+		switch (_stage)
+		{
+		case Minerva::Shader::Type::VERTEX:
+			stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+			break;
+
+		case Minerva::Shader::Type::FRAGMENT:
+			stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+			break;
+
+		case Minerva::Shader::Type::TESSELLATION:
+			stageFlags = VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT | VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+			break;
+
+		case Minerva::Shader::Type::COMPUTE:
+			stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+			break;
+
+		case Minerva::Shader::Type::ALL_GRAPHICS:
+		default:
+			stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS;
+			break;
+		}
+
+		if (!(range.stageFlags & stageFlags))
+		{
+			Logger::Log_Error("Unable to push constants. The pipeline's shaders of this stage do not read push constants.");
+			throw std::runtime_error("Unable to push constants. The pipeline's shaders of this stage do not read push constants.");
+		}
 
-		vkCmdPushConstants(m_VKCommandBuffer, _pipeline->GetVKPipelineLayout(), ShaderStage, _offset, _size, _pValue);
+		// Trailing bytes the shaders never read, e.g. padding of the application's struct, are dropped
+		vkCmdPushConstants(m_VKCommandBuffer, _pipeline->GetVKPipelineLayout(), range.stageFlags, _offset, std::min(_size, range.offset + range.size - _offset), _pValue);
 	}
 }
@@ -5,19 +5,96 @@ namespace Minerva::Vulkan
 	class CommandBuffer
 	{
 	public:
-		CommandBuffer(std::shared_ptr<Minerva::Vulkan::Renderpass> _renderpass, VkCommandBuffer _vkCommandBuffer, VkExtent2D _extent, int _index);
+		// A null _renderpass records outside of a render pass (compute). _isRecording continues a command buffer that was already begun.
+		// With VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS the render pass is filled through BeginSecondary/ExecuteCommands only,
+		// which needs the owning _window for its per thread command pools
+		CommandBuffer(std::shared_ptr<Minerva::Vulkan::Renderpass> _renderpass, VkCommandBuffer _vkCommandBuffer, VkExtent2D _extent, int _index, bool _isRecording = false,
+			VkSubpassContents _contents = VK_SUBPASS_CONTENTS_INLINE, Minerva::Vulkan::Window* _window = nullptr);
+
+		// Secondary command buffer continuing subpass _subpass of _renderpass on framebuffer _index
+		CommandBuffer(std::shared_ptr<Minerva::Vulkan::Renderpass> _renderpass, VkCommandBuffer _vkSecondaryCommandBuffer, int _index, uint32_t _subpass = 0);
+
+		// Begins a secondary command buffer from _worker's pool, inheriting this command buffer's render pass and current subpass
+		std::shared_ptr<Minerva::Vulkan::CommandBuffer> BeginSecondary(size_t _worker);
+		void ExecuteCommands(std::span<const std::shared_ptr<Minerva::Vulkan::CommandBuffer>> _secondaryCommandBuffers);
+		void End();
+
+		// Ends the render pass so compute work can read its attachments, ResumeRenderpass continues it without clearing.
+		// Bound state is kept. A suspended render pass must be resumed before Window::PageFlip
+		void SuspendRenderpass();
+		void ResumeRenderpass();
+		// Moves to the next subpass of a multi subpass render pass, which must be in its last subpass when it ends
+		void NextSubpass();
 
 		// vkCmd functions abstraction
 		void BindGraphicsPipeline(std::shared_ptr<Minerva::Vulkan::Pipeline> _pipeline);
+		void BindComputePipeline(std::shared_ptr<Minerva::Vulkan::Pipeline> _pipeline);
 		void BindBuffer(std::shared_ptr<Minerva::Vulkan::Buffer> _buffer);
+		void BindVertexBuffer(std::shared_ptr<Minerva::Vulkan::Buffer> _buffer, VkDeviceSize _offset);
 		void BindDescriptorSet(std::shared_ptr<Minerva::Vulkan::Pipeline> _pipeline, std::shared_ptr<Minerva::Vulkan::DescriptorSet> _descriptorSet);
 		void Draw(int _vertexCount, int _instanceCount, int _firstIndex, int _firstInstance);
 		void DrawIndexed(uint32_t _indexCount, uint32_t _instanceCount, uint32_t _firstIndex, int32_t _vertexOffset, uint32_t _firstInstance);
+		void DrawIndirect(std::shared_ptr<Minerva::Vulkan::Buffer> _buffer, uint32_t _offset, uint32_t _drawCount, uint32_t _stride);
+		void DrawIndexedIndirect(std::shared_ptr<Minerva::Vulkan::Buffer> _buffer, uint32_t _offset, uint32_t _drawCount, uint32_t _stride);
+		void DrawIndirectCount(std::shared_ptr<Minerva::Vulkan::Buffer> _buffer, uint32_t _offset, std::shared_ptr<Minerva::Vulkan::Buffer> _countBuffer, uint32_t _countOffset,
+			uint32_t _maxDrawCount, uint32_t _stride);
+		void DrawIndexedIndirectCount(std::shared_ptr<Minerva::Vulkan::Buffer> _buffer, uint32_t _offset, std::shared_ptr<Minerva::Vulkan::Buffer> _countBuffer, uint32_t _countOffset,
+			uint32_t _maxDrawCount, uint32_t _stride);
+		void Dispatch(uint32_t _groupCountX, uint32_t _groupCountY, uint32_t _groupCountZ);
+		void DispatchIndirect(std::shared_ptr<Minerva::Vulkan::Buffer> _buffer, uint32_t _offset);
+		void UpdateBuffer(std::shared_ptr<Minerva::Vulkan::Buffer> _buffer, uint32_t _offset, uint32_t _size, const void* _pData);
 		void PushConstant(std::shared_ptr<Minerva::Vulkan::Pipeline> _pipeline, Minerva::Shader::Type _stage, uint32_t _offset, uint32_t _size, const void* _pValue);
 
+		// Resource state tracking. Uses append the barriers they need to a pending batch, recorded as one vkCmdPipelineBarrier
+		// by the next Dispatch or transfer, or by FlushBarriers. Barriers cannot be recorded inside a render pass
+		void UseBuffer(std::shared_ptr<Minerva::Vulkan::Buffer> _buffer, const BarrierBatch::SyncState& _sync, bool _write);
+		void UseImage(ResourceState& _state, uint32_t _baseMip, uint32_t _mipCount, VkImageLayout _layout, const BarrierBatch::SyncState& _sync, bool _write);
+		void FlushBarriers();
+		// For command buffers whose barriers are issued by their owner, e.g. RenderGraph passes
+		inline void DisableResourceTracking() { m_TrackResources = false; }
+
+		inline const Minerva::CommandBuffer::Statistics& GetStatistics() const { return m_Statistics; }
+		inline VkCommandBuffer GetVKCommandBuffer() const { return m_VKCommandBuffer; }
+		inline std::shared_ptr<Minerva::Vulkan::Renderpass> GetVKRenderpassHandle() const { return m_VKRenderpassHandle; }
+
 	private:
 		VkCommandBuffer m_VKCommandBuffer;
 		std::shared_ptr<Minerva::Vulkan::Renderpass> m_VKRenderpassHandle;
+		Minerva::Vulkan::Window* m_VKWindow; // Owner of the frame's command pools, outlives the command buffer
+		VkSubpassContents m_VKContents;
+		int m_FramebufferIndex;
+		uint32_t m_Subpass;
+		bool m_InsideRenderpass;
+		bool m_TrackResources;
+		BarrierBatch m_PendingBarriers;
+		std::shared_ptr<Minerva::Vulkan::DescriptorSet> m_BoundComputeDescriptorSetHandle; // Resources the next Dispatch uses
+
+		// Shadow of the state recorded so far. Binds and dynamic state that would not change it are skipped.
+		// Starts empty for every CommandBuffer object, so a new object never relies on state recorded through another one
+		struct BoundDescriptorSet
+		{
+			VkDescriptorSet m_VKDescriptorSet{ VK_NULL_HANDLE };
+			VkPipelineLayout m_VKPipelineLayout{ VK_NULL_HANDLE };
+		};
+
+		VkPipeline m_BoundGraphicsPipeline;
+		VkPipeline m_BoundComputePipeline;
+		BoundDescriptorSet m_BoundGraphicsDescriptorSet;
+		BoundDescriptorSet m_BoundComputeDescriptorSet;
+		VkBuffer m_BoundVertexBuffer;
+		VkDeviceSize m_BoundVertexOffset;
+		VkBuffer m_BoundIndexBuffer;
+		VkIndexType m_BoundIndexType;
+		VkExtent2D m_ViewportExtent; // Zero until the viewport and scissor are set
+		Minerva::CommandBuffer::Statistics m_Statistics;
+
+		// Helper function
+		void SetViewportAndScissor();
+		void ResetBoundState();
+		void BindIndexBuffer(VkBuffer _buffer, VkIndexType _indexType);
+		static void ValidateIndirectBuffer(const std::shared_ptr<Minerva::Vulkan::Buffer>& _buffer);
+		void BeginGraphics();
+		void BeginDispatch(const char* _command);
 
 		//int m_index; // Index of framebuffer the command buffer renders to
 	};
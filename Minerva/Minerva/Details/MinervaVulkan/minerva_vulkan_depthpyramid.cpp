@@ -0,0 +1,261 @@
+namespace Minerva::Vulkan
+{
+	DepthPyramid::DepthPyramid(std::shared_ptr<Minerva::Vulkan::Device> _device, std::shared_ptr<Minerva::Vulkan::Renderpass> _renderpass,
+		std::shared_ptr<Minerva::Vulkan::Shader> _buildShader) :
+		m_VKDeviceHandle{ _device }, m_VKRenderpassHandle{ _renderpass },
+		m_Layouts{ {
+			{ 0, Minerva::DescriptorSet::DescriptorType::COMBINED_IMAGE_SAMPLER, 1, Minerva::Shader::Type::COMPUTE }, // Source
+			{ 1, Minerva::DescriptorSet::DescriptorType::STORAGE_IMAGE, 1, Minerva::Shader::Type::COMPUTE }           // Destination
+		} },
+		m_VKDescriptorSets{}, m_VKPipeline{ nullptr },
+		m_VKImage{ VK_NULL_HANDLE }, m_VKImageMemory{ VK_NULL_HANDLE }, m_VKImageView{ VK_NULL_HANDLE }, m_VKMipImageViews{},
+		m_VKSampler{ VK_NULL_HANDLE }, m_VKSourceDepthImageView{ VK_NULL_HANDLE }, m_SourceGeneration{ 0 }, m_Extent{ 0, 0 }, m_MipCount{ 0 },
+		m_State{ _device->GetResourceTracker() }
+	{
+		if (!m_VKRenderpassHandle->HasDepthAttachment())
+		{
+			Logger::Log_Error("Unable to create DepthPyramid. Render pass has no depth attachment.");
+			throw std::runtime_error("Unable to create DepthPyramid. Render pass has no depth attachment.");
+		}
+
+		if (m_VKRenderpassHandle->IsDepthDiscarded())
+		{
+			Logger::Log_Error("Unable to create DepthPyramid. Depth is not stored by the render pass.");
+			throw std::runtime_error("Unable to create DepthPyramid. Depth is not stored by the render pass.");
+		}
+
+		// Sets are allocated once for the largest pyramid and rewritten on resize, the descriptor pool never frees
+		m_VKDescriptorSets.reserve(MAX_MIP_COUNT);
+		for (uint32_t i{ 0 }; i < MAX_MIP_COUNT; ++i)
+			m_VKDescriptorSets.emplace_back(std::make_shared<Minerva::Vulkan::DescriptorSet>(m_VKDeviceHandle, m_Layouts));
+
+		m_VKPipeline = std::make_shared<Minerva::Vulkan::Pipeline>(m_VKDeviceHandle, _buildShader, m_VKDescriptorSets[0]);
+
+		// Texels are fetched, the sampler only has to be valid
+		VkSamplerCreateInfo samplerInfo{
+			.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+			.magFilter = VK_FILTER_NEAREST,
+			.minFilter = VK_FILTER_NEAREST,
+			.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST,
+			.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+			.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+			.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+			.mipLodBias = 0.f,
+			.anisotropyEnable = VK_FALSE,
+			.maxAnisotropy = 1.f,
+			.compareEnable = VK_FALSE,
+			.compareOp = VK_COMPARE_OP_ALWAYS,
+			.minLod = 0.f,
+			.maxLod = static_cast<float>(MAX_MIP_COUNT),
+			.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE,
+			.unnormalizedCoordinates = VK_FALSE
+		};
+
+		if (int vkErr{ vkCreateSampler(m_VKDeviceHandle->GetVKDevice(), &samplerInfo, nullptr, &m_VKSampler) }; vkErr)
+		{
+			Logger::Log_Error("Unable to create DepthPyramid. vkCreateSampler failed.");
+			throw std::runtime_error("Unable to create DepthPyramid. vkCreateSampler failed.");
+		}
+
+		Update();
+	}
+
+	DepthPyramid::~DepthPyramid()
+	{
+		DestroyImage();
+
+		if (m_VKSampler != VK_NULL_HANDLE)
+			vkDestroySampler(m_VKDeviceHandle->GetVKDevice(), m_VKSampler, nullptr);
+	}
+
+	bool DepthPyramid::Update()
+	{
+		// SetDepthOps can switch the store op after construction
+		if (m_VKRenderpassHandle->IsDepthDiscarded())
+		{
+			Logger::Log_Error("Unable to update DepthPyramid. Depth is not stored by the render pass.");
+			throw std::runtime_error("Unable to update DepthPyramid. Depth is not stored by the render pass.");
+		}
+
+		// The render pass generation changes with its attachments, even when the new depth view reuses the old handle
+		const VkExtent2D depthExtent{ m_VKRenderpassHandle->GetFramebufferExtent() };
+		if (m_VKImage != VK_NULL_HANDLE && m_SourceGeneration == m_VKRenderpassHandle->GetGeneration())
+			return false;
+
+		// Only happens on resize, the frames using the old image have to finish first
+		if (m_VKImage != VK_NULL_HANDLE)
+			vkDeviceWaitIdle(m_VKDeviceHandle->GetVKDevice());
+
+		DestroyImage();
+		CreateImage(depthExtent);
+		m_VKSourceDepthImageView = m_VKRenderpassHandle->GetVKDepthImageView();
+		m_SourceGeneration = m_VKRenderpassHandle->GetGeneration();
+		WriteDescriptors();
+		return true;
+	}
+
+	void DepthPyramid::Build(Minerva::Vulkan::CommandBuffer& _cmdBuffer)
+	{
+		// Each dispatch waits for the previous mip and for earlier readers of its own mip through the tracked descriptors
+		_cmdBuffer.BindComputePipeline(m_VKPipeline);
+
+		VkExtent2D sourceExtent{ m_VKRenderpassHandle->GetFramebufferExtent() };
+		for (uint32_t mip{ 0 }; mip < m_MipCount; ++mip)
+		{
+			const VkExtent2D extent{ std::max(m_Extent.width >> mip, 1u), std::max(m_Extent.height >> mip, 1u) };
+
+			BuildData buildData{
+				.m_SourceWidth = static_cast<int32_t>(sourceExtent.width),
+				.m_SourceHeight = static_cast<int32_t>(sourceExtent.height),
+				.m_DestinationWidth = static_cast<int32_t>(extent.width),
+				.m_DestinationHeight = static_cast<int32_t>(extent.height)
+			};
+
+			_cmdBuffer.BindDescriptorSet(m_VKPipeline, m_VKDescriptorSets[mip]);
+			_cmdBuffer.PushConstant(m_VKPipeline, Minerva::Shader::Type::COMPUTE, 0, sizeof(BuildData), &buildData);
+			_cmdBuffer.Dispatch((extent.width + 7) / 8, (extent.height + 7) / 8, 1);
+
+			sourceExtent = extent;
+		}
+	}
+
+	void DepthPyramid::CreateImage(VkExtent2D _depthExtent)
+	{
+		// Largest power of two not above the depth size, so every further mip halves exactly
+		auto FloorPowerOfTwo = [](uint32_t _value)
+		{
+			uint32_t result{ 1 };
+			while (result * 2 <= _value) result *= 2;
+			return result;
+		};
+
+		m_Extent = VkExtent2D{ FloorPowerOfTwo(std::max(_depthExtent.width, 1u)), FloorPowerOfTwo(std::max(_depthExtent.height, 1u)) };
+		m_MipCount = 1;
+		while ((std::max(m_Extent.width, m_Extent.height) >> m_MipCount) > 0 && m_MipCount < MAX_MIP_COUNT)
+			++m_MipCount;
+
+		VkImageCreateInfo imageInfo{
+			.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+			.pNext = nullptr,
+			.flags = 0,
+			.imageType = VK_IMAGE_TYPE_2D,
+			.format = VK_FORMAT_R32_SFLOAT,
+			.extent = { m_Extent.width, m_Extent.height, 1 },
+			.mipLevels = m_MipCount,
+			.arrayLayers = 1,
+			.samples = VK_SAMPLE_COUNT_1_BIT,
+			.tiling = VK_IMAGE_TILING_OPTIMAL,
+			.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+			.sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+			.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED
+		};
+
+		if (int vkErr{ vkCreateImage(m_VKDeviceHandle->GetVKDevice(), &imageInfo, nullptr, &m_VKImage) }; vkErr)
+		{
+			Logger::Log_Error("Unable to create DepthPyramid. vkCreateImage failed.");
+			throw std::runtime_error("Unable to create DepthPyramid. vkCreateImage failed.");
+		}
+
+		VkMemoryRequirements memRequirements{};
+		vkGetImageMemoryRequirements(m_VKDeviceHandle->GetVKDevice(), m_VKImage, &memRequirements);
+
+		VkMemoryAllocateInfo allocInfo{
+			.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+			.allocationSize = memRequirements.size,
+			.memoryTypeIndex = FindMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
+		};
+
+		if (int vkErr{ vkAllocateMemory(m_VKDeviceHandle->GetVKDevice(), &allocInfo, nullptr, &m_VKImageMemory) }; vkErr)
+		{
+			Logger::Log_Error("Unable to create DepthPyramid. vkAllocateMemory failed.");
+			throw std::runtime_error("Unable to create DepthPyramid. vkAllocateMemory failed.");
+		}
+
+		vkBindImageMemory(m_VKDeviceHandle->GetVKDevice(), m_VKImage, m_VKImageMemory, 0);
+
+		VkImageViewCreateInfo viewInfo{
+			.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+			.image = m_VKImage,
+			.viewType = VK_IMAGE_VIEW_TYPE_2D,
+			.format = VK_FORMAT_R32_SFLOAT,
+			.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, m_MipCount, 0, 1 }
+		};
+
+		if (int vkErr{ vkCreateImageView(m_VKDeviceHandle->GetVKDevice(), &viewInfo, nullptr, &m_VKImageView) }; vkErr)
+		{
+			Logger::Log_Error("Unable to create DepthPyramid. vkCreateImageView failed.");
+			throw std::runtime_error("Unable to create DepthPyramid. vkCreateImageView failed.");
+		}
+
+		m_VKMipImageViews.resize(m_MipCount, VK_NULL_HANDLE);
+		for (uint32_t mip{ 0 }; mip < m_MipCount; ++mip)
+		{
+			viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, mip, 1, 0, 1 };
+			if (int vkErr{ vkCreateImageView(m_VKDeviceHandle->GetVKDevice(), &viewInfo, nullptr, &m_VKMipImageViews[mip]) }; vkErr)
+			{
+				Logger::Log_Error("Unable to create DepthPyramid. vkCreateImageView failed.");
+				throw std::runtime_error("Unable to create DepthPyramid. vkCreateImageView failed.");
+			}
+		}
+
+		// Mips move to GENERAL on their first use
+		m_State.Reset(m_VKImage, VK_IMAGE_ASPECT_COLOR_BIT, m_MipCount);
+	}
+
+	void DepthPyramid::DestroyImage()
+	{
+		for (VkImageView view : m_VKMipImageViews)
+		{
+			if (view != VK_NULL_HANDLE)
+				vkDestroyImageView(m_VKDeviceHandle->GetVKDevice(), view, nullptr);
+		}
+		m_VKMipImageViews.clear();
+
+		if (m_VKImageView != VK_NULL_HANDLE)
+			vkDestroyImageView(m_VKDeviceHandle->GetVKDevice(), m_VKImageView, nullptr);
+		if (m_VKImage != VK_NULL_HANDLE)
+			vkDestroyImage(m_VKDeviceHandle->GetVKDevice(), m_VKImage, nullptr);
+		if (m_VKImageMemory != VK_NULL_HANDLE)
+			vkFreeMemory(m_VKDeviceHandle->GetVKDevice(), m_VKImageMemory, nullptr);
+
+		m_VKImageView = VK_NULL_HANDLE;
+		m_VKImage = VK_NULL_HANDLE;
+		m_VKImageMemory = VK_NULL_HANDLE;
+	}
+
+	void DepthPyramid::WriteDescriptors()
+	{
+		for (uint32_t mip{ 0 }; mip < m_MipCount; ++mip)
+		{
+			// Mip 0 reads the depth attachment, which is read only outside of the render pass
+			const VkDescriptorImageInfo source{
+				.sampler = m_VKSampler,
+				.imageView = mip == 0 ? m_VKSourceDepthImageView : m_VKMipImageViews[mip - 1],
+				.imageLayout = mip == 0 ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_GENERAL
+			};
+			const VkDescriptorImageInfo destination{
+				.sampler = VK_NULL_HANDLE,
+				.imageView = m_VKMipImageViews[mip],
+				.imageLayout = VK_IMAGE_LAYOUT_GENERAL
+			};
+
+			// The depth attachment is synchronized by the render pass, only the pyramid's own mips are tracked
+			m_VKDescriptorSets[mip]->Update(m_Layouts[0], std::span<const VkDescriptorImageInfo>{ &source, 1 }, mip == 0 ? nullptr : &m_State, mip == 0 ? 0 : mip - 1, 1);
+			m_VKDescriptorSets[mip]->Update(m_Layouts[1], std::span<const VkDescriptorImageInfo>{ &destination, 1 }, &m_State, mip, 1);
+		}
+	}
+
+	uint32_t DepthPyramid::FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties)
+	{
+		VkPhysicalDeviceMemoryProperties memProperties;
+		vkGetPhysicalDeviceMemoryProperties(m_VKDeviceHandle->GetVKPhysicalDevice(), &memProperties);
+
+		for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+			if ((typeFilter & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+				return i;
+			}
+		}
+
+		throw std::runtime_error("failed to find suitable memory type!");
+	}
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+namespace Minerva::Vulkan
+{
+	// Hierarchical depth: mip 0 is the depth attachment reduced to the next lower power of two, every further mip
+	// keeps the farthest depth of the texels it covers. Built on the GPU with Assets/Shaders/hiz_build.comp.
+	// The image is used in VK_IMAGE_LAYOUT_GENERAL, so it can be written as storage image and sampled without transitions.
+	// Its state is tracked per mip, dispatches reading or writing it get their barriers from the command buffer
+	class DepthPyramid
+	{
+	public:
+		static constexpr uint32_t MAX_MIP_COUNT{ 14 }; // 8192 x 8192
+
+		DepthPyramid(std::shared_ptr<Minerva::Vulkan::Device> _device, std::shared_ptr<Minerva::Vulkan::Renderpass> _renderpass,
+			std::shared_ptr<Minerva::Vulkan::Shader> _buildShader);
+		~DepthPyramid();
+
+		// Recreates the pyramid when the depth attachment was resized. Must be called before the pyramid is used in a frame,
+		// since recording its old descriptors and replacing them later would invalidate the command buffer. Returns true when recreated
+		bool Update();
+
+		// Records the downsample of the depth attachment into every mip. The render pass must be suspended
+		void Build(Minerva::Vulkan::CommandBuffer& _cmdBuffer);
+
+		inline VkImageView GetVKImageView() const { return m_VKImageView; }
+		inline VkSampler GetVKSampler() const { return m_VKSampler; }
+		inline VkExtent2D GetExtent() const { return m_Extent; }
+		inline uint32_t GetMipCount() const { return m_MipCount; }
+		inline ResourceState& GetResourceState() { return m_State; }
+
+	private:
+		// Push constant block of hiz_build.comp
+		struct BuildData
+		{
+			int32_t m_SourceWidth;
+			int32_t m_SourceHeight;
+			int32_t m_DestinationWidth;
+			int32_t m_DestinationHeight;
+		};
+
+		std::shared_ptr<Minerva::Vulkan::Device> m_VKDeviceHandle;
+		std::shared_ptr<Minerva::Vulkan::Renderpass> m_VKRenderpassHandle;
+
+		// One set per mip: previous mip (or the depth attachment) as source, the mip as destination
+		std::array<Minerva::DescriptorSet::Layout, 2> m_Layouts;
+		std::vector<std::shared_ptr<Minerva::Vulkan::DescriptorSet>> m_VKDescriptorSets;
+		std::shared_ptr<Minerva::Vulkan::Pipeline> m_VKPipeline;
+
+		VkImage m_VKImage;
+		VkDeviceMemory m_VKImageMemory;
+		VkImageView m_VKImageView;                   // All mips, for sampling
+		std::vector<VkImageView> m_VKMipImageViews;  // One mip each, for building
+		VkSampler m_VKSampler;
+		VkImageView m_VKSourceDepthImageView;        // Depth attachment the descriptors were written for
+		uint32_t m_SourceGeneration;                 // Render pass generation of m_VKSourceDepthImageView
+		VkExtent2D m_Extent;
+		uint32_t m_MipCount;
+		ResourceState m_State;
+
+		// Helper functions
+		void CreateImage(VkExtent2D _depthExtent);
+		void DestroyImage();
+		void WriteDescriptors();
+		uint32_t FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
+	};
+}
+
+#include "minerva_vulkan_depthpyramid.cpp"
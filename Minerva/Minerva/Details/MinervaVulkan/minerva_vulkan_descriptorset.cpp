@@ -1,7 +1,7 @@
 namespace Minerva::Vulkan
 {
 	DescriptorSet::DescriptorSet(std::shared_ptr<Minerva::Vulkan::Device> _device, std::span<Minerva::DescriptorSet::Layout> _layouts) :
-		m_VKDeviceHandle{ _device }
+		m_VKDeviceHandle{ _device }, m_Layouts{ _layouts.begin(), _layouts.end() }
 	{
 		if (_layouts.size() == 0)
 		{
@@ -22,6 +22,11 @@ namespace Minerva::Vulkan
 				return VkShaderStageFlagBits::VK_SHADER_STAGE_FRAGMENT_BIT;
 				break;
 
+			case Minerva::Shader::Type::COMPUTE:
+				return VkShaderStageFlagBits::VK_SHADER_STAGE_COMPUTE_BIT;
+				break;
+
+			case Minerva::Shader::Type::ALL_GRAPHICS:
 			default:
 				return VkShaderStageFlagBits::VK_SHADER_STAGE_ALL_GRAPHICS;
 				break;
@@ -40,20 +45,8 @@ namespace Minerva::Vulkan
 			bindings[i].stageFlags = GetShaderFlag(_layouts[i].m_ShaderStage);
 		}
 
-		// Create DescriptorSetLayout
-		VkDescriptorSetLayoutCreateInfo descriptorSetLayoutInfo {
-			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
-			.pNext = nullptr,
-			.flags = 0,
-			.bindingCount = static_cast<uint32_t>(bindings.size()),
-			.pBindings = bindings.data()
-		};
-
-		if (int vkErr{ vkCreateDescriptorSetLayout(m_VKDeviceHandle->GetVKDevice(), &descriptorSetLayoutInfo, nullptr, &m_VKDescriptorSetLayout) }; vkErr)
-		{
-			Logger::Log_Error("Unable to create Descriptor Set. vkCreateDescriptorSetLayout error.");
-			throw std::runtime_error("Unable to create Descriptor Set. vkCreateDescriptorSetLayout error.");
-		}
+		// Sets with the same bindings share one layout, which also lets them share pipeline layouts
+		m_VKDescriptorSetLayout = m_VKDeviceHandle->GetLayoutCache().GetDescriptorSetLayout(m_VKDeviceHandle->GetVKDevice(), bindings);
 
 		// Allocate Descriptor Set
 		VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{
@@ -73,8 +66,7 @@ namespace Minerva::Vulkan
 
 	DescriptorSet::~DescriptorSet()
 	{
-		if (m_VKDescriptorSetLayout != VK_NULL_HANDLE)
-			vkDestroyDescriptorSetLayout(m_VKDeviceHandle->GetVKDevice(), m_VKDescriptorSetLayout, nullptr);
+		// The layout is owned by the device's LayoutCache
 	}
 
 	void DescriptorSet::Update(const Minerva::DescriptorSet::Layout& _layout, std::span<std::shared_ptr<Minerva::Vulkan::Texture>> _textures)
@@ -89,6 +81,10 @@ namespace Minerva::Vulkan
 			imageInfos[i].sampler = _textures[i]->GetVKSampler();
 		}
 
+		ClearTrackedResources(_layout.m_BindingPoint);
+		for (int i{ 0 }; i < _layout.m_DescriptorCount; ++i)
+			m_TrackedResources.push_back({ _layout.m_BindingPoint, &_textures[i]->GetResourceState(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 0, VK_REMAINING_MIP_LEVELS, false, false });
+
 		//! DescriptorWrite information
 		VkWriteDescriptorSet descriptorWrite{};
 		descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
@@ -102,4 +98,88 @@ namespace Minerva::Vulkan
 		//! Write into descriptor set
 		vkUpdateDescriptorSets(m_VKDeviceHandle->GetVKDevice(), 1, &descriptorWrite, 0, nullptr);
 	}
+
+	void DescriptorSet::Update(const Minerva::DescriptorSet::Layout& _layout, std::span<std::shared_ptr<Minerva::Vulkan::Buffer>> _buffers)
+	{
+		//! Create VkDescriptorBufferInfos for each Buffer in the layout, whole buffer range
+		std::vector<VkDescriptorBufferInfo> bufferInfos(_layout.m_DescriptorCount);
+
+		for (int i{ 0 }; i < _layout.m_DescriptorCount; ++i)
+		{
+			bufferInfos[i].buffer = _buffers[i]->GetVKBuffer();
+			bufferInfos[i].offset = 0;
+			bufferInfos[i].range = VK_WHOLE_SIZE;
+		}
+
+		// Storage buffers may be written by the shader, uniform ones only read
+		const Minerva::DescriptorSet::DescriptorType type{ _layout.m_DescriptorType };
+		const bool write{ type == Minerva::DescriptorSet::DescriptorType::STORAGE_BUFFER || type == Minerva::DescriptorSet::DescriptorType::STORAGE_BUFFER_DYNAMIC };
+
+		ClearTrackedResources(_layout.m_BindingPoint);
+		for (int i{ 0 }; i < _layout.m_DescriptorCount; ++i)
+			m_TrackedResources.push_back({ _layout.m_BindingPoint, &_buffers[i]->GetResourceState(), VK_IMAGE_LAYOUT_UNDEFINED, 0, 0, write, !write });
+
+		//! DescriptorWrite information
+		VkWriteDescriptorSet descriptorWrite{};
+		descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		descriptorWrite.dstSet = m_VKDescriptorSet;
+		descriptorWrite.dstBinding = _layout.m_BindingPoint;
+		descriptorWrite.dstArrayElement = 0;
+		descriptorWrite.descriptorType = static_cast<VkDescriptorType>(_layout.m_DescriptorType);
+		descriptorWrite.descriptorCount = bufferInfos.size();
+		descriptorWrite.pBufferInfo = bufferInfos.data();
+
+		//! Write into descriptor set
+		vkUpdateDescriptorSets(m_VKDeviceHandle->GetVKDevice(), 1, &descriptorWrite, 0, nullptr);
+	}
+
+	void DescriptorSet::Update(const Minerva::DescriptorSet::Layout& _layout, std::span<const VkDescriptorImageInfo> _imageInfos,
+		ResourceState* _state, uint32_t _baseMip, uint32_t _mipCount)
+	{
+		VkWriteDescriptorSet descriptorWrite{
+			.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+			.pNext = nullptr,
+			.dstSet = m_VKDescriptorSet,
+			.dstBinding = _layout.m_BindingPoint,
+			.dstArrayElement = 0,
+			.descriptorCount = static_cast<uint32_t>(std::min<size_t>(_imageInfos.size(), _layout.m_DescriptorCount)),
+			.descriptorType = static_cast<VkDescriptorType>(_layout.m_DescriptorType),
+			.pImageInfo = _imageInfos.data()
+		};
+
+		vkUpdateDescriptorSets(m_VKDeviceHandle->GetVKDevice(), 1, &descriptorWrite, 0, nullptr);
+
+		ClearTrackedResources(_layout.m_BindingPoint);
+		if (_state && !_imageInfos.empty())
+		{
+			const bool write{ _layout.m_DescriptorType == Minerva::DescriptorSet::DescriptorType::STORAGE_IMAGE };
+			m_TrackedResources.push_back({ _layout.m_BindingPoint, _state, _imageInfos[0].imageLayout, _baseMip, _mipCount, write, false });
+		}
+	}
+
+	void DescriptorSet::AddComputeUses(BarrierBatch& _batch) const
+	{
+		for (const TrackedResource& resource : m_TrackedResources)
+		{
+			const BarrierBatch::SyncState sync{
+				.m_VKStages = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+				.m_VKAccess = static_cast<VkAccessFlags>(resource.m_Write ? VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT
+					: (resource.m_Uniform ? VK_ACCESS_UNIFORM_READ_BIT : VK_ACCESS_SHADER_READ_BIT))
+			};
+
+			if (resource.m_VKLayout == VK_IMAGE_LAYOUT_UNDEFINED)
+			{
+				resource.m_State->Use(_batch, sync, resource.m_Write);
+				continue;
+			}
+
+			const uint32_t mipCount{ resource.m_MipCount == VK_REMAINING_MIP_LEVELS ? resource.m_State->GetMipCount() - resource.m_BaseMip : resource.m_MipCount };
+			resource.m_State->Use(_batch, resource.m_BaseMip, mipCount, 0, resource.m_State->GetLayerCount(), resource.m_VKLayout, sync, resource.m_Write);
+		}
+	}
+
+	void DescriptorSet::ClearTrackedResources(uint32_t _bindingPoint)
+	{
+		std::erase_if(m_TrackedResources, [_bindingPoint](const TrackedResource& _resource) { return _resource.m_BindingPoint == _bindingPoint; });
+	}
 }
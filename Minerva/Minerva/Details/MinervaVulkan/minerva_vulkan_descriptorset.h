@@ -10,14 +10,40 @@ namespace Minerva::Vulkan
 
 		inline VkDescriptorSetLayout GetVKDescriptorSetLayout() const { return m_VKDescriptorSetLayout; }
 		inline VkDescriptorSet GetVKDescriptorSet() const { return m_VKDescriptorSet; }
+		inline std::span<const Minerva::DescriptorSet::Layout> GetLayouts() const { return m_Layouts; }
 		
 		void Update(const Minerva::DescriptorSet::Layout& _layout, std::span<std::shared_ptr<Minerva::Vulkan::Texture>> _textures);
+		void Update(const Minerva::DescriptorSet::Layout& _layout, std::span<std::shared_ptr<Minerva::Vulkan::Buffer>> _buffers);
+		// Images that are not Textures, e.g. attachments or storage images, with their layout already filled in.
+		// _state, when given, is tracked over _mipCount mips from _baseMip in the layout of the first image info
+		void Update(const Minerva::DescriptorSet::Layout& _layout, std::span<const VkDescriptorImageInfo> _imageInfos,
+			ResourceState* _state = nullptr, uint32_t _baseMip = 0, uint32_t _mipCount = VK_REMAINING_MIP_LEVELS);
+
+		// Uses of every tracked resource by a compute dispatch. Storage bindings are assumed written
+		void AddComputeUses(BarrierBatch& _batch) const;
 
 	private:
+		// Resource behind a binding, UNDEFINED layout for buffers
+		struct TrackedResource
+		{
+			uint32_t m_BindingPoint;
+			ResourceState* m_State;
+			VkImageLayout m_VKLayout;
+			uint32_t m_BaseMip;
+			uint32_t m_MipCount;
+			bool m_Write;
+			bool m_Uniform;
+		};
+
 		std::shared_ptr<Minerva::Vulkan::Device> m_VKDeviceHandle;
+		std::vector<Minerva::DescriptorSet::Layout> m_Layouts;
+		std::vector<TrackedResource> m_TrackedResources;
 
 		VkDescriptorSet m_VKDescriptorSet;
 		VkDescriptorSetLayout m_VKDescriptorSetLayout;
+
+		// Helper functions
+		void ClearTrackedResources(uint32_t _bindingPoint);
 	};
 }
 
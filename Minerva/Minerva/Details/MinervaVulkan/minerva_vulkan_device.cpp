@@ -1,9 +1,12 @@
 namespace Minerva::Vulkan
 {
-	Device::Device(std::shared_ptr<Minerva::Vulkan::Instance> _instance, Minerva::Device::QueueFamily _queueFamily, Minerva::Device::Type _type) :
+	Device::Device(std::shared_ptr<Minerva::Vulkan::Instance> _instance, Minerva::Device::QueueFamily _queueFamily, Minerva::Device::Type _type,
+		std::string_view _pipelineCachePath) :
 		m_VKInstanceHandle{ _instance }, m_VKPhysicalDevice{ VK_NULL_HANDLE }, m_VKDevice{ VK_NULL_HANDLE }, m_VKCommandPool{VK_NULL_HANDLE},
 		m_VKDescriptorPool{ VK_NULL_HANDLE }, m_VKDescriptorPoolSizes{}, m_VKMainQueue{ VK_NULL_HANDLE }, m_MainQueueIndex{ 0xffffffff },
-		m_QueueFamily{ _queueFamily }, m_Type{ _type }
+		m_QueueFamily{ _queueFamily }, m_Type{ _type }, m_MultiDrawIndirect{ false }, m_DrawIndirectCount{ false },
+		m_DynamicRendering{ false }, m_VKCmdBeginRendering{ nullptr }, m_VKCmdEndRendering{ nullptr },
+		m_VKPipelineCache{ VK_NULL_HANDLE }, m_PipelineCachePath{ _pipelineCachePath }, m_PipelineCacheWarm{ false }, m_PipelineCreationTime{ 0.0 }
 	{
 		if (_instance->GetVkInstance() == VK_NULL_HANDLE)
 		{
@@ -172,12 +175,18 @@ namespace Minerva::Vulkan
 		m_VKDescriptorPoolSizes[0].descriptorCount = 100;
 		m_VKDescriptorPoolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
 		m_VKDescriptorPoolSizes[1].descriptorCount = 100;
+		m_VKDescriptorPoolSizes[2].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		m_VKDescriptorPoolSizes[2].descriptorCount = 100;
+		m_VKDescriptorPoolSizes[3].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+		m_VKDescriptorPoolSizes[3].descriptorCount = 32;
+		m_VKDescriptorPoolSizes[4].type = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+		m_VKDescriptorPoolSizes[4].descriptorCount = 16;
 
 		VkDescriptorPoolCreateInfo descriptorPoolInfo{
 			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
 			.pNext = nullptr,
 			.flags = 0,
-			.maxSets = 10,
+			.maxSets = 64, // Compute passes allocate a set each, depth pyramids one per mip
 			.poolSizeCount = static_cast<uint32_t>(m_VKDescriptorPoolSizes.size()),
 			.pPoolSizes = m_VKDescriptorPoolSizes.data()
 		};
@@ -188,13 +197,26 @@ namespace Minerva::Vulkan
 			throw std::runtime_error("Failed to create device. Unable to create Descriptor Pool.");
 		}
 
+		CreatePipelineCache();
 	}
 
 	Device::~Device()
 	{
+		if (m_VKPipelineCache != VK_NULL_HANDLE)
+		{
+			SavePipelineCache();
+			vkDestroyPipelineCache(m_VKDevice, m_VKPipelineCache, nullptr);
+		}
+
 		if (m_VKDescriptorPool != VK_NULL_HANDLE)
 			vkDestroyDescriptorPool(m_VKDevice, m_VKDescriptorPool, nullptr);
 
+		if (m_VKDevice != VK_NULL_HANDLE)
+		{
+			m_LayoutCache.Destroy(m_VKDevice);
+			m_RenderpassCache.Destroy(m_VKDevice);
+		}
+
 		if (m_VKCommandPool != VK_NULL_HANDLE)
 			vkDestroyCommandPool(m_VKDevice, m_VKCommandPool, nullptr);
 
@@ -223,6 +245,54 @@ namespace Minerva::Vulkan
 		VkPhysicalDeviceFeatures DeviceFeatures{};
 		vkGetPhysicalDeviceFeatures(m_VKPhysicalDevice, &DeviceFeatures);
 
+		// Indirect count draws are core in 1.2 but still an optional feature
+		VkPhysicalDeviceVulkan12Features Vulkan12Features{
+			.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+			.pNext = nullptr
+		};
+		VkPhysicalDeviceFeatures2 SupportedFeatures{
+			.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+			.pNext = &Vulkan12Features
+		};
+
+		// Dynamic rendering is core in 1.3, older drivers may expose it as VK_KHR_dynamic_rendering
+		VkPhysicalDeviceProperties DeviceProperties;
+		vkGetPhysicalDeviceProperties(m_VKPhysicalDevice, &DeviceProperties);
+		const bool dynamicRenderingCore{ DeviceProperties.apiVersion >= VK_API_VERSION_1_3 };
+
+		uint32_t extensionCount{ 0 };
+		vkEnumerateDeviceExtensionProperties(m_VKPhysicalDevice, nullptr, &extensionCount, nullptr);
+		std::vector<VkExtensionProperties> SupportedExtensions(extensionCount);
+		vkEnumerateDeviceExtensionProperties(m_VKPhysicalDevice, nullptr, &extensionCount, SupportedExtensions.data());
+		const bool dynamicRenderingExtension{ std::any_of(SupportedExtensions.begin(), SupportedExtensions.end(),
+			[](const VkExtensionProperties& _extension) { return strcmp(_extension.extensionName, VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME) == 0; }) };
+
+		VkPhysicalDeviceDynamicRenderingFeaturesKHR DynamicRenderingFeatures{
+			.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR,
+			.pNext = nullptr,
+			.dynamicRendering = VK_FALSE
+		};
+		if (dynamicRenderingCore || dynamicRenderingExtension)
+			Vulkan12Features.pNext = &DynamicRenderingFeatures;
+
+		vkGetPhysicalDeviceFeatures2(m_VKPhysicalDevice, &SupportedFeatures);
+
+		m_MultiDrawIndirect = DeviceFeatures.multiDrawIndirect == VK_TRUE;
+		m_DrawIndirectCount = Vulkan12Features.drawIndirectCount == VK_TRUE;
+		m_DynamicRendering = DynamicRenderingFeatures.dynamicRendering == VK_TRUE;
+
+		VkPhysicalDeviceDynamicRenderingFeaturesKHR EnabledDynamicRenderingFeatures{
+			.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR,
+			.pNext = nullptr,
+			.dynamicRendering = VK_TRUE
+		};
+
+		VkPhysicalDeviceVulkan12Features EnabledVulkan12Features{
+			.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+			.pNext = m_DynamicRendering ? &EnabledDynamicRenderingFeatures : nullptr,
+			.drawIndirectCount = Vulkan12Features.drawIndirectCount
+		};
+
 		//todo Left as empty for now
 		// deviceFeatures.shaderClipDistance = true;
 		// deviceFeatures.shaderCullDistance = true;
@@ -231,12 +301,14 @@ namespace Minerva::Vulkan
 		// Required Extensions
 		static std::vector<const char*> EnabledDeviceExtensions;
 		EnabledDeviceExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+		if (m_DynamicRendering && !dynamicRenderingCore)
+			EnabledDeviceExtensions.push_back(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
 		//EnabledDeviceExtensions.push_back(VK_NV_GLSL_SHADER_EXTENSION_NAME); // nVidia useful extension to be able to load GLSL shaders
 
 		// CreateDeviceInfo
 		VkDeviceCreateInfo DeviceCreateInfo{
 			.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
-			.pNext = nullptr,
+			.pNext = &EnabledVulkan12Features,
 			.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfo.size()),
 			.pQueueCreateInfos = queueCreateInfo.data(),
 			.enabledLayerCount = 0,
@@ -261,15 +333,129 @@ namespace Minerva::Vulkan
 			Logger::Log_Error(VKErr, "Failed to create Vulkan Graphical Device");
 			throw std::runtime_error("Failed to create Logical Device (Graphics)");
 		}
+
+		// Core and extension entry points behave the same, the loader only exports the core ones
+		if (m_DynamicRendering)
+		{
+			m_VKCmdBeginRendering = reinterpret_cast<PFN_vkCmdBeginRenderingKHR>(vkGetDeviceProcAddr(m_VKDevice, dynamicRenderingCore ? "vkCmdBeginRendering" : "vkCmdBeginRenderingKHR"));
+			m_VKCmdEndRendering = reinterpret_cast<PFN_vkCmdEndRenderingKHR>(vkGetDeviceProcAddr(m_VKDevice, dynamicRenderingCore ? "vkCmdEndRendering" : "vkCmdEndRenderingKHR"));
+			m_DynamicRendering = m_VKCmdBeginRendering && m_VKCmdEndRendering;
+		}
+	}
+
+	void Device::CreatePipelineCache()
+	{
+		// Read the previous run's cache, if any
+		std::vector<char> data;
+		if (!m_PipelineCachePath.empty())
+		{
+			std::ifstream file(m_PipelineCachePath, std::ios::binary | std::ios::ate);
+			if (file.is_open())
+			{
+				data.resize(static_cast<size_t>(file.tellg()));
+				file.seekg(0);
+				if (!file.read(data.data(), data.size()))
+					data.clear();
+			}
+		}
+
+		// Drivers are required to reject foreign data, but some crash on it instead
+		if (!data.empty() && !IsPipelineCacheCompatible(data))
+		{
+			Logger::Log_Warn("Discarding pipeline cache. It was created by another device or driver version.");
+			data.clear();
+		}
+
+		VkPipelineCacheCreateInfo pipelineCacheInfo{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+			.pNext = nullptr,
+			.flags = 0,
+			.initialDataSize = data.size(),
+			.pInitialData = data.empty() ? nullptr : data.data()
+		};
+
+		if (vkCreatePipelineCache(m_VKDevice, &pipelineCacheInfo, nullptr, &m_VKPipelineCache) == VK_SUCCESS)
+		{
+			m_PipelineCacheWarm = !data.empty();
+			return;
+		}
+
+		// Corrupted content behind a valid header, start cold
+		if (!data.empty())
+		{
+			Logger::Log_Warn("Discarding pipeline cache. vkCreatePipelineCache rejected its data.");
+			pipelineCacheInfo.initialDataSize = 0;
+			pipelineCacheInfo.pInitialData = nullptr;
+
+			if (vkCreatePipelineCache(m_VKDevice, &pipelineCacheInfo, nullptr, &m_VKPipelineCache) == VK_SUCCESS)
+				return;
+		}
+
+		Logger::Log_Error("Failed to create device. Unable to create Pipeline Cache.");
+		throw std::runtime_error("Failed to create device. Unable to create Pipeline Cache.");
+	}
+
+	bool Device::IsPipelineCacheCompatible(std::span<const char> _data) const
+	{
+		// VkPipelineCacheHeaderVersionOne: header length, header version, vendor ID, device ID, cache UUID
+		constexpr size_t HEADER_SIZE{ 4 * sizeof(uint32_t) + VK_UUID_SIZE };
+		if (_data.size() < HEADER_SIZE) return false;
+
+		uint32_t headerLength{}, headerVersion{}, vendorID{}, deviceID{};
+		std::memcpy(&headerLength, _data.data(), sizeof(uint32_t));
+		std::memcpy(&headerVersion, _data.data() + 4, sizeof(uint32_t));
+		std::memcpy(&vendorID, _data.data() + 8, sizeof(uint32_t));
+		std::memcpy(&deviceID, _data.data() + 12, sizeof(uint32_t));
+
+		VkPhysicalDeviceProperties properties{};
+		vkGetPhysicalDeviceProperties(m_VKPhysicalDevice, &properties);
+
+		return headerLength >= HEADER_SIZE && headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+			&& vendorID == properties.vendorID && deviceID == properties.deviceID
+			&& std::memcmp(_data.data() + 16, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+	}
+
+	void Device::SavePipelineCache()
+	{
+		if (m_PipelineCachePath.empty() || m_VKPipelineCache == VK_NULL_HANDLE) return;
+
+		size_t size{ 0 };
+		if (vkGetPipelineCacheData(m_VKDevice, m_VKPipelineCache, &size, nullptr) != VK_SUCCESS || size == 0) return;
+
+		std::vector<char> data(size);
+		if (vkGetPipelineCacheData(m_VKDevice, m_VKPipelineCache, &size, data.data()) != VK_SUCCESS)
+		{
+			Logger::Log_Warn("Unable to save pipeline cache. vkGetPipelineCacheData failed.");
+			return;
+		}
+
+		const std::string temporaryPath{ m_PipelineCachePath + ".tmp" };
+		{
+			std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+			if (!file.is_open() || !file.write(data.data(), size))
+			{
+				Logger::Log_Warn("Unable to save pipeline cache. Unable to write " + temporaryPath + ".");
+				return;
+			}
+		}
+
+		// Replaces the previous cache in one step
+		std::error_code error;
+		std::filesystem::rename(temporaryPath, m_PipelineCachePath, error);
+		if (error)
+		{
+			Logger::Log_Warn("Unable to save pipeline cache. Unable to replace " + m_PipelineCachePath + ".");
+			std::filesystem::remove(temporaryPath, error);
+		}
 	}
 
-	void Device::CopyBuffer(VkBuffer _src, VkBuffer _dst, VkDeviceSize _size)
+	void Device::CopyBuffer(VkBuffer _src, VkBuffer _dst, VkDeviceSize _size, VkDeviceSize _dstOffset)
 	{
 		VkCommandBuffer commandBuffer{ BeginSingleTimeCommands() };
 
 		VkBufferCopy copyRegion{};
 		copyRegion.srcOffset = 0; // Optional
-		copyRegion.dstOffset = 0; // Optional
+		copyRegion.dstOffset = _dstOffset;
 		copyRegion.size = _size;
 		vkCmdCopyBuffer(commandBuffer, _src, _dst, 1, &copyRegion);
 
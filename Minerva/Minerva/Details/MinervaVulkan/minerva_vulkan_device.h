@@ -5,13 +5,20 @@ namespace Minerva::Vulkan
 	class Device
 	{
 	public:
-		Device(std::shared_ptr<Minerva::Vulkan::Instance> _instance, Minerva::Device::QueueFamily _queueFamily, Minerva::Device::Type _type);
+		// An empty _pipelineCachePath keeps the pipeline cache in memory only
+		Device(std::shared_ptr<Minerva::Vulkan::Instance> _instance, Minerva::Device::QueueFamily _queueFamily, Minerva::Device::Type _type,
+			std::string_view _pipelineCachePath);
 		~Device();
 
-		void CopyBuffer(VkBuffer _src, VkBuffer _dst, VkDeviceSize _size);
+		void CopyBuffer(VkBuffer _src, VkBuffer _dst, VkDeviceSize _size, VkDeviceSize _dstOffset = 0);
 		VkCommandBuffer BeginSingleTimeCommands();
 		void EndSingleTimeCommands(VkCommandBuffer _cmdBuffer);
 
+		// Writes the pipeline cache to a temporary file and renames it over the cache file, so a crash never leaves a truncated cache
+		void SavePipelineCache();
+		// Thread safe, pipelines may be compiled by worker threads
+		inline void AddPipelineCreationTime(double _milliseconds) { m_PipelineCreationTime.fetch_add(_milliseconds, std::memory_order_relaxed); }
+
 		inline std::shared_ptr<Minerva::Vulkan::Instance> GetVKInstanceHandle() const { return m_VKInstanceHandle; }
 		inline VkPhysicalDevice GetVKPhysicalDevice() const { return m_VKPhysicalDevice; }
 		inline VkDevice GetVKDevice() const { return m_VKDevice; }
@@ -20,6 +27,17 @@ namespace Minerva::Vulkan
 		inline uint32_t GetMainQueueIndex() const { return m_MainQueueIndex; }
 		inline Minerva::Device::QueueFamily GetQueueFamily() const { return m_QueueFamily; }
 		inline Minerva::Device::Type GetDeviceType() const { return m_Type; }
+		inline bool IsMultiDrawIndirectSupported() const { return m_MultiDrawIndirect; }
+		inline bool IsDrawIndirectCountSupported() const { return m_DrawIndirectCount; }
+		inline bool IsDynamicRenderingEnabled() const { return m_DynamicRendering; }
+		inline void CmdBeginRendering(VkCommandBuffer _commandBuffer, const VkRenderingInfoKHR& _renderingInfo) const { m_VKCmdBeginRendering(_commandBuffer, &_renderingInfo); }
+		inline void CmdEndRendering(VkCommandBuffer _commandBuffer) const { m_VKCmdEndRendering(_commandBuffer); }
+		inline ResourceTracker& GetResourceTracker() { return m_ResourceTracker; }
+		inline LayoutCache& GetLayoutCache() { return m_LayoutCache; }
+		inline RenderpassCache& GetRenderpassCache() { return m_RenderpassCache; }
+		inline VkPipelineCache GetVKPipelineCache() const { return m_VKPipelineCache; }
+		inline bool IsPipelineCacheWarm() const { return m_PipelineCacheWarm; }
+		inline double GetPipelineCreationTime() const { return m_PipelineCreationTime.load(std::memory_order_relaxed); }
 	private:
 		// Minerva::Vulkan Object handles
 		std::shared_ptr<Minerva::Vulkan::Instance> m_VKInstanceHandle;
@@ -29,7 +47,7 @@ namespace Minerva::Vulkan
 		VkDevice m_VKDevice;
 		VkCommandPool m_VKCommandPool;
 		VkDescriptorPool m_VKDescriptorPool;
-		std::array<VkDescriptorPoolSize, 2> m_VKDescriptorPoolSizes;
+		std::array<VkDescriptorPoolSize, 5> m_VKDescriptorPoolSizes;
 
 		// Queue properties
 		VkQueue m_VKMainQueue;
@@ -38,9 +56,25 @@ namespace Minerva::Vulkan
 		// Minerva properties
 		Minerva::Device::QueueFamily m_QueueFamily;
 		Minerva::Device::Type m_Type;
+		bool m_MultiDrawIndirect; // More than one draw per indirect call
+		bool m_DrawIndirectCount; // Draw count read from a buffer (vkCmdDraw*IndirectCount)
+		bool m_DynamicRendering;  // Render passes begin rendering on image views, without VkRenderPass and VkFramebuffer objects
+		PFN_vkCmdBeginRenderingKHR m_VKCmdBeginRendering;
+		PFN_vkCmdEndRenderingKHR m_VKCmdEndRendering;
+		ResourceTracker m_ResourceTracker;
+		LayoutCache m_LayoutCache;
+		RenderpassCache m_RenderpassCache;
+
+		// Pipeline cache
+		VkPipelineCache m_VKPipelineCache;
+		std::string m_PipelineCachePath;
+		bool m_PipelineCacheWarm;      // Created from the data on disk
+		std::atomic<double> m_PipelineCreationTime; // Milliseconds spent in vkCreate*Pipelines
 
 		// Helper function to create graphics device
 		void CreateGraphicsDevice(const std::vector<VkQueueFamilyProperties>& _deviceProperties);
+		void CreatePipelineCache();
+		bool IsPipelineCacheCompatible(std::span<const char> _data) const;
 	};
 }
 
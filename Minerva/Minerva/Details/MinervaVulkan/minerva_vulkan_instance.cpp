@@ -49,7 +49,7 @@ namespace Minerva::Vulkan
 			.applicationVersion = m_ApplicationVersion,
 			.pEngineName = "Minerva::Vulkan",
 			.engineVersion = VK_MAKE_API_VERSION(0, 1, 0, 0),
-			.apiVersion = VK_API_VERSION_1_2
+			.apiVersion = VK_API_VERSION_1_3 // Highest version used, devices down to 1.2 are accepted
 		};
 
 		// Create Info
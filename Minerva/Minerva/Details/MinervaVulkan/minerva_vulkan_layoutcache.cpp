@@ -0,0 +1,101 @@
+namespace Minerva::Vulkan
+{
+	VkDescriptorSetLayout LayoutCache::GetDescriptorSetLayout(VkDevice _device, std::span<const VkDescriptorSetLayoutBinding> _bindings)
+	{
+		// Immutable samplers are not supported, every binding is described by its four fields
+		std::string key;
+		auto Append = [&key](const auto& _value) { key.append(reinterpret_cast<const char*>(&_value), sizeof(_value)); };
+		for (const VkDescriptorSetLayoutBinding& binding : _bindings)
+		{
+			Append(binding.binding);
+			Append(binding.descriptorType);
+			Append(binding.descriptorCount);
+			Append(binding.stageFlags);
+		}
+
+		std::scoped_lock lock{ m_Lock };
+		if (auto it{ m_VKDescriptorSetLayouts.find(key) }; it != m_VKDescriptorSetLayouts.end())
+		{
+			m_DeduplicatedCount.fetch_add(1, std::memory_order_relaxed);
+			return it->second;
+		}
+
+		VkDescriptorSetLayoutCreateInfo descriptorSetLayoutInfo{
+			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+			.pNext = nullptr,
+			.flags = 0,
+			.bindingCount = static_cast<uint32_t>(_bindings.size()),
+			.pBindings = _bindings.data()
+		};
+
+		VkDescriptorSetLayout layout{ VK_NULL_HANDLE };
+		if (int vkErr{ vkCreateDescriptorSetLayout(_device, &descriptorSetLayoutInfo, nullptr, &layout) }; vkErr)
+		{
+			Logger::Log_Error("Unable to create Descriptor Set. vkCreateDescriptorSetLayout error.");
+			throw std::runtime_error("Unable to create Descriptor Set. vkCreateDescriptorSetLayout error.");
+		}
+
+		m_VKDescriptorSetLayouts.emplace(std::move(key), layout);
+		return layout;
+	}
+
+	VkPipelineLayout LayoutCache::GetPipelineLayout(VkDevice _device, VkDescriptorSetLayout _setLayout, std::span<const VkPushConstantRange> _pushConstantRanges)
+	{
+		// Set layouts come from this cache, so equal sets share a handle
+		std::string key;
+		auto Append = [&key](const auto& _value) { key.append(reinterpret_cast<const char*>(&_value), sizeof(_value)); };
+		Append(_setLayout);
+		for (const VkPushConstantRange& range : _pushConstantRanges)
+		{
+			Append(range.stageFlags);
+			Append(range.offset);
+			Append(range.size);
+		}
+
+		std::scoped_lock lock{ m_Lock };
+		if (auto it{ m_VKPipelineLayouts.find(key) }; it != m_VKPipelineLayouts.end())
+		{
+			m_DeduplicatedCount.fetch_add(1, std::memory_order_relaxed);
+			return it->second;
+		}
+
+		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+			.pNext = nullptr,
+			.flags = 0,
+			.setLayoutCount = 1,
+			.pSetLayouts = &_setLayout,
+			.pushConstantRangeCount = static_cast<uint32_t>(_pushConstantRanges.size()),
+			.pPushConstantRanges = _pushConstantRanges.data()
+		};
+
+		VkPipelineLayout layout{ VK_NULL_HANDLE };
+		if (auto VkErr{ vkCreatePipelineLayout(_device, &pipelineLayoutCreateInfo, nullptr, &layout) }; VkErr)
+		{
+			Logger::Log_Error("Unable to create pipeline. Failed to create Pipeline Layout");
+			throw std::runtime_error("Unable to create pipeline. Failed to create Pipeline Layout");
+		}
+
+		m_VKPipelineLayouts.emplace(std::move(key), layout);
+		return layout;
+	}
+
+	void LayoutCache::Destroy(VkDevice _device)
+	{
+		std::scoped_lock lock{ m_Lock };
+
+		for (auto& [key, layout] : m_VKPipelineLayouts)
+			vkDestroyPipelineLayout(_device, layout, nullptr);
+		m_VKPipelineLayouts.clear();
+
+		for (auto& [key, layout] : m_VKDescriptorSetLayouts)
+			vkDestroyDescriptorSetLayout(_device, layout, nullptr);
+		m_VKDescriptorSetLayouts.clear();
+	}
+
+	size_t LayoutCache::GetLayoutCount() const
+	{
+		std::scoped_lock lock{ m_Lock };
+		return m_VKDescriptorSetLayouts.size() + m_VKPipelineLayouts.size();
+	}
+}
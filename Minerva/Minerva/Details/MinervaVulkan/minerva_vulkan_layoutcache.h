@@ -0,0 +1,31 @@
+#pragma once
+
+namespace Minerva::Vulkan
+{
+	// Descriptor set and pipeline layouts shared by everything created with the same description. Owned by the Device,
+	// layouts live as long as it does, so the handles it returns are never destroyed by their users
+	class LayoutCache
+	{
+	public:
+		LayoutCache() = default;
+		LayoutCache(const LayoutCache&) = delete;
+		LayoutCache& operator=(const LayoutCache&) = delete;
+
+		// Thread safe, pipelines may be created by worker threads
+		VkDescriptorSetLayout GetDescriptorSetLayout(VkDevice _device, std::span<const VkDescriptorSetLayoutBinding> _bindings);
+		VkPipelineLayout GetPipelineLayout(VkDevice _device, VkDescriptorSetLayout _setLayout, std::span<const VkPushConstantRange> _pushConstantRanges);
+
+		void Destroy(VkDevice _device);
+
+		size_t GetLayoutCount() const;
+		inline uint32_t GetDeduplicatedCount() const { return m_DeduplicatedCount.load(std::memory_order_relaxed); }
+
+	private:
+		std::unordered_map<std::string, VkDescriptorSetLayout> m_VKDescriptorSetLayouts;
+		std::unordered_map<std::string, VkPipelineLayout> m_VKPipelineLayouts;
+		mutable std::mutex m_Lock;
+		std::atomic<uint32_t> m_DeduplicatedCount{ 0 }; // Requests answered by an existing layout
+	};
+}
+
+#include "minerva_vulkan_layoutcache.cpp"
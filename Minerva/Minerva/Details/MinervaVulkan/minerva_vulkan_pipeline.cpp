@@ -6,85 +6,246 @@ namespace Minerva::Vulkan
 		const Minerva::Shader* _shaders,
 		int _shaderCount,
 		std::shared_ptr<Minerva::Vulkan::DescriptorSet> _descriptorSet,
-		std::shared_ptr<Minerva::Vulkan::VertexDescriptor> _vertDesc) :
+		std::shared_ptr<Minerva::Vulkan::VertexDescriptor> _vertDesc,
+		const Minerva::Pipeline::State& _state,
+		bool _compile) :
 		m_VKDeviceHandle{ _device }, m_VKWindowHandle{ _window }, m_VKRenderpassHandle{ _renderpass }, // Private handles
-		m_VKShaderHandles{}, m_VKShaderStages{}, m_VKPipelineLayout{ VK_NULL_HANDLE }, m_VKPipeline{ VK_NULL_HANDLE }, // Vulkan properties
-		m_VKDescriptorSetLayout{ _descriptorSet->GetVKDescriptorSetLayout() }, m_VKVertexDescriptorHandle{ _vertDesc }
+		m_VKShaderHandles{}, m_VKShaderStages{}, m_StageSpecializations{}, m_VKPipelineLayout{ VK_NULL_HANDLE }, m_VKPushConstantRange{}, m_VKPipeline{ VK_NULL_HANDLE }, // Vulkan properties
+		m_VKDescriptorSetLayout{ _descriptorSet->GetVKDescriptorSetLayout() }, m_Type{ Minerva::Pipeline::Type::GRAPHICS }, m_VKVertexDescriptorHandle{ _vertDesc },
+		m_State{ _state }, m_Ready{ false }
 	{
-		// Internal function to convert Minerva::Shader::Type enum to a VkShaderStageFlagBits
-		constexpr auto ShaderType = []() constexpr
-		{
-			std::array<VkShaderStageFlagBits, static_cast<std::size_t>(Minerva::Shader::Type::ENUM_COUNT)> ShaderType{};
-
-			ShaderType[static_cast<std::size_t>(Minerva::Shader::Type::VERTEX)] = VK_SHADER_STAGE_VERTEX_BIT;
-			ShaderType[static_cast<std::size_t>(Minerva::Shader::Type::FRAGMENT)] = VK_SHADER_STAGE_FRAGMENT_BIT;
-			//ShaderType[static_cast<std::size_t>(Minerva::Shader::Type::TESSELLATION)] = VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
-			ShaderType[static_cast<std::size_t>(Minerva::Shader::Type::COMPUTE)] = VK_SHADER_STAGE_COMPUTE_BIT;
-
-			return ShaderType;
-		}();
-
-		// Get Vulkan Shader Handles
+		// Get Vulkan Shader Handles and store Shader Stages
 		m_VKShaderHandles.reserve(_shaderCount);
+		m_VKShaderStages.reserve(_shaderCount);
+		m_StageSpecializations.reserve(_shaderCount);
 		for (int i = 0; i < _shaderCount; ++i)
 		{
 			m_VKShaderHandles.emplace_back(_shaders[i].GetVKShaderHandle());
+			AddShaderStage(m_VKShaderHandles.back(), _shaders[i].GetSpecializations());
 		}
 
-		// Store Shader Stages
-		m_VKShaderStages.reserve(m_VKShaderHandles.size());
-		for (const auto& shader : m_VKShaderHandles)
+		if (m_State.m_Subpass >= _renderpass->GetSubpassCount())
 		{
-			VkPipelineShaderStageCreateInfo shaderStageInfo{
-			.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
-			.stage = ShaderType[static_cast<size_t>(shader->GetShaderType())],
-			.module = shader->GetVKShaderModule(),
-			.pName = "main",
-			};
+			Logger::Log_Error("Unable to create pipeline. Render pass has no such subpass.");
+			throw std::runtime_error("Unable to create pipeline. Render pass has no such subpass.");
+		}
 
-			m_VKShaderStages.emplace_back(shaderStageInfo);
+		ValidateBindings(*_descriptorSet);
+		ValidateVertexInputs();
+
+		if (_compile)
+			CreateGraphicsPipeline();
+		else
+			CreatePipelineLayout();
+	}
+
+	Pipeline::Pipeline(std::shared_ptr<Minerva::Vulkan::Device> _device,
+		std::shared_ptr<Minerva::Vulkan::Shader> _computeShader,
+		std::shared_ptr<Minerva::Vulkan::DescriptorSet> _descriptorSet,
+		std::span<const Minerva::Shader::Specialization> _specializations) :
+		m_VKDeviceHandle{ _device }, m_VKWindowHandle{ nullptr }, m_VKRenderpassHandle{ nullptr }, // Private handles
+		m_VKShaderHandles{ _computeShader }, m_VKShaderStages{}, m_StageSpecializations{}, m_VKPipelineLayout{ VK_NULL_HANDLE }, m_VKPushConstantRange{}, m_VKPipeline{ VK_NULL_HANDLE }, // Vulkan properties
+		m_VKDescriptorSetLayout{ _descriptorSet->GetVKDescriptorSetLayout() }, m_Type{ Minerva::Pipeline::Type::COMPUTE }, m_VKVertexDescriptorHandle{ nullptr },
+		m_State{}, m_Ready{ false }
+	{
+		if (_computeShader->GetShaderType() != Minerva::Shader::Type::COMPUTE)
+		{
+			Logger::Log_Error("Unable to create compute pipeline. Shader is not a compute shader.");
+			throw std::runtime_error("Unable to create compute pipeline. Shader is not a compute shader.");
 		}
 
-		CreateGraphicsPipeline();
+		m_StageSpecializations.reserve(1);
+		AddShaderStage(_computeShader, _specializations);
+
+		ValidateBindings(*_descriptorSet);
+		CreateComputePipeline();
 	}
 
+	// The layout is owned by the device's LayoutCache
 	Pipeline::~Pipeline()
 	{
-		if (m_VKPipelineLayout != VK_NULL_HANDLE)
-			vkDestroyPipelineLayout(m_VKDeviceHandle->GetVKDevice(), m_VKPipelineLayout, nullptr);
-
 		if (m_VKPipeline != VK_NULL_HANDLE)
 			vkDestroyPipeline(m_VKDeviceHandle->GetVKDevice(), m_VKPipeline, nullptr);
 	}
 
 	void Pipeline::CleanupPipeline()
 	{
-		if (m_VKPipelineLayout != VK_NULL_HANDLE)
-			vkDestroyPipelineLayout(m_VKDeviceHandle->GetVKDevice(), m_VKPipelineLayout, nullptr);
-
 		if (m_VKPipeline != VK_NULL_HANDLE)
 			vkDestroyPipeline(m_VKDeviceHandle->GetVKDevice(), m_VKPipeline, nullptr);
 	}
 
 	void Pipeline::RecreatePipeline()
 	{
-		CreateGraphicsPipeline();
+		if (m_Type == Minerva::Pipeline::Type::COMPUTE)
+			CreateComputePipeline();
+		else
+			CreateGraphicsPipeline();
+	}
+
+
+	void Pipeline::AddShaderStage(const std::shared_ptr<Minerva::Vulkan::Shader>& _shader, std::span<const Minerva::Shader::Specialization> _specializations)
+	{
+		VkPipelineShaderStageCreateInfo shaderStageInfo{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+			.stage = _shader->GetVKShaderStage(),
+			.module = _shader->GetVKShaderModule(),
+			.pName = "main",
+			.pSpecializationInfo = nullptr
+		};
+
+		// Specialized values are baked in at pipeline creation, the driver folds branches and unrolls loops on them
+		if (!_specializations.empty())
+		{
+			StageSpecialization& specialization{ m_StageSpecializations.emplace_back() };
+			specialization.m_VKMapEntries.reserve(_specializations.size());
+			for (const Minerva::Shader::Specialization& value : _specializations)
+			{
+				const uint32_t offset{ static_cast<uint32_t>(specialization.m_Data.size()) };
+				specialization.m_Data.resize(offset + value.m_Size);
+				std::memcpy(specialization.m_Data.data() + offset, &value.m_Value, value.m_Size); // Little endian, the low bytes hold 32 bit values
+				specialization.m_VKMapEntries.push_back(VkSpecializationMapEntry{ .constantID = value.m_ConstantID, .offset = offset, .size = value.m_Size });
+			}
+
+			specialization.m_VKInfo = VkSpecializationInfo{
+				.mapEntryCount = static_cast<uint32_t>(specialization.m_VKMapEntries.size()),
+				.pMapEntries = specialization.m_VKMapEntries.data(),
+				.dataSize = specialization.m_Data.size(),
+				.pData = specialization.m_Data.data()
+			};
+			shaderStageInfo.pSpecializationInfo = &specialization.m_VKInfo;
+		}
+
+		m_VKShaderStages.emplace_back(shaderStageInfo);
 	}
 
+	void Pipeline::CreatePipelineLayout()
+	{
+		// Creating a Pipeline Layout - To specify Uniforms or Descriptor Sets to Shaders
+
+		// One push constant range over the bytes any stage reads, visible to every stage that reads some
+		uint32_t begin{ UINT32_MAX }, end{ 0 };
+		m_VKPushConstantRange = VkPushConstantRange{ .stageFlags = 0, .offset = 0, .size = 0 };
+		for (const auto& shader : m_VKShaderHandles)
+		{
+			const Minerva::Tools::SPIRVReflect::PushConstantBlock& block{ shader->GetReflection().m_PushConstants };
+			if (block.m_Size == 0) continue;
+
+			m_VKPushConstantRange.stageFlags |= shader->GetVKShaderStage();
+			begin = std::min(begin, block.m_Offset);
+			end = std::max(end, block.m_Offset + block.m_Size);
+		}
+		if (m_VKPushConstantRange.stageFlags != 0)
+		{
+			m_VKPushConstantRange.offset = begin;
+			m_VKPushConstantRange.size = end - begin;
+		}
+
+		m_VKPipelineLayout = m_VKDeviceHandle->GetLayoutCache().GetPipelineLayout(m_VKDeviceHandle->GetVKDevice(), m_VKDescriptorSetLayout,
+			m_VKPushConstantRange.size ? std::span<const VkPushConstantRange>{ &m_VKPushConstantRange, 1 } : std::span<const VkPushConstantRange>{});
+	}
+
+	void Pipeline::ValidateBindings(const Minerva::Vulkan::DescriptorSet& _descriptorSet) const
+	{
+		// Dynamic offsets are a property of the set, SPIR-V only knows uniform and storage buffers
+		auto IsCompatibleType = [](Minerva::DescriptorSet::DescriptorType _setType, Minerva::Tools::SPIRVReflect::DescriptorType _shaderType)
+		{
+			using SetType = Minerva::DescriptorSet::DescriptorType;
+			using ShaderType = Minerva::Tools::SPIRVReflect::DescriptorType;
+			if (_setType == SetType::UNIFORM_BUFFER_DYNAMIC)
+				return _shaderType == ShaderType::UNIFORM_BUFFER || _shaderType == ShaderType::UNIFORM_BUFFER_DYNAMIC;
+			if (_setType == SetType::STORAGE_BUFFER_DYNAMIC)
+				return _shaderType == ShaderType::STORAGE_BUFFER || _shaderType == ShaderType::STORAGE_BUFFER_DYNAMIC;
+			return static_cast<uint8_t>(_setType) == static_cast<uint8_t>(_shaderType);
+		};
+
+		// Every binding a shader declares must exist in the set with the same type and be visible to the shader's stage
+		const std::span<const Minerva::DescriptorSet::Layout> layouts{ _descriptorSet.GetLayouts() };
+		for (const auto& shader : m_VKShaderHandles)
+		{
+			for (const Minerva::Tools::SPIRVReflect::Binding& binding : shader->GetReflection().m_Bindings)
+			{
+				if (binding.m_Set != 0)
+				{
+					Logger::Log_Error("Unable to create pipeline. Shader uses a descriptor set other than set 0.");
+					throw std::runtime_error("Unable to create pipeline. Shader uses a descriptor set other than set 0.");
+				}
+
+				auto layout{ std::find_if(layouts.begin(), layouts.end(), [&binding](const Minerva::DescriptorSet::Layout& _layout) { return _layout.m_BindingPoint == binding.m_Binding; }) };
+				if (layout == layouts.end() || !IsCompatibleType(layout->m_DescriptorType, binding.m_Type))
+				{
+					std::stringstream ss;
+					ss << "Unable to create pipeline. Binding " << binding.m_Binding << " (" << binding.m_Name << ") of " << shader->GetFilepath()
+						<< (layout == layouts.end() ? " is missing from the descriptor set." : " has a different descriptor type in the descriptor set.");
+					Logger::Log_Error(ss.str());
+					throw std::runtime_error(ss.str());
+				}
+
+				const bool visible{ layout->m_ShaderStage == Minerva::Shader::Type::ALL_GRAPHICS ? shader->GetVKShaderStage() != VK_SHADER_STAGE_COMPUTE_BIT :
+					layout->m_ShaderStage == shader->GetShaderType() };
+				if (!visible)
+				{
+					std::stringstream ss;
+					ss << "Unable to create pipeline. Binding " << binding.m_Binding << " (" << binding.m_Name << ") of " << shader->GetFilepath()
+						<< " is not visible to its stage in the descriptor set.";
+					Logger::Log_Error(ss.str());
+					throw std::runtime_error(ss.str());
+				}
+			}
+		}
+	}
+
+	void Pipeline::ValidateVertexInputs() const
+	{
+		// Every vertex shader input needs an attribute at its location
+		const VkPipelineVertexInputStateCreateInfo vertexInput{ m_VKVertexDescriptorHandle->GetPipelineVertexInputCreateInfo() };
+		for (const auto& shader : m_VKShaderHandles)
+		{
+			for (const Minerva::Tools::SPIRVReflect::VertexInput& input : shader->GetReflection().m_VertexInputs)
+			{
+				const std::span<const VkVertexInputAttributeDescription> attributes{ vertexInput.pVertexAttributeDescriptions, vertexInput.vertexAttributeDescriptionCount };
+				if (std::none_of(attributes.begin(), attributes.end(), [&input](const VkVertexInputAttributeDescription& _attribute) { return _attribute.location == input.m_Location; }))
+				{
+					std::stringstream ss;
+					ss << "Unable to create pipeline. Vertex input " << input.m_Location << " (" << input.m_Name << ") of " << shader->GetFilepath()
+						<< " has no attribute in the vertex descriptor.";
+					Logger::Log_Error(ss.str());
+					throw std::runtime_error(ss.str());
+				}
+			}
+		}
+	}
 
 	void Pipeline::CreateGraphicsPipeline()
 	{
-		//std::vector<VkDynamicState> dynamicStates{
-		//	VK_DYNAMIC_STATE_VIEWPORT,
-		//	VK_DYNAMIC_STATE_SCISSOR
-		//};
+		CreatePipelineLayout();
 
+		GraphicsCreateInfo createInfo{};
+		FillGraphicsCreateInfo(createInfo);
 
+		// Create Graphics Pipeline through the device's cache, which skips the driver compile of pipelines seen before (also on RecreatePipeline)
+		const auto start{ std::chrono::steady_clock::now() };
+		if (auto VkErr{ vkCreateGraphicsPipelines(m_VKDeviceHandle->GetVKDevice(), m_VKDeviceHandle->GetVKPipelineCache(), 1, &createInfo.m_VKCreateInfo, nullptr, &m_VKPipeline)}; VkErr)
+		{
+			Logger::Log_Error("Failed to create Graphics Pipeline. vkCreateGraphicsPipeline failed.");
+			throw std::runtime_error("Failed to create Graphics Pipeline. vkCreateGraphicsPipeline failed.");
+		}
+		m_VKDeviceHandle->AddPipelineCreationTime(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+		m_Ready.store(true, std::memory_order_release);
+	}
+
+	void Pipeline::SetCompiledPipeline(VkPipeline _pipeline)
+	{
+		m_VKPipeline = _pipeline;
+		m_Ready.store(true, std::memory_order_release);
+	}
+
+	void Pipeline::FillGraphicsCreateInfo(GraphicsCreateInfo& _createInfo) const
+	{
 		// Describe Vertex Input - Format of vertex data passed into vertex shader
-		VkPipelineVertexInputStateCreateInfo vertexInputInfo{ m_VKVertexDescriptorHandle->GetPipelineVertexInputCreateInfo() };
+		_createInfo.m_VKVertexInput = m_VKVertexDescriptorHandle->GetPipelineVertexInputCreateInfo();
 
 		// Fixed Function Stage: Input Assembly
-		VkPipelineInputAssemblyStateCreateInfo inputAssemblyCreateInfo{
+		_createInfo.m_VKInputAssembly = VkPipelineInputAssemblyStateCreateInfo{
 			.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
 			.topology = m_VKVertexDescriptorHandle->GetVKTopology(),
 			.primitiveRestartEnable = VK_FALSE
@@ -106,7 +267,7 @@ namespace Minerva::Vulkan
 		//scissors.offset = { 0, 0 };
 		//scissors.extent = swapExtent;
 
-		VkPipelineViewportStateCreateInfo viewportStateCreateInfo{
+		_createInfo.m_VKViewport = VkPipelineViewportStateCreateInfo{
 			.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
 			.viewportCount = 1,
 			.pViewports = nullptr,
@@ -115,12 +276,12 @@ namespace Minerva::Vulkan
 		};
 
 		// Fixed Function Stage: Rasterizer
-		VkPipelineRasterizationStateCreateInfo rasterizerCreateInfo{
+		_createInfo.m_VKRasterization = VkPipelineRasterizationStateCreateInfo{
 			.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
 			.depthClampEnable = VK_FALSE, // Clamp between 0-1. All vertices will be rendered
 			.rasterizerDiscardEnable = VK_FALSE, // Turn off rasterizer
-			.polygonMode = VK_POLYGON_MODE_FILL, // Fill polygon with fragments
-			.cullMode = VK_CULL_MODE_BACK_BIT, // Cull back facing
+			.polygonMode = m_State.m_PolygonMode, // Fill polygon with fragments by default
+			.cullMode = m_State.m_CullMode, // Cull back facing by default
 			.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE, // Clockwise = front facing
 			.depthBiasEnable = VK_FALSE,
 			.depthBiasConstantFactor = 0.f,
@@ -128,11 +289,10 @@ namespace Minerva::Vulkan
 			.depthBiasSlopeFactor = 0.f
 		};
 
-		// Multisampling: For anti-aliasing (MSAA) 
-		//! [DISABLED FOR NOW]
-		VkPipelineMultisampleStateCreateInfo multisamplingCreateInfo{
+		// Multisampling: For anti-aliasing (MSAA). Must match the render pass attachments, shaded once per pixel
+		_createInfo.m_VKMultisample = VkPipelineMultisampleStateCreateInfo{
 			.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
-			.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+			.rasterizationSamples = m_VKRenderpassHandle->GetVKSamples(),
 			.sampleShadingEnable = VK_FALSE,
 			.minSampleShading = 1.f,
 			.pSampleMask = nullptr,
@@ -145,89 +305,111 @@ namespace Minerva::Vulkan
 
 		// Configuration PER ATTACHED FRAMEBUFFER
 		VkPipelineColorBlendAttachmentState colorBlendAttachmentState{
-			.blendEnable = VK_FALSE, // New color from Fragment Shader will be unmodified
+			.blendEnable = m_State.m_Blend ? VK_TRUE : VK_FALSE, // Without blending the new color from Fragment Shader will be unmodified
 			// Look up VkBlendFactor and VkBlendOp enums in specs for more info.
-			.srcColorBlendFactor = VK_BLEND_FACTOR_ONE,
-			.dstColorBlendFactor = VK_BLEND_FACTOR_ZERO,
+			.srcColorBlendFactor = m_State.m_Blend ? VK_BLEND_FACTOR_SRC_ALPHA : VK_BLEND_FACTOR_ONE,
+			.dstColorBlendFactor = m_State.m_Blend ? VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA : VK_BLEND_FACTOR_ZERO,
 			.colorBlendOp = VK_BLEND_OP_ADD,
 			.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE,
-			.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO,
+			.dstAlphaBlendFactor = m_State.m_Blend ? VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA : VK_BLEND_FACTOR_ZERO,
 			.alphaBlendOp = VK_BLEND_OP_ADD,
-			.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT,
+			.colorWriteMask = m_State.m_ColorWrite ? static_cast<VkColorComponentFlags>(VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT) : 0u,
 		};
 
+		// Every color attachment of the render pass needs its own state, all of them share the same configuration
+		_createInfo.m_VKColorBlendAttachments.assign(m_VKRenderpassHandle->GetColorAttachmentCount(m_State.m_Subpass), colorBlendAttachmentState);
+
 		// Configuration for global color blending settings for all framebuffers
-		VkPipelineColorBlendStateCreateInfo colorBlendAttachmentStateCreateInfo{
+		_createInfo.m_VKColorBlend = VkPipelineColorBlendStateCreateInfo{
 			.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
 			.logicOpEnable = VK_FALSE, // Bitwise op blending turned off
 			.logicOp = VK_LOGIC_OP_COPY,
-			.attachmentCount = 1,
-			.pAttachments = &colorBlendAttachmentState
+			.attachmentCount = static_cast<uint32_t>(_createInfo.m_VKColorBlendAttachments.size()),
+			.pAttachments = _createInfo.m_VKColorBlendAttachments.data()
+		};
+		_createInfo.m_VKColorBlend.blendConstants[0] = 0.0f;
+		_createInfo.m_VKColorBlend.blendConstants[1] = 0.0f;
+		_createInfo.m_VKColorBlend.blendConstants[2] = 0.0f;
+		_createInfo.m_VKColorBlend.blendConstants[3] = 0.0f;
+
+		// Depth test and write when the render pass has a depth attachment, unless the state turns them off
+		_createInfo.m_VKDepthStencil = VkPipelineDepthStencilStateCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO,
+			.depthTestEnable = m_State.m_DepthTest ? VK_TRUE : VK_FALSE,
+			.depthWriteEnable = m_State.m_DepthWrite ? VK_TRUE : VK_FALSE,
+			.depthCompareOp = m_State.m_DepthCompareOp,
+			.depthBoundsTestEnable = VK_FALSE,
+			.stencilTestEnable = VK_FALSE,
+			.minDepthBounds = 0.f,
+			.maxDepthBounds = 1.f
 		};
-		colorBlendAttachmentStateCreateInfo.blendConstants[0] = 0.0f;
-		colorBlendAttachmentStateCreateInfo.blendConstants[1] = 0.0f;
-		colorBlendAttachmentStateCreateInfo.blendConstants[2] = 0.0f;
-		colorBlendAttachmentStateCreateInfo.blendConstants[3] = 0.0f;
 
 		// Dynamic States - To change state previously specified without recreating pipeline
-		VkDynamicState dynamicStates[] = {
+		_createInfo.m_VKDynamicStates = {
 			VK_DYNAMIC_STATE_VIEWPORT,
 			VK_DYNAMIC_STATE_SCISSOR
 		};
 
-		VkPipelineDynamicStateCreateInfo dynamicState{};
-		dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-		dynamicState.dynamicStateCount = 2;
-		dynamicState.pDynamicStates = dynamicStates;
-
-		// Creating a Pipeline Layout - To specify Uniforms or Descriptor Sets to Shaders
-
-		VkPushConstantRange pushConstant;
-		pushConstant.offset = 0;
-		pushConstant.size = 64;
-		pushConstant.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
-
-		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{
-			.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+		_createInfo.m_VKDynamic = VkPipelineDynamicStateCreateInfo{};
+		_createInfo.m_VKDynamic.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+		_createInfo.m_VKDynamic.dynamicStateCount = static_cast<uint32_t>(_createInfo.m_VKDynamicStates.size());
+		_createInfo.m_VKDynamic.pDynamicStates = _createInfo.m_VKDynamicStates.data();
+
+		// With dynamic rendering the pipeline only declares its attachment formats and works with any extent
+		const bool dynamicRendering{ m_VKRenderpassHandle->IsDynamicRendering() };
+		const std::span<const VkFormat> colorFormats{ m_VKRenderpassHandle->GetVKColorFormats() };
+		_createInfo.m_VKColorFormats.assign(colorFormats.begin(), colorFormats.end());
+		_createInfo.m_VKRendering = VkPipelineRenderingCreateInfoKHR{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR,
 			.pNext = nullptr,
-			.flags = 0,
-			.setLayoutCount = 1,
-			.pSetLayouts = &m_VKDescriptorSetLayout,
-			.pushConstantRangeCount = 1,
-			.pPushConstantRanges = &pushConstant
+			.viewMask = 0,
+			.colorAttachmentCount = static_cast<uint32_t>(_createInfo.m_VKColorFormats.size()),
+			.pColorAttachmentFormats = _createInfo.m_VKColorFormats.data(),
+			.depthAttachmentFormat = m_VKRenderpassHandle->HasDepthAttachment() ? m_VKRenderpassHandle->GetVKDepthFormat() : VK_FORMAT_UNDEFINED,
+			.stencilAttachmentFormat = m_VKRenderpassHandle->HasStencil() ? m_VKRenderpassHandle->GetVKDepthFormat() : VK_FORMAT_UNDEFINED
 		};
 
-		if (auto VkErr{ vkCreatePipelineLayout(m_VKDeviceHandle->GetVKDevice(), &pipelineLayoutCreateInfo, nullptr, &m_VKPipelineLayout) }; VkErr)
-		{
-			Logger::Log_Error("Unable to create pipeline. Failed to create Pipeline Layout");
-			throw std::runtime_error("Unable to create pipeline. Failed to create Pipeline Layout");
-		}
-
 		// Describe Graphics pipeline
-		VkGraphicsPipelineCreateInfo pipelineCreateInfo{
+		_createInfo.m_VKCreateInfo = VkGraphicsPipelineCreateInfo{
 			.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-			.stageCount = 2, // Shader stages count
+			.pNext = dynamicRendering ? &_createInfo.m_VKRendering : nullptr,
+			.stageCount = static_cast<uint32_t>(m_VKShaderStages.size()), // Shader stages count
 			.pStages = m_VKShaderStages.data(), // Container of shader stages
-			.pVertexInputState = &vertexInputInfo, // Vertex input state
-			.pInputAssemblyState = &inputAssemblyCreateInfo, // Assembly stage state
-			.pViewportState = &viewportStateCreateInfo, // Viewport state when rasterization enabled
-			.pRasterizationState = &rasterizerCreateInfo, // Rasterization state
-			.pMultisampleState = &multisamplingCreateInfo, // Multisampling state when rasterization enabled
-			.pDepthStencilState = nullptr, // Depth or stencil attachment
-			.pColorBlendState = &colorBlendAttachmentStateCreateInfo, // Color blending stage state
-			.pDynamicState = &dynamicState, // Determines what properties are dynamic and CAN be changed independently of pipeline state
+			.pVertexInputState = &_createInfo.m_VKVertexInput, // Vertex input state
+			.pInputAssemblyState = &_createInfo.m_VKInputAssembly, // Assembly stage state
+			.pViewportState = &_createInfo.m_VKViewport, // Viewport state when rasterization enabled
+			.pRasterizationState = &_createInfo.m_VKRasterization, // Rasterization state
+			.pMultisampleState = &_createInfo.m_VKMultisample, // Multisampling state when rasterization enabled
+			.pDepthStencilState = m_VKRenderpassHandle->HasDepthAttachment(m_State.m_Subpass) ? &_createInfo.m_VKDepthStencil : nullptr, // Depth or stencil attachment
+			.pColorBlendState = &_createInfo.m_VKColorBlend, // Color blending stage state
+			.pDynamicState = &_createInfo.m_VKDynamic, // Determines what properties are dynamic and CAN be changed independently of pipeline state
 			.layout = m_VKPipelineLayout, // Uniform/Descriptor set binding
-			.renderPass = m_VKRenderpassHandle->GetVKRenderPass(), // Renderpass describing environment which pipeline can be used.
-			.subpass = 0, // Index of the subpass inside renderpass where pipeline will be used
+			.renderPass = m_VKRenderpassHandle->GetVKRenderPass(), // Renderpass describing environment which pipeline can be used. Null with dynamic rendering
+			.subpass = m_State.m_Subpass, // Index of the subpass inside renderpass where pipeline will be used
 			.basePipelineHandle = VK_NULL_HANDLE, // Base pipeline handle
 			.basePipelineIndex = -1 // Base pipeline index
 		};
+	}
+
+	void Pipeline::CreateComputePipeline()
+	{
+		CreatePipelineLayout();
+
+		VkComputePipelineCreateInfo pipelineCreateInfo{
+			.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+			.stage = m_VKShaderStages[0],
+			.layout = m_VKPipelineLayout,
+			.basePipelineHandle = VK_NULL_HANDLE,
+			.basePipelineIndex = -1
+		};
 
-		// Create Graphics Pipeline
-		if (auto VkErr{ vkCreateGraphicsPipelines(m_VKDeviceHandle->GetVKDevice(), VK_NULL_HANDLE, 1, &pipelineCreateInfo, nullptr, &m_VKPipeline)}; VkErr)
+		const auto start{ std::chrono::steady_clock::now() };
+		if (auto VkErr{ vkCreateComputePipelines(m_VKDeviceHandle->GetVKDevice(), m_VKDeviceHandle->GetVKPipelineCache(), 1, &pipelineCreateInfo, nullptr, &m_VKPipeline) }; VkErr)
 		{
-			Logger::Log_Error("Failed to create Graphics Pipeline. vkCreateGraphicsPipeline failed.");
-			throw std::runtime_error("Failed to create Graphics Pipeline. vkCreateGraphicsPipeline failed.");
+			Logger::Log_Error("Failed to create Compute Pipeline. vkCreateComputePipelines failed.");
+			throw std::runtime_error("Failed to create Compute Pipeline. vkCreateComputePipelines failed.");
 		}
+		m_VKDeviceHandle->AddPipelineCreationTime(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+		m_Ready.store(true, std::memory_order_release);
 	}
-}
+}
\ No newline at end of file
@@ -5,24 +5,71 @@ namespace Minerva::Vulkan
 	class Pipeline
 	{
 	public:
+		// Specialization constants of one stage, pointed to by its VkPipelineShaderStageCreateInfo
+		struct StageSpecialization
+		{
+			std::vector<VkSpecializationMapEntry> m_VKMapEntries;
+			std::vector<uint8_t> m_Data;
+			VkSpecializationInfo m_VKInfo;
+		};
+
+		// Everything a VkGraphicsPipelineCreateInfo points to. Filled in place, so it must not move afterwards
+		struct GraphicsCreateInfo
+		{
+			VkPipelineVertexInputStateCreateInfo m_VKVertexInput;
+			VkPipelineInputAssemblyStateCreateInfo m_VKInputAssembly;
+			VkPipelineViewportStateCreateInfo m_VKViewport;
+			VkPipelineRasterizationStateCreateInfo m_VKRasterization;
+			VkPipelineMultisampleStateCreateInfo m_VKMultisample;
+			std::vector<VkPipelineColorBlendAttachmentState> m_VKColorBlendAttachments;
+			VkPipelineColorBlendStateCreateInfo m_VKColorBlend;
+			VkPipelineDepthStencilStateCreateInfo m_VKDepthStencil;
+			std::array<VkDynamicState, 2> m_VKDynamicStates;
+			VkPipelineDynamicStateCreateInfo m_VKDynamic;
+			std::vector<VkFormat> m_VKColorFormats;                 // Dynamic rendering only
+			VkPipelineRenderingCreateInfoKHR m_VKRendering;
+			VkGraphicsPipelineCreateInfo m_VKCreateInfo;
+		};
+
+		// _compile false only creates the layout, the pipeline is compiled later by a PipelineLibrary
 		Pipeline(std::shared_ptr<Minerva::Vulkan::Device> _device,
 			std::shared_ptr<Minerva::Vulkan::Window> _window,
 			std::shared_ptr<Minerva::Vulkan::Renderpass> _renderpass,
 			const Minerva::Shader* _shaders,
 			int _shaderCount,
 			std::shared_ptr<Minerva::Vulkan::DescriptorSet> _descriptorSet,
-			std::shared_ptr<Minerva::Vulkan::VertexDescriptor> _vertDesc);
+			std::shared_ptr<Minerva::Vulkan::VertexDescriptor> _vertDesc,
+			const Minerva::Pipeline::State& _state = {},
+			bool _compile = true);
+		Pipeline(std::shared_ptr<Minerva::Vulkan::Device> _device,
+			std::shared_ptr<Minerva::Vulkan::Shader> _computeShader,
+			std::shared_ptr<Minerva::Vulkan::DescriptorSet> _descriptorSet,
+			std::span<const Minerva::Shader::Specialization> _specializations = {});
 		~Pipeline();
 
 		inline VkPipeline GetGraphicsPipeline() const { return m_VKPipeline; }
+		inline VkPipeline GetVKPipeline() const { return m_VKPipeline; }
+		inline Minerva::Pipeline::Type GetType() const { return m_Type; }
+		inline VkPipelineBindPoint GetVKBindPoint() const { return m_Type == Minerva::Pipeline::Type::COMPUTE ? VK_PIPELINE_BIND_POINT_COMPUTE : VK_PIPELINE_BIND_POINT_GRAPHICS; }
 		inline std::shared_ptr<Minerva::Vulkan::Device> GetVKDeviceHandle() const { return m_VKDeviceHandle; }
 		inline std::shared_ptr<Minerva::Vulkan::Window> GetVKWindowHandle() const { return m_VKWindowHandle; }
 		inline std::shared_ptr<Minerva::Vulkan::Renderpass> GetVKRenderpassHandle() const { return m_VKRenderpassHandle; }
 		inline VkPipelineLayout GetVKPipelineLayout() const { return m_VKPipelineLayout; }
+		inline const VkPushConstantRange& GetVKPushConstantRange() const { return m_VKPushConstantRange; } // Size 0 if no stage reads push constants
+		inline const Minerva::Pipeline::State& GetState() const { return m_State; }
+		inline std::span<const std::shared_ptr<Minerva::Vulkan::Shader>> GetVKShaderHandles() const { return m_VKShaderHandles; }
+		inline std::shared_ptr<Minerva::Vulkan::VertexDescriptor> GetVKVertexDescriptorHandle() const { return m_VKVertexDescriptorHandle; }
+
+		// The pipeline handle may only be read once ready
+		inline bool IsReady() const { return m_Ready.load(std::memory_order_acquire); }
 
 		void CleanupPipeline();
 		void RecreatePipeline();
 
+		// Deferred compilation, see PipelineLibrary
+		void FillGraphicsCreateInfo(GraphicsCreateInfo& _createInfo) const;
+		void SetCompiledPipeline(VkPipeline _pipeline);
+
 	private:
 		// Private interface handles
 		std::shared_ptr<Minerva::Vulkan::Device> m_VKDeviceHandle;
@@ -32,16 +79,25 @@ namespace Minerva::Vulkan
 
 		// Vulkan properties
 		std::vector<VkPipelineShaderStageCreateInfo> m_VKShaderStages;
-		VkPipelineLayout m_VKPipelineLayout;
+		std::vector<StageSpecialization> m_StageSpecializations; // Reserved up front, the stages point into it
+		VkPipelineLayout m_VKPipelineLayout; // Owned by the device's LayoutCache
+		VkPushConstantRange m_VKPushConstantRange;
 		VkPipeline m_VKPipeline;
 		VkDescriptorSetLayout  m_VKDescriptorSetLayout;
 
 		// Minerva properties
-		//todo Minerva::Pipeline::Type m_Type;
+		Minerva::Pipeline::Type m_Type;
 		std::shared_ptr<Minerva::Vulkan::VertexDescriptor> m_VKVertexDescriptorHandle;
+		Minerva::Pipeline::State m_State;
+		std::atomic<bool> m_Ready;
 
 		// Helper function
+		void AddShaderStage(const std::shared_ptr<Minerva::Vulkan::Shader>& _shader, std::span<const Minerva::Shader::Specialization> _specializations);
+		void CreatePipelineLayout();
+		void ValidateBindings(const Minerva::Vulkan::DescriptorSet& _descriptorSet) const;
+		void ValidateVertexInputs() const;
 		void CreateGraphicsPipeline();
+		void CreateComputePipeline();
 	};
 }
 
@@ -0,0 +1,223 @@
+namespace Minerva::Vulkan
+{
+	PipelineLibrary::PipelineLibrary(std::shared_ptr<Minerva::Vulkan::Device> _device, uint32_t _threadCount) :
+		m_VKDeviceHandle{ _device }, m_Pipelines{}, m_Pending{}, m_Workers{}, m_Compiling{ 0 }, m_Stop{ false },
+		m_DeduplicatedCount{ 0 }, m_BatchCount{ 0 }
+	{
+		const uint32_t threadCount{ std::max(1u, _threadCount) };
+		m_Workers.reserve(threadCount);
+		for (uint32_t i{ 0 }; i < threadCount; ++i)
+			m_Workers.emplace_back(&PipelineLibrary::Worker, this);
+	}
+
+	PipelineLibrary::~PipelineLibrary()
+	{
+		// Batches being compiled finish, pipelines still queued stay not ready
+		{
+			std::scoped_lock lock{ m_Lock };
+			m_Stop = true;
+		}
+		m_WorkAvailable.notify_all();
+
+		for (std::thread& worker : m_Workers)
+			worker.join();
+	}
+
+	std::shared_ptr<Minerva::Vulkan::Pipeline> PipelineLibrary::Request(std::shared_ptr<Minerva::Vulkan::Window> _window,
+		std::shared_ptr<Minerva::Vulkan::Renderpass> _renderpass,
+		const Minerva::Shader* _shaders,
+		int _shaderCount,
+		std::shared_ptr<Minerva::Vulkan::DescriptorSet> _descriptorSet,
+		std::shared_ptr<Minerva::Vulkan::VertexDescriptor> _vertDesc,
+		const Minerva::Pipeline::State& _state)
+	{
+		std::string description{ Describe(_renderpass, _shaders, _shaderCount, _descriptorSet, _vertDesc, _state) };
+
+		{
+			std::scoped_lock lock{ m_Lock };
+			if (auto it{ m_Pipelines.find(description) }; it != m_Pipelines.end())
+			{
+				m_DeduplicatedCount.fetch_add(1, std::memory_order_relaxed);
+				return it->second;
+			}
+		}
+
+		// The layout is created here, only the pipeline compile is deferred
+		std::shared_ptr<Minerva::Vulkan::Pipeline> pipeline{ std::make_shared<Minerva::Vulkan::Pipeline>(m_VKDeviceHandle, _window, _renderpass,
+			_shaders, _shaderCount, _descriptorSet, _vertDesc, _state, false) };
+
+		{
+			std::scoped_lock lock{ m_Lock };
+
+			// Another thread may have requested the same description meanwhile
+			auto [it, inserted] { m_Pipelines.try_emplace(std::move(description), pipeline) };
+			if (!inserted)
+			{
+				m_DeduplicatedCount.fetch_add(1, std::memory_order_relaxed);
+				return it->second;
+			}
+
+			m_Pending.push_back(pipeline);
+		}
+		m_WorkAvailable.notify_one();
+
+		return pipeline;
+	}
+
+	void PipelineLibrary::WaitIdle()
+	{
+		std::unique_lock lock{ m_Lock };
+		m_Idle.wait(lock, [this]() { return m_Pending.empty() && m_Compiling == 0; });
+	}
+
+	size_t PipelineLibrary::GetPipelineCount() const
+	{
+		std::scoped_lock lock{ m_Lock };
+		return m_Pipelines.size();
+	}
+
+	size_t PipelineLibrary::GetPendingCount() const
+	{
+		std::scoped_lock lock{ m_Lock };
+		return m_Pending.size() + m_Compiling;
+	}
+
+	std::string PipelineLibrary::Describe(const std::shared_ptr<Minerva::Vulkan::Renderpass>& _renderpass, const Minerva::Shader* _shaders, int _shaderCount,
+		const std::shared_ptr<Minerva::Vulkan::DescriptorSet>& _descriptorSet, const std::shared_ptr<Minerva::Vulkan::VertexDescriptor>& _vertDesc,
+		const Minerva::Pipeline::State& _state)
+	{
+		std::string description;
+
+		// Fields are appended one by one, padding bytes would make equal descriptions differ
+		auto Append = [&description](const auto& _value)
+		{
+			description.append(reinterpret_cast<const char*>(&_value), sizeof(_value));
+		};
+
+		// Render pass object rather than its VkRenderPass, which changes when the window recreates it
+		Append(_renderpass.get());
+
+		// Shaders by file, the same file always creates the same module
+		Append(_shaderCount);
+		for (int i{ 0 }; i < _shaderCount; ++i)
+		{
+			std::string_view filepath{ _shaders[i].GetVKShaderHandle()->GetFilepath() };
+			Append(_shaders[i].GetVKShaderHandle()->GetShaderType());
+			Append(filepath.size());
+			description.append(filepath);
+
+			// Specialized variants of one module are different pipelines
+			const std::span<const Minerva::Shader::Specialization> specializations{ _shaders[i].GetSpecializations() };
+			Append(specializations.size());
+			for (const Minerva::Shader::Specialization& specialization : specializations)
+			{
+				Append(specialization.m_ConstantID);
+				Append(specialization.m_Size);
+				Append(specialization.m_Value);
+			}
+		}
+
+		// Identically defined set layouts are compatible, so sets with the same bindings share pipelines
+		const std::span<const Minerva::DescriptorSet::Layout> layouts{ _descriptorSet->GetLayouts() };
+		Append(layouts.size());
+		for (const Minerva::DescriptorSet::Layout& layout : layouts)
+		{
+			Append(layout.m_BindingPoint);
+			Append(layout.m_DescriptorType);
+			Append(layout.m_DescriptorCount);
+			Append(layout.m_ShaderStage);
+		}
+
+		const VkPipelineVertexInputStateCreateInfo vertexInput{ _vertDesc->GetPipelineVertexInputCreateInfo() };
+		Append(_vertDesc->GetVKTopology());
+		Append(vertexInput.vertexBindingDescriptionCount);
+		for (uint32_t i{ 0 }; i < vertexInput.vertexBindingDescriptionCount; ++i)
+		{
+			Append(vertexInput.pVertexBindingDescriptions[i].binding);
+			Append(vertexInput.pVertexBindingDescriptions[i].stride);
+			Append(vertexInput.pVertexBindingDescriptions[i].inputRate);
+		}
+		Append(vertexInput.vertexAttributeDescriptionCount);
+		for (uint32_t i{ 0 }; i < vertexInput.vertexAttributeDescriptionCount; ++i)
+		{
+			Append(vertexInput.pVertexAttributeDescriptions[i].location);
+			Append(vertexInput.pVertexAttributeDescriptions[i].binding);
+			Append(vertexInput.pVertexAttributeDescriptions[i].format);
+			Append(vertexInput.pVertexAttributeDescriptions[i].offset);
+		}
+
+		Append(_state.m_CullMode);
+		Append(_state.m_PolygonMode);
+		Append(_state.m_DepthCompareOp);
+		Append(_state.m_DepthTest);
+		Append(_state.m_DepthWrite);
+		Append(_state.m_Blend);
+		Append(_state.m_ColorWrite);
+		Append(_state.m_Subpass);
+
+		return description;
+	}
+
+	void PipelineLibrary::Worker()
+	{
+		std::vector<std::shared_ptr<Minerva::Vulkan::Pipeline>> batch;
+		batch.reserve(MAX_BATCH_SIZE);
+
+		while (true)
+		{
+			{
+				std::unique_lock lock{ m_Lock };
+				m_WorkAvailable.wait(lock, [this]() { return m_Stop || !m_Pending.empty(); });
+				if (m_Stop) return;
+
+				// Whatever queued up while the workers were busy is compiled together
+				while (!m_Pending.empty() && batch.size() < MAX_BATCH_SIZE)
+				{
+					batch.push_back(std::move(m_Pending.front()));
+					m_Pending.pop_front();
+				}
+				m_Compiling += batch.size();
+			}
+
+			Compile(batch);
+
+			{
+				std::scoped_lock lock{ m_Lock };
+				m_Compiling -= batch.size();
+				if (m_Pending.empty() && m_Compiling == 0)
+					m_Idle.notify_all();
+			}
+			batch.clear();
+		}
+	}
+
+	void PipelineLibrary::Compile(std::span<const std::shared_ptr<Minerva::Vulkan::Pipeline>> _pipelines)
+	{
+		// Sized once, the create infos point into their own elements
+		std::vector<Minerva::Vulkan::Pipeline::GraphicsCreateInfo> createInfos(_pipelines.size());
+		std::vector<VkGraphicsPipelineCreateInfo> vkCreateInfos(_pipelines.size());
+		for (size_t i{ 0 }; i < _pipelines.size(); ++i)
+		{
+			_pipelines[i]->FillGraphicsCreateInfo(createInfos[i]);
+			vkCreateInfos[i] = createInfos[i].m_VKCreateInfo;
+		}
+
+		std::vector<VkPipeline> vkPipelines(_pipelines.size(), VK_NULL_HANDLE);
+
+		const auto start{ std::chrono::steady_clock::now() };
+		const VkResult result{ vkCreateGraphicsPipelines(m_VKDeviceHandle->GetVKDevice(), m_VKDeviceHandle->GetVKPipelineCache(),
+			static_cast<uint32_t>(vkCreateInfos.size()), vkCreateInfos.data(), nullptr, vkPipelines.data()) };
+		m_VKDeviceHandle->AddPipelineCreationTime(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+		m_BatchCount.fetch_add(1, std::memory_order_relaxed);
+
+		// Worker threads do not throw. Pipelines that failed stay not ready and are never bound
+		if (result != VK_SUCCESS)
+			Logger::Log_Error("PipelineLibrary failed to compile pipelines. vkCreateGraphicsPipelines failed.");
+
+		for (size_t i{ 0 }; i < _pipelines.size(); ++i)
+		{
+			if (vkPipelines[i] != VK_NULL_HANDLE)
+				_pipelines[i]->SetCompiledPipeline(vkPipelines[i]);
+		}
+	}
+}
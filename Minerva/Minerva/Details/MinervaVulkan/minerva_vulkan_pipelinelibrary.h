@@ -0,0 +1,53 @@
+#pragma once
+
+namespace Minerva::Vulkan
+{
+	// Backend of Minerva::PipelineLibrary. Requests are keyed by their serialized description, so the map hashes the whole
+	// description and equal descriptions share one pipeline. Worker threads compile pending pipelines in batches
+	class PipelineLibrary
+	{
+	public:
+		static constexpr size_t MAX_BATCH_SIZE{ 16 }; // Create infos per vkCreateGraphicsPipelines call
+
+		PipelineLibrary(std::shared_ptr<Minerva::Vulkan::Device> _device, uint32_t _threadCount);
+		~PipelineLibrary();
+
+		std::shared_ptr<Minerva::Vulkan::Pipeline> Request(std::shared_ptr<Minerva::Vulkan::Window> _window,
+			std::shared_ptr<Minerva::Vulkan::Renderpass> _renderpass,
+			const Minerva::Shader* _shaders,
+			int _shaderCount,
+			std::shared_ptr<Minerva::Vulkan::DescriptorSet> _descriptorSet,
+			std::shared_ptr<Minerva::Vulkan::VertexDescriptor> _vertDesc,
+			const Minerva::Pipeline::State& _state);
+
+		void WaitIdle();
+
+		size_t GetPipelineCount() const;
+		size_t GetPendingCount() const;
+		inline uint32_t GetDeduplicatedCount() const { return m_DeduplicatedCount.load(std::memory_order_relaxed); }
+		inline uint32_t GetBatchCount() const { return m_BatchCount.load(std::memory_order_relaxed); }
+
+	private:
+		std::shared_ptr<Minerva::Vulkan::Device> m_VKDeviceHandle;
+
+		std::unordered_map<std::string, std::shared_ptr<Minerva::Vulkan::Pipeline>> m_Pipelines;
+		std::deque<std::shared_ptr<Minerva::Vulkan::Pipeline>> m_Pending;
+		std::vector<std::thread> m_Workers;
+		mutable std::mutex m_Lock;                 // Guards the map, the queue, m_Compiling and m_Stop
+		std::condition_variable m_WorkAvailable;
+		std::condition_variable m_Idle;
+		size_t m_Compiling;                        // Taken from the queue, not compiled yet
+		bool m_Stop;
+		std::atomic<uint32_t> m_DeduplicatedCount; // Requests answered by an existing pipeline
+		std::atomic<uint32_t> m_BatchCount;
+
+		// Helper functions
+		static std::string Describe(const std::shared_ptr<Minerva::Vulkan::Renderpass>& _renderpass, const Minerva::Shader* _shaders, int _shaderCount,
+			const std::shared_ptr<Minerva::Vulkan::DescriptorSet>& _descriptorSet, const std::shared_ptr<Minerva::Vulkan::VertexDescriptor>& _vertDesc,
+			const Minerva::Pipeline::State& _state);
+		void Worker();
+		void Compile(std::span<const std::shared_ptr<Minerva::Vulkan::Pipeline>> _pipelines);
+	};
+}
+
+#include "minerva_vulkan_pipelinelibrary.cpp"
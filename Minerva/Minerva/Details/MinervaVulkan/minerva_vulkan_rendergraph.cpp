@@ -0,0 +1,710 @@
+namespace Minerva::Vulkan
+{
+	RenderGraph::RenderGraph(std::shared_ptr<Minerva::Vulkan::Device> _device, std::shared_ptr<Minerva::Vulkan::Window> _window) :
+		m_VKDeviceHandle{ _device }, m_VKWindowHandle{ _window },
+		m_Passes{}, m_Resources{}, m_MemoryBlocks{}, m_ImageBindings{}, m_FinalBarriers{},
+		m_VKLinearSampler{ VK_NULL_HANDLE }, m_VKNearestSampler{ VK_NULL_HANDLE }, m_WindowExtent{ 0, 0 },
+		m_TransientMemorySize{ 0 }, m_BarrierBatchCount{ 0 }, m_Compiled{ false }
+	{
+		for (VkFilter filter : { VK_FILTER_LINEAR, VK_FILTER_NEAREST })
+		{
+			VkSamplerCreateInfo samplerInfo{
+				.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+				.magFilter = filter,
+				.minFilter = filter,
+				.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST,
+				.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+				.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+				.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+				.mipLodBias = 0.f,
+				.anisotropyEnable = VK_FALSE,
+				.maxAnisotropy = 1.f,
+				.compareEnable = VK_FALSE,
+				.compareOp = VK_COMPARE_OP_ALWAYS,
+				.minLod = 0.f,
+				.maxLod = 0.f,
+				.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_BLACK,
+				.unnormalizedCoordinates = VK_FALSE
+			};
+
+			if (int vkErr{ vkCreateSampler(m_VKDeviceHandle->GetVKDevice(), &samplerInfo, nullptr, filter == VK_FILTER_LINEAR ? &m_VKLinearSampler : &m_VKNearestSampler) }; vkErr)
+			{
+				Logger::Log_Error("Unable to create RenderGraph. vkCreateSampler failed.");
+				throw std::runtime_error("Unable to create RenderGraph. vkCreateSampler failed.");
+			}
+		}
+	}
+
+	RenderGraph::~RenderGraph()
+	{
+		DestroyImages();
+
+		if (m_VKLinearSampler != VK_NULL_HANDLE)
+			vkDestroySampler(m_VKDeviceHandle->GetVKDevice(), m_VKLinearSampler, nullptr);
+		if (m_VKNearestSampler != VK_NULL_HANDLE)
+			vkDestroySampler(m_VKDeviceHandle->GetVKDevice(), m_VKNearestSampler, nullptr);
+	}
+
+	uint32_t RenderGraph::CreateImage(std::string_view _name, const Minerva::RenderGraph::ImageDesc& _desc)
+	{
+		ValidateDeclaration();
+
+		// Views, barriers and clears only cover the depth aspect
+		if (_desc.m_Format == VK_FORMAT_S8_UINT || _desc.m_Format == VK_FORMAT_D16_UNORM_S8_UINT ||
+			_desc.m_Format == VK_FORMAT_D24_UNORM_S8_UINT || _desc.m_Format == VK_FORMAT_D32_SFLOAT_S8_UINT)
+		{
+			Logger::Log_Error("Unable to create RenderGraph image. Formats with a stencil aspect are not supported.");
+			throw std::runtime_error("Unable to create RenderGraph image. Formats with a stencil aspect are not supported.");
+		}
+
+		m_Resources.push_back(Resource{ .m_Name = std::string(_name), .m_Desc{ _desc } });
+		return static_cast<uint32_t>(m_Resources.size() - 1);
+	}
+
+	uint32_t RenderGraph::ImportBuffer(std::string_view _name, std::shared_ptr<Minerva::Vulkan::Buffer> _buffer)
+	{
+		ValidateDeclaration();
+
+		m_Resources.push_back(Resource{ .m_Name = std::string(_name), .m_VKBuffer{ _buffer } });
+		return static_cast<uint32_t>(m_Resources.size() - 1);
+	}
+
+	uint32_t RenderGraph::AddPass(std::string_view _name, Minerva::RenderGraph::PassType _type, Minerva::RenderGraph::ExecuteFunction _function)
+	{
+		ValidateDeclaration();
+
+		m_Passes.push_back(Pass{ .m_Name = std::string(_name), .m_Type = _type, .m_Function{ std::move(_function) } });
+		return static_cast<uint32_t>(m_Passes.size() - 1);
+	}
+
+	void RenderGraph::AddAccess(uint32_t _pass, uint32_t _resource, Minerva::RenderGraph::Access _access, bool _write)
+	{
+		ValidateDeclaration();
+
+		if (_pass >= m_Passes.size() || _resource >= m_Resources.size())
+		{
+			Logger::Log_Error("Unable to add RenderGraph access. Invalid pass or resource.");
+			throw std::runtime_error("Unable to add RenderGraph access. Invalid pass or resource.");
+		}
+
+		Pass& pass{ m_Passes[_pass] };
+		const Resource& resource{ m_Resources[_resource] };
+		const bool isImage{ !resource.m_VKBuffer };
+		const bool isDepth{ isImage && IsDepthFormat(resource.m_Desc.m_Format) };
+		const AccessInfo info{ GetAccessInfo(_access, pass.m_Type, isDepth) };
+
+		if (info.m_Write != _write)
+		{
+			Logger::Log_Error("Unable to add RenderGraph access. Reads and writes must be declared through Read and Write respectively.");
+			throw std::runtime_error("Unable to add RenderGraph access. Reads and writes must be declared through Read and Write respectively.");
+		}
+
+		if ((isImage && info.m_VKUsage == 0) || (!isImage && !info.m_Buffer))
+		{
+			Logger::Log_Error("Unable to add RenderGraph access. Access is not valid for this resource type.");
+			throw std::runtime_error("Unable to add RenderGraph access. Access is not valid for this resource type.");
+		}
+
+		if (info.m_Attachment && (pass.m_Type != Minerva::RenderGraph::PassType::GRAPHICS ||
+			isDepth != (_access == Minerva::RenderGraph::Access::DEPTH_ATTACHMENT)))
+		{
+			Logger::Log_Error("Unable to add RenderGraph access. Attachments need a graphics pass and a matching color or depth format.");
+			throw std::runtime_error("Unable to add RenderGraph access. Attachments need a graphics pass and a matching color or depth format.");
+		}
+
+		// One access per resource and pass, a pass reading what it writes would be a feedback loop
+		for (const PassAccess& access : pass.m_Accesses)
+		{
+			if (access.m_Resource == _resource)
+			{
+				Logger::Log_Error("Unable to add RenderGraph access. Resource is already accessed by this pass.");
+				throw std::runtime_error("Unable to add RenderGraph access. Resource is already accessed by this pass.");
+			}
+		}
+
+		pass.m_Accesses.push_back(PassAccess{ _resource, _access });
+	}
+
+	void RenderGraph::SetOutput(uint32_t _resource)
+	{
+		ValidateDeclaration();
+
+		if (_resource >= m_Resources.size() || m_Resources[_resource].m_VKBuffer)
+		{
+			Logger::Log_Error("Unable to set RenderGraph output. Outputs must be images of this graph.");
+			throw std::runtime_error("Unable to set RenderGraph output. Outputs must be images of this graph.");
+		}
+
+		m_Resources[_resource].m_Output = true;
+	}
+
+	void RenderGraph::Compile()
+	{
+		ValidateDeclaration();
+
+		CullPasses();
+
+		// Lifetimes span the first to the last pass using a resource, outputs are used until the end of the frame
+		for (uint32_t passIndex{ 0 }; passIndex < m_Passes.size(); ++passIndex)
+		{
+			const Pass& pass{ m_Passes[passIndex] };
+			if (pass.m_Culled) continue;
+
+			for (const PassAccess& access : pass.m_Accesses)
+			{
+				Resource& resource{ m_Resources[access.m_Resource] };
+				resource.m_FirstPass = std::min(resource.m_FirstPass, passIndex);
+				resource.m_LastPass = std::max(resource.m_LastPass, passIndex);
+				resource.m_VKUsage |= GetAccessInfo(access.m_Access, pass.m_Type, IsDepthFormat(resource.m_Desc.m_Format)).m_VKUsage;
+			}
+		}
+
+		for (Resource& resource : m_Resources)
+		{
+			if (!resource.m_Output) continue;
+
+			if (resource.m_FirstPass == UINT32_MAX)
+			{
+				Logger::Log_Error("Unable to compile RenderGraph. An output is never written.");
+				throw std::runtime_error("Unable to compile RenderGraph. An output is never written.");
+			}
+
+			// Outputs are sampled after the graph
+			resource.m_LastPass = static_cast<uint32_t>(m_Passes.size());
+			resource.m_VKUsage |= VK_IMAGE_USAGE_SAMPLED_BIT;
+		}
+
+		CreateImages();
+		CreateRenderpasses();
+		ComputeBarriers();
+		m_Compiled = true;
+
+		for (const ImageBinding& binding : m_ImageBindings)
+			WriteImageBinding(binding);
+	}
+
+	void RenderGraph::BindImage(std::shared_ptr<Minerva::Vulkan::DescriptorSet> _descriptorSet, const Minerva::DescriptorSet::Layout& _layout, uint32_t _resource)
+	{
+		if (_resource >= m_Resources.size() || m_Resources[_resource].m_VKBuffer)
+		{
+			Logger::Log_Error("Unable to bind RenderGraph image. Resource is not an image of this graph.");
+			throw std::runtime_error("Unable to bind RenderGraph image. Resource is not an image of this graph.");
+		}
+
+		m_ImageBindings.push_back(ImageBinding{ _descriptorSet, _layout, _resource });
+
+		// Bindings added before Compile are written once the images exist
+		if (m_Compiled)
+			WriteImageBinding(m_ImageBindings.back());
+	}
+
+	std::shared_ptr<Minerva::Vulkan::Renderpass> RenderGraph::GetRenderpass(uint32_t _pass) const
+	{
+		if (!m_Compiled || _pass >= m_Passes.size() || !m_Passes[_pass].m_VKRenderpass)
+		{
+			Logger::Log_Error("Unable to get RenderGraph render pass. Graph is not compiled, or the pass is culled or not a graphics pass.");
+			throw std::runtime_error("Unable to get RenderGraph render pass. Graph is not compiled, or the pass is culled or not a graphics pass.");
+		}
+
+		return m_Passes[_pass].m_VKRenderpass;
+	}
+
+	void RenderGraph::Execute(Minerva::Vulkan::CommandBuffer& _cmdBuffer)
+	{
+		if (!m_Compiled)
+		{
+			Logger::Log_Error("Unable to execute RenderGraph. Graph is not compiled.");
+			throw std::runtime_error("Unable to execute RenderGraph. Graph is not compiled.");
+		}
+
+		// Minimized
+		const VkExtent2D windowExtent{ m_VKWindowHandle->GetVKSwapExtent() };
+		if (windowExtent.width == 0 || windowExtent.height == 0) return;
+
+		if (windowExtent.width != m_WindowExtent.width || windowExtent.height != m_WindowExtent.height)
+		{
+			const bool followsWindow{ std::any_of(m_Resources.begin(), m_Resources.end(), [](const Resource& _resource) {
+				return !_resource.m_VKBuffer && (_resource.m_Desc.m_Width == 0 || _resource.m_Desc.m_Height == 0); }) };
+
+			if (followsWindow)
+			{
+				// Images may still be used by a previous frame
+				vkDeviceWaitIdle(m_VKDeviceHandle->GetVKDevice());
+
+				DestroyImages();
+				CreateImages();
+				CreateRenderpasses();
+				ComputeBarriers();
+
+				for (const ImageBinding& binding : m_ImageBindings)
+					WriteImageBinding(binding);
+			}
+			m_WindowExtent = windowExtent;
+		}
+
+		const VkCommandBuffer vkCommandBuffer{ _cmdBuffer.GetVKCommandBuffer() };
+		m_BarrierBatchCount = 0;
+
+		for (Pass& pass : m_Passes)
+		{
+			if (pass.m_Culled) continue;
+
+			if (!pass.m_Barriers.IsEmpty())
+			{
+				pass.m_Barriers.Record(vkCommandBuffer);
+				++m_BarrierBatchCount;
+			}
+
+			// Graph barriers replace the ones a command buffer would insert, so passes continue the caller's command buffer
+			if (pass.m_Type == Minerva::RenderGraph::PassType::GRAPHICS)
+			{
+				Minerva::CommandBuffer commandBuffer{ std::make_shared<Minerva::Vulkan::CommandBuffer>(pass.m_VKRenderpass, vkCommandBuffer,
+					pass.m_VKRenderpass->GetFramebufferExtent(), 0, true) };
+				commandBuffer.GetVKCommandBufferHandle()->DisableResourceTracking();
+				pass.m_Function(commandBuffer);
+				pass.m_VKRenderpass->End(vkCommandBuffer, 0);
+			}
+			else
+			{
+				Minerva::CommandBuffer commandBuffer{ std::make_shared<Minerva::Vulkan::CommandBuffer>(nullptr, vkCommandBuffer, windowExtent, 0, true) };
+				commandBuffer.GetVKCommandBufferHandle()->DisableResourceTracking();
+				pass.m_Function(commandBuffer);
+			}
+		}
+
+		if (!m_FinalBarriers.IsEmpty())
+		{
+			m_FinalBarriers.Record(vkCommandBuffer);
+			++m_BarrierBatchCount;
+		}
+	}
+
+	RenderGraph::AccessInfo RenderGraph::GetAccessInfo(Minerva::RenderGraph::Access _access, Minerva::RenderGraph::PassType _passType, bool _depth)
+	{
+		using Access = Minerva::RenderGraph::Access;
+
+		// Shader accesses only wait for the stages of the pass type
+		const VkPipelineStageFlags shaderStages{
+			_passType == Minerva::RenderGraph::PassType::COMPUTE ? static_cast<VkPipelineStageFlags>(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT) :
+			_passType == Minerva::RenderGraph::PassType::GRAPHICS ? static_cast<VkPipelineStageFlags>(VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT) :
+			static_cast<VkPipelineStageFlags>(VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT) };
+
+		switch (_access)
+		{
+		case Access::COLOR_ATTACHMENT:
+			return AccessInfo{ VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+				{ VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT },
+				VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, true, false, true };
+		case Access::DEPTH_ATTACHMENT:
+			return AccessInfo{ VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+				{ VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT },
+				VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, true, false, true };
+		case Access::SAMPLED:
+			return AccessInfo{ _depth ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+				{ shaderStages, VK_ACCESS_SHADER_READ_BIT }, VK_IMAGE_USAGE_SAMPLED_BIT, false, false, false };
+		case Access::STORAGE_READ:
+			return AccessInfo{ VK_IMAGE_LAYOUT_GENERAL, { shaderStages, VK_ACCESS_SHADER_READ_BIT }, VK_IMAGE_USAGE_STORAGE_BIT, false, true, false };
+		case Access::STORAGE_WRITE:
+			return AccessInfo{ VK_IMAGE_LAYOUT_GENERAL, { shaderStages, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT }, VK_IMAGE_USAGE_STORAGE_BIT, true, true, false };
+		case Access::INDIRECT_READ:
+			return AccessInfo{ VK_IMAGE_LAYOUT_UNDEFINED, { VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT }, 0, false, true, false };
+		case Access::VERTEX_READ:
+			return AccessInfo{ VK_IMAGE_LAYOUT_UNDEFINED, { VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT }, 0, false, true, false };
+		case Access::TRANSFER_READ:
+			return AccessInfo{ VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, { VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT }, VK_IMAGE_USAGE_TRANSFER_SRC_BIT, false, true, false };
+		case Access::TRANSFER_WRITE:
+		default:
+			return AccessInfo{ VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, { VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT }, VK_IMAGE_USAGE_TRANSFER_DST_BIT, true, true, false };
+		}
+	}
+
+	bool RenderGraph::IsDepthFormat(VkFormat _format)
+	{
+		return _format == VK_FORMAT_D16_UNORM || _format == VK_FORMAT_X8_D24_UNORM_PACK32 || _format == VK_FORMAT_D32_SFLOAT;
+	}
+
+	void RenderGraph::ValidateDeclaration() const
+	{
+		if (m_Compiled)
+		{
+			Logger::Log_Error("Unable to change RenderGraph. Graph is already compiled.");
+			throw std::runtime_error("Unable to change RenderGraph. Graph is already compiled.");
+		}
+	}
+
+	void RenderGraph::CullPasses()
+	{
+		// Walking backwards, a pass is kept when it writes something needed later. Everything a kept pass touches becomes needed,
+		// attachments included, since a later pass may load what an earlier one rendered. Imported buffers are always needed
+		std::vector<uint8_t> needed(m_Resources.size(), 0);
+		for (size_t i{ 0 }; i < m_Resources.size(); ++i)
+			needed[i] = m_Resources[i].m_Output || m_Resources[i].m_VKBuffer;
+
+		for (size_t passIndex{ m_Passes.size() }; passIndex-- > 0;)
+		{
+			Pass& pass{ m_Passes[passIndex] };
+			pass.m_Culled = std::none_of(pass.m_Accesses.begin(), pass.m_Accesses.end(), [&](const PassAccess& _access) {
+				return needed[_access.m_Resource] && GetAccessInfo(_access.m_Access, pass.m_Type, false).m_Write; });
+
+			if (pass.m_Culled) continue;
+
+			for (const PassAccess& access : pass.m_Accesses)
+				needed[access.m_Resource] = 1;
+		}
+	}
+
+	void RenderGraph::CreateImages()
+	{
+		const VkDevice device{ m_VKDeviceHandle->GetVKDevice() };
+		m_WindowExtent = m_VKWindowHandle->GetVKSwapExtent();
+
+		std::vector<uint32_t> images;
+		for (uint32_t i{ 0 }; i < m_Resources.size(); ++i)
+		{
+			Resource& resource{ m_Resources[i] };
+			if (resource.m_VKBuffer || resource.m_FirstPass == UINT32_MAX) continue;
+
+			const bool followsWindow{ resource.m_Desc.m_Width == 0 || resource.m_Desc.m_Height == 0 };
+			resource.m_Extent = followsWindow ? m_WindowExtent : VkExtent2D{ resource.m_Desc.m_Width, resource.m_Desc.m_Height };
+
+			VkImageCreateInfo imageInfo{
+				.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+				.pNext = nullptr,
+				.flags = 0,
+				.imageType = VK_IMAGE_TYPE_2D,
+				.format = resource.m_Desc.m_Format,
+				.extent = { resource.m_Extent.width, resource.m_Extent.height, 1 },
+				.mipLevels = 1,
+				.arrayLayers = 1,
+				.samples = VK_SAMPLE_COUNT_1_BIT,
+				.tiling = VK_IMAGE_TILING_OPTIMAL,
+				.usage = resource.m_VKUsage,
+				.sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+				.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED
+			};
+
+			if (int vkErr{ vkCreateImage(device, &imageInfo, nullptr, &resource.m_VKImage) }; vkErr)
+			{
+				Logger::Log_Error("Unable to create RenderGraph image. vkCreateImage failed.");
+				throw std::runtime_error("Unable to create RenderGraph image. vkCreateImage failed.");
+			}
+
+			vkGetImageMemoryRequirements(device, resource.m_VKImage, &resource.m_VKMemoryRequirements);
+			images.push_back(i);
+		}
+
+		// Largest first, so smaller images fill blocks sized by larger ones. Every image is bound at offset 0 of its block,
+		// which satisfies any alignment
+		std::stable_sort(images.begin(), images.end(), [&](uint32_t _a, uint32_t _b) {
+			return m_Resources[_a].m_VKMemoryRequirements.size > m_Resources[_b].m_VKMemoryRequirements.size; });
+
+		for (uint32_t image : images)
+		{
+			Resource& resource{ m_Resources[image] };
+
+			// Transients share a block when the block's memory types fit and no occupant is alive at the same time
+			auto blockIt{ std::find_if(m_MemoryBlocks.begin(), m_MemoryBlocks.end(), [&](const MemoryBlock& _block) {
+				if (resource.m_Output || _block.m_Output || !(_block.m_MemoryTypeBits & resource.m_VKMemoryRequirements.memoryTypeBits))
+					return false;
+
+				return std::all_of(_block.m_Resources.begin(), _block.m_Resources.end(), [&](uint32_t _occupant) {
+					return resource.m_LastPass < m_Resources[_occupant].m_FirstPass || m_Resources[_occupant].m_LastPass < resource.m_FirstPass; });
+			}) };
+
+			if (blockIt == m_MemoryBlocks.end())
+			{
+				m_MemoryBlocks.push_back(MemoryBlock{ .m_MemoryTypeBits = resource.m_VKMemoryRequirements.memoryTypeBits, .m_Output = resource.m_Output });
+				blockIt = m_MemoryBlocks.end() - 1;
+			}
+
+			blockIt->m_Size = std::max(blockIt->m_Size, resource.m_VKMemoryRequirements.size);
+			blockIt->m_MemoryTypeBits &= resource.m_VKMemoryRequirements.memoryTypeBits;
+			blockIt->m_Resources.push_back(image);
+			resource.m_MemoryBlock = static_cast<uint32_t>(blockIt - m_MemoryBlocks.begin());
+		}
+
+		m_TransientMemorySize = 0;
+		for (MemoryBlock& block : m_MemoryBlocks)
+		{
+			VkMemoryAllocateInfo allocInfo{
+				.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+				.allocationSize = block.m_Size,
+				.memoryTypeIndex = FindMemoryType(block.m_MemoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
+			};
+
+			if (int vkErr{ vkAllocateMemory(device, &allocInfo, nullptr, &block.m_VKMemory) }; vkErr)
+			{
+				Logger::Log_Error("Unable to create RenderGraph image. vkAllocateMemory failed.");
+				throw std::runtime_error("Unable to create RenderGraph image. vkAllocateMemory failed.");
+			}
+
+			if (!block.m_Output)
+				m_TransientMemorySize += block.m_Size;
+
+			for (uint32_t image : block.m_Resources)
+			{
+				Resource& resource{ m_Resources[image] };
+				vkBindImageMemory(device, resource.m_VKImage, block.m_VKMemory, 0);
+
+				VkImageViewCreateInfo viewInfo{
+					.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+					.image = resource.m_VKImage,
+					.viewType = VK_IMAGE_VIEW_TYPE_2D,
+					.format = resource.m_Desc.m_Format,
+					.subresourceRange = {
+						static_cast<VkImageAspectFlags>(IsDepthFormat(resource.m_Desc.m_Format) ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT), 0, 1, 0, 1 }
+				};
+
+				if (int vkErr{ vkCreateImageView(device, &viewInfo, nullptr, &resource.m_VKImageView) }; vkErr)
+				{
+					Logger::Log_Error("Unable to create RenderGraph image. vkCreateImageView failed.");
+					throw std::runtime_error("Unable to create RenderGraph image. vkCreateImageView failed.");
+				}
+			}
+		}
+	}
+
+	void RenderGraph::DestroyImages()
+	{
+		const VkDevice device{ m_VKDeviceHandle->GetVKDevice() };
+
+		for (Resource& resource : m_Resources)
+		{
+			if (resource.m_VKImageView != VK_NULL_HANDLE)
+				vkDestroyImageView(device, resource.m_VKImageView, nullptr);
+			if (resource.m_VKImage != VK_NULL_HANDLE)
+				vkDestroyImage(device, resource.m_VKImage, nullptr);
+			resource.m_VKImageView = VK_NULL_HANDLE;
+			resource.m_VKImage = VK_NULL_HANDLE;
+			resource.m_MemoryBlock = UINT32_MAX;
+		}
+
+		for (MemoryBlock& block : m_MemoryBlocks)
+		{
+			if (block.m_VKMemory != VK_NULL_HANDLE)
+				vkFreeMemory(device, block.m_VKMemory, nullptr);
+		}
+		m_MemoryBlocks.clear();
+	}
+
+	void RenderGraph::CreateRenderpasses()
+	{
+		for (uint32_t passIndex{ 0 }; passIndex < m_Passes.size(); ++passIndex)
+		{
+			Pass& pass{ m_Passes[passIndex] };
+			if (pass.m_Culled || pass.m_Type != Minerva::RenderGraph::PassType::GRAPHICS) continue;
+
+			// Colors in declaration order, then depth
+			pass.m_Attachments.clear();
+			for (Minerva::RenderGraph::Access kind : { Minerva::RenderGraph::Access::COLOR_ATTACHMENT, Minerva::RenderGraph::Access::DEPTH_ATTACHMENT })
+			{
+				for (const PassAccess& access : pass.m_Accesses)
+				{
+					if (access.m_Access == kind)
+						pass.m_Attachments.push_back(access.m_Resource);
+				}
+			}
+
+			if (pass.m_Attachments.empty())
+			{
+				Logger::Log_Error("Unable to compile RenderGraph. Graphics pass has no attachment.");
+				throw std::runtime_error("Unable to compile RenderGraph. Graphics pass has no attachment.");
+			}
+
+			const VkExtent2D extent{ m_Resources[pass.m_Attachments[0]].m_Extent };
+			std::vector<Renderpass::AttachmentDescription> descriptions;
+			std::vector<VkImageView> views;
+
+			for (uint32_t attachment : pass.m_Attachments)
+			{
+				const Resource& resource{ m_Resources[attachment] };
+				if (resource.m_Extent.width != extent.width || resource.m_Extent.height != extent.height)
+				{
+					Logger::Log_Error("Unable to compile RenderGraph. Attachments of a graphics pass differ in size.");
+					throw std::runtime_error("Unable to compile RenderGraph. Attachments of a graphics pass differ in size.");
+				}
+
+				// The first user clears, contents are only stored when a later pass or the caller reads them
+				const bool depth{ IsDepthFormat(resource.m_Desc.m_Format) };
+				const glm::vec4& clearColor{ resource.m_Desc.m_ClearColor };
+				descriptions.push_back(Renderpass::AttachmentDescription{
+					.m_VKFormat = resource.m_Desc.m_Format,
+					.m_VKLoadOp = resource.m_FirstPass == passIndex ? VK_ATTACHMENT_LOAD_OP_CLEAR : VK_ATTACHMENT_LOAD_OP_LOAD,
+					.m_VKStoreOp = resource.m_LastPass > passIndex ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE,
+					.m_VKLayout = depth ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+					.m_VKClearValue = depth ? VkClearValue{ .depthStencil = { 1.f, 0 } } : VkClearValue{ .color = { { clearColor.r, clearColor.g, clearColor.b, clearColor.a } } },
+					.m_Depth = depth
+				});
+				views.push_back(resource.m_VKImageView);
+			}
+
+			// Pipelines created against the render pass stay valid, only the framebuffer follows resized images
+			if (pass.m_VKRenderpass)
+				pass.m_VKRenderpass->RecreateFramebuffer(views, extent);
+			else
+				pass.m_VKRenderpass = std::make_shared<Minerva::Vulkan::Renderpass>(m_VKDeviceHandle, descriptions, views, extent);
+		}
+	}
+
+	void RenderGraph::ComputeBarriers()
+	{
+		// Replays one frame, tracking the layout and the pending accesses of every resource
+		struct State
+		{
+			VkImageLayout m_VKLayout{ VK_IMAGE_LAYOUT_UNDEFINED };
+			BarrierBatch::SyncState m_Sync{};      // Accesses since the last barrier, all reads unless m_Write
+			BarrierBatch::SyncState m_LastWrite{}; // Most recent write, including writes recorded before Execute for buffers
+			BarrierBatch::SyncState m_Waited{};    // Stages and accesses already ordered after m_LastWrite
+			bool m_Write{ false };
+			bool m_Written{ false };               // Written by a pass of the graph
+			bool m_Touched{ false };
+		};
+
+		std::vector<State> states(m_Resources.size());
+
+		// Last accesses to each memory block, a new occupant waits for them before discarding the contents
+		std::vector<BarrierBatch::SyncState> blockSync(m_MemoryBlocks.size(), BarrierBatch::SyncState{ VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0 });
+
+		// Work recorded before Execute, e.g. uploads and culling, may have written imported buffers
+		const BarrierBatch::SyncState externalWrites{ VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT };
+
+		auto IsWaited = [](const State& _state, const BarrierBatch::SyncState& _sync)
+		{
+			return (_sync.m_VKStages & ~_state.m_Waited.m_VKStages) == 0 && (_sync.m_VKAccess & ~_state.m_Waited.m_VKAccess) == 0;
+		};
+
+		for (Pass& pass : m_Passes)
+		{
+			pass.m_Barriers.Clear();
+			if (pass.m_Culled) continue;
+
+			for (const PassAccess& access : pass.m_Accesses)
+			{
+				const Resource& resource{ m_Resources[access.m_Resource] };
+				const bool depth{ !resource.m_VKBuffer && IsDepthFormat(resource.m_Desc.m_Format) };
+				const AccessInfo info{ GetAccessInfo(access.m_Access, pass.m_Type, depth) };
+				const VkImageSubresourceRange range{ static_cast<VkImageAspectFlags>(depth ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT), 0, 1, 0, 1 };
+				State& state{ states[access.m_Resource] };
+
+				if (state.m_Touched && !state.m_Write && !info.m_Write && (resource.m_VKBuffer || state.m_VKLayout == info.m_VKLayout))
+				{
+					// Reads after reads in the same layout share the barrier that made the last write visible, unless they come from stages it did not cover
+					if (!state.m_LastWrite.IsEmpty() && !IsWaited(state, info.m_Sync))
+					{
+						if (resource.m_VKBuffer)
+							pass.m_Barriers.AddMemoryBarrier(state.m_LastWrite, info.m_Sync);
+						else
+							pass.m_Barriers.AddImageBarrier(resource.m_VKImage, range, state.m_VKLayout, state.m_VKLayout, state.m_LastWrite, info.m_Sync);
+						state.m_Waited.m_VKStages |= info.m_Sync.m_VKStages;
+						state.m_Waited.m_VKAccess |= info.m_Sync.m_VKAccess;
+					}
+
+					// Later writers wait for all of them
+					state.m_Sync.m_VKStages |= info.m_Sync.m_VKStages;
+					state.m_Sync.m_VKAccess |= info.m_Sync.m_VKAccess;
+				}
+				else
+				{
+					if (resource.m_VKBuffer)
+					{
+						pass.m_Barriers.AddMemoryBarrier(state.m_Touched ? state.m_Sync : externalWrites, info.m_Sync);
+						if (!state.m_Touched)
+							state.m_LastWrite = externalWrites;
+					}
+					else
+					{
+						// Contents are discarded on first use, every user either clears or fully writes the image
+						pass.m_Barriers.AddImageBarrier(resource.m_VKImage, range,
+							state.m_Touched ? state.m_VKLayout : VK_IMAGE_LAYOUT_UNDEFINED, info.m_VKLayout,
+							state.m_Touched ? state.m_Sync : blockSync[resource.m_MemoryBlock], info.m_Sync);
+						state.m_VKLayout = info.m_VKLayout;
+					}
+
+					// The barrier is chained after the last write, its destination has waited for it
+					state.m_Sync = info.m_Sync;
+					state.m_Waited = info.m_Sync;
+					state.m_Write = info.m_Write;
+					state.m_Touched = true;
+					if (info.m_Write)
+					{
+						state.m_LastWrite = info.m_Sync;
+						state.m_Waited = BarrierBatch::SyncState{};
+						state.m_Written = true;
+					}
+				}
+
+				if (!resource.m_VKBuffer)
+					blockSync[resource.m_MemoryBlock] = state.m_Sync;
+			}
+		}
+
+		// Outputs are sampled and imported buffers consumed after the graph. Consumers wait for the pending accesses and for the last
+		// write, which the last access may not have covered when it was a read
+		m_FinalBarriers.Clear();
+		for (uint32_t i{ 0 }; i < m_Resources.size(); ++i)
+		{
+			const Resource& resource{ m_Resources[i] };
+			const State& state{ states[i] };
+			if (!state.m_Touched) continue;
+
+			const BarrierBatch::SyncState source{
+				state.m_Sync.m_VKStages | (state.m_Written ? state.m_LastWrite.m_VKStages : 0),
+				state.m_Sync.m_VKAccess | (state.m_Written ? state.m_LastWrite.m_VKAccess : 0)
+			};
+
+			if (resource.m_Output)
+			{
+				const bool depth{ IsDepthFormat(resource.m_Desc.m_Format) };
+				const VkImageLayout finalLayout{ depth ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+				const BarrierBatch::SyncState destination{ VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT };
+				if (state.m_VKLayout == finalLayout && (!state.m_Written || (!state.m_Write && IsWaited(state, destination)))) continue;
+
+				m_FinalBarriers.AddImageBarrier(resource.m_VKImage,
+					VkImageSubresourceRange{ static_cast<VkImageAspectFlags>(depth ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT), 0, 1, 0, 1 },
+					state.m_VKLayout, finalLayout, source, destination);
+			}
+			else if (resource.m_VKBuffer && state.m_Written)
+			{
+				m_FinalBarriers.AddMemoryBarrier(source, BarrierBatch::SyncState{
+					VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
+					VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+					VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT });
+			}
+		}
+	}
+
+	void RenderGraph::WriteImageBinding(const ImageBinding& _binding)
+	{
+		const Resource& resource{ m_Resources[_binding.m_Resource] };
+		if (resource.m_VKImageView == VK_NULL_HANDLE)
+		{
+			Logger::Log_Error("Unable to bind RenderGraph image. Image is not used by any pass that was kept.");
+			throw std::runtime_error("Unable to bind RenderGraph image. Image is not used by any pass that was kept.");
+		}
+
+		const bool depth{ IsDepthFormat(resource.m_Desc.m_Format) };
+		const bool storage{ _binding.m_Layout.m_DescriptorType == Minerva::DescriptorSet::DescriptorType::STORAGE_IMAGE };
+
+		const std::array<VkDescriptorImageInfo, 1> imageInfos{ VkDescriptorImageInfo{
+			.sampler = depth ? m_VKNearestSampler : m_VKLinearSampler,
+			.imageView = resource.m_VKImageView,
+			.imageLayout = storage ? VK_IMAGE_LAYOUT_GENERAL : depth ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+		} };
+
+		_binding.m_VKDescriptorSet->Update(_binding.m_Layout, imageInfos);
+	}
+
+	uint32_t RenderGraph::FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties)
+	{
+		VkPhysicalDeviceMemoryProperties memProperties;
+		vkGetPhysicalDeviceMemoryProperties(m_VKDeviceHandle->GetVKPhysicalDevice(), &memProperties);
+
+		for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+			if ((typeFilter & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+				return i;
+			}
+		}
+
+		throw std::runtime_error("failed to find suitable memory type!");
+	}
+}
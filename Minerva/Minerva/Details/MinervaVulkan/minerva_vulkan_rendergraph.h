@@ -0,0 +1,123 @@
+#pragma once
+
+namespace Minerva::Vulkan
+{
+	// Backend of Minerva::RenderGraph. Passes are indexed in declaration order, which is also their execution order
+	class RenderGraph
+	{
+	public:
+		RenderGraph(std::shared_ptr<Minerva::Vulkan::Device> _device, std::shared_ptr<Minerva::Vulkan::Window> _window);
+		~RenderGraph();
+
+		uint32_t CreateImage(std::string_view _name, const Minerva::RenderGraph::ImageDesc& _desc);
+		uint32_t ImportBuffer(std::string_view _name, std::shared_ptr<Minerva::Vulkan::Buffer> _buffer);
+		uint32_t AddPass(std::string_view _name, Minerva::RenderGraph::PassType _type, Minerva::RenderGraph::ExecuteFunction _function);
+		void AddAccess(uint32_t _pass, uint32_t _resource, Minerva::RenderGraph::Access _access, bool _write);
+		void SetOutput(uint32_t _resource);
+		void Compile();
+
+		void BindImage(std::shared_ptr<Minerva::Vulkan::DescriptorSet> _descriptorSet, const Minerva::DescriptorSet::Layout& _layout, uint32_t _resource);
+		std::shared_ptr<Minerva::Vulkan::Renderpass> GetRenderpass(uint32_t _pass) const;
+
+		// Must be recorded outside of a render pass
+		void Execute(Minerva::Vulkan::CommandBuffer& _cmdBuffer);
+
+		inline bool IsPassCulled(uint32_t _pass) const { return _pass >= m_Passes.size() || m_Passes[_pass].m_Culled; }
+		inline VkDeviceSize GetTransientMemorySize() const { return m_TransientMemorySize; }
+		inline uint32_t GetBarrierBatchCount() const { return m_BarrierBatchCount; }
+
+	private:
+		// What an access does to a resource, see GetAccessInfo
+		struct AccessInfo
+		{
+			VkImageLayout m_VKLayout;
+			BarrierBatch::SyncState m_Sync;
+			VkImageUsageFlags m_VKUsage; // 0 for buffer only accesses
+			bool m_Write;
+			bool m_Buffer;               // Valid on buffers
+			bool m_Attachment;           // Graphics passes only
+		};
+
+		struct PassAccess
+		{
+			uint32_t m_Resource;
+			Minerva::RenderGraph::Access m_Access;
+		};
+
+		struct Pass
+		{
+			std::string m_Name;
+			Minerva::RenderGraph::PassType m_Type;
+			Minerva::RenderGraph::ExecuteFunction m_Function;
+			std::vector<PassAccess> m_Accesses;
+			bool m_Culled{ true };
+			std::shared_ptr<Minerva::Vulkan::Renderpass> m_VKRenderpass; // Graphics passes
+			std::vector<uint32_t> m_Attachments;                         // Colors, then depth
+			BarrierBatch m_Barriers;                                     // Recorded before the pass
+		};
+
+		struct Resource
+		{
+			std::string m_Name;
+			Minerva::RenderGraph::ImageDesc m_Desc{};
+			std::shared_ptr<Minerva::Vulkan::Buffer> m_VKBuffer; // Null for images
+			bool m_Output{ false };
+
+			// Compiled
+			uint32_t m_FirstPass{ UINT32_MAX };
+			uint32_t m_LastPass{ 0 };
+			VkImageUsageFlags m_VKUsage{ 0 };
+			VkExtent2D m_Extent{ 0, 0 };
+			VkMemoryRequirements m_VKMemoryRequirements{};
+			uint32_t m_MemoryBlock{ UINT32_MAX };
+			VkImage m_VKImage{ VK_NULL_HANDLE };
+			VkImageView m_VKImageView{ VK_NULL_HANDLE };
+		};
+
+		// Shared by images whose lifetimes do not overlap. Outputs own a block
+		struct MemoryBlock
+		{
+			VkDeviceMemory m_VKMemory{ VK_NULL_HANDLE };
+			VkDeviceSize m_Size{ 0 };
+			uint32_t m_MemoryTypeBits{ 0 };
+			bool m_Output{ false };
+			std::vector<uint32_t> m_Resources;
+		};
+
+		struct ImageBinding
+		{
+			std::shared_ptr<Minerva::Vulkan::DescriptorSet> m_VKDescriptorSet;
+			Minerva::DescriptorSet::Layout m_Layout;
+			uint32_t m_Resource;
+		};
+
+		std::shared_ptr<Minerva::Vulkan::Device> m_VKDeviceHandle;
+		std::shared_ptr<Minerva::Vulkan::Window> m_VKWindowHandle;
+
+		std::vector<Pass> m_Passes;
+		std::vector<Resource> m_Resources;
+		std::vector<MemoryBlock> m_MemoryBlocks;
+		std::vector<ImageBinding> m_ImageBindings;
+		BarrierBatch m_FinalBarriers; // Outputs to their shader read layout, written buffers to later readers
+		VkSampler m_VKLinearSampler;
+		VkSampler m_VKNearestSampler; // Depth formats may not support linear filtering
+		VkExtent2D m_WindowExtent;    // Extent window sized images were created with
+		VkDeviceSize m_TransientMemorySize;
+		uint32_t m_BarrierBatchCount;
+		bool m_Compiled;
+
+		// Helper functions
+		static AccessInfo GetAccessInfo(Minerva::RenderGraph::Access _access, Minerva::RenderGraph::PassType _passType, bool _depth);
+		static bool IsDepthFormat(VkFormat _format);
+		void ValidateDeclaration() const;
+		void CullPasses();
+		void CreateImages();
+		void DestroyImages();
+		void CreateRenderpasses();
+		void ComputeBarriers();
+		void WriteImageBinding(const ImageBinding& _binding);
+		uint32_t FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
+	};
+}
+
+#include "minerva_vulkan_rendergraph.cpp"
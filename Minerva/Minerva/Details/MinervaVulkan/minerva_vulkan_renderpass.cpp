@@ -1,63 +1,821 @@
 namespace Minerva::Vulkan
 {
-    Renderpass::Renderpass(std::shared_ptr<Minerva::Vulkan::Device> _device, std::shared_ptr<Minerva::Vulkan::Window> _window, float* _clearColor) :
-        m_VKDeviceHandle{ _device }, m_VKWindowHandle{ _window }, m_VKClearValue{ {_clearColor[0], _clearColor[1], _clearColor[2], _clearColor[3]} },
-        m_VKFramebufferExtent{ _window->GetVKSwapExtent() }
+    Renderpass::Renderpass(std::shared_ptr<Minerva::Vulkan::Device> _device, std::shared_ptr<Minerva::Vulkan::Window> _window, float* _clearColor, bool _depthAttachment, bool _stencil,
+        std::span<const VkFormat> _gbufferFormats, VkSampleCountFlagBits _samples) :
+        m_VKDeviceHandle{ _device }, m_VKWindowHandle{ _window }, m_VKRenderPass{ VK_NULL_HANDLE }, m_VKResumeRenderPass{ VK_NULL_HANDLE },
+        m_VKClearValues{ VkClearValue{ .color = { {_clearColor[0], _clearColor[1], _clearColor[2], _clearColor[3]} } } },
+        m_VKFramebufferExtent{ _window->GetVKSwapExtent() }, m_ColorAttachmentCount{ 1 }, m_VKColorFormats{ _window->GetVKImageFormat() },
+        m_DynamicRendering{ _device->IsDynamicRenderingEnabled() && _gbufferFormats.empty() }, // Subpasses need a render pass object
+        m_DepthAttachment{ _depthAttachment || !_gbufferFormats.empty() }, m_Stencil{ m_DepthAttachment && _stencil }, m_VKDepthFormat{ VK_FORMAT_UNDEFINED }, m_VKDepthImage{ VK_NULL_HANDLE },
+        m_VKDepthMemory{ VK_NULL_HANDLE }, m_VKDepthImageView{ VK_NULL_HANDLE }, m_VKDepthAttachmentView{ VK_NULL_HANDLE },
+        m_VKSamples{ _samples }, m_VKMSAAColorImage{ VK_NULL_HANDLE }, m_VKMSAAColorMemory{ VK_NULL_HANDLE }, m_VKMSAAColorImageView{ VK_NULL_HANDLE },
+        m_VKColorLoadOp{ VK_ATTACHMENT_LOAD_OP_CLEAR }, m_VKDepthLoadOp{ VK_ATTACHMENT_LOAD_OP_CLEAR }, m_VKDepthStoreOp{ VK_ATTACHMENT_STORE_OP_STORE },
+        m_Generation{ 0 }
 	{
-        // CREATE RENDERPASS
-        // Describe the color attachment
-        VkAttachmentDescription colorAttachmentDescription{
-        .format = _window->GetVKImageFormat(),
-        .samples = VK_SAMPLE_COUNT_1_BIT,
-        .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR, // Can be set to clear/not to clear
-        .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
-        .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
-        .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
-        .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-        .finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+        if (IsMultisampled())
+        {
+            if (!_gbufferFormats.empty())
+            {
+                Logger::Log_Error("Unable to create render pass. Deferred render passes are not multisampled.");
+                throw std::runtime_error("Unable to create render pass. Deferred render passes are not multisampled.");
+            }
+
+            VkPhysicalDeviceProperties deviceProperties;
+            vkGetPhysicalDeviceProperties(m_VKDeviceHandle->GetVKPhysicalDevice(), &deviceProperties);
+            const VkSampleCountFlags supported{ deviceProperties.limits.framebufferColorSampleCounts &
+                (m_DepthAttachment ? deviceProperties.limits.framebufferDepthSampleCounts : ~0u) };
+            if (!(supported & m_VKSamples))
+            {
+                Logger::Log_Error("Unable to create render pass. Sample count is not supported by the device.");
+                throw std::runtime_error("Unable to create render pass. Sample count is not supported by the device.");
+            }
+        }
+
+        if (m_DepthAttachment)
+        {
+            m_VKDepthFormat = FindDepthFormat();
+            m_VKClearValues.push_back(VkClearValue{ .depthStencil = { 1.f, 0 } });
+        }
+
+        // G-buffer attachments follow the color and depth ones, cleared to 0
+        m_GBuffer.reserve(_gbufferFormats.size());
+        for (VkFormat format : _gbufferFormats)
+        {
+            m_GBuffer.push_back(GBufferAttachment{ .m_VKFormat = format, .m_VKImage = VK_NULL_HANDLE, .m_VKMemory = VK_NULL_HANDLE, .m_VKImageView = VK_NULL_HANDLE });
+            m_VKClearValues.push_back(VkClearValue{ .color = { { 0.f, 0.f, 0.f, 0.f } } });
+        }
+
+        if (IsDeferred())
+            CreateDeferredRenderpass();
+        else
+            CreateRenderpass();
+        CreateDepthResources();
+        CreateGBufferResources();
+        CreateMSAAResources();
+        CreateFramebuffers();
+	}
+
+    Renderpass::Renderpass(std::shared_ptr<Minerva::Vulkan::Device> _device, std::span<const AttachmentDescription> _attachments, std::span<const VkImageView> _views, VkExtent2D _extent) :
+        m_VKDeviceHandle{ _device }, m_VKWindowHandle{ nullptr }, m_VKRenderPass{ VK_NULL_HANDLE }, m_VKResumeRenderPass{ VK_NULL_HANDLE },
+        m_VKFramebufferExtent{ _extent }, m_ColorAttachmentCount{ 0 }, m_OffscreenAttachments{ _attachments.begin(), _attachments.end() },
+        m_VKColorFormats{}, m_DynamicRendering{ _device->IsDynamicRenderingEnabled() },
+        m_DepthAttachment{ false }, m_Stencil{ false }, m_VKDepthFormat{ VK_FORMAT_UNDEFINED }, m_VKDepthImage{ VK_NULL_HANDLE },
+        m_VKDepthMemory{ VK_NULL_HANDLE }, m_VKDepthImageView{ VK_NULL_HANDLE }, m_VKDepthAttachmentView{ VK_NULL_HANDLE },
+        m_VKSamples{ VK_SAMPLE_COUNT_1_BIT }, m_VKMSAAColorImage{ VK_NULL_HANDLE }, m_VKMSAAColorMemory{ VK_NULL_HANDLE }, m_VKMSAAColorImageView{ VK_NULL_HANDLE },
+        m_VKColorLoadOp{ VK_ATTACHMENT_LOAD_OP_CLEAR }, m_VKDepthLoadOp{ VK_ATTACHMENT_LOAD_OP_CLEAR }, m_VKDepthStoreOp{ VK_ATTACHMENT_STORE_OP_STORE },
+        m_Generation{ 0 }
+    {
+        if (_attachments.size() != _views.size())
+        {
+            Logger::Log_Error("Unable to create render pass. Every attachment needs an image view.");
+            throw std::runtime_error("Unable to create render pass. Every attachment needs an image view.");
+        }
+
+        for (const AttachmentDescription& attachment : m_OffscreenAttachments)
+        {
+            if (attachment.m_Depth && m_DepthAttachment)
+            {
+                Logger::Log_Error("Unable to create render pass. More than one depth attachment.");
+                throw std::runtime_error("Unable to create render pass. More than one depth attachment.");
+            }
+
+            m_DepthAttachment |= attachment.m_Depth;
+            m_ColorAttachmentCount += attachment.m_Depth ? 0 : 1;
+            if (attachment.m_Depth)
+                m_VKDepthFormat = attachment.m_VKFormat;
+            else
+                m_VKColorFormats.push_back(attachment.m_VKFormat);
+            m_VKClearValues.push_back(attachment.m_VKClearValue);
+        }
+
+        CreateOffscreenRenderpass();
+        CreateOffscreenFramebuffer(_views);
+    }
+
+
+    Renderpass::~Renderpass()
+    {
+        CleanupRenderpass();
+    }
+
+    void Renderpass::CleanupRenderpass()
+    {
+        for (auto framebuffer : m_VKFramebuffers)
+        {
+            if (framebuffer != VK_NULL_HANDLE)
+                vkDestroyFramebuffer(m_VKDeviceHandle->GetVKDevice(), framebuffer, nullptr);
+        }
+        m_VKFramebuffers.clear();
+
+        // Offscreen render passes do not own their depth view
+        if (m_VKDepthImage != VK_NULL_HANDLE && m_VKDepthAttachmentView != VK_NULL_HANDLE && m_VKDepthAttachmentView != m_VKDepthImageView)
+            vkDestroyImageView(m_VKDeviceHandle->GetVKDevice(), m_VKDepthAttachmentView, nullptr);
+        if (m_VKDepthImage != VK_NULL_HANDLE && m_VKDepthImageView != VK_NULL_HANDLE)
+            vkDestroyImageView(m_VKDeviceHandle->GetVKDevice(), m_VKDepthImageView, nullptr);
+        if (m_VKDepthImage != VK_NULL_HANDLE)
+            vkDestroyImage(m_VKDeviceHandle->GetVKDevice(), m_VKDepthImage, nullptr);
+        if (m_VKDepthMemory != VK_NULL_HANDLE)
+            vkFreeMemory(m_VKDeviceHandle->GetVKDevice(), m_VKDepthMemory, nullptr);
+        m_VKDepthImageView = VK_NULL_HANDLE;
+        m_VKDepthAttachmentView = VK_NULL_HANDLE;
+        m_VKDepthImage = VK_NULL_HANDLE;
+        m_VKDepthMemory = VK_NULL_HANDLE;
+
+        for (GBufferAttachment& attachment : m_GBuffer)
+        {
+            if (attachment.m_VKImageView != VK_NULL_HANDLE)
+                vkDestroyImageView(m_VKDeviceHandle->GetVKDevice(), attachment.m_VKImageView, nullptr);
+            if (attachment.m_VKImage != VK_NULL_HANDLE)
+                vkDestroyImage(m_VKDeviceHandle->GetVKDevice(), attachment.m_VKImage, nullptr);
+            if (attachment.m_VKMemory != VK_NULL_HANDLE)
+                vkFreeMemory(m_VKDeviceHandle->GetVKDevice(), attachment.m_VKMemory, nullptr);
+            attachment.m_VKImageView = VK_NULL_HANDLE;
+            attachment.m_VKImage = VK_NULL_HANDLE;
+            attachment.m_VKMemory = VK_NULL_HANDLE;
+        }
+
+        if (m_VKMSAAColorImageView != VK_NULL_HANDLE)
+            vkDestroyImageView(m_VKDeviceHandle->GetVKDevice(), m_VKMSAAColorImageView, nullptr);
+        if (m_VKMSAAColorImage != VK_NULL_HANDLE)
+            vkDestroyImage(m_VKDeviceHandle->GetVKDevice(), m_VKMSAAColorImage, nullptr);
+        if (m_VKMSAAColorMemory != VK_NULL_HANDLE)
+            vkFreeMemory(m_VKDeviceHandle->GetVKDevice(), m_VKMSAAColorMemory, nullptr);
+        m_VKMSAAColorImageView = VK_NULL_HANDLE;
+        m_VKMSAAColorImage = VK_NULL_HANDLE;
+        m_VKMSAAColorMemory = VK_NULL_HANDLE;
+
+        // Owned by the device's RenderpassCache
+        m_VKRenderPass = VK_NULL_HANDLE;
+        m_VKResumeRenderPass = VK_NULL_HANDLE;
+    }
+
+    void Renderpass::RecreateRenderpass()
+    {
+        if (IsOffscreen())
+        {
+            Logger::Log_Error("Unable to recreate render pass. Offscreen render passes are recreated through RecreateFramebuffer.");
+            throw std::runtime_error("Unable to recreate render pass. Offscreen render passes are recreated through RecreateFramebuffer.");
+        }
+
+        // With dynamic rendering only the depth image follows the new size
+        m_VKFramebufferExtent = m_VKWindowHandle->GetVKSwapExtent();
+        m_VKColorFormats[0] = m_VKWindowHandle->GetVKImageFormat();
+        ++m_Generation;
+
+        if (IsDeferred())
+            CreateDeferredRenderpass();
+        else
+            CreateRenderpass();
+        CreateDepthResources();
+        CreateGBufferResources();
+        CreateMSAAResources();
+        CreateFramebuffers();
+
+        // Views changed, descriptors reading them are rewritten
+        std::erase_if(m_RecreateCallbacks, [this](const RecreateCallback& _callback) { return !_callback.m_Callback(*this); });
+    }
+
+    void Renderpass::SetColorLoadOp(VkAttachmentLoadOp _loadOp)
+    {
+        ValidateWindowOps(_loadOp);
+        m_VKColorLoadOp = _loadOp;
+        UpdateRenderpass();
+    }
+
+    void Renderpass::SetDepthOps(VkAttachmentLoadOp _loadOp, VkAttachmentStoreOp _storeOp)
+    {
+        ValidateWindowOps(_loadOp);
+        if (!m_DepthAttachment)
+        {
+            Logger::Log_Error("Unable to set depth operations. Render pass has no depth attachment.");
+            throw std::runtime_error("Unable to set depth operations. Render pass has no depth attachment.");
+        }
+
+        m_VKDepthLoadOp = _loadOp;
+        m_VKDepthStoreOp = _storeOp;
+        UpdateRenderpass();
+    }
+
+    void Renderpass::SetClearColor(const float* _clearColor)
+    {
+        if (IsOffscreen())
+        {
+            Logger::Log_Error("Unable to set clear color. Offscreen render passes take it from their attachment descriptions.");
+            throw std::runtime_error("Unable to set clear color. Offscreen render passes take it from their attachment descriptions.");
+        }
+
+        m_VKClearValues[0] = VkClearValue{ .color = { { _clearColor[0], _clearColor[1], _clearColor[2], _clearColor[3] } } };
+    }
+
+    void Renderpass::SetClearDepth(float _depth, uint32_t _stencil)
+    {
+        if (!m_DepthAttachment || IsOffscreen())
+        {
+            Logger::Log_Error("Unable to set depth clear value. Render pass has no depth attachment.");
+            throw std::runtime_error("Unable to set depth clear value. Render pass has no depth attachment.");
+        }
+
+        m_VKClearValues[1] = VkClearValue{ .depthStencil = { _depth, _stencil } };
+    }
+
+    void Renderpass::ValidateWindowOps(VkAttachmentLoadOp _loadOp) const
+    {
+        // Offscreen passes get their operations per attachment, from their AttachmentDescriptions
+        if (IsOffscreen())
+        {
+            Logger::Log_Error("Unable to set attachment operations. Offscreen render passes take them from their attachment descriptions.");
+            throw std::runtime_error("Unable to set attachment operations. Offscreen render passes take them from their attachment descriptions.");
+        }
+
+        // Nothing is preserved for the first pass of a frame: the acquired image and the depth start UNDEFINED
+        if (_loadOp == VK_ATTACHMENT_LOAD_OP_LOAD)
+        {
+            Logger::Log_Error("Unable to set attachment operations. Window attachments are cleared or not loaded, use ResumeRenderpass to continue them.");
+            throw std::runtime_error("Unable to set attachment operations. Window attachments are cleared or not loaded, use ResumeRenderpass to continue them.");
+        }
+    }
+
+    void Renderpass::UpdateRenderpass()
+    {
+        // Render passes differing only in their operations are compatible, so framebuffers and pipelines are kept.
+        // The previous VkRenderPass stays alive in the cache for command buffers still in flight
+        if (m_DynamicRendering) return;
+
+        if (IsDeferred())
+            CreateDeferredRenderpass();
+        else
+            CreateRenderpass();
+    }
+
+    void Renderpass::AddRecreateCallback(const void* _owner, uint32_t _binding, std::function<bool(const Renderpass&)> _callback)
+    {
+        // Rewriting the same binding again replaces its callback instead of adding one per update
+        auto it{ std::find_if(m_RecreateCallbacks.begin(), m_RecreateCallbacks.end(),
+            [_owner, _binding](const RecreateCallback& _entry) { return _entry.m_Owner == _owner && _entry.m_Binding == _binding; }) };
+        if (it != m_RecreateCallbacks.end())
+            it->m_Callback = std::move(_callback);
+        else
+            m_RecreateCallbacks.push_back(RecreateCallback{ .m_Owner = _owner, .m_Binding = _binding, .m_Callback = std::move(_callback) });
+    }
+
+    VkDescriptorImageInfo Renderpass::GetVKInputAttachmentInfo(uint32_t _attachment) const
+    {
+        if (!IsDeferred())
+        {
+            Logger::Log_Error("Unable to get input attachment. Render pass is not deferred.");
+            throw std::runtime_error("Unable to get input attachment. Render pass is not deferred.");
+        }
+
+        if (_attachment > m_GBuffer.size())
+        {
+            Logger::Log_Error("Unable to get input attachment. Render pass has no such G-buffer attachment.");
+            throw std::runtime_error("Unable to get input attachment. Render pass has no such G-buffer attachment.");
+        }
+
+        // Layouts of the lighting subpass' input attachment references
+        if (_attachment == m_GBuffer.size())
+            return VkDescriptorImageInfo{ .sampler = VK_NULL_HANDLE, .imageView = m_VKDepthImageView, .imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL };
+        return VkDescriptorImageInfo{ .sampler = VK_NULL_HANDLE, .imageView = m_GBuffer[_attachment].m_VKImageView, .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+    }
+
+    void Renderpass::Begin(VkCommandBuffer _commandBuffer, int _index, VkSubpassContents _contents, bool _resume) const
+    {
+        if (!m_DynamicRendering)
+        {
+            // The resume pass loads every attachment, nothing is cleared
+            VkRenderPassBeginInfo renderPassInfo{
+                .sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+                .pNext = nullptr,
+                .renderPass = _resume ? m_VKResumeRenderPass : m_VKRenderPass,
+                .framebuffer = m_VKFramebuffers[_index],
+                .renderArea = { { 0, 0 }, m_VKFramebufferExtent },
+                .clearValueCount = _resume ? 0u : static_cast<uint32_t>(m_VKClearValues.size()),
+                .pClearValues = _resume ? nullptr : m_VKClearValues.data()
+            };
+
+            vkCmdBeginRenderPass(_commandBuffer, &renderPassInfo, _contents);
+            return;
+        }
+
+        std::vector<VkRenderingAttachmentInfoKHR> colorAttachments;
+        VkRenderingAttachmentInfoKHR depthAttachment{};
+        colorAttachments.reserve(m_ColorAttachmentCount);
+
+        if (IsOffscreen())
+        {
+            // Offscreen attachments stay in their layout, the owner synchronizes them
+            for (size_t i{ 0 }; i < m_OffscreenAttachments.size(); ++i)
+            {
+                const AttachmentDescription& attachment{ m_OffscreenAttachments[i] };
+                const VkRenderingAttachmentInfoKHR attachmentInfo{
+                    .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR,
+                    .imageView = m_VKOffscreenViews[i],
+                    .imageLayout = attachment.m_VKLayout,
+                    .resolveMode = VK_RESOLVE_MODE_NONE,
+                    .loadOp = attachment.m_VKLoadOp,
+                    .storeOp = attachment.m_VKStoreOp,
+                    .clearValue = attachment.m_VKClearValue
+                };
+
+                if (attachment.m_Depth)
+                    depthAttachment = attachmentInfo;
+                else
+                    colorAttachments.push_back(attachmentInfo);
+            }
+        }
+        else
+        {
+            // Same transitions and dependencies as the render pass: the swapchain image is presented after the pass,
+            // the depth is left readable and its earlier readers finish before it is written again
+            BarrierBatch barriers;
+            barriers.AddImageBarrier(m_VKWindowHandle->GetVKSwapImages()[_index], { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 },
+                _resume ? VK_IMAGE_LAYOUT_PRESENT_SRC_KHR : VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT },
+                { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT });
+            if (m_DepthAttachment)
+            {
+                barriers.AddImageBarrier(m_VKDepthImage, { static_cast<VkImageAspectFlags>(m_Stencil ? VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT : VK_IMAGE_ASPECT_DEPTH_BIT), 0, 1, 0, 1 },
+                    _resume ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                    { VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT },
+                    { VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT });
+            }
+            // Multisampled contents are discarded every frame, so the transient image starts from UNDEFINED
+            if (IsMultisampled())
+            {
+                barriers.AddImageBarrier(m_VKMSAAColorImage, { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 },
+                    VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                    { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT },
+                    { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT });
+            }
+            barriers.Record(_commandBuffer);
+
+            // Multisampled passes are never resumed, see CommandBuffer::SuspendRenderpass
+            const VkAttachmentLoadOp loadOp{ _resume ? VK_ATTACHMENT_LOAD_OP_LOAD : m_VKColorLoadOp };
+            const VkAttachmentStoreOp storeOp{ IsMultisampled() ? VK_ATTACHMENT_STORE_OP_DONT_CARE : VK_ATTACHMENT_STORE_OP_STORE };
+            colorAttachments.push_back(VkRenderingAttachmentInfoKHR{
+                .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR,
+                .imageView = IsMultisampled() ? m_VKMSAAColorImageView : m_VKWindowHandle->GetVKSwapImageViews()[_index],
+                .imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                .resolveMode = IsMultisampled() ? VK_RESOLVE_MODE_AVERAGE_BIT : VK_RESOLVE_MODE_NONE,
+                .resolveImageView = IsMultisampled() ? m_VKWindowHandle->GetVKSwapImageViews()[_index] : VK_NULL_HANDLE,
+                .resolveImageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                .loadOp = loadOp,
+                .storeOp = storeOp,
+                .clearValue = m_VKClearValues[0]
+            });
+
+            if (m_DepthAttachment)
+            {
+                depthAttachment = VkRenderingAttachmentInfoKHR{
+                    .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR,
+                    .imageView = m_VKDepthAttachmentView,
+                    .imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                    .resolveMode = VK_RESOLVE_MODE_NONE,
+                    .loadOp = _resume ? VK_ATTACHMENT_LOAD_OP_LOAD : m_VKDepthLoadOp,
+                    .storeOp = IsMultisampled() ? VK_ATTACHMENT_STORE_OP_DONT_CARE : m_VKDepthStoreOp,
+                    .clearValue = m_VKClearValues[1]
+                };
+            }
+        }
+
+        // The stencil aspect shares the depth attachment's view and operations
+        const VkRenderingInfoKHR renderingInfo{
+            .sType = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR,
+            .pNext = nullptr,
+            .flags = _contents == VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS ? static_cast<VkRenderingFlagsKHR>(VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT_KHR) : 0u,
+            .renderArea = { { 0, 0 }, m_VKFramebufferExtent },
+            .layerCount = 1,
+            .viewMask = 0,
+            .colorAttachmentCount = static_cast<uint32_t>(colorAttachments.size()),
+            .pColorAttachments = colorAttachments.data(),
+            .pDepthAttachment = m_DepthAttachment ? &depthAttachment : nullptr,
+            .pStencilAttachment = m_Stencil ? &depthAttachment : nullptr
         };
 
-        // Color attachment binding point/reference
-        VkAttachmentReference colorAttachmentRef{
-            .attachment = 0, // Index bound to color attachment
-            .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
+        m_VKDeviceHandle->CmdBeginRendering(_commandBuffer, renderingInfo);
+    }
+
+    void Renderpass::End(VkCommandBuffer _commandBuffer, int _index) const
+    {
+        if (!m_DynamicRendering)
+        {
+            vkCmdEndRenderPass(_commandBuffer);
+            return;
+        }
+
+        m_VKDeviceHandle->CmdEndRendering(_commandBuffer);
+        if (IsOffscreen()) return;
+
+        // Final layouts of the render pass. Depth written by the pass is read by compute or fragment shaders afterwards
+        BarrierBatch barriers;
+        barriers.AddImageBarrier(m_VKWindowHandle->GetVKSwapImages()[_index], { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 },
+            VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+            { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT },
+            { VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0 });
+        if (m_DepthAttachment && !IsMultisampled())
+        {
+            barriers.AddImageBarrier(m_VKDepthImage, { static_cast<VkImageAspectFlags>(m_Stencil ? VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT : VK_IMAGE_ASPECT_DEPTH_BIT), 0, 1, 0, 1 },
+                VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
+                { VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT },
+                { VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT });
+        }
+        barriers.Record(_commandBuffer);
+    }
+
+    void Renderpass::CreateRenderpass()
+    {
+        if (m_DynamicRendering) return;
+
+        // CREATE RENDERPASS
+        // The first pass of a frame clears its attachments, the resume pass continues from their contents.
+        // Both only differ in load ops and initial layouts, so they share framebuffers and pipelines
+        for (bool resume : { false, true })
+        {
+            // Transient multisampled attachments hold nothing to resume from
+            if (resume && IsMultisampled()) continue;
+
+            // Describe the color attachment. Multisampled color is discarded once resolved
+            const bool multisampled{ IsMultisampled() };
+            VkAttachmentDescription colorAttachmentDescription{
+            .format = m_VKWindowHandle->GetVKImageFormat(),
+            .samples = m_VKSamples,
+            .loadOp = resume ? VK_ATTACHMENT_LOAD_OP_LOAD : m_VKColorLoadOp,
+            .storeOp = multisampled ? VK_ATTACHMENT_STORE_OP_DONT_CARE : VK_ATTACHMENT_STORE_OP_STORE,
+            .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+            .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+            .initialLayout = resume ? VK_IMAGE_LAYOUT_PRESENT_SRC_KHR : VK_IMAGE_LAYOUT_UNDEFINED,
+            .finalLayout = multisampled ? VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+            };
+
+            // Depth is stored so it can be read after the pass, unless it is multisampled
+            VkAttachmentDescription depthAttachmentDescription{
+            .format = m_VKDepthFormat,
+            .samples = m_VKSamples,
+            .loadOp = resume ? VK_ATTACHMENT_LOAD_OP_LOAD : m_VKDepthLoadOp,
+            .storeOp = multisampled ? VK_ATTACHMENT_STORE_OP_DONT_CARE : m_VKDepthStoreOp,
+            .stencilLoadOp = !m_Stencil ? VK_ATTACHMENT_LOAD_OP_DONT_CARE : resume ? VK_ATTACHMENT_LOAD_OP_LOAD : m_VKDepthLoadOp,
+            .stencilStoreOp = m_Stencil && !multisampled ? m_VKDepthStoreOp : VK_ATTACHMENT_STORE_OP_DONT_CARE,
+            .initialLayout = resume ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED,
+            .finalLayout = multisampled ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL
+            };
+
+            // The swapchain image is only written by the resolve
+            VkAttachmentDescription resolveAttachmentDescription{
+            .format = m_VKWindowHandle->GetVKImageFormat(),
+            .samples = VK_SAMPLE_COUNT_1_BIT,
+            .loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+            .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
+            .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+            .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+            .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+            .finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+            };
+
+            // Color, optional depth, resolve when multisampled
+            std::vector<VkAttachmentDescription> attachments{ colorAttachmentDescription };
+            if (m_DepthAttachment)
+                attachments.push_back(depthAttachmentDescription);
+            if (multisampled)
+                attachments.push_back(resolveAttachmentDescription);
+
+            // Color attachment binding point/reference
+            VkAttachmentReference colorAttachmentRef{
+                .attachment = 0, // Index bound to color attachment
+                .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
+            };
+
+            VkAttachmentReference depthAttachmentRef{
+                .attachment = 1,
+                .layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
+            };
+
+            VkAttachmentReference resolveAttachmentRef{
+                .attachment = static_cast<uint32_t>(attachments.size() - 1),
+                .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
+            };
+
+            // Description of subpass -> Render pass must have at least 1 subpass. The color is resolved at its end
+            VkSubpassDescription subpassDesc{
+                .pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS,
+                .colorAttachmentCount = 1,
+                .pColorAttachments = &colorAttachmentRef,
+                .pResolveAttachments = multisampled ? &resolveAttachmentRef : nullptr,
+                .pDepthStencilAttachment = m_DepthAttachment ? &depthAttachmentRef : nullptr
+            };
+
+            // Subpass dependencies
+            // Attachment writes of an earlier pass (or its suspended part) and compute reads of the depth must complete before this pass writes
+            std::array<VkSubpassDependency, 2> dependencies{
+                VkSubpassDependency{
+                .srcSubpass = VK_SUBPASS_EXTERNAL,
+                .dstSubpass = 0,
+                .srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                .dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                .srcAccessMask = m_DepthAttachment ? static_cast<VkAccessFlags>(VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT) : 0u,
+                .dstAccessMask = m_DepthAttachment ? static_cast<VkAccessFlags>(VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                    VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT) : static_cast<VkAccessFlags>(VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT),
+                },
+                // Depth written by the pass is read by compute afterwards
+                VkSubpassDependency{
+                .srcSubpass = 0,
+                .dstSubpass = VK_SUBPASS_EXTERNAL,
+                .srcStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                .dstStageMask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                .srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                .dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
+                }
+            };
+
+            // Describe render pass
+            VkRenderPassCreateInfo renderPassInfo{
+            .sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
+            .attachmentCount = static_cast<uint32_t>(attachments.size()),
+            .pAttachments = attachments.data(), // pointer to container of attachments
+            .subpassCount = 1, // At least 1 subpass
+            .pSubpasses = &subpassDesc, // pointer to array of subpass descriptions
+            .dependencyCount = m_DepthAttachment && !multisampled ? 2u : 1u,
+            .pDependencies = dependencies.data()
+            };
+
+            // Get Render Pass, shared with every pass described the same way
+            (resume ? m_VKResumeRenderPass : m_VKRenderPass) = m_VKDeviceHandle->GetRenderpassCache().GetRenderPass(m_VKDeviceHandle->GetVKDevice(), renderPassInfo);
+        }
+    }
+
+    void Renderpass::CreateDeferredRenderpass()
+    {
+        // Attachments: 0 window color, 1 depth, then the G-buffer. The G-buffer subpass writes the G-buffer and depth, the lighting
+        // subpass reads both as input attachments at the same pixel and writes the window. The G-buffer is cleared and never stored,
+        // so tile-based GPUs resolve the whole pass in tile memory
+        std::vector<VkAttachmentDescription> attachments{
+            VkAttachmentDescription{
+            .format = m_VKWindowHandle->GetVKImageFormat(),
+            .samples = VK_SAMPLE_COUNT_1_BIT,
+            .loadOp = m_VKColorLoadOp,
+            .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
+            .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+            .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+            .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+            .finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+            },
+            // Depth is still stored, e.g. for a depth pyramid
+            VkAttachmentDescription{
+            .format = m_VKDepthFormat,
+            .samples = VK_SAMPLE_COUNT_1_BIT,
+            .loadOp = m_VKDepthLoadOp,
+            .storeOp = m_VKDepthStoreOp,
+            .stencilLoadOp = m_Stencil ? m_VKDepthLoadOp : VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+            .stencilStoreOp = m_Stencil ? m_VKDepthStoreOp : VK_ATTACHMENT_STORE_OP_DONT_CARE,
+            .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+            .finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL
+            }
         };
 
-        // Description of subpass -> Render pass must have at least 1 subpass
-        VkSubpassDescription subpassDesc{
+        std::vector<VkAttachmentReference> gbufferRefs;
+        std::vector<VkAttachmentReference> inputRefs;
+        for (const GBufferAttachment& gbuffer : m_GBuffer)
+        {
+            const uint32_t index{ static_cast<uint32_t>(attachments.size()) };
+            attachments.push_back(VkAttachmentDescription{
+                .format = gbuffer.m_VKFormat,
+                .samples = VK_SAMPLE_COUNT_1_BIT,
+                .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+                .storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+                .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+                .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+                .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+                .finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+            });
+            gbufferRefs.push_back(VkAttachmentReference{ .attachment = index, .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL });
+            inputRefs.push_back(VkAttachmentReference{ .attachment = index, .layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL });
+        }
+        inputRefs.push_back(VkAttachmentReference{ .attachment = 1, .layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL });
+
+        const VkAttachmentReference colorAttachmentRef{ .attachment = 0, .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
+        const VkAttachmentReference depthAttachmentRef{ .attachment = 1, .layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL };
+
+        std::array<VkSubpassDescription, 2> subpasses{
+            VkSubpassDescription{
+            .pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS,
+            .colorAttachmentCount = static_cast<uint32_t>(gbufferRefs.size()),
+            .pColorAttachments = gbufferRefs.data(),
+            .pDepthStencilAttachment = &depthAttachmentRef
+            },
+            VkSubpassDescription{
             .pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS,
+            .inputAttachmentCount = static_cast<uint32_t>(inputRefs.size()),
+            .pInputAttachments = inputRefs.data(),
             .colorAttachmentCount = 1,
-            .pColorAttachments = &colorAttachmentRef
+            .pColorAttachments = &colorAttachmentRef,
+            .pDepthStencilAttachment = nullptr
+            }
         };
 
-        // Subpass dependencies
-        VkSubpassDependency dependency{
-        .srcSubpass = VK_SUBPASS_EXTERNAL,
-        .dstSubpass = 0,
-        .srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT,
-        .dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT,
-        .srcAccessMask = 0,
-        .dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+        std::array<VkSubpassDependency, 4> dependencies{
+            // Earlier attachment writes and compute reads of the depth complete before the G-buffer subpass writes
+            VkSubpassDependency{
+            .srcSubpass = VK_SUBPASS_EXTERNAL,
+            .dstSubpass = GBUFFER_SUBPASS,
+            .srcStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            .dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+            .srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+            },
+            // The acquired window image is written by the lighting subpass
+            VkSubpassDependency{
+            .srcSubpass = VK_SUBPASS_EXTERNAL,
+            .dstSubpass = LIGHTING_SUBPASS,
+            .srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+            .dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+            .srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+            },
+            // Per pixel: lighting reads only the G-buffer texel it shades, so the dependency is by region and stays on chip
+            VkSubpassDependency{
+            .srcSubpass = GBUFFER_SUBPASS,
+            .dstSubpass = LIGHTING_SUBPASS,
+            .srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+            .dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+            .srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_INPUT_ATTACHMENT_READ_BIT,
+            .dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT
+            },
+            // Depth written by the pass is read by compute afterwards
+            VkSubpassDependency{
+            .srcSubpass = GBUFFER_SUBPASS,
+            .dstSubpass = VK_SUBPASS_EXTERNAL,
+            .srcStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+            .dstStageMask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+            .srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
+            }
         };
 
-        // Describe render pass
         VkRenderPassCreateInfo renderPassInfo{
-        .sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
-        .attachmentCount = 1, // Only color
-        .pAttachments = &colorAttachmentDescription, // pointer to container of attachments
-        .subpassCount = 1, // At least 1 subpass
-        .pSubpasses = &subpassDesc, // pointer to array of subpass descriptions
-        .dependencyCount = 1,
-        .pDependencies = &dependency
+            .sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
+            .attachmentCount = static_cast<uint32_t>(attachments.size()),
+            .pAttachments = attachments.data(),
+            .subpassCount = static_cast<uint32_t>(subpasses.size()),
+            .pSubpasses = subpasses.data(),
+            .dependencyCount = static_cast<uint32_t>(dependencies.size()),
+            .pDependencies = dependencies.data()
         };
 
-        // Create Render Pass
-        if (auto VkErr{ vkCreateRenderPass(m_VKDeviceHandle->GetVKDevice(), &renderPassInfo, nullptr, &m_VKRenderPass)}; VkErr)
+        // The G-buffer does not survive a suspension, so deferred passes have no resume pass
+        m_VKRenderPass = m_VKDeviceHandle->GetRenderpassCache().GetRenderPass(m_VKDeviceHandle->GetVKDevice(), renderPassInfo);
+    }
+
+    void Renderpass::CreateDepthResources()
+    {
+        if (!m_DepthAttachment) return;
+
+        // Sampled as well, so the depth can be read once the pass ends. Multisampled depth never leaves the pass
+        const VkImageUsageFlags usage{ IsMultisampled() ? static_cast<VkImageUsageFlags>(VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT)
+            : static_cast<VkImageUsageFlags>(VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | (IsDeferred() ? VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT : 0)) };
+        VkImageCreateInfo imageInfo{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = 0,
+            .imageType = VK_IMAGE_TYPE_2D,
+            .format = m_VKDepthFormat,
+            .extent = { m_VKFramebufferExtent.width, m_VKFramebufferExtent.height, 1 },
+            .mipLevels = 1,
+            .arrayLayers = 1,
+            .samples = m_VKSamples,
+            .tiling = VK_IMAGE_TILING_OPTIMAL,
+            .usage = usage,
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+            .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED
+        };
+
+        if (int vkErr{ vkCreateImage(m_VKDeviceHandle->GetVKDevice(), &imageInfo, nullptr, &m_VKDepthImage) }; vkErr)
         {
-            Logger::Log_Error("Unable to create render pass. vkCreateRenderPass failed.");
-            throw std::runtime_error("Unable to create render pass. vkCreateRenderPass failed.");
+            Logger::Log_Error("Unable to create depth attachment. vkCreateImage failed.");
+            throw std::runtime_error("Unable to create depth attachment. vkCreateImage failed.");
         }
 
+        m_VKDepthMemory = AllocateImageMemory(m_VKDepthImage, IsMultisampled());
+
+        VkImageViewCreateInfo viewInfo{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+            .image = m_VKDepthImage,
+            .viewType = VK_IMAGE_VIEW_TYPE_2D,
+            .format = m_VKDepthFormat,
+            .subresourceRange = { VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, 0, 1 }
+        };
+
+        if (int vkErr{ vkCreateImageView(m_VKDeviceHandle->GetVKDevice(), &viewInfo, nullptr, &m_VKDepthImageView) }; vkErr)
+        {
+            Logger::Log_Error("Unable to create depth attachment. vkCreateImageView failed.");
+            throw std::runtime_error("Unable to create depth attachment. vkCreateImageView failed.");
+        }
+
+        // Framebuffers need both aspects of a depth/stencil image, samplers only accept one
+        m_VKDepthAttachmentView = m_VKDepthImageView;
+        if (m_Stencil)
+        {
+            viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+            if (int vkErr{ vkCreateImageView(m_VKDeviceHandle->GetVKDevice(), &viewInfo, nullptr, &m_VKDepthAttachmentView) }; vkErr)
+            {
+                Logger::Log_Error("Unable to create depth attachment. vkCreateImageView failed.");
+                throw std::runtime_error("Unable to create depth attachment. vkCreateImageView failed.");
+            }
+        }
+    }
+
+    void Renderpass::CreateGBufferResources()
+    {
+        for (GBufferAttachment& attachment : m_GBuffer)
+        {
+            VkImageCreateInfo imageInfo{
+                .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+                .pNext = nullptr,
+                .flags = 0,
+                .imageType = VK_IMAGE_TYPE_2D,
+                .format = attachment.m_VKFormat,
+                .extent = { m_VKFramebufferExtent.width, m_VKFramebufferExtent.height, 1 },
+                .mipLevels = 1,
+                .arrayLayers = 1,
+                .samples = VK_SAMPLE_COUNT_1_BIT,
+                .tiling = VK_IMAGE_TILING_OPTIMAL,
+                .usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT,
+                .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+                .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED
+            };
+
+            if (int vkErr{ vkCreateImage(m_VKDeviceHandle->GetVKDevice(), &imageInfo, nullptr, &attachment.m_VKImage) }; vkErr)
+            {
+                Logger::Log_Error("Unable to create G-buffer attachment. vkCreateImage failed.");
+                throw std::runtime_error("Unable to create G-buffer attachment. vkCreateImage failed.");
+            }
+
+            attachment.m_VKMemory = AllocateImageMemory(attachment.m_VKImage, true);
+
+            VkImageViewCreateInfo viewInfo{
+                .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+                .image = attachment.m_VKImage,
+                .viewType = VK_IMAGE_VIEW_TYPE_2D,
+                .format = attachment.m_VKFormat,
+                .subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 }
+            };
+
+            if (int vkErr{ vkCreateImageView(m_VKDeviceHandle->GetVKDevice(), &viewInfo, nullptr, &attachment.m_VKImageView) }; vkErr)
+            {
+                Logger::Log_Error("Unable to create G-buffer attachment. vkCreateImageView failed.");
+                throw std::runtime_error("Unable to create G-buffer attachment. vkCreateImageView failed.");
+            }
+        }
+    }
+
+    void Renderpass::CreateMSAAResources()
+    {
+        if (!IsMultisampled()) return;
+
+        // Only ever an attachment, the swapchain image receives the resolved color
+        VkImageCreateInfo imageInfo{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = 0,
+            .imageType = VK_IMAGE_TYPE_2D,
+            .format = m_VKWindowHandle->GetVKImageFormat(),
+            .extent = { m_VKFramebufferExtent.width, m_VKFramebufferExtent.height, 1 },
+            .mipLevels = 1,
+            .arrayLayers = 1,
+            .samples = m_VKSamples,
+            .tiling = VK_IMAGE_TILING_OPTIMAL,
+            .usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT,
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+            .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED
+        };
+
+        if (int vkErr{ vkCreateImage(m_VKDeviceHandle->GetVKDevice(), &imageInfo, nullptr, &m_VKMSAAColorImage) }; vkErr)
+        {
+            Logger::Log_Error("Unable to create multisampled color attachment. vkCreateImage failed.");
+            throw std::runtime_error("Unable to create multisampled color attachment. vkCreateImage failed.");
+        }
+
+        m_VKMSAAColorMemory = AllocateImageMemory(m_VKMSAAColorImage, true);
+
+        VkImageViewCreateInfo viewInfo{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+            .image = m_VKMSAAColorImage,
+            .viewType = VK_IMAGE_VIEW_TYPE_2D,
+            .format = m_VKWindowHandle->GetVKImageFormat(),
+            .subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 }
+        };
+
+        if (int vkErr{ vkCreateImageView(m_VKDeviceHandle->GetVKDevice(), &viewInfo, nullptr, &m_VKMSAAColorImageView) }; vkErr)
+        {
+            Logger::Log_Error("Unable to create multisampled color attachment. vkCreateImageView failed.");
+            throw std::runtime_error("Unable to create multisampled color attachment. vkCreateImageView failed.");
+        }
+    }
+
+    void Renderpass::CreateFramebuffers()
+    {
+        if (m_DynamicRendering) return;
 
         // CREATE FRAMEBUFFERS
         // Framebuffers references the attachments used in renderpass.
@@ -68,136 +826,213 @@ namespace Minerva::Vulkan
         m_VKFramebuffers.resize(m_VKWindowHandle->GetVKSwapImageViews().size());
         for (size_t i{ 0 }; i < m_VKFramebuffers.size(); ++i)
         {
-            VkImageView attachments[] = { m_VKWindowHandle->GetVKSwapImageViews()[i] };
+            // Same order as the render pass attachments: color, depth, G-buffer, resolve
+            std::vector<VkImageView> attachments{ IsMultisampled() ? m_VKMSAAColorImageView : m_VKWindowHandle->GetVKSwapImageViews()[i] };
+            if (m_DepthAttachment)
+                attachments.push_back(m_VKDepthAttachmentView);
+            for (const GBufferAttachment& gbuffer : m_GBuffer)
+                attachments.push_back(gbuffer.m_VKImageView);
+            if (IsMultisampled())
+                attachments.push_back(m_VKWindowHandle->GetVKSwapImageViews()[i]);
 
             VkFramebufferCreateInfo frameBufferCreateInfo{
                 .sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
                 .renderPass = m_VKRenderPass,
-                .attachmentCount = 1,
-                .pAttachments = attachments,
+                .attachmentCount = static_cast<uint32_t>(attachments.size()),
+                .pAttachments = attachments.data(),
                 .width = m_VKFramebufferExtent.width,
                 .height = m_VKFramebufferExtent.height,
                 .layers = 1
             };
 
-            if (auto VkErr{ vkCreateFramebuffer(m_VKDeviceHandle->GetVKDevice(), &frameBufferCreateInfo, nullptr, &m_VKFramebuffers[i])})
+            if (auto VkErr{ vkCreateFramebuffer(m_VKDeviceHandle->GetVKDevice(), &frameBufferCreateInfo, nullptr, &m_VKFramebuffers[i]) })
             {
                 Logger::Log_Error("Unable to create Framebuffer. vkCreateFramebuff failed.");
                 throw std::runtime_error("Unable to create Framebuffer. vkCreateFramebuff failed.");
             }
         }
-	}
-
+    }
 
-    Renderpass::~Renderpass()
+    void Renderpass::RecreateFramebuffer(std::span<const VkImageView> _views, VkExtent2D _extent)
     {
-        for (auto framebuffer : m_VKFramebuffers)
+        if (!IsOffscreen() || _views.size() != m_OffscreenAttachments.size())
         {
-            if (framebuffer != VK_NULL_HANDLE)
-                vkDestroyFramebuffer(m_VKDeviceHandle->GetVKDevice(), framebuffer, nullptr);
+            Logger::Log_Error("Unable to recreate framebuffer. Not an offscreen render pass or attachment count mismatch.");
+            throw std::runtime_error("Unable to recreate framebuffer. Not an offscreen render pass or attachment count mismatch.");
         }
 
-        if (m_VKRenderPass != VK_NULL_HANDLE)
-            vkDestroyRenderPass(m_VKDeviceHandle->GetVKDevice(), m_VKRenderPass, nullptr);
-    }
-
-    void Renderpass::CleanupRenderpass()
-    {
         for (auto framebuffer : m_VKFramebuffers)
         {
             if (framebuffer != VK_NULL_HANDLE)
                 vkDestroyFramebuffer(m_VKDeviceHandle->GetVKDevice(), framebuffer, nullptr);
         }
+        m_VKFramebuffers.clear();
 
-        if (m_VKRenderPass != VK_NULL_HANDLE)
-            vkDestroyRenderPass(m_VKDeviceHandle->GetVKDevice(), m_VKRenderPass, nullptr);
+        m_VKFramebufferExtent = _extent;
+        ++m_Generation;
+        CreateOffscreenFramebuffer(_views);
     }
 
-    void Renderpass::RecreateRenderpass()
+    void Renderpass::CreateOffscreenRenderpass()
     {
-        m_VKFramebufferExtent = m_VKWindowHandle->GetVKSwapExtent();
+        if (m_DynamicRendering) return;
 
-        // CREATE RENDERPASS
-        // Describe the color attachment
-        VkAttachmentDescription colorAttachmentDescription{
-        .format = m_VKWindowHandle->GetVKImageFormat(),
-        .samples = VK_SAMPLE_COUNT_1_BIT,
-        .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR, // Can be set to clear/not to clear
-        .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
-        .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
-        .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
-        .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-        .finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
-        };
+        // Layouts never change inside the pass, so no implicit transitions or external dependencies are needed.
+        // The owner synchronizes the attachments with its own barriers
+        std::vector<VkAttachmentDescription> attachments;
+        std::vector<VkAttachmentReference> colorAttachmentRefs;
+        VkAttachmentReference depthAttachmentRef{};
+        attachments.reserve(m_OffscreenAttachments.size());
 
-        // Color attachment binding point/reference
-        VkAttachmentReference colorAttachmentRef{
-            .attachment = 0, // Index bound to color attachment
-            .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
-        };
+        for (const AttachmentDescription& attachment : m_OffscreenAttachments)
+        {
+            const uint32_t index{ static_cast<uint32_t>(attachments.size()) };
+            attachments.push_back(VkAttachmentDescription{
+                .format = attachment.m_VKFormat,
+                .samples = VK_SAMPLE_COUNT_1_BIT,
+                .loadOp = attachment.m_VKLoadOp,
+                .storeOp = attachment.m_VKStoreOp,
+                .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+                .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+                .initialLayout = attachment.m_VKLayout,
+                .finalLayout = attachment.m_VKLayout
+            });
+
+            if (attachment.m_Depth)
+                depthAttachmentRef = VkAttachmentReference{ .attachment = index, .layout = attachment.m_VKLayout };
+            else
+                colorAttachmentRefs.push_back(VkAttachmentReference{ .attachment = index, .layout = attachment.m_VKLayout });
+        }
 
-        // Description of subpass -> Render pass must have at least 1 subpass
         VkSubpassDescription subpassDesc{
             .pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS,
-            .colorAttachmentCount = 1,
-            .pColorAttachments = &colorAttachmentRef
-        };
-
-        // Subpass dependencies
-        VkSubpassDependency dependency{
-        .srcSubpass = VK_SUBPASS_EXTERNAL,
-        .dstSubpass = 0,
-        .srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT,
-        .dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT,
-        .srcAccessMask = 0,
-        .dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+            .colorAttachmentCount = static_cast<uint32_t>(colorAttachmentRefs.size()),
+            .pColorAttachments = colorAttachmentRefs.data(),
+            .pDepthStencilAttachment = m_DepthAttachment ? &depthAttachmentRef : nullptr
         };
 
-        // Describe render pass
         VkRenderPassCreateInfo renderPassInfo{
-        .sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
-        .attachmentCount = 1, // Only color
-        .pAttachments = &colorAttachmentDescription, // pointer to container of attachments
-        .subpassCount = 1, // At least 1 subpass
-        .pSubpasses = &subpassDesc, // pointer to array of subpass descriptions
-        .dependencyCount = 1,
-        .pDependencies = &dependency
+            .sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
+            .attachmentCount = static_cast<uint32_t>(attachments.size()),
+            .pAttachments = attachments.data(),
+            .subpassCount = 1,
+            .pSubpasses = &subpassDesc,
+            .dependencyCount = 0,
+            .pDependencies = nullptr
         };
 
-        // Create Render Pass
-        if (auto VkErr{ vkCreateRenderPass(m_VKDeviceHandle->GetVKDevice(), &renderPassInfo, nullptr, &m_VKRenderPass) }; VkErr)
+        m_VKRenderPass = m_VKDeviceHandle->GetRenderpassCache().GetRenderPass(m_VKDeviceHandle->GetVKDevice(), renderPassInfo);
+    }
+
+    void Renderpass::CreateOffscreenFramebuffer(std::span<const VkImageView> _views)
+    {
+        // Depth view is exposed for passes that read it afterwards, e.g. a depth pyramid
+        for (size_t i{ 0 }; i < m_OffscreenAttachments.size(); ++i)
         {
-            Logger::Log_Error("Unable to create render pass. vkCreateRenderPass failed.");
-            throw std::runtime_error("Unable to create render pass. vkCreateRenderPass failed.");
+            if (m_OffscreenAttachments[i].m_Depth)
+            {
+                m_VKDepthImageView = _views[i];
+                m_VKDepthAttachmentView = _views[i];
+            }
         }
 
+        if (m_DynamicRendering)
+        {
+            m_VKOffscreenViews.assign(_views.begin(), _views.end());
+            return;
+        }
 
-        // CREATE FRAMEBUFFERS
-        // Framebuffers references the attachments used in renderpass.
-        // Each swapchain image will require their own framebuffer
-        // The Image used for the attachment will be the one returned by the swapchain
-        //  - the output of the shader stages will be the image to be "drawn on"
+        m_VKFramebuffers.resize(1);
 
-        m_VKFramebuffers.resize(m_VKWindowHandle->GetVKSwapImageViews().size());
-        for (size_t i{ 0 }; i < m_VKFramebuffers.size(); ++i)
+        VkFramebufferCreateInfo frameBufferCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
+            .renderPass = m_VKRenderPass,
+            .attachmentCount = static_cast<uint32_t>(_views.size()),
+            .pAttachments = _views.data(),
+            .width = m_VKFramebufferExtent.width,
+            .height = m_VKFramebufferExtent.height,
+            .layers = 1
+        };
+
+        if (auto VkErr{ vkCreateFramebuffer(m_VKDeviceHandle->GetVKDevice(), &frameBufferCreateInfo, nullptr, &m_VKFramebuffers[0]) })
         {
-            VkImageView attachments[] = { m_VKWindowHandle->GetVKSwapImageViews()[i] };
+            Logger::Log_Error("Unable to create Framebuffer. vkCreateFramebuff failed.");
+            throw std::runtime_error("Unable to create Framebuffer. vkCreateFramebuff failed.");
+        }
+    }
 
-            VkFramebufferCreateInfo frameBufferCreateInfo{
-                .sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
-                .renderPass = m_VKRenderPass,
-                .attachmentCount = 1,
-                .pAttachments = attachments,
-                .width = m_VKFramebufferExtent.width,
-                .height = m_VKFramebufferExtent.height,
-                .layers = 1
-            };
+    VkFormat Renderpass::FindDepthFormat() const
+    {
+        // First format usable as both depth attachment and sampled image. Depth only formats are preferred by precision,
+        // with a stencil the packed 24-bit depth is preferred as it is the smallest combined format
+        const std::array<VkFormat, 3> depthFormats{ VK_FORMAT_D32_SFLOAT, VK_FORMAT_X8_D24_UNORM_PACK32, VK_FORMAT_D16_UNORM };
+        const std::array<VkFormat, 3> stencilFormats{ VK_FORMAT_D24_UNORM_S8_UINT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D16_UNORM_S8_UINT };
 
-            if (auto VkErr{ vkCreateFramebuffer(m_VKDeviceHandle->GetVKDevice(), &frameBufferCreateInfo, nullptr, &m_VKFramebuffers[i]) })
+        for (VkFormat format : m_Stencil ? stencilFormats : depthFormats)
+        {
+            VkFormatProperties properties;
+            vkGetPhysicalDeviceFormatProperties(m_VKDeviceHandle->GetVKPhysicalDevice(), format, &properties);
+
+            const VkFormatFeatureFlags required{ VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT };
+            if ((properties.optimalTilingFeatures & required) == required)
+                return format;
+        }
+
+        Logger::Log_Error("Unable to create render pass. No supported depth format.");
+        throw std::runtime_error("Unable to create render pass. No supported depth format.");
+    }
+
+    VkDeviceMemory Renderpass::AllocateImageMemory(VkImage _image, bool _lazy)
+    {
+        VkMemoryRequirements memRequirements{};
+        vkGetImageMemoryRequirements(m_VKDeviceHandle->GetVKDevice(), _image, &memRequirements);
+
+        // Lazily allocated memory is only backed when the attachment leaves tile memory, which a transient one never does.
+        // Desktop GPUs usually have no such memory type, the image then gets regular device memory
+        uint32_t memoryType{ UINT32_MAX };
+        if (_lazy)
+        {
+            VkPhysicalDeviceMemoryProperties memProperties;
+            vkGetPhysicalDeviceMemoryProperties(m_VKDeviceHandle->GetVKPhysicalDevice(), &memProperties);
+
+            const VkMemoryPropertyFlags lazyProperties{ VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT };
+            for (uint32_t i{ 0 }; i < memProperties.memoryTypeCount && memoryType == UINT32_MAX; ++i)
             {
-                Logger::Log_Error("Unable to create Framebuffer. vkCreateFramebuff failed.");
-                throw std::runtime_error("Unable to create Framebuffer. vkCreateFramebuff failed.");
+                if ((memRequirements.memoryTypeBits & (1u << i)) && (memProperties.memoryTypes[i].propertyFlags & lazyProperties) == lazyProperties)
+                    memoryType = i;
+            }
+        }
+        if (memoryType == UINT32_MAX)
+            memoryType = FindMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        VkMemoryAllocateInfo allocInfo{
+            .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+            .allocationSize = memRequirements.size,
+            .memoryTypeIndex = memoryType
+        };
+
+        VkDeviceMemory memory{ VK_NULL_HANDLE };
+        if (int vkErr{ vkAllocateMemory(m_VKDeviceHandle->GetVKDevice(), &allocInfo, nullptr, &memory) }; vkErr)
+        {
+            Logger::Log_Error("Unable to create render pass attachment. vkAllocateMemory failed.");
+            throw std::runtime_error("Unable to create render pass attachment. vkAllocateMemory failed.");
+        }
+
+        vkBindImageMemory(m_VKDeviceHandle->GetVKDevice(), _image, memory, 0);
+        return memory;
+    }
+
+    uint32_t Renderpass::FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties)
+    {
+        VkPhysicalDeviceMemoryProperties memProperties;
+        vkGetPhysicalDeviceMemoryProperties(m_VKDeviceHandle->GetVKPhysicalDevice(), &memProperties);
+
+        for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+            if ((typeFilter & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+                return i;
             }
         }
+
+        throw std::runtime_error("failed to find suitable memory type!");
     }
 }
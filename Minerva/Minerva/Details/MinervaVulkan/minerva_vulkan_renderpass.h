@@ -5,16 +5,80 @@ namespace Minerva::Vulkan
 	class Renderpass
 	{
 	public:
-		Renderpass(std::shared_ptr<Minerva::Vulkan::Device> _device, std::shared_ptr<Minerva::Vulkan::Window> _window, float* _clearColor);
+		static constexpr uint32_t GBUFFER_SUBPASS{ 0 };
+		static constexpr uint32_t LIGHTING_SUBPASS{ 1 };
+
+		// Attachment of an offscreen render pass. The image stays in m_VKLayout before, during and after the pass,
+		// transitions are left to the caller
+		struct AttachmentDescription
+		{
+			VkFormat m_VKFormat;
+			VkAttachmentLoadOp m_VKLoadOp;
+			VkAttachmentStoreOp m_VKStoreOp;
+			VkImageLayout m_VKLayout;
+			VkClearValue m_VKClearValue;
+			bool m_Depth;
+		};
+
+		// _stencil picks a combined depth/stencil format, its stencil is cleared to 0 and stored like the depth.
+		// A non empty _gbufferFormats makes a deferred render pass, see Minerva::Renderpass. It always has a depth attachment.
+		// _samples above 1 renders into transient multisampled attachments resolved into the swapchain image, not with a G-buffer
+		Renderpass(std::shared_ptr<Minerva::Vulkan::Device> _device, std::shared_ptr<Minerva::Vulkan::Window> _window, float* _clearColor, bool _depthAttachment = false, bool _stencil = false,
+			std::span<const VkFormat> _gbufferFormats = {}, VkSampleCountFlagBits _samples = VK_SAMPLE_COUNT_1_BIT);
+
+		// Offscreen render pass with a single framebuffer over _views. At most one depth attachment
+		Renderpass(std::shared_ptr<Minerva::Vulkan::Device> _device, std::span<const AttachmentDescription> _attachments, std::span<const VkImageView> _views, VkExtent2D _extent);
 		~Renderpass();
 
+		// Begins the pass on framebuffer _index, _resume continues a suspended pass without clearing. End also suspends.
+		// With dynamic rendering the window attachments are transitioned here, as a render pass would
+		void Begin(VkCommandBuffer _commandBuffer, int _index, VkSubpassContents _contents, bool _resume) const;
+		void End(VkCommandBuffer _commandBuffer, int _index) const;
+
+		// VK_NULL_HANDLE, and no framebuffers, with dynamic rendering
 		inline VkRenderPass GetVKRenderPass() const { return m_VKRenderPass; }
-		inline VkClearValue GetVkClearValue() const { return m_VKClearValue; }
+		inline VkRenderPass GetVKResumeRenderPass() const { return m_VKResumeRenderPass; }
+		inline VkClearValue GetVkClearValue() const { return m_VKClearValues[0]; }
+		inline const std::vector<VkClearValue>& GetVKClearValues() const { return m_VKClearValues; }
 		inline std::vector<VkFramebuffer>& GetVKFramebuffers() { return m_VKFramebuffers; }
 		inline const VkExtent2D& GetFramebufferExtent() const { return m_VKFramebufferExtent; }
+		inline bool HasDepthAttachment() const { return m_DepthAttachment; }
+		inline VkFormat GetVKDepthFormat() const { return m_VKDepthFormat; }
+		inline VkImageView GetVKDepthImageView() const { return m_VKDepthImageView; }
+		inline bool HasStencil() const { return m_Stencil; }
+		inline uint32_t GetColorAttachmentCount(uint32_t _subpass = 0) const { return IsDeferred() && _subpass == GBUFFER_SUBPASS ? static_cast<uint32_t>(m_GBuffer.size()) : m_ColorAttachmentCount; }
+		inline bool HasDepthAttachment(uint32_t _subpass) const { return m_DepthAttachment && (!IsDeferred() || _subpass == GBUFFER_SUBPASS); }
+		inline uint32_t GetSubpassCount() const { return IsDeferred() ? 2u : 1u; }
+		inline bool IsDeferred() const { return !m_GBuffer.empty(); }
+		inline VkSampleCountFlagBits GetVKSamples() const { return m_VKSamples; }
+		inline bool IsMultisampled() const { return m_VKSamples != VK_SAMPLE_COUNT_1_BIT; }
+		// Depth contents are undefined after the pass, it cannot be read or resumed
+		inline bool IsDepthDiscarded() const { return m_DepthAttachment && (IsMultisampled() || m_VKDepthStoreOp == VK_ATTACHMENT_STORE_OP_DONT_CARE); }
+
+		// Window render passes only. LOAD is rejected, a suspended pass is continued through the resume pass instead.
+		// Switching operations picks another compatible VkRenderPass, framebuffers and pipelines are kept
+		void SetColorLoadOp(VkAttachmentLoadOp _loadOp);
+		void SetDepthOps(VkAttachmentLoadOp _loadOp, VkAttachmentStoreOp _storeOp);
+		void SetClearColor(const float* _clearColor);
+		void SetClearDepth(float _depth, uint32_t _stencil);
+		inline uint32_t GetGBufferCount() const { return static_cast<uint32_t>(m_GBuffer.size()); }
+		// Input attachment _attachment of the lighting subpass, G-buffer attachments first and the depth last
+		VkDescriptorImageInfo GetVKInputAttachmentInfo(uint32_t _attachment) const;
+		// Called after every recreation, e.g. to rewrite input attachment descriptors. Callbacks returning false are removed.
+		// One callback per _owner and _binding, adding another replaces it
+		void AddRecreateCallback(const void* _owner, uint32_t _binding, std::function<bool(const Renderpass&)> _callback);
+		inline std::span<const VkFormat> GetVKColorFormats() const { return m_VKColorFormats; }
+		inline bool IsDynamicRendering() const { return m_DynamicRendering; }
+		inline bool IsOffscreen() const { return !m_VKWindowHandle; }
+		// Changes whenever the attachments are recreated. Image view handles may be reused by the driver, so they cannot tell
+		inline uint32_t GetGeneration() const { return m_Generation; }
+		inline std::shared_ptr<Minerva::Vulkan::Device> GetVKDeviceHandle() const { return m_VKDeviceHandle; }
 
 		void CleanupRenderpass();
 		void RecreateRenderpass();
+
+		// Offscreen only. Rebuilds the framebuffer over new views, e.g. after its images were resized
+		void RecreateFramebuffer(std::span<const VkImageView> _views, VkExtent2D _extent);
 	private:
 		// Private interface handles
 		std::shared_ptr<Minerva::Vulkan::Device> m_VKDeviceHandle;
@@ -23,11 +87,74 @@ namespace Minerva::Vulkan
 
 		// Vulkan properties
 		VkRenderPass m_VKRenderPass;
+		VkRenderPass m_VKResumeRenderPass; // Same attachments, loaded instead of cleared. Compatible with m_VKRenderPass
 		std::vector<VkFramebuffer> m_VKFramebuffers;
-		VkClearValue m_VKClearValue;
+		std::vector<VkClearValue> m_VKClearValues; // Color, then depth
 		VkExtent2D m_VKFramebufferExtent;
-		
+		uint32_t m_ColorAttachmentCount;
+		std::vector<AttachmentDescription> m_OffscreenAttachments; // Empty for window render passes
+		std::vector<VkFormat> m_VKColorFormats;
+		bool m_DynamicRendering;
+		std::vector<VkImageView> m_VKOffscreenViews; // Dynamic rendering only, the views the framebuffer would hold
+
+		// Depth attachment, one image shared by all framebuffers. Offscreen render passes only reference the caller's view. Left in DEPTH_STENCIL_READ_ONLY_OPTIMAL after the pass
+		// so it can be sampled, e.g. to build a depth pyramid
+		bool m_DepthAttachment;
+		bool m_Stencil;
+		VkFormat m_VKDepthFormat;
+		VkImage m_VKDepthImage;
+		VkDeviceMemory m_VKDepthMemory;
+		VkImageView m_VKDepthImageView;      // Depth aspect only, for sampling
+		VkImageView m_VKDepthAttachmentView; // Depth and stencil aspects with a stencil, otherwise m_VKDepthImageView
+
+		// Multisampling. Color and depth are rendered into transient images, lazily allocated where the device allows, and only the
+		// color is resolved into the swapchain image at the end of the subpass. Neither multisampled image is ever written to memory,
+		// so the depth is not readable after the pass
+		VkSampleCountFlagBits m_VKSamples;
+		VkImage m_VKMSAAColorImage;
+		VkDeviceMemory m_VKMSAAColorMemory;
+		VkImageView m_VKMSAAColorImageView;
+
+		// Operations of the window attachments on the first pass of a frame. The color is always stored, it is presented
+		VkAttachmentLoadOp m_VKColorLoadOp;
+		VkAttachmentLoadOp m_VKDepthLoadOp;
+		VkAttachmentStoreOp m_VKDepthStoreOp;
+
+		uint32_t m_Generation; // RecreateRenderpass/RecreateFramebuffer count
+
+		// G-buffer of a deferred render pass. Written and read inside the pass only, so the images are transient and, where the
+		// device allows, lazily allocated: tile-based GPUs keep them in tile memory and never write them out
+		struct GBufferAttachment
+		{
+			VkFormat m_VKFormat;
+			VkImage m_VKImage;
+			VkDeviceMemory m_VKMemory;
+			VkImageView m_VKImageView;
+		};
+		std::vector<GBufferAttachment> m_GBuffer;
+		struct RecreateCallback
+		{
+			const void* m_Owner;
+			uint32_t m_Binding;
+			std::function<bool(const Renderpass&)> m_Callback;
+		};
+		std::vector<RecreateCallback> m_RecreateCallbacks;
+
+		// Helper functions
+		void CreateRenderpass();
+		void CreateDeferredRenderpass();
+		void CreateDepthResources();
+		void CreateGBufferResources();
+		void CreateMSAAResources();
+		void ValidateWindowOps(VkAttachmentLoadOp _loadOp) const;
+		void UpdateRenderpass();
+		void CreateFramebuffers();
+		void CreateOffscreenRenderpass();
+		void CreateOffscreenFramebuffer(std::span<const VkImageView> _views);
+		VkFormat FindDepthFormat() const;
+		uint32_t FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
+		VkDeviceMemory AllocateImageMemory(VkImage _image, bool _lazy);
 	};
 }
 
-#include "minerva_vulkan_renderpass.cpp"
\ No newline at end of file
+#include "minerva_vulkan_renderpass.cpp"
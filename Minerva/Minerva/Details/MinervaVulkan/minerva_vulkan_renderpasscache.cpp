@@ -0,0 +1,94 @@
+namespace Minerva::Vulkan
+{
+	VkRenderPass RenderpassCache::GetRenderPass(VkDevice _device, const VkRenderPassCreateInfo& _createInfo)
+	{
+		// Every field of the description, pointers replaced by what they point to
+		std::string key;
+		auto Append = [&key](const auto& _value) { key.append(reinterpret_cast<const char*>(&_value), sizeof(_value)); };
+		auto AppendReferences = [&Append](uint32_t _count, const VkAttachmentReference* _references)
+		{
+			Append(_references ? _count : 0u);
+			for (uint32_t i{ 0 }; _references && i < _count; ++i)
+			{
+				Append(_references[i].attachment);
+				Append(_references[i].layout);
+			}
+		};
+
+		Append(_createInfo.flags);
+		Append(_createInfo.attachmentCount);
+		for (uint32_t i{ 0 }; i < _createInfo.attachmentCount; ++i)
+		{
+			const VkAttachmentDescription& attachment{ _createInfo.pAttachments[i] };
+			Append(attachment.flags);
+			Append(attachment.format);
+			Append(attachment.samples);
+			Append(attachment.loadOp);
+			Append(attachment.storeOp);
+			Append(attachment.stencilLoadOp);
+			Append(attachment.stencilStoreOp);
+			Append(attachment.initialLayout);
+			Append(attachment.finalLayout);
+		}
+
+		Append(_createInfo.subpassCount);
+		for (uint32_t i{ 0 }; i < _createInfo.subpassCount; ++i)
+		{
+			const VkSubpassDescription& subpass{ _createInfo.pSubpasses[i] };
+			Append(subpass.flags);
+			Append(subpass.pipelineBindPoint);
+			AppendReferences(subpass.inputAttachmentCount, subpass.pInputAttachments);
+			AppendReferences(subpass.colorAttachmentCount, subpass.pColorAttachments);
+			AppendReferences(subpass.pResolveAttachments ? subpass.colorAttachmentCount : 0u, subpass.pResolveAttachments);
+			AppendReferences(subpass.pDepthStencilAttachment ? 1u : 0u, subpass.pDepthStencilAttachment);
+			Append(subpass.preserveAttachmentCount);
+			for (uint32_t j{ 0 }; j < subpass.preserveAttachmentCount; ++j)
+				Append(subpass.pPreserveAttachments[j]);
+		}
+
+		Append(_createInfo.dependencyCount);
+		for (uint32_t i{ 0 }; i < _createInfo.dependencyCount; ++i)
+		{
+			const VkSubpassDependency& dependency{ _createInfo.pDependencies[i] };
+			Append(dependency.srcSubpass);
+			Append(dependency.dstSubpass);
+			Append(dependency.srcStageMask);
+			Append(dependency.dstStageMask);
+			Append(dependency.srcAccessMask);
+			Append(dependency.dstAccessMask);
+			Append(dependency.dependencyFlags);
+		}
+
+		std::scoped_lock lock{ m_Lock };
+		if (auto it{ m_VKRenderPasses.find(key) }; it != m_VKRenderPasses.end())
+		{
+			m_DeduplicatedCount.fetch_add(1, std::memory_order_relaxed);
+			return it->second;
+		}
+
+		VkRenderPass renderPass{ VK_NULL_HANDLE };
+		if (auto VkErr{ vkCreateRenderPass(_device, &_createInfo, nullptr, &renderPass) }; VkErr)
+		{
+			Logger::Log_Error("Unable to create render pass. vkCreateRenderPass failed.");
+			throw std::runtime_error("Unable to create render pass. vkCreateRenderPass failed.");
+		}
+
+		m_VKRenderPasses.emplace(std::move(key), renderPass);
+		return renderPass;
+	}
+
+	void RenderpassCache::Destroy(VkDevice _device)
+	{
+		std::scoped_lock lock{ m_Lock };
+
+		for (auto& [key, renderPass] : m_VKRenderPasses)
+			vkDestroyRenderPass(_device, renderPass, nullptr);
+		m_VKRenderPasses.clear();
+	}
+
+	size_t RenderpassCache::GetRenderpassCount() const
+	{
+		std::scoped_lock lock{ m_Lock };
+		return m_VKRenderPasses.size();
+	}
+}
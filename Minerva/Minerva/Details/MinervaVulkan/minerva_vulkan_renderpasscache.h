@@ -0,0 +1,30 @@
+#pragma once
+
+namespace Minerva::Vulkan
+{
+	// Render pass objects shared by everything created with the same description. Owned by the Device, like the LayoutCache.
+	// Variants of a pass that only differ in load/store ops or layouts are compatible with the same framebuffers and pipelines,
+	// so switching between them only looks up another handle
+	class RenderpassCache
+	{
+	public:
+		RenderpassCache() = default;
+		RenderpassCache(const RenderpassCache&) = delete;
+		RenderpassCache& operator=(const RenderpassCache&) = delete;
+
+		// Thread safe. pNext chains are not supported
+		VkRenderPass GetRenderPass(VkDevice _device, const VkRenderPassCreateInfo& _createInfo);
+
+		void Destroy(VkDevice _device);
+
+		size_t GetRenderpassCount() const;
+		inline uint32_t GetDeduplicatedCount() const { return m_DeduplicatedCount.load(std::memory_order_relaxed); }
+
+	private:
+		std::unordered_map<std::string, VkRenderPass> m_VKRenderPasses;
+		mutable std::mutex m_Lock;
+		std::atomic<uint32_t> m_DeduplicatedCount{ 0 }; // Requests answered by an existing render pass
+	};
+}
+
+#include "minerva_vulkan_renderpasscache.cpp"
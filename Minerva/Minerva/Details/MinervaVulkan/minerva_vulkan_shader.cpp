@@ -1,7 +1,8 @@
 namespace Minerva::Vulkan
 {
 	Shader::Shader(std::shared_ptr<Minerva::Vulkan::Device> _device, const std::string_view _filepath, Minerva::Shader::Type _shaderType) :
-		m_VKDeviceHandle{ _device }, m_VKShaderModule{ VK_NULL_HANDLE }, m_ShaderType{ _shaderType }, m_Filename{_filepath}
+		m_VKDeviceHandle{ _device }, m_VKShaderModule{ VK_NULL_HANDLE }, m_VKShaderStage{ VK_SHADER_STAGE_VERTEX_BIT }, m_ShaderType{ _shaderType }, m_Filename{_filepath},
+		m_Reflection{}
 	{
 		// Load shader file
 		std::ifstream ifs(_filepath.data(), std::ios::ate | std::ios::binary);
@@ -18,6 +19,32 @@ namespace Minerva::Vulkan
 		ifs.read(buffer.data(), fileSize);
 		ifs.close();
 
+		// Descriptor bindings, push constants and inputs are read from the module itself, so layouts always match the shader
+		using namespace Minerva::Tools::SPIRVReflect;
+		if (ReflectError reflectErr{ Reflect(m_Reflection, std::span<const uint32_t>{ reinterpret_cast<const uint32_t*>(buffer.data()), buffer.size() / sizeof(uint32_t) }) };
+			reflectErr != ReflectError::SUCCESS)
+		{
+			std::stringstream ss;
+			ss << "Unable to load shader. SPIR-V reflection failed. " << GetErrorMessage(reflectErr);
+			Logger::Log_Error(ss.str());
+			throw std::runtime_error(ss.str());
+		}
+
+		constexpr std::array<VkShaderStageFlagBits, 6> stages{ VK_SHADER_STAGE_VERTEX_BIT, VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT, VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT,
+			VK_SHADER_STAGE_GEOMETRY_BIT, VK_SHADER_STAGE_FRAGMENT_BIT, VK_SHADER_STAGE_COMPUTE_BIT };
+		m_VKShaderStage = stages[static_cast<size_t>(m_Reflection.m_Stage)];
+
+		const bool tessellation{ m_VKShaderStage == VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT || m_VKShaderStage == VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT };
+		if ((_shaderType == Minerva::Shader::Type::VERTEX && m_VKShaderStage != VK_SHADER_STAGE_VERTEX_BIT) ||
+			(_shaderType == Minerva::Shader::Type::FRAGMENT && m_VKShaderStage != VK_SHADER_STAGE_FRAGMENT_BIT) ||
+			(_shaderType == Minerva::Shader::Type::TESSELLATION && !tessellation) ||
+			(_shaderType == Minerva::Shader::Type::COMPUTE && m_VKShaderStage != VK_SHADER_STAGE_COMPUTE_BIT) ||
+			_shaderType == Minerva::Shader::Type::ALL_GRAPHICS)
+		{
+			Logger::Log_Error("Unable to load shader. Shader type does not match the stage of the SPIR-V entry point.");
+			throw std::runtime_error("Unable to load shader. Shader type does not match the stage of the SPIR-V entry point.");
+		}
+
 		// Create shader module
 		VkShaderModuleCreateInfo shaderModuleCreateInfo{
 			.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
@@ -11,6 +11,8 @@ namespace Minerva::Vulkan
 		inline VkShaderModule GetVKShaderModule() const { return m_VKShaderModule; }
 		inline Minerva::Shader::Type GetShaderType() const { return m_ShaderType; }
 		inline std::string_view GetFilepath() const { return m_Filename; }
+		inline const Minerva::Tools::SPIRVReflect::Reflection& GetReflection() const { return m_Reflection; }
+		inline VkShaderStageFlagBits GetVKShaderStage() const { return m_VKShaderStage; }
 
 	private:
 		// Private interface handles
@@ -18,10 +20,12 @@ namespace Minerva::Vulkan
 
 		// Vulkan properties
 		VkShaderModule m_VKShaderModule;
+		VkShaderStageFlagBits m_VKShaderStage; // From the entry point of the module
 
 		// Minerva properties
 		Minerva::Shader::Type m_ShaderType;
 		std::string m_Filename;
+		Minerva::Tools::SPIRVReflect::Reflection m_Reflection;
 	};
 }
 
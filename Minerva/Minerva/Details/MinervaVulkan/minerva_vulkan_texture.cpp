@@ -4,7 +4,7 @@ namespace Minerva::Vulkan
         m_VKDeviceHandle{_device},
         m_VKImage{ VK_NULL_HANDLE }, m_VKImageView{ VK_NULL_HANDLE }, m_VKImageFormat{VK_FORMAT_UNDEFINED},
         m_VKImageMemory{VK_NULL_HANDLE}, m_VKSampler{ VK_NULL_HANDLE },
-        m_Width{ 0 }, m_Height{ 0 }, m_MipLevels{}
+        m_Width{ 0 }, m_Height{ 0 }, m_MipLevels{}, m_State{ _device->GetResourceTracker() }
 	{
 		// Load DDS
 		Minerva::Tools::DDSLoader::Bitmap loadedBitmap{};
@@ -79,9 +79,14 @@ namespace Minerva::Vulkan
 
         vkBindImageMemory(m_VKDeviceHandle->GetVKDevice(), m_VKImage, m_VKImageMemory, 0);
 
-        TransitionImageLayout(m_VKImage, m_VKImageFormat, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-        CopyBufferToImage(stagingBuffer, m_VKImage, m_Width, m_Height);
-        TransitionImageLayout(m_VKImage, m_VKImageFormat, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        m_State.Reset(m_VKImage, VK_IMAGE_ASPECT_COLOR_BIT, m_MipLevels);
+
+        // Transitions and copy in a single submission
+        VkCommandBuffer commandBuffer{ m_VKDeviceHandle->BeginSingleTimeCommands() };
+        TransitionImageLayout(commandBuffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, BarrierBatch::GetLayoutSyncState(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL), true);
+        CopyBufferToImage(commandBuffer, stagingBuffer, m_VKImage, m_Width, m_Height);
+        TransitionImageLayout(commandBuffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, BarrierBatch::GetLayoutSyncState(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL), false);
+        m_VKDeviceHandle->EndSingleTimeCommands(commandBuffer);
         
         vkDestroyBuffer(m_VKDeviceHandle->GetVKDevice(), stagingBuffer, nullptr);
         vkFreeMemory(m_VKDeviceHandle->GetVKDevice(), imageMemory, nullptr);
@@ -189,65 +194,16 @@ namespace Minerva::Vulkan
         vkBindBufferMemory(m_VKDeviceHandle->GetVKDevice(), _buffer, _bufferMemory, 0);
     }
 
-    void Texture::TransitionImageLayout(VkImage _image, VkFormat _format, VkImageLayout _oldLayout, VkImageLayout _newLayout)
+    void Texture::TransitionImageLayout(VkCommandBuffer _commandBuffer, VkImageLayout _newLayout, const BarrierBatch::SyncState& _sync, bool _write)
     {
-        VkCommandBuffer commandBuffer{ m_VKDeviceHandle->BeginSingleTimeCommands() };
-
-        VkImageMemoryBarrier barrier{};
-        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-        barrier.oldLayout = _oldLayout;
-        barrier.newLayout = _newLayout;
-        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.image = _image;
-        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        barrier.subresourceRange.baseMipLevel = 0;
-        barrier.subresourceRange.levelCount = m_MipLevels;
-        barrier.subresourceRange.baseArrayLayer = 0;
-        barrier.subresourceRange.layerCount = 1;
-
-        // Transition barrier masks
-        VkPipelineStageFlags sourceStage;
-        VkPipelineStageFlags destinationStage;
-
-        if (_oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && _newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
-        {
-            barrier.srcAccessMask = 0;
-            barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-
-            sourceStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-            destinationStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-        }
-        else if (_oldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL && _newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
-        {
-            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-            sourceStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            destinationStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-        }
-        else
-        {
-            Logger::Log_Error("Error setting up Image Barrier. Unsupported layout transition.");
-            throw std::runtime_error("Error setting up Image Barrier. Unsupported layout transition.");
-        }
-
-        vkCmdPipelineBarrier(
-            commandBuffer,
-            sourceStage, destinationStage,
-            0,
-            0, nullptr,
-            0, nullptr,
-            1, &barrier
-        );
-
-        m_VKDeviceHandle->EndSingleTimeCommands(commandBuffer);
+        // Any transition is valid, the old layout and the accesses to wait for come from the tracked state
+        BarrierBatch barriers;
+        m_State.Use(barriers, 0, m_MipLevels, 0, 1, _newLayout, _sync, _write);
+        barriers.Record(_commandBuffer);
     }
 
-    void Texture::CopyBufferToImage(VkBuffer _buffer, VkImage _image, uint32_t _width, uint32_t _height)
+    void Texture::CopyBufferToImage(VkCommandBuffer _commandBuffer, VkBuffer _buffer, VkImage _image, uint32_t _width, uint32_t _height)
     {
-        VkCommandBuffer commandBuffer{ m_VKDeviceHandle->BeginSingleTimeCommands() };
-
         VkBufferImageCopy region{};
         region.bufferOffset = 0;
         region.bufferRowLength = 0;
@@ -263,9 +219,7 @@ namespace Minerva::Vulkan
             1
         };
 
-        vkCmdCopyBufferToImage(commandBuffer, _buffer, _image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-
-        m_VKDeviceHandle->EndSingleTimeCommands(commandBuffer);
+        vkCmdCopyBufferToImage(_commandBuffer, _buffer, _image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
     }
 
     VkFormat Texture::ConvertFormat(Minerva::Tools::PixelFormat::ImageFormat _format,
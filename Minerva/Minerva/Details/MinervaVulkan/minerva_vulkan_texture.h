@@ -13,6 +13,7 @@ namespace Minerva::Vulkan
 
 		inline VkImageView GetVKImageView() const { return m_VKImageView; }
 		inline VkSampler GetVKSampler() const { return m_VKSampler; }
+		inline ResourceState& GetResourceState() { return m_State; }
 
 	private:
 		// Vulkan handles
@@ -31,11 +32,12 @@ namespace Minerva::Vulkan
 		Minerva::Tools::PixelFormat::ColorSpace m_ColorSpace;
 		Minerva::Tools::PixelFormat::Signedness m_Signedness;*/
 		uint32_t m_MipLevels;
+		ResourceState m_State;
 
 		uint32_t FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
 		void CreateBuffer(VkDeviceSize _size, VkBufferUsageFlags _usage, VkMemoryPropertyFlags _properties, VkBuffer& _buffer, VkDeviceMemory& _bufferMemory);
-		void TransitionImageLayout(VkImage _image, VkFormat _format, VkImageLayout _oldLayout, VkImageLayout _newLayout);
-		void CopyBufferToImage(VkBuffer _buffer, VkImage _image, uint32_t _width, uint32_t _height);
+		void TransitionImageLayout(VkCommandBuffer _commandBuffer, VkImageLayout _newLayout, const BarrierBatch::SyncState& _sync, bool _write);
+		void CopyBufferToImage(VkCommandBuffer _commandBuffer, VkBuffer _buffer, VkImage _image, uint32_t _width, uint32_t _height);
 	};
 }
 
@@ -33,6 +33,7 @@ namespace Minerva::Vulkan
 				case Minerva::VertexDescriptor::Format::FLOAT_4D:               return std::pair{ VK_FORMAT_R32G32B32A32_SFLOAT,  16 };
 				case Minerva::VertexDescriptor::Format::UINT8_1D_NORMALIZED:    return std::pair{ VK_FORMAT_R8_UNORM,             1 };
 				case Minerva::VertexDescriptor::Format::UINT8_4D_NORMALIZED:    return std::pair{ VK_FORMAT_R8G8B8A8_UNORM,       4 };
+				case Minerva::VertexDescriptor::Format::UINT8_4D:               return std::pair{ VK_FORMAT_R8G8B8A8_UINT,        4 };
 				/*case Minerva::VertexDescriptor::Format::UINT8_1D:               return std::pair{ VK_FORMAT_R8_UINT,              1 };
 				case Minerva::VertexDescriptor::Format::UINT16_1D:              return std::pair{ VK_FORMAT_R16_UINT,             2 };
 				case Minerva::VertexDescriptor::Format::UINT32_1D:              return std::pair{ VK_FORMAT_R32_UINT,             4 };
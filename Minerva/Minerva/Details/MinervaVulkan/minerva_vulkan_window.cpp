@@ -10,8 +10,8 @@ namespace Minerva::Vulkan
         m_VKInstanceHandle{ _device->GetVKInstanceHandle() }, m_VKDeviceHandle{ _device }, m_VKRenderpassHandle{ nullptr }, // Handles
         m_VKSurface{ VK_NULL_HANDLE }, m_VKSwapChain{ VK_NULL_HANDLE }, // Vulkan properties
         m_VKSwapChainImages{}, m_VKSwapChainImageViews{}, m_VKSwapChainImageFormat{}, m_VKSwapExtent{ 0 },
-        m_VKCommandPool{ VK_NULL_HANDLE }, m_VKCommandBuffers{}, // Command pool and buffers
-        m_VKImageAvailableSemaphores{}, m_VKRenderCompleteSemaphores{}, m_VKInFlightFences{}, m_CurrentFrame{ 0 }, m_ImageIndex{ 0 }, // Sync objects
+        m_FrameCommands{}, // Command pools and buffers
+        m_VKImageAvailableSemaphores{}, m_VKRenderCompleteSemaphores{}, m_VKInFlightFences{}, m_CurrentFrame{ 0 }, m_ImageIndex{ 0 }, m_IsRecording{ false }, // Sync objects
         m_hInstance{ nullptr }, m_hWND{ nullptr }, // Win32 properties
         m_Width{ _width }, m_Height{ _height }, m_FullScreen{ _fullscreen }, m_VSync{ _vsync }, // Window properties
         m_Minimized{ false }, m_Resized{ false }
@@ -50,9 +50,8 @@ namespace Minerva::Vulkan
             vkDestroyFence(m_VKDeviceHandle->GetVKDevice(), m_VKInFlightFences[i], nullptr);
         }
 
-        // Destroy command pool
-        if (m_VKCommandPool != VK_NULL_HANDLE)
-            vkDestroyCommandPool(m_VKDeviceHandle->GetVKDevice(), m_VKCommandPool, nullptr);
+        // Destroy command pools, frees their command buffers
+        DestroyCommandBuffers();
 
         // Destroy all image view
         for (auto imageView : m_VKSwapChainImageViews)
@@ -228,35 +227,90 @@ namespace Minerva::Vulkan
 
     void Window::CreateCommandBuffers()
     {
-        // Create Command Pool
+        // Pools are reset as a whole every frame, buffers are never reset individually
         VkCommandPoolCreateInfo commandPoolCreateInfo{
             .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
-            .flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT, // All command buffers are resettable together
+            .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
             .queueFamilyIndex = m_VKDeviceHandle->GetMainQueueIndex()
         };
 
-        if (auto VkErr{ vkCreateCommandPool(m_VKDeviceHandle->GetVKDevice(), &commandPoolCreateInfo, nullptr, &m_VKCommandPool)}; VkErr)
+        auto CreatePool = [&]()
         {
-            Logger::Log_Error("Unable to create Command Pool. vkCreateCommandPool failed.");
-            throw std::runtime_error("Unable to create Command Pool. vkCreateCommandPool failed.");
+            VkCommandPool commandPool{ VK_NULL_HANDLE };
+            if (auto VkErr{ vkCreateCommandPool(m_VKDeviceHandle->GetVKDevice(), &commandPoolCreateInfo, nullptr, &commandPool) }; VkErr)
+            {
+                Logger::Log_Error("Unable to create Command Pool. vkCreateCommandPool failed.");
+                throw std::runtime_error("Unable to create Command Pool. vkCreateCommandPool failed.");
+            }
+            return commandPool;
+        };
+
+        // One primary command buffer per frame in flight, indexed by m_CurrentFrame
+        m_FrameCommands.resize(MAX_FRAMES_IN_FLIGHT);
+        for (FrameCommands& frame : m_FrameCommands)
+        {
+            frame.m_VKCommandPool = CreatePool();
+
+            // Describe command buffer
+            VkCommandBufferAllocateInfo commandBufferAllocInfo{
+                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+                .commandPool = frame.m_VKCommandPool,
+                .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+                .commandBufferCount = 1
+            };
+
+            if (auto VkErr{ vkAllocateCommandBuffers(m_VKDeviceHandle->GetVKDevice(), &commandBufferAllocInfo, &frame.m_VKCommandBuffer) }; VkErr)
+            {
+                Logger::Log_Error("Unable to allocate Command Buffers. vkAllocateCommandBuffer failed.");
+                throw std::runtime_error("Unable to allocate Command Buffers. vkAllocateCommandBuffer failed.");
+            }
+
+            // Secondary buffers are allocated on demand by AcquireSecondaryCommandBuffer
+            frame.m_SecondaryPools.resize(Minerva::Tools::Parallel::GetWorkerCount());
+            for (SecondaryCommandPool& secondaryPool : frame.m_SecondaryPools)
+                secondaryPool = SecondaryCommandPool{ .m_VKCommandPool = CreatePool(), .m_VKCommandBuffers = {}, .m_UsedCount = 0 };
         }
+    }
 
-        // Allocate as many Command Buffers as Framebuffers(same number as image views) -> Each Buffer will work on a specified frame buffer based on index
-        m_VKCommandBuffers.resize(m_VKSwapChainImageViews.size());
+    void Window::DestroyCommandBuffers()
+    {
+        for (FrameCommands& frame : m_FrameCommands)
+        {
+            for (SecondaryCommandPool& secondaryPool : frame.m_SecondaryPools)
+                if (secondaryPool.m_VKCommandPool != VK_NULL_HANDLE)
+                    vkDestroyCommandPool(m_VKDeviceHandle->GetVKDevice(), secondaryPool.m_VKCommandPool, nullptr);
 
-        // Describe command buffers
-        VkCommandBufferAllocateInfo commandBufferAllocInfo{
-            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
-            .commandPool = m_VKCommandPool,
-            .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY, // Currently all are primary cmd buffers
-            .commandBufferCount = static_cast<uint32_t>(m_VKCommandBuffers.size())
-        };
+            if (frame.m_VKCommandPool != VK_NULL_HANDLE)
+                vkDestroyCommandPool(m_VKDeviceHandle->GetVKDevice(), frame.m_VKCommandPool, nullptr);
+        }
+        m_FrameCommands.clear();
+    }
+
+    VkCommandBuffer Window::AcquireSecondaryCommandBuffer(size_t _worker)
+    {
+        std::vector<SecondaryCommandPool>& secondaryPools{ m_FrameCommands[m_CurrentFrame].m_SecondaryPools };
+        SecondaryCommandPool& secondaryPool{ secondaryPools[_worker % secondaryPools.size()] };
 
-        if (auto VkErr{ vkAllocateCommandBuffers(m_VKDeviceHandle->GetVKDevice(), &commandBufferAllocInfo, m_VKCommandBuffers.data())}; VkErr)
+        // Grow the pool the first time a frame needs more buffers, later frames reuse them
+        if (secondaryPool.m_UsedCount == secondaryPool.m_VKCommandBuffers.size())
         {
-            Logger::Log_Error("Unable to allocate Command Buffers. vkAllocateCommandBuffer failed.");
-            throw std::runtime_error("Unable to allocate Command Buffers. vkAllocateCommandBuffer failed.");
+            VkCommandBufferAllocateInfo commandBufferAllocInfo{
+                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+                .commandPool = secondaryPool.m_VKCommandPool,
+                .level = VK_COMMAND_BUFFER_LEVEL_SECONDARY,
+                .commandBufferCount = 1
+            };
+
+            VkCommandBuffer commandBuffer{ VK_NULL_HANDLE };
+            if (auto VkErr{ vkAllocateCommandBuffers(m_VKDeviceHandle->GetVKDevice(), &commandBufferAllocInfo, &commandBuffer) }; VkErr)
+            {
+                Logger::Log_Error("Unable to allocate secondary Command Buffer. vkAllocateCommandBuffer failed.");
+                throw std::runtime_error("Unable to allocate secondary Command Buffer. vkAllocateCommandBuffer failed.");
+            }
+            secondaryPool.m_VKCommandBuffers.push_back(commandBuffer);
         }
+
+        return secondaryPool.m_VKCommandBuffers[secondaryPool.m_UsedCount++];
     }
 
     void Window::CreateSyncObjects()
@@ -486,8 +540,16 @@ namespace Minerva::Vulkan
         // Reset fence to be reused
         vkResetFences(m_VKDeviceHandle->GetVKDevice(), 1, &m_VKInFlightFences[m_CurrentFrame]);
 
-        // Reset command buffer
-        vkResetCommandBuffer(m_VKCommandBuffers[m_CurrentFrame] /*VkCommandBufferResetFlagBits*/, 0);
+        // Recycle every command buffer of the frame, the fence guarantees the GPU is done with them
+        FrameCommands& frame{ m_FrameCommands[m_CurrentFrame] };
+        vkResetCommandPool(m_VKDeviceHandle->GetVKDevice(), frame.m_VKCommandPool, 0);
+        for (SecondaryCommandPool& secondaryPool : frame.m_SecondaryPools)
+        {
+            if (secondaryPool.m_UsedCount == 0) continue;
+            vkResetCommandPool(m_VKDeviceHandle->GetVKDevice(), secondaryPool.m_VKCommandPool, 0);
+            secondaryPool.m_UsedCount = 0;
+        }
+        m_IsRecording = false;
 
         return Minerva::Window::RenderStatus::RENDER_OK;
     }
@@ -495,10 +557,9 @@ namespace Minerva::Vulkan
     Minerva::Window::RenderStatus Window::PageFlip()
     {
         Minerva::Window::RenderStatus retval{ Minerva::Window::RenderStatus::RENDER_OK };
-        // End Render Pass
-        vkCmdEndRenderPass(m_VKCommandBuffers[m_CurrentFrame]);
+        // The render pass was ended by Minerva::Window::PageFlip, this file is compiled before Renderpass is complete
         // End Command Buffer
-        if (vkEndCommandBuffer(m_VKCommandBuffers[m_CurrentFrame]) != VK_SUCCESS) {
+        if (vkEndCommandBuffer(m_FrameCommands[m_CurrentFrame].m_VKCommandBuffer) != VK_SUCCESS) {
             Logger::Log_Error("Failed to record Command Buffer");
             throw std::runtime_error("Failed to record Command Buffer");
         }
@@ -515,7 +576,7 @@ namespace Minerva::Vulkan
         submitInfo.pWaitDstStageMask = waitStages;
         // Set command buffers to be submitted
         submitInfo.commandBufferCount = 1;
-        submitInfo.pCommandBuffers = &m_VKCommandBuffers[m_CurrentFrame];
+        submitInfo.pCommandBuffers = &m_FrameCommands[m_CurrentFrame].m_VKCommandBuffer;
         // Set render complete semaphore
         VkSemaphore signalSemaphores[] = { m_VKRenderCompleteSemaphores[m_CurrentFrame] };
         submitInfo.signalSemaphoreCount = 1;
@@ -557,6 +618,9 @@ namespace Minerva::Vulkan
 
         vkQueueWaitIdle(m_VKDeviceHandle->GetMainQueue());
 
+        // Everything recorded so far has executed, tracked resources start the next frame without pending accesses
+        m_VKDeviceHandle->GetResourceTracker().AdvanceEpoch();
+
         // Increment to next frame
         m_CurrentFrame = (m_CurrentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
         return retval;
@@ -588,9 +652,19 @@ namespace Minerva::Vulkan
         CreateSwapChain();
     }
 
-    Minerva::CommandBuffer Window::GetCommandBuffer()
+    Minerva::CommandBuffer Window::GetComputeCommandBuffer()
+    {
+        const bool isRecording{ m_IsRecording };
+        m_IsRecording = true;
+        return Minerva::CommandBuffer(nullptr, m_FrameCommands[m_CurrentFrame].m_VKCommandBuffer, m_VKSwapExtent, m_ImageIndex, isRecording);
+    }
+
+    Minerva::CommandBuffer Window::GetCommandBuffer(VkSubpassContents _contents)
     {
-        return Minerva::CommandBuffer(m_VKRenderpassHandle, m_VKCommandBuffers[m_CurrentFrame], m_VKSwapExtent, m_ImageIndex);
+        const bool isRecording{ m_IsRecording };
+        m_IsRecording = true;
+        return Minerva::CommandBuffer(std::make_shared<Minerva::Vulkan::CommandBuffer>(
+            m_VKRenderpassHandle, m_FrameCommands[m_CurrentFrame].m_VKCommandBuffer, m_VKSwapExtent, m_ImageIndex, isRecording, _contents, this));
     }
     
 }
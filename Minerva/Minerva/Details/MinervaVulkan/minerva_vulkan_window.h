@@ -23,11 +23,23 @@ namespace Minerva::Vulkan
 
 		inline const VkExtent2D GetVKSwapExtent() const { return m_VKSwapExtent; }
 		inline const VkFormat GetVKImageFormat() const { return m_VKSwapChainImageFormat; }
+		inline const std::vector<VkImage>& GetVKSwapImages() const { return m_VKSwapChainImages; }
 		inline const std::vector<VkImageView>& GetVKSwapImageViews() const { return m_VKSwapChainImageViews; }
+		inline uint32_t GetFrameIndex() const { return m_CurrentFrame; }
+		inline uint32_t GetImageIndex() const { return m_ImageIndex; }
+		inline VkCommandBuffer GetVKFrameCommandBuffer() const { return m_FrameCommands[m_CurrentFrame].m_VKCommandBuffer; }
+		inline std::shared_ptr<Minerva::Vulkan::Renderpass> GetVKRenderpassHandle() const { return m_VKRenderpassHandle; }
+		inline uint32_t GetFrameCount() const { return static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT); }
 
 		// Actual Functionalities
-		Minerva::CommandBuffer GetCommandBuffer();
+		Minerva::CommandBuffer GetComputeCommandBuffer();
+		Minerva::CommandBuffer GetCommandBuffer(VkSubpassContents _contents = VK_SUBPASS_CONTENTS_INLINE);
+
+		// Next free secondary command buffer of _worker's pool for the current frame. Each worker only touches its own pool,
+		// so workers may call this concurrently. The pools are reset together in BeginRender
+		VkCommandBuffer AcquireSecondaryCommandBuffer(size_t _worker);
 		Minerva::Window::RenderStatus BeginRender(std::shared_ptr<Minerva::Vulkan::Renderpass> _renderpass);
+		// Submits and presents the frame. Its render pass must have been ended
 		Minerva::Window::RenderStatus PageFlip();
 
 		void SetWindowValues(int _width, int _height, bool _isMinimized);
@@ -51,17 +63,33 @@ namespace Minerva::Vulkan
 		std::vector<VkImageView> m_VKSwapChainImageViews;
 		VkFormat m_VKSwapChainImageFormat;
 		VkExtent2D m_VKSwapExtent;
-		VkCommandPool m_VKCommandPool;
-		std::vector<VkCommandBuffer> m_VKCommandBuffers;
-		std::vector<CommandBuffer> m_CommandBuffers;
+
+		// Command pools are per frame in flight and per worker thread, so a whole frame is recycled with one reset per pool
+		// and recording threads never share a pool
+		struct SecondaryCommandPool
+		{
+			VkCommandPool m_VKCommandPool{ VK_NULL_HANDLE };
+			std::vector<VkCommandBuffer> m_VKCommandBuffers{};
+			uint32_t m_UsedCount{ 0 }; // Buffers handed out this frame
+		};
+
+		struct FrameCommands
+		{
+			VkCommandPool m_VKCommandPool{ VK_NULL_HANDLE };
+			VkCommandBuffer m_VKCommandBuffer{ VK_NULL_HANDLE }; // Primary, submitted in PageFlip
+			std::vector<SecondaryCommandPool> m_SecondaryPools{}; // One per worker thread
+		};
+
+		std::vector<FrameCommands> m_FrameCommands;
 
 		// Synchronization
-		const int MAX_FRAMES_IN_FLIGHT = 2;
+		static constexpr int MAX_FRAMES_IN_FLIGHT = 2;
 		std::vector<VkSemaphore> m_VKImageAvailableSemaphores; // Signals that image in a frame has been acquired from swap chain
 		std::vector<VkSemaphore> m_VKRenderCompleteSemaphores; // Signals that rendering in a frame is finished
 		std::vector<VkFence> m_VKInFlightFences; // Ensures a frame is rendering at one time
 		uint32_t m_CurrentFrame;
 		uint32_t m_ImageIndex;
+		bool m_IsRecording; // Frame command buffer has been begun
 
 		// WIN32 API properties
 		HMODULE m_hInstance;
@@ -82,6 +110,7 @@ namespace Minerva::Vulkan
 		void CreateSwapChain();
 		void CreateImageViews();
 		void CreateCommandBuffers();
+		void DestroyCommandBuffers();
 		void CreateSyncObjects();
 	};
 }
@@ -2,10 +2,15 @@
 
 namespace Minerva
 {
-	Buffer::Buffer(Minerva::Device& _device, Type _type, const void* _data, uint32_t _size) :
+	Buffer::Buffer(Minerva::Device& _device, Type _type, const void* _data, uint32_t _size, IndexType _indexType) :
 		m_VKBufferHandle{ nullptr }
 	{
-		m_VKBufferHandle = std::make_shared<Minerva::Vulkan::Buffer>(_device.GetVKDeviceHandle(), _type, _data, _size);
+		m_VKBufferHandle = std::make_shared<Minerva::Vulkan::Buffer>(_device.GetVKDeviceHandle(), _type, _data, _size, _indexType);
+	}
+
+	inline void Buffer::Upload(const void* _data, uint32_t _offset, uint32_t _size)
+	{
+		m_VKBufferHandle->Upload(_data, _offset, _size);
 	}
 
 	inline std::shared_ptr<Minerva::Vulkan::Buffer> Buffer::GetVKBufferHandle() const
@@ -14,4 +19,6 @@ namespace Minerva
 	}
 
 	inline VkBuffer Buffer::GetVKBuffer() const { return m_VKBufferHandle->GetVKBuffer(); }
+
+	inline Buffer::IndexType Buffer::GetIndexType() const { return m_VKBufferHandle->GetIndexType(); }
 }
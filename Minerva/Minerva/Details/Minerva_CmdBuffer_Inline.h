@@ -2,10 +2,47 @@
 
 namespace Minerva
 {
-	CommandBuffer::CommandBuffer(std::shared_ptr<Minerva::Vulkan::Renderpass> _renderpass, VkCommandBuffer _vkCommandBuffer, VkExtent2D _extent, int _index) :
+	CommandBuffer::CommandBuffer(std::shared_ptr<Minerva::Vulkan::Renderpass> _renderpass, VkCommandBuffer _vkCommandBuffer, VkExtent2D _extent, int _index, bool _isRecording) :
 		m_VKCommandBufferHandle{ nullptr }
 	{
-		m_VKCommandBufferHandle = std::make_shared<Minerva::Vulkan::CommandBuffer>(_renderpass, _vkCommandBuffer, _extent, _index);
+		m_VKCommandBufferHandle = std::make_shared<Minerva::Vulkan::CommandBuffer>(_renderpass, _vkCommandBuffer, _extent, _index, _isRecording);
+	}
+
+	CommandBuffer::CommandBuffer(std::shared_ptr<Minerva::Vulkan::CommandBuffer> _vkCommandBufferHandle) :
+		m_VKCommandBufferHandle{ _vkCommandBufferHandle }
+	{
+	}
+
+	template<typename T_FUNCTION>
+	inline void CommandBuffer::RecordParallel(size_t _count, size_t _minBatchSize, T_FUNCTION&& _function)
+	{
+		// Every worker handles exactly one range, so indexing by worker keeps the ranges in order
+		std::vector<std::shared_ptr<Minerva::Vulkan::CommandBuffer>> secondaryCommandBuffers(Minerva::Tools::Parallel::GetWorkerCount());
+
+		Minerva::Tools::Parallel::ForRange(_count, _minBatchSize, [&](size_t _begin, size_t _end, size_t _worker)
+		{
+			Minerva::CommandBuffer secondaryCommandBuffer{ m_VKCommandBufferHandle->BeginSecondary(_worker) };
+			_function(secondaryCommandBuffer, _begin, _end);
+			secondaryCommandBuffer.m_VKCommandBufferHandle->End();
+			secondaryCommandBuffers[_worker] = secondaryCommandBuffer.m_VKCommandBufferHandle;
+		});
+
+		m_VKCommandBufferHandle->ExecuteCommands(secondaryCommandBuffers);
+	}
+
+	inline void CommandBuffer::SuspendRenderpass()
+	{
+		m_VKCommandBufferHandle->SuspendRenderpass();
+	}
+
+	inline void CommandBuffer::ResumeRenderpass()
+	{
+		m_VKCommandBufferHandle->ResumeRenderpass();
+	}
+
+	inline void CommandBuffer::NextSubpass()
+	{
+		m_VKCommandBufferHandle->NextSubpass();
 	}
 
 	inline void CommandBuffer::BindGraphicsPipeline(Minerva::Pipeline& _pipeline)
@@ -13,11 +50,21 @@ namespace Minerva
 		m_VKCommandBufferHandle->BindGraphicsPipeline(_pipeline.GetVKPipelineHandle());
 	}
 
+	inline void CommandBuffer::BindComputePipeline(Minerva::Pipeline& _pipeline)
+	{
+		m_VKCommandBufferHandle->BindComputePipeline(_pipeline.GetVKPipelineHandle());
+	}
+
 	inline void CommandBuffer::BindBuffer(Minerva::Buffer& _buffer)
 	{
 		m_VKCommandBufferHandle->BindBuffer(_buffer.GetVKBufferHandle());
 	}
 
+	inline void CommandBuffer::BindVertexBuffer(Minerva::Buffer& _buffer, uint32_t _offset)
+	{
+		m_VKCommandBufferHandle->BindVertexBuffer(_buffer.GetVKBufferHandle(), _offset);
+	}
+
 	inline void CommandBuffer::BindDescriptorSet(Minerva::Pipeline& _pipeline, Minerva::DescriptorSet& _descriptorSet)
 	{
 		m_VKCommandBufferHandle->BindDescriptorSet(_pipeline.GetVKPipelineHandle(), _descriptorSet.GetVKDescriptorSetHandle());
@@ -33,9 +80,63 @@ namespace Minerva
 		m_VKCommandBufferHandle->DrawIndexed(_indexCount, _instanceCount, _firstIndex, _vertexOffset, _firstInstance);
 	}
 
+	inline void CommandBuffer::DrawIndirect(Minerva::Buffer& _buffer, uint32_t _offset, uint32_t _drawCount, uint32_t _stride)
+	{
+		m_VKCommandBufferHandle->DrawIndirect(_buffer.GetVKBufferHandle(), _offset, _drawCount, _stride);
+	}
+
+	inline void CommandBuffer::DrawIndexedIndirect(Minerva::Buffer& _buffer, uint32_t _offset, uint32_t _drawCount, uint32_t _stride)
+	{
+		m_VKCommandBufferHandle->DrawIndexedIndirect(_buffer.GetVKBufferHandle(), _offset, _drawCount, _stride);
+	}
+
+	inline void CommandBuffer::DrawIndirectCount(Minerva::Buffer& _buffer, uint32_t _offset, Minerva::Buffer& _countBuffer, uint32_t _countOffset, uint32_t _maxDrawCount, uint32_t _stride)
+	{
+		m_VKCommandBufferHandle->DrawIndirectCount(_buffer.GetVKBufferHandle(), _offset, _countBuffer.GetVKBufferHandle(), _countOffset, _maxDrawCount, _stride);
+	}
+
+	inline void CommandBuffer::DrawIndexedIndirectCount(Minerva::Buffer& _buffer, uint32_t _offset, Minerva::Buffer& _countBuffer, uint32_t _countOffset, uint32_t _maxDrawCount, uint32_t _stride)
+	{
+		m_VKCommandBufferHandle->DrawIndexedIndirectCount(_buffer.GetVKBufferHandle(), _offset, _countBuffer.GetVKBufferHandle(), _countOffset, _maxDrawCount, _stride);
+	}
+
+	inline void CommandBuffer::Dispatch(uint32_t _groupCountX, uint32_t _groupCountY, uint32_t _groupCountZ)
+	{
+		m_VKCommandBufferHandle->Dispatch(_groupCountX, _groupCountY, _groupCountZ);
+	}
+
+	inline void CommandBuffer::DispatchIndirect(Minerva::Buffer& _buffer, uint32_t _offset)
+	{
+		m_VKCommandBufferHandle->DispatchIndirect(_buffer.GetVKBufferHandle(), _offset);
+	}
+
+	inline void CommandBuffer::UpdateBuffer(Minerva::Buffer& _buffer, uint32_t _offset, uint32_t _size, const void* _pData)
+	{
+		m_VKCommandBufferHandle->UpdateBuffer(_buffer.GetVKBufferHandle(), _offset, _size, _pData);
+	}
+
 	inline void CommandBuffer::PushConstant(Minerva::Pipeline& _pipeline, Minerva::Shader::Type _stage, uint32_t _offset, uint32_t _size, const void* _pValue)
 	{
 		m_VKCommandBufferHandle->PushConstant(_pipeline.GetVKPipelineHandle(), _stage, _offset, _size, _pValue);
 	}
 
+	inline const CommandBuffer::Statistics& CommandBuffer::GetStatistics() const { return m_VKCommandBufferHandle->GetStatistics(); }
+
+	inline std::shared_ptr<Minerva::Vulkan::CommandBuffer> CommandBuffer::GetVKCommandBufferHandle() const { return m_VKCommandBufferHandle; }
+
+	inline CommandBuffer::Statistics& CommandBuffer::Statistics::operator+=(const Statistics& _other)
+	{
+		m_PipelineBinds += _other.m_PipelineBinds;
+		m_DescriptorSetBinds += _other.m_DescriptorSetBinds;
+		m_VertexBufferBinds += _other.m_VertexBufferBinds;
+		m_IndexBufferBinds += _other.m_IndexBufferBinds;
+		m_DynamicStateSets += _other.m_DynamicStateSets;
+		m_SkippedPipelineBinds += _other.m_SkippedPipelineBinds;
+		m_SkippedDescriptorSetBinds += _other.m_SkippedDescriptorSetBinds;
+		m_SkippedVertexBufferBinds += _other.m_SkippedVertexBufferBinds;
+		m_SkippedIndexBufferBinds += _other.m_SkippedIndexBufferBinds;
+		m_SkippedDynamicStateSets += _other.m_SkippedDynamicStateSets;
+		m_PipelineBarriers += _other.m_PipelineBarriers;
+		return *this;
+	}
 }
@@ -0,0 +1,89 @@
+#pragma once
+
+namespace Minerva
+{
+	ComputeSkinner::ComputeSkinner(Minerva::Device& _device, Minerva::Window& _window, Minerva::JointPalette& _palette,
+		std::span<const Minerva::JointPalette::SkinnedVertex> _vertices, uint32_t _jointCount, uint32_t _maxInstanceCount,
+		const Minerva::Shader& _skinShader) :
+		m_VKWindowHandle{ _window.GetVKWindowHandle() },
+		m_Layouts{ {
+			{ 0, Minerva::DescriptorSet::DescriptorType::STORAGE_BUFFER, 1, Minerva::Shader::Type::COMPUTE }, // Joint matrices
+			{ 1, Minerva::DescriptorSet::DescriptorType::STORAGE_BUFFER, 1, Minerva::Shader::Type::COMPUTE }, // Source vertices
+			{ 2, Minerva::DescriptorSet::DescriptorType::STORAGE_BUFFER, 1, Minerva::Shader::Type::COMPUTE }  // Skinned vertices
+		} },
+		m_SourceBuffer{ _device, Minerva::Buffer::Type::STORAGE, _vertices.data(), static_cast<uint32_t>(_vertices.size_bytes()) },
+		m_OutputBuffers{},
+		m_DescriptorSets{ CreateDescriptorSets(_device, _window, m_Layouts) },
+		m_Pipeline{ _device, _skinShader, m_DescriptorSets[0] },
+		m_VertexCount{ static_cast<uint32_t>(_vertices.size()) },
+		m_JointCount{ _jointCount },
+		m_MaxInstanceCount{ _maxInstanceCount },
+		m_InstanceCount{ 0 }
+	{
+		if (_vertices.empty() || _maxInstanceCount == 0)
+		{
+			Minerva::Vulkan::Logger::Log_Error("Unable to create ComputeSkinner. Mesh or instance count is empty.");
+			throw std::runtime_error("Unable to create ComputeSkinner. Mesh or instance count is empty.");
+		}
+
+		const uint32_t outputSize{ m_VertexCount * _maxInstanceCount * static_cast<uint32_t>(sizeof(Minerva::Mesh::Vertex)) };
+
+		m_OutputBuffers.reserve(m_DescriptorSets.size());
+		for (size_t i{ 0 }; i < m_DescriptorSets.size(); ++i)
+		{
+			m_OutputBuffers.emplace_back(_device, Minerva::Buffer::Type::STORAGE, nullptr, outputSize);
+
+			std::array<Minerva::Buffer, 1> source{ m_SourceBuffer };
+			std::array<Minerva::Buffer, 1> output{ m_OutputBuffers[i] };
+			m_DescriptorSets[i].Update(m_Layouts[1], source);
+			m_DescriptorSets[i].Update(m_Layouts[2], output);
+		}
+
+		_palette.WriteDescriptors(m_DescriptorSets, m_Layouts[0]);
+	}
+
+	inline void ComputeSkinner::Skin(Minerva::CommandBuffer& _computeCmdBuffer, uint32_t _instanceCount, uint32_t _firstMatrix)
+	{
+		m_InstanceCount = std::min(_instanceCount, m_MaxInstanceCount);
+		if (m_InstanceCount == 0) return;
+
+		const SkinData skinData{
+			.m_VertexCount = m_VertexCount,
+			.m_InstanceCount = m_InstanceCount,
+			.m_JointCount = m_JointCount,
+			.m_FirstMatrix = _firstMatrix
+		};
+
+		Minerva::DescriptorSet& descriptorSet{ m_DescriptorSets[m_VKWindowHandle->GetFrameIndex()] };
+
+		_computeCmdBuffer.BindComputePipeline(m_Pipeline);
+		_computeCmdBuffer.BindDescriptorSet(m_Pipeline, descriptorSet);
+		_computeCmdBuffer.PushConstant(m_Pipeline, Minerva::Shader::Type::COMPUTE, 0, sizeof(SkinData), &skinData);
+
+		// 64 vertices per workgroup along X, one instance per row along Y
+		_computeCmdBuffer.Dispatch((m_VertexCount + 63) / 64, m_InstanceCount, 1);
+	}
+
+	inline void ComputeSkinner::Draw(Minerva::CommandBuffer& _cmdBuffer, Minerva::Buffer& _indexBuffer, uint32_t _indexCount)
+	{
+		_cmdBuffer.BindVertexBuffer(GetOutputBuffer());
+		_cmdBuffer.BindBuffer(_indexBuffer);
+
+		// Every instance is a separate copy of the vertices, selected through vertexOffset
+		for (uint32_t i{ 0 }; i < m_InstanceCount; ++i)
+			_cmdBuffer.DrawIndexed(_indexCount, 1, 0, static_cast<int32_t>(i * m_VertexCount), 0);
+	}
+
+	inline Minerva::Buffer& ComputeSkinner::GetOutputBuffer() { return m_OutputBuffers[m_VKWindowHandle->GetFrameIndex()]; }
+
+	inline uint32_t ComputeSkinner::GetVertexCount() const { return m_VertexCount; }
+
+	std::vector<Minerva::DescriptorSet> ComputeSkinner::CreateDescriptorSets(Minerva::Device& _device, Minerva::Window& _window, std::span<Minerva::DescriptorSet::Layout> _layouts)
+	{
+		std::vector<Minerva::DescriptorSet> descriptorSets;
+		descriptorSets.reserve(_window.GetFrameCount());
+		for (uint32_t i{ 0 }; i < _window.GetFrameCount(); ++i)
+			descriptorSets.emplace_back(_device, _layouts);
+		return descriptorSets;
+	}
+}
@@ -8,6 +8,13 @@ namespace Minerva
 		m_VKDescriptorSetHandle = std::make_shared<Minerva::Vulkan::DescriptorSet>(_device.GetVKDeviceHandle(), _layouts);
 	}
 
+	DescriptorSet::DescriptorSet(Minerva::Device& _device, const Minerva::Shader* _shaders, int _shaderCount) :
+		m_VKDescriptorSetHandle{ nullptr }
+	{
+		std::vector<Layout> layouts{ ReflectLayouts(_shaders, _shaderCount) };
+		m_VKDescriptorSetHandle = std::make_shared<Minerva::Vulkan::DescriptorSet>(_device.GetVKDeviceHandle(), layouts);
+	}
+
 	DescriptorSet::~DescriptorSet() {}
 	
 	inline std::shared_ptr<Minerva::Vulkan::DescriptorSet> DescriptorSet::GetVKDescriptorSetHandle() const
@@ -15,6 +22,68 @@ namespace Minerva
 		return m_VKDescriptorSetHandle;
 	}
 
+	inline std::span<const DescriptorSet::Layout> DescriptorSet::GetLayouts() const { return m_VKDescriptorSetHandle->GetLayouts(); }
+
+	inline const DescriptorSet::Layout& DescriptorSet::GetLayout(uint32_t _bindingPoint) const
+	{
+		for (const Layout& layout : m_VKDescriptorSetHandle->GetLayouts())
+		{
+			if (layout.m_BindingPoint == _bindingPoint)
+				return layout;
+		}
+
+		Minerva::Vulkan::Logger::Log_Error("Unable to find descriptor set layout. No layout at this binding point.");
+		throw std::runtime_error("Unable to find descriptor set layout. No layout at this binding point.");
+	}
+
+	inline std::vector<DescriptorSet::Layout> DescriptorSet::ReflectLayouts(const Minerva::Shader* _shaders, int _shaderCount)
+	{
+		std::vector<Layout> layouts;
+		for (int i{ 0 }; i < _shaderCount; ++i)
+		{
+			for (const Minerva::Tools::SPIRVReflect::Binding& binding : _shaders[i].GetReflection().m_Bindings)
+			{
+				// Pipelines bind a single set
+				if (binding.m_Set != 0)
+				{
+					Minerva::Vulkan::Logger::Log_Error("Unable to reflect descriptor set layouts. Shader uses a descriptor set other than set 0.");
+					throw std::runtime_error("Unable to reflect descriptor set layouts. Shader uses a descriptor set other than set 0.");
+				}
+
+				const Layout layout{
+					.m_BindingPoint = binding.m_Binding,
+					.m_DescriptorType = static_cast<DescriptorType>(binding.m_Type),
+					.m_DescriptorCount = std::max(binding.m_Count, 1u),
+					.m_ShaderStage = _shaders[i].GetShaderType()
+				};
+
+				auto existing{ std::find_if(layouts.begin(), layouts.end(), [&layout](const Layout& _layout) { return _layout.m_BindingPoint == layout.m_BindingPoint; }) };
+				if (existing == layouts.end())
+				{
+					layouts.push_back(layout);
+					continue;
+				}
+
+				if (existing->m_DescriptorType != layout.m_DescriptorType || existing->m_DescriptorCount != layout.m_DescriptorCount)
+				{
+					Minerva::Vulkan::Logger::Log_Error("Unable to reflect descriptor set layouts. Shaders declare the same binding differently.");
+					throw std::runtime_error("Unable to reflect descriptor set layouts. Shaders declare the same binding differently.");
+				}
+				if (existing->m_ShaderStage != layout.m_ShaderStage)
+					existing->m_ShaderStage = Minerva::Shader::Type::ALL_GRAPHICS;
+			}
+		}
+
+		if (layouts.empty())
+		{
+			Minerva::Vulkan::Logger::Log_Error("Unable to reflect descriptor set layouts. Shaders declare no bindings.");
+			throw std::runtime_error("Unable to reflect descriptor set layouts. Shaders declare no bindings.");
+		}
+
+		std::sort(layouts.begin(), layouts.end(), [](const Layout& _a, const Layout& _b) { return _a.m_BindingPoint < _b.m_BindingPoint; });
+		return layouts;
+	}
+
 	inline void DescriptorSet::Update(const Layout& _layout, std::span<Minerva::Texture> _textures)
 	{
 		// Create a container of Vulkan texture handles
@@ -24,4 +93,39 @@ namespace Minerva
 
 		m_VKDescriptorSetHandle->Update(_layout, textures);
 	}
+
+	inline void DescriptorSet::Update(const Layout& _layout, std::span<Minerva::Buffer> _buffers)
+	{
+		// Create a container of Vulkan buffer handles
+		std::vector<std::shared_ptr<Minerva::Vulkan::Buffer>> buffers(_buffers.size());
+		for (int i{ 0 }; i < _buffers.size(); ++i)
+			buffers[i] = _buffers[i].GetVKBufferHandle();
+
+		m_VKDescriptorSetHandle->Update(_layout, buffers);
+	}
+
+	inline void DescriptorSet::Update(const Layout& _layout, Minerva::Renderpass& _renderpass, uint32_t _attachment)
+	{
+		if (_layout.m_DescriptorType != DescriptorType::INPUT_ATTACHMENT)
+		{
+			Minerva::Vulkan::Logger::Log_Error("Unable to update descriptor set. Render pass attachments are bound as INPUT_ATTACHMENT.");
+			throw std::runtime_error("Unable to update descriptor set. Render pass attachments are bound as INPUT_ATTACHMENT.");
+		}
+
+		const VkDescriptorImageInfo imageInfo{ _renderpass.GetVKRenderpassHandle()->GetVKInputAttachmentInfo(_attachment) };
+		m_VKDescriptorSetHandle->Update(_layout, std::span<const VkDescriptorImageInfo>{ &imageInfo, 1 });
+
+		// The attachment views change when the window resizes. The set is not kept alive by the render pass
+		std::weak_ptr<Minerva::Vulkan::DescriptorSet> descriptorSet{ m_VKDescriptorSetHandle };
+		_renderpass.GetVKRenderpassHandle()->AddRecreateCallback(m_VKDescriptorSetHandle.get(), _layout.m_BindingPoint, [descriptorSet, _layout, _attachment](const Minerva::Vulkan::Renderpass& _recreated)
+			{
+				std::shared_ptr<Minerva::Vulkan::DescriptorSet> handle{ descriptorSet.lock() };
+				if (!handle)
+					return false;
+
+				const VkDescriptorImageInfo imageInfo{ _recreated.GetVKInputAttachmentInfo(_attachment) };
+				handle->Update(_layout, std::span<const VkDescriptorImageInfo>{ &imageInfo, 1 });
+				return true;
+			});
+	}
 }
@@ -2,10 +2,10 @@
 
 namespace Minerva
 {
-	Device::Device(const Minerva::Instance& _instance, QueueFamily _queueFamily, Type _type) :
+	Device::Device(const Minerva::Instance& _instance, QueueFamily _queueFamily, Type _type, std::string_view _pipelineCachePath) :
 		m_VKDeviceHandle{ nullptr }
 	{
-		m_VKDeviceHandle = std::make_shared<Minerva::Vulkan::Device>(_instance.GetVKInstanceHandle(), _queueFamily, _type);
+		m_VKDeviceHandle = std::make_shared<Minerva::Vulkan::Device>(_instance.GetVKInstanceHandle(), _queueFamily, _type, _pipelineCachePath);
 	}
 
 	inline std::shared_ptr<Minerva::Vulkan::Device> Device::GetVKDeviceHandle() const { return m_VKDeviceHandle; }
@@ -13,4 +13,16 @@ namespace Minerva
 	inline Device::QueueFamily Device::GetQueueFamily() const { return m_VKDeviceHandle->GetQueueFamily(); }
 
 	inline Device::Type Device::GetDeviceType() const { return m_VKDeviceHandle->GetDeviceType(); }
+
+	inline bool Device::IsMultiDrawIndirectSupported() const { return m_VKDeviceHandle->IsMultiDrawIndirectSupported(); }
+
+	inline bool Device::IsDrawIndirectCountSupported() const { return m_VKDeviceHandle->IsDrawIndirectCountSupported(); }
+
+	inline bool Device::IsDynamicRenderingEnabled() const { return m_VKDeviceHandle->IsDynamicRenderingEnabled(); }
+
+	inline void Device::SavePipelineCache() { m_VKDeviceHandle->SavePipelineCache(); }
+
+	inline bool Device::IsPipelineCacheWarm() const { return m_VKDeviceHandle->IsPipelineCacheWarm(); }
+
+	inline double Device::GetPipelineCreationTime() const { return m_VKDeviceHandle->GetPipelineCreationTime(); }
 }
@@ -0,0 +1,83 @@
+#pragma once
+
+namespace Minerva
+{
+	GeometryPool::GeometryPool(Minerva::Device& _device, uint32_t _vertexStride, uint32_t _maxVertexCount, uint32_t _maxIndexCount, Minerva::Buffer::IndexType _indexType) :
+		m_VertexBuffer{ _device, Minerva::Buffer::Type::VERTEX, nullptr, _vertexStride * _maxVertexCount },
+		m_IndexBuffer{ _device, Minerva::Buffer::Type::INDEX, nullptr, _maxIndexCount * (_indexType == Minerva::Buffer::IndexType::UINT32 ? 4u : 2u), _indexType },
+		m_VertexStride{ _vertexStride },
+		m_MaxVertexCount{ _maxVertexCount },
+		m_MaxIndexCount{ _maxIndexCount },
+		m_VertexCount{ 0 },
+		m_IndexCount{ 0 }
+	{
+	}
+
+	GeometryPool::Range GeometryPool::Add(const void* _vertices, uint32_t _vertexCount, std::span<const uint32_t> _indices)
+	{
+		const uint32_t indexCount{ static_cast<uint32_t>(_indices.size()) };
+		if (m_VertexCount + _vertexCount > m_MaxVertexCount || m_IndexCount + indexCount > m_MaxIndexCount)
+		{
+			Minerva::Vulkan::Logger::Log_Error("Unable to add mesh to GeometryPool. Pool is full.");
+			throw std::runtime_error("Unable to add mesh to GeometryPool. Pool is full.");
+		}
+
+		const bool is16Bit{ m_IndexBuffer.GetIndexType() == Minerva::Buffer::IndexType::UINT16 };
+		if (is16Bit && Minerva::Tools::MeshLoader::RequiresUInt32Indices(_vertexCount))
+		{
+			Minerva::Vulkan::Logger::Log_Error("Unable to add mesh to GeometryPool. Mesh has too many vertices for 16-bit indices.");
+			throw std::runtime_error("Unable to add mesh to GeometryPool. Mesh has too many vertices for 16-bit indices.");
+		}
+
+		const Range range{ m_IndexCount, indexCount, static_cast<int32_t>(m_VertexCount), _vertexCount };
+
+		if (_vertexCount > 0)
+			m_VertexBuffer.Upload(_vertices, m_VertexCount * m_VertexStride, _vertexCount * m_VertexStride);
+
+		if (indexCount > 0)
+		{
+			if (is16Bit)
+			{
+				std::vector<uint16_t> indices(_indices.size());
+				for (size_t i{ 0 }; i < indices.size(); ++i)
+					indices[i] = static_cast<uint16_t>(_indices[i]);
+				m_IndexBuffer.Upload(indices.data(), m_IndexCount * sizeof(uint16_t), indexCount * sizeof(uint16_t));
+			}
+			else
+				m_IndexBuffer.Upload(_indices.data(), m_IndexCount * sizeof(uint32_t), indexCount * sizeof(uint32_t));
+		}
+
+		m_VertexCount += _vertexCount;
+		m_IndexCount += indexCount;
+		return range;
+	}
+
+	inline GeometryPool::Range GeometryPool::Add(const Minerva::Tools::MeshLoader::MeshData& _meshData)
+	{
+		if (m_VertexStride != sizeof(Minerva::Tools::MeshLoader::Vertex))
+		{
+			Minerva::Vulkan::Logger::Log_Error("Unable to add mesh to GeometryPool. Pool stride does not match Minerva::Mesh::Vertex.");
+			throw std::runtime_error("Unable to add mesh to GeometryPool. Pool stride does not match Minerva::Mesh::Vertex.");
+		}
+		return Add(_meshData.m_Vertices.data(), static_cast<uint32_t>(_meshData.m_Vertices.size()), _meshData.m_Indices);
+	}
+
+	inline void GeometryPool::Bind(Minerva::CommandBuffer& _cmdBuffer)
+	{
+		_cmdBuffer.BindBuffer(m_VertexBuffer);
+		_cmdBuffer.BindBuffer(m_IndexBuffer);
+	}
+
+	inline void GeometryPool::Draw(Minerva::CommandBuffer& _cmdBuffer, const Range& _range, uint32_t _instanceCount, uint32_t _firstInstance)
+	{
+		_cmdBuffer.DrawIndexed(_range.m_IndexCount, _instanceCount, _range.m_FirstIndex, _range.m_VertexOffset, _firstInstance);
+	}
+
+	inline Minerva::Buffer& GeometryPool::GetVertexBuffer() { return m_VertexBuffer; }
+
+	inline Minerva::Buffer& GeometryPool::GetIndexBuffer() { return m_IndexBuffer; }
+
+	inline uint32_t GeometryPool::GetVertexCount() const { return m_VertexCount; }
+
+	inline uint32_t GeometryPool::GetIndexCount() const { return m_IndexCount; }
+}
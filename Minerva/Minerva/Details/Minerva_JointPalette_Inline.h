@@ -0,0 +1,66 @@
+#pragma once
+
+namespace Minerva
+{
+	JointPalette::JointPalette(Minerva::Device& _device, Minerva::Window& _window, uint32_t _maxMatrixCount) :
+		m_VKWindowHandle{ _window.GetVKWindowHandle() },
+		m_Buffers{},
+		m_Matrices(_maxMatrixCount, glm::mat4{ 1.f })
+	{
+		if (_maxMatrixCount == 0)
+		{
+			Minerva::Vulkan::Logger::Log_Error("Unable to create JointPalette. Matrix count is zero.");
+			throw std::runtime_error("Unable to create JointPalette. Matrix count is zero.");
+		}
+
+		m_Buffers.reserve(_window.GetFrameCount());
+		for (uint32_t i{ 0 }; i < _window.GetFrameCount(); ++i)
+			m_Buffers.emplace_back(_device, Minerva::Buffer::Type::DYNAMIC_STORAGE, m_Matrices.data(), static_cast<uint32_t>(m_Matrices.size() * sizeof(glm::mat4)));
+	}
+
+	void JointPalette::Update(std::span<const Character> _characters)
+	{
+		uint32_t matrixCount{ 0 };
+		for (const Character& character : _characters)
+		{
+			const size_t end{ character.m_PaletteOffset + (character.m_Skeleton ? character.m_Skeleton->m_Parents.size() : 0) };
+			if (end > m_Matrices.size())
+			{
+				Minerva::Vulkan::Logger::Log_Error("Unable to update JointPalette. Character palette exceeds the matrix count.");
+				throw std::runtime_error("Unable to update JointPalette. Character palette exceeds the matrix count.");
+			}
+			matrixCount = std::max(matrixCount, static_cast<uint32_t>(end));
+		}
+
+		Minerva::Tools::Animation::EvaluatePalettes(_characters, m_Matrices);
+
+		if (matrixCount > 0)
+			GetCurrentBuffer().Upload(m_Matrices.data(), 0, matrixCount * static_cast<uint32_t>(sizeof(glm::mat4)));
+	}
+
+	inline void JointPalette::WriteDescriptors(std::span<Minerva::DescriptorSet> _descriptorSets, const Minerva::DescriptorSet::Layout& _layout)
+	{
+		for (size_t i{ 0 }; i < _descriptorSets.size() && i < m_Buffers.size(); ++i)
+		{
+			std::array<Minerva::Buffer, 1> buffer{ m_Buffers[i] };
+			_descriptorSets[i].Update(_layout, buffer);
+		}
+	}
+
+	inline Minerva::Buffer& JointPalette::GetBuffer(uint32_t _frame) { return m_Buffers[_frame]; }
+
+	inline Minerva::Buffer& JointPalette::GetCurrentBuffer() { return m_Buffers[m_VKWindowHandle->GetFrameIndex()]; }
+
+	inline uint32_t JointPalette::GetMaxMatrixCount() const { return static_cast<uint32_t>(m_Matrices.size()); }
+
+	inline std::array<Minerva::VertexDescriptor::Attribute, 5> JointPalette::GetVertexAttributes()
+	{
+		return {
+			Minerva::VertexDescriptor::Attribute{ .m_Offset = offsetof(SkinnedVertex, m_Position), .m_Format = Minerva::VertexDescriptor::Format::FLOAT_3D },
+			Minerva::VertexDescriptor::Attribute{ .m_Offset = offsetof(SkinnedVertex, m_Normal), .m_Format = Minerva::VertexDescriptor::Format::FLOAT_3D },
+			Minerva::VertexDescriptor::Attribute{ .m_Offset = offsetof(SkinnedVertex, m_TexCoord), .m_Format = Minerva::VertexDescriptor::Format::FLOAT_2D },
+			Minerva::VertexDescriptor::Attribute{ .m_Offset = offsetof(SkinnedVertex, m_Joints), .m_Format = Minerva::VertexDescriptor::Format::UINT8_4D },
+			Minerva::VertexDescriptor::Attribute{ .m_Offset = offsetof(SkinnedVertex, m_Weights), .m_Format = Minerva::VertexDescriptor::Format::UINT8_4D_NORMALIZED }
+		};
+	}
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+namespace Minerva
+{
+	Mesh::Mesh(Minerva::Device& _device, std::string_view _filepath, uint32_t _lodCount) :
+		Mesh(_device, LoadMeshData(_filepath), _lodCount)
+	{
+	}
+
+	Mesh::Mesh(Minerva::Device& _device, const Minerva::Tools::MeshLoader::MeshData& _meshData, uint32_t _lodCount) :
+		Mesh(_device, _meshData, BuildLODChain(_meshData, _lodCount))
+	{
+	}
+
+	Mesh::Mesh(Minerva::Device& _device, const Minerva::Tools::MeshLoader::MeshData& _meshData, Minerva::Tools::Simplifier::LODChain&& _lodChain) :
+		m_VertexBuffer{ _device, Minerva::Buffer::Type::VERTEX, _meshData.m_Vertices.data(), static_cast<uint32_t>(_meshData.m_Vertices.size() * sizeof(Vertex)) },
+		m_IndexBuffer{ CreateIndexBuffer(_device, _lodChain.m_Indices, _meshData.m_Vertices.size()) },
+		m_PositionBuffer{ CreatePositionBuffer(_device, _meshData) },
+		m_VertexCount{ static_cast<uint32_t>(_meshData.m_Vertices.size()) },
+		m_IndexCount{ _lodChain.m_LODs[0].m_IndexCount },
+		m_LODs{ std::move(_lodChain.m_LODs) },
+		m_BoundsCenter{ _lodChain.m_Center },
+		m_BoundsRadius{ _lodChain.m_Radius }
+	{
+	}
+
+	inline Minerva::Buffer& Mesh::GetVertexBuffer() { return m_VertexBuffer; }
+
+	inline Minerva::Buffer& Mesh::GetIndexBuffer() { return m_IndexBuffer; }
+
+	inline Minerva::Buffer& Mesh::GetPositionBuffer() { return m_PositionBuffer; }
+
+	inline uint32_t Mesh::GetVertexCount() const { return m_VertexCount; }
+
+	inline uint32_t Mesh::GetIndexCount() const { return m_IndexCount; }
+
+	inline Minerva::Buffer::IndexType Mesh::GetIndexType() const { return m_IndexBuffer.GetIndexType(); }
+
+	inline uint32_t Mesh::GetLODCount() const { return static_cast<uint32_t>(m_LODs.size()); }
+
+	inline const Minerva::Tools::Simplifier::LOD& Mesh::GetLOD(uint32_t _lod) const { return m_LODs[std::min<size_t>(_lod, m_LODs.size() - 1)]; }
+
+	inline uint32_t Mesh::SelectLOD(const glm::mat4& _model, const glm::vec3& _cameraPosition, float _fovY, float _screenHeight, float _pixelError) const
+	{
+		if (m_LODs.size() == 1) return 0;
+
+		// Errors scale with the largest axis of the model matrix
+		const float scale{ std::max({ glm::length(glm::vec3{ _model[0] }), glm::length(glm::vec3{ _model[1] }), glm::length(glm::vec3{ _model[2] }) }) };
+		const glm::vec3 center{ _model * glm::vec4{ m_BoundsCenter, 1.f } };
+		const float distance{ glm::length(center - _cameraPosition) - m_BoundsRadius * scale };
+		const float projectionScale{ _screenHeight / (2.f * std::tan(_fovY * 0.5f)) };
+
+		return Minerva::Tools::Simplifier::SelectLOD(m_LODs, distance, projectionScale * scale, _pixelError);
+	}
+
+	inline std::array<Minerva::VertexDescriptor::Attribute, 3> Mesh::GetVertexAttributes()
+	{
+		return {
+			Minerva::VertexDescriptor::Attribute{ .m_Offset = offsetof(Vertex, m_Position), .m_Format = Minerva::VertexDescriptor::Format::FLOAT_3D },
+			Minerva::VertexDescriptor::Attribute{ .m_Offset = offsetof(Vertex, m_Normal), .m_Format = Minerva::VertexDescriptor::Format::FLOAT_3D },
+			Minerva::VertexDescriptor::Attribute{ .m_Offset = offsetof(Vertex, m_TexCoord), .m_Format = Minerva::VertexDescriptor::Format::FLOAT_2D }
+		};
+	}
+
+	inline std::array<Minerva::VertexDescriptor::Attribute, 1> Mesh::GetPositionAttributes()
+	{
+		return { Minerva::VertexDescriptor::Attribute{ .m_Offset = 0, .m_Format = Minerva::VertexDescriptor::Format::FLOAT_3D } };
+	}
+
+	Minerva::Tools::MeshLoader::MeshData Mesh::LoadMeshData(std::string_view _filepath)
+	{
+		Minerva::Tools::MeshLoader::MeshData meshData{};
+		Minerva::Tools::MeshLoader::MeshError meshErr{ Minerva::Tools::MeshLoader::LoadMesh(meshData, _filepath) };
+		if (meshErr != Minerva::Tools::MeshLoader::MeshError::SUCCESS)
+		{
+			std::stringstream ss;
+			ss << "Error loading Mesh. " << Minerva::Tools::MeshLoader::GetErrorMessage(meshErr);
+			Minerva::Vulkan::Logger::Log_Error(ss.str());
+			throw std::runtime_error(ss.str());
+		}
+		return meshData;
+	}
+
+	Minerva::Tools::Simplifier::LODChain Mesh::BuildLODChain(const Minerva::Tools::MeshLoader::MeshData& _meshData, uint32_t _lodCount)
+	{
+		std::vector<glm::vec3> positions(_meshData.m_Vertices.size());
+		for (size_t i{ 0 }; i < positions.size(); ++i)
+			positions[i] = _meshData.m_Vertices[i].m_Position;
+
+		Minerva::Tools::Simplifier::LODChain chain{};
+		Minerva::Tools::Simplifier::BuildLODChain(chain, positions, _meshData.m_Indices, std::max(1u, _lodCount));
+		return chain;
+	}
+
+	Minerva::Buffer Mesh::CreatePositionBuffer(Minerva::Device& _device, const Minerva::Tools::MeshLoader::MeshData& _meshData)
+	{
+		// 12 of the 32 bytes of an interleaved vertex, depth only draws fetch less and hit the vertex cache more often
+		std::vector<glm::vec3> positions(_meshData.m_Vertices.size());
+		for (size_t i{ 0 }; i < positions.size(); ++i)
+			positions[i] = _meshData.m_Vertices[i].m_Position;
+
+		return Minerva::Buffer{ _device, Minerva::Buffer::Type::VERTEX, positions.data(), static_cast<uint32_t>(positions.size() * sizeof(glm::vec3)) };
+	}
+
+	Minerva::Buffer Mesh::CreateIndexBuffer(Minerva::Device& _device, std::span<const uint32_t> _indices, size_t _vertexCount)
+	{
+		// 32-bit indices only when the mesh cannot be addressed with 16 bits
+		if (Minerva::Tools::MeshLoader::RequiresUInt32Indices(_vertexCount))
+		{
+			return Minerva::Buffer{ _device, Minerva::Buffer::Type::INDEX, _indices.data(),
+				static_cast<uint32_t>(_indices.size() * sizeof(uint32_t)), Minerva::Buffer::IndexType::UINT32 };
+		}
+
+		std::vector<uint16_t> indices(_indices.size());
+		for (size_t i{ 0 }; i < indices.size(); ++i)
+			indices[i] = static_cast<uint16_t>(_indices[i]);
+
+		return Minerva::Buffer{ _device, Minerva::Buffer::Type::INDEX, indices.data(),
+			static_cast<uint32_t>(indices.size() * sizeof(uint16_t)), Minerva::Buffer::IndexType::UINT16 };
+	}
+}
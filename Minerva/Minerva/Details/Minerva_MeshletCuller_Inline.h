@@ -0,0 +1,124 @@
+#pragma once
+
+namespace Minerva
+{
+	MeshletCuller::MeshletCuller(Minerva::Device& _device, const Minerva::Tools::MeshLoader::MeshData& _meshData, const Minerva::Shader& _cullShader) :
+		MeshletCuller(_device, BuildClusterData(_meshData), _cullShader)
+	{
+	}
+
+	MeshletCuller::MeshletCuller(Minerva::Device& _device, const ClusterData& _clusterData, const Minerva::Shader& _cullShader) :
+		m_Layouts{ {
+			{ 0, Minerva::DescriptorSet::DescriptorType::STORAGE_BUFFER, 1, Minerva::Shader::Type::COMPUTE }, // Meshlets
+			{ 1, Minerva::DescriptorSet::DescriptorType::STORAGE_BUFFER, 1, Minerva::Shader::Type::COMPUTE }, // Meshlet indices
+			{ 2, Minerva::DescriptorSet::DescriptorType::STORAGE_BUFFER, 1, Minerva::Shader::Type::COMPUTE }, // Culled indices
+			{ 3, Minerva::DescriptorSet::DescriptorType::STORAGE_BUFFER, 1, Minerva::Shader::Type::COMPUTE }  // Draw command
+		} },
+		m_MeshletBuffer{ _device, Minerva::Buffer::Type::STORAGE, _clusterData.m_Meshlets.data(), static_cast<uint32_t>(_clusterData.m_Meshlets.size() * sizeof(GPUMeshlet)) },
+		m_MeshletIndexBuffer{ _device, Minerva::Buffer::Type::STORAGE, _clusterData.m_Indices.data(), static_cast<uint32_t>(_clusterData.m_Indices.size() * sizeof(uint32_t)) },
+		m_CulledIndexBuffer{ _device, Minerva::Buffer::Type::STORAGE, nullptr, static_cast<uint32_t>(_clusterData.m_Indices.size() * sizeof(uint32_t)), Minerva::Buffer::IndexType::UINT32 },
+		m_DrawCommandBuffer{ _device, Minerva::Buffer::Type::INDIRECT, nullptr, sizeof(VkDrawIndexedIndirectCommand) },
+		m_DescriptorSet{ _device, m_Layouts },
+		m_Pipeline{ _device, _cullShader, m_DescriptorSet },
+		m_MeshletCount{ static_cast<uint32_t>(_clusterData.m_Meshlets.size()) }
+	{
+		std::array<Minerva::Buffer, 1> meshlets{ m_MeshletBuffer };
+		std::array<Minerva::Buffer, 1> meshletIndices{ m_MeshletIndexBuffer };
+		std::array<Minerva::Buffer, 1> culledIndices{ m_CulledIndexBuffer };
+		std::array<Minerva::Buffer, 1> drawCommand{ m_DrawCommandBuffer };
+
+		m_DescriptorSet.Update(m_Layouts[0], meshlets);
+		m_DescriptorSet.Update(m_Layouts[1], meshletIndices);
+		m_DescriptorSet.Update(m_Layouts[2], culledIndices);
+		m_DescriptorSet.Update(m_Layouts[3], drawCommand);
+	}
+
+	inline void MeshletCuller::Cull(Minerva::CommandBuffer& _computeCmdBuffer, const glm::mat4& _modelViewProjection, const glm::vec3& _cameraPosition)
+	{
+		// Frustum planes from the clip space matrix rows, depth is [0, 1]
+		auto Row = [&](int _row) { return glm::vec4{ _modelViewProjection[0][_row], _modelViewProjection[1][_row], _modelViewProjection[2][_row], _modelViewProjection[3][_row] }; };
+
+		CullData cullData{
+			.m_FrustumPlanes = {
+				Row(3) + Row(0), // Left
+				Row(3) - Row(0), // Right
+				Row(3) + Row(1), // Bottom
+				Row(3) - Row(1), // Top
+				Row(2),          // Near
+				Row(3) - Row(2)  // Far
+			},
+			.m_CameraPosition = _cameraPosition,
+			.m_MeshletCount = m_MeshletCount
+		};
+
+		for (glm::vec4& plane : cullData.m_FrustumPlanes)
+			plane /= glm::length(glm::vec3{ plane });
+
+		// Reset the draw, the shader accumulates indexCount
+		VkDrawIndexedIndirectCommand drawCommand{
+			.indexCount = 0,
+			.instanceCount = 1,
+			.firstIndex = 0,
+			.vertexOffset = 0,
+			.firstInstance = 0
+		};
+		_computeCmdBuffer.UpdateBuffer(m_DrawCommandBuffer, 0, sizeof(drawCommand), &drawCommand);
+
+		_computeCmdBuffer.BindComputePipeline(m_Pipeline);
+		_computeCmdBuffer.BindDescriptorSet(m_Pipeline, m_DescriptorSet);
+		_computeCmdBuffer.PushConstant(m_Pipeline, Minerva::Shader::Type::COMPUTE, 0, sizeof(CullData), &cullData);
+
+		// One workgroup per meshlet, spread over Y past the guaranteed 65535 groups per dimension
+		const uint32_t groupCountX{ std::min(m_MeshletCount, 65535u) };
+		const uint32_t groupCountY{ (m_MeshletCount + groupCountX - 1) / groupCountX };
+		_computeCmdBuffer.Dispatch(groupCountX, groupCountY, 1);
+	}
+
+	inline void MeshletCuller::Draw(Minerva::CommandBuffer& _cmdBuffer)
+	{
+		_cmdBuffer.BindBuffer(m_CulledIndexBuffer);
+		_cmdBuffer.DrawIndexedIndirect(m_DrawCommandBuffer, 0, 1, sizeof(VkDrawIndexedIndirectCommand));
+	}
+
+	inline uint32_t MeshletCuller::GetMeshletCount() const { return m_MeshletCount; }
+
+	MeshletCuller::ClusterData MeshletCuller::BuildClusterData(const Minerva::Tools::MeshLoader::MeshData& _meshData)
+	{
+		if (_meshData.m_Indices.size() < 3)
+		{
+			Minerva::Vulkan::Logger::Log_Error("Unable to create MeshletCuller. Mesh has no triangles.");
+			throw std::runtime_error("Unable to create MeshletCuller. Mesh has no triangles.");
+		}
+
+		std::vector<glm::vec3> positions(_meshData.m_Vertices.size());
+		for (size_t i{ 0 }; i < positions.size(); ++i)
+			positions[i] = _meshData.m_Vertices[i].m_Position;
+
+		Minerva::Tools::Meshlet::MeshletData meshletData;
+		Minerva::Tools::Meshlet::BuildMeshlets(meshletData, positions, _meshData.m_Indices);
+
+		ClusterData clusterData;
+		clusterData.m_Meshlets.resize(meshletData.m_Meshlets.size());
+		clusterData.m_Indices.resize(meshletData.m_Triangles.size());
+
+		for (size_t m{ 0 }; m < meshletData.m_Meshlets.size(); ++m)
+		{
+			const auto& meshlet{ meshletData.m_Meshlets[m] };
+			const auto& bounds{ meshletData.m_Bounds[m] };
+
+			// Triangles are stored contiguously, 3 entries each, so the triangle offset is also the index offset
+			clusterData.m_Meshlets[m] = GPUMeshlet{
+				.m_Sphere = glm::vec4{ bounds.m_Center, bounds.m_Radius },
+				.m_Cone = glm::vec4{ bounds.m_ConeAxis, bounds.m_ConeCutoff },
+				.m_IndexOffset = meshlet.m_TriangleOffset,
+				.m_IndexCount = meshlet.m_TriangleCount * 3,
+				.m_Padding = { 0, 0 }
+			};
+
+			for (uint32_t i{ 0 }; i < meshlet.m_TriangleCount * 3; ++i)
+				clusterData.m_Indices[meshlet.m_TriangleOffset + i] = meshletData.m_Vertices[meshlet.m_VertexOffset + meshletData.m_Triangles[meshlet.m_TriangleOffset + i]];
+		}
+
+		return clusterData;
+	}
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+namespace Minerva
+{
+	ObjectCuller::ObjectCuller(Minerva::Device& _device, const Minerva::Shader& _cullShader, uint32_t _maxObjectCount) :
+		m_Layouts{ {
+			{ 0, Minerva::DescriptorSet::DescriptorType::STORAGE_BUFFER, 1, Minerva::Shader::Type::COMPUTE }, // Objects
+			{ 1, Minerva::DescriptorSet::DescriptorType::STORAGE_BUFFER, 1, Minerva::Shader::Type::COMPUTE }, // Draw commands
+			{ 2, Minerva::DescriptorSet::DescriptorType::STORAGE_BUFFER, 1, Minerva::Shader::Type::COMPUTE }  // Draw count
+		} },
+		m_ObjectBuffer{ _device, Minerva::Buffer::Type::STORAGE, nullptr, static_cast<uint32_t>(std::max(_maxObjectCount, 1u) * sizeof(Object)) },
+		m_DrawCommandBuffer{ _device, Minerva::Buffer::Type::INDIRECT, nullptr, static_cast<uint32_t>(std::max(_maxObjectCount, 1u) * sizeof(VkDrawIndexedIndirectCommand)) },
+		m_DrawCountBuffer{ _device, Minerva::Buffer::Type::INDIRECT, nullptr, sizeof(uint32_t) },
+		m_DescriptorSet{ _device, m_Layouts },
+		m_Pipeline{ _device, _cullShader, m_DescriptorSet },
+		m_MaxObjectCount{ _maxObjectCount },
+		m_ObjectCount{ 0 },
+		m_Compact{ _device.IsDrawIndirectCountSupported() }
+	{
+		std::array<Minerva::Buffer, 1> objects{ m_ObjectBuffer };
+		std::array<Minerva::Buffer, 1> drawCommands{ m_DrawCommandBuffer };
+		std::array<Minerva::Buffer, 1> drawCount{ m_DrawCountBuffer };
+
+		m_DescriptorSet.Update(m_Layouts[0], objects);
+		m_DescriptorSet.Update(m_Layouts[1], drawCommands);
+		m_DescriptorSet.Update(m_Layouts[2], drawCount);
+	}
+
+	void ObjectCuller::SetObjects(std::span<const Object> _objects, uint32_t _firstObject)
+	{
+		if (_objects.empty()) return;
+
+		if (_firstObject + _objects.size() > m_MaxObjectCount)
+		{
+			Minerva::Vulkan::Logger::Log_Error("Unable to set ObjectCuller objects. Range exceeds the maximum object count.");
+			throw std::runtime_error("Unable to set ObjectCuller objects. Range exceeds the maximum object count.");
+		}
+
+		m_ObjectBuffer.Upload(_objects.data(), static_cast<uint32_t>(_firstObject * sizeof(Object)), static_cast<uint32_t>(_objects.size_bytes()));
+	}
+
+	inline void ObjectCuller::Cull(Minerva::CommandBuffer& _computeCmdBuffer, const glm::mat4& _viewProjection, uint32_t _objectCount)
+	{
+		m_ObjectCount = std::min(_objectCount, m_MaxObjectCount);
+		if (m_ObjectCount == 0) return;
+
+		const CullData cullData{
+			.m_FrustumPlanes = Minerva::Tools::BVH::ExtractFrustum(_viewProjection).m_Planes,
+			.m_ObjectCount = m_ObjectCount,
+			.m_Compact = m_Compact ? 1u : 0u
+		};
+
+		// Reset the counter the shader appends to
+		if (m_Compact)
+		{
+			const uint32_t zero{ 0 };
+			_computeCmdBuffer.UpdateBuffer(m_DrawCountBuffer, 0, sizeof(zero), &zero);
+		}
+
+		_computeCmdBuffer.BindComputePipeline(m_Pipeline);
+		_computeCmdBuffer.BindDescriptorSet(m_Pipeline, m_DescriptorSet);
+		_computeCmdBuffer.PushConstant(m_Pipeline, Minerva::Shader::Type::COMPUTE, 0, sizeof(CullData), &cullData);
+
+		// 64 objects per workgroup
+		_computeCmdBuffer.Dispatch((m_ObjectCount + 63) / 64, 1, 1);
+	}
+
+	inline void ObjectCuller::Draw(Minerva::CommandBuffer& _cmdBuffer)
+	{
+		if (m_ObjectCount == 0) return;
+
+		if (m_Compact)
+			_cmdBuffer.DrawIndexedIndirectCount(m_DrawCommandBuffer, 0, m_DrawCountBuffer, 0, m_ObjectCount);
+		else
+			_cmdBuffer.DrawIndexedIndirect(m_DrawCommandBuffer, 0, m_ObjectCount);
+	}
+
+	inline Minerva::Buffer& ObjectCuller::GetObjectBuffer() { return m_ObjectBuffer; }
+
+	inline uint32_t ObjectCuller::GetMaxObjectCount() const { return m_MaxObjectCount; }
+
+	glm::vec4 ObjectCuller::ComputeBoundingSphere(const Minerva::Tools::MeshLoader::MeshData& _meshData)
+	{
+		if (_meshData.m_Vertices.empty()) return glm::vec4{ 0.f };
+
+		glm::vec3 min{ _meshData.m_Vertices[0].m_Position }, max{ min };
+		for (const auto& vertex : _meshData.m_Vertices)
+		{
+			min = glm::min(min, vertex.m_Position);
+			max = glm::max(max, vertex.m_Position);
+		}
+
+		const glm::vec3 center{ (min + max) * 0.5f };
+		float radius{ 0.f };
+		for (const auto& vertex : _meshData.m_Vertices)
+			radius = std::max(radius, glm::length(vertex.m_Position - center));
+
+		return glm::vec4{ center, radius };
+	}
+}
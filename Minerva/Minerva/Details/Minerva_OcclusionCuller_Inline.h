@@ -0,0 +1,168 @@
+#pragma once
+
+namespace Minerva
+{
+	OcclusionCuller::OcclusionCuller(Minerva::Device& _device, const Minerva::Renderpass& _renderpass, const Minerva::Shader& _pyramidShader,
+		const Minerva::Shader& _cullShader, uint32_t _maxObjectCount) :
+		m_Layouts{ {
+			{ 0, Minerva::DescriptorSet::DescriptorType::STORAGE_BUFFER, 1, Minerva::Shader::Type::COMPUTE },        // Objects
+			{ 1, Minerva::DescriptorSet::DescriptorType::STORAGE_BUFFER, 1, Minerva::Shader::Type::COMPUTE },        // Visibility
+			{ 2, Minerva::DescriptorSet::DescriptorType::STORAGE_BUFFER, 1, Minerva::Shader::Type::COMPUTE },        // Draw commands
+			{ 3, Minerva::DescriptorSet::DescriptorType::STORAGE_BUFFER, 1, Minerva::Shader::Type::COMPUTE },        // Draw counts
+			{ 4, Minerva::DescriptorSet::DescriptorType::STORAGE_BUFFER, 1, Minerva::Shader::Type::COMPUTE },        // View data
+			{ 5, Minerva::DescriptorSet::DescriptorType::COMBINED_IMAGE_SAMPLER, 1, Minerva::Shader::Type::COMPUTE } // Depth pyramid
+		} },
+		m_ObjectBuffer{ _device, Minerva::Buffer::Type::STORAGE, nullptr, static_cast<uint32_t>(std::max(_maxObjectCount, 1u) * sizeof(Minerva::ObjectCuller::Object)) },
+		m_VisibilityBuffer{ _device, Minerva::Buffer::Type::STORAGE, nullptr, static_cast<uint32_t>(std::max(_maxObjectCount, 1u) * sizeof(uint32_t)) },
+		m_DrawCommandBuffer{ _device, Minerva::Buffer::Type::INDIRECT, nullptr, static_cast<uint32_t>(2 * std::max(_maxObjectCount, 1u) * sizeof(VkDrawIndexedIndirectCommand)) },
+		m_DrawCountBuffer{ _device, Minerva::Buffer::Type::INDIRECT, nullptr, 2 * sizeof(uint32_t) },
+		m_ViewBuffer{ _device, Minerva::Buffer::Type::STORAGE, nullptr, sizeof(ViewData) },
+		m_DescriptorSet{ _device, m_Layouts },
+		m_Pipeline{ _device, _cullShader, m_DescriptorSet },
+		m_VKDepthPyramidHandle{ nullptr },
+		m_PreviousViewProjection{ 1.f },
+		m_MaxObjectCount{ _maxObjectCount },
+		m_ObjectCount{ 0 },
+		m_PreviousPyramidValid{ false },
+		m_Compact{ _device.IsDrawIndirectCountSupported() }
+	{
+		if (!_renderpass.HasDepthAttachment())
+		{
+			Minerva::Vulkan::Logger::Log_Error("Unable to create OcclusionCuller. Render pass has no depth attachment.");
+			throw std::runtime_error("Unable to create OcclusionCuller. Render pass has no depth attachment.");
+		}
+
+		m_VKDepthPyramidHandle = std::make_shared<Minerva::Vulkan::DepthPyramid>(_device.GetVKDeviceHandle(), _renderpass.GetVKRenderpassHandle(), _pyramidShader.GetVKShaderHandle());
+
+		std::array<Minerva::Buffer, 1> objects{ m_ObjectBuffer };
+		std::array<Minerva::Buffer, 1> visibility{ m_VisibilityBuffer };
+		std::array<Minerva::Buffer, 1> drawCommands{ m_DrawCommandBuffer };
+		std::array<Minerva::Buffer, 1> drawCounts{ m_DrawCountBuffer };
+		std::array<Minerva::Buffer, 1> view{ m_ViewBuffer };
+
+		m_DescriptorSet.Update(m_Layouts[0], objects);
+		m_DescriptorSet.Update(m_Layouts[1], visibility);
+		m_DescriptorSet.Update(m_Layouts[2], drawCommands);
+		m_DescriptorSet.Update(m_Layouts[3], drawCounts);
+		m_DescriptorSet.Update(m_Layouts[4], view);
+		WritePyramidDescriptor();
+	}
+
+	void OcclusionCuller::SetObjects(std::span<const Minerva::ObjectCuller::Object> _objects, uint32_t _firstObject)
+	{
+		if (_objects.empty()) return;
+
+		if (_firstObject + _objects.size() > m_MaxObjectCount)
+		{
+			Minerva::Vulkan::Logger::Log_Error("Unable to set OcclusionCuller objects. Range exceeds the maximum object count.");
+			throw std::runtime_error("Unable to set OcclusionCuller objects. Range exceeds the maximum object count.");
+		}
+
+		m_ObjectBuffer.Upload(_objects.data(), static_cast<uint32_t>(_firstObject * sizeof(Minerva::ObjectCuller::Object)), static_cast<uint32_t>(_objects.size_bytes()));
+	}
+
+	void OcclusionCuller::CullEarly(Minerva::CommandBuffer& _computeCmdBuffer, const glm::mat4& _viewProjection, uint32_t _objectCount)
+	{
+		m_ObjectCount = std::min(_objectCount, m_MaxObjectCount);
+
+		// A resized depth attachment invalidates the pyramid, its content no longer matches the previous view projection
+		if (m_VKDepthPyramidHandle->Update())
+		{
+			WritePyramidDescriptor();
+			m_PreviousPyramidValid = false;
+		}
+
+		if (m_ObjectCount == 0) return;
+
+		const VkExtent2D pyramidExtent{ m_VKDepthPyramidHandle->GetExtent() };
+		ViewData viewData{
+			.m_ViewProjection = _viewProjection,
+			.m_PreviousViewProjection = m_PreviousViewProjection,
+			.m_FrustumPlanes = Minerva::Tools::BVH::ExtractFrustum(_viewProjection).m_Planes,
+			.m_PyramidSize = glm::vec2{ static_cast<float>(pyramidExtent.width), static_cast<float>(pyramidExtent.height) },
+			.m_PreviousPyramidValid = m_PreviousPyramidValid ? 1u : 0u
+		};
+
+		const std::array<uint32_t, 2> zero{ 0, 0 };
+		_computeCmdBuffer.UpdateBuffer(m_ViewBuffer, 0, sizeof(ViewData), &viewData);
+		_computeCmdBuffer.UpdateBuffer(m_DrawCountBuffer, 0, sizeof(zero), zero.data());
+
+		CullData cullData{
+			.m_ObjectCount = m_ObjectCount,
+			.m_Phase = 0,
+			.m_Compact = m_Compact ? 1u : 0u,
+			.m_MaxObjectCount = m_MaxObjectCount
+		};
+
+		_computeCmdBuffer.BindComputePipeline(m_Pipeline);
+		_computeCmdBuffer.BindDescriptorSet(m_Pipeline, m_DescriptorSet);
+		_computeCmdBuffer.PushConstant(m_Pipeline, Minerva::Shader::Type::COMPUTE, 0, sizeof(CullData), &cullData);
+
+		// 64 objects per workgroup
+		_computeCmdBuffer.Dispatch((m_ObjectCount + 63) / 64, 1, 1);
+
+		m_PreviousViewProjection = _viewProjection;
+	}
+
+	inline void OcclusionCuller::DrawEarly(Minerva::CommandBuffer& _cmdBuffer)
+	{
+		if (m_ObjectCount == 0) return;
+
+		if (m_Compact)
+			_cmdBuffer.DrawIndexedIndirectCount(m_DrawCommandBuffer, 0, m_DrawCountBuffer, 0, m_ObjectCount);
+		else
+			_cmdBuffer.DrawIndexedIndirect(m_DrawCommandBuffer, 0, m_ObjectCount);
+	}
+
+	void OcclusionCuller::CullLate(Minerva::CommandBuffer& _cmdBuffer)
+	{
+		_cmdBuffer.SuspendRenderpass();
+
+		m_VKDepthPyramidHandle->Build(*_cmdBuffer.GetVKCommandBufferHandle());
+		m_PreviousPyramidValid = true;
+
+		if (m_ObjectCount > 0)
+		{
+			CullData cullData{
+				.m_ObjectCount = m_ObjectCount,
+				.m_Phase = 1,
+				.m_Compact = m_Compact ? 1u : 0u,
+				.m_MaxObjectCount = m_MaxObjectCount
+			};
+
+			_cmdBuffer.BindComputePipeline(m_Pipeline);
+			_cmdBuffer.BindDescriptorSet(m_Pipeline, m_DescriptorSet);
+			_cmdBuffer.PushConstant(m_Pipeline, Minerva::Shader::Type::COMPUTE, 0, sizeof(CullData), &cullData);
+			_cmdBuffer.Dispatch((m_ObjectCount + 63) / 64, 1, 1);
+		}
+
+		// Makes the commands and counts just written visible to the late draws
+		_cmdBuffer.ResumeRenderpass();
+	}
+
+	inline void OcclusionCuller::DrawLate(Minerva::CommandBuffer& _cmdBuffer)
+	{
+		if (m_ObjectCount == 0) return;
+
+		const uint32_t offset{ static_cast<uint32_t>(m_MaxObjectCount * sizeof(VkDrawIndexedIndirectCommand)) };
+		if (m_Compact)
+			_cmdBuffer.DrawIndexedIndirectCount(m_DrawCommandBuffer, offset, m_DrawCountBuffer, sizeof(uint32_t), m_ObjectCount);
+		else
+			_cmdBuffer.DrawIndexedIndirect(m_DrawCommandBuffer, offset, m_ObjectCount);
+	}
+
+	inline Minerva::Buffer& OcclusionCuller::GetObjectBuffer() { return m_ObjectBuffer; }
+
+	inline uint32_t OcclusionCuller::GetMaxObjectCount() const { return m_MaxObjectCount; }
+
+	void OcclusionCuller::WritePyramidDescriptor()
+	{
+		const VkDescriptorImageInfo pyramid{
+			.sampler = m_VKDepthPyramidHandle->GetVKSampler(),
+			.imageView = m_VKDepthPyramidHandle->GetVKImageView(),
+			.imageLayout = VK_IMAGE_LAYOUT_GENERAL
+		};
+
+		m_DescriptorSet.GetVKDescriptorSetHandle()->Update(m_Layouts[5], std::span<const VkDescriptorImageInfo>{ &pyramid, 1 }, &m_VKDepthPyramidHandle->GetResourceState());
+	}
+}
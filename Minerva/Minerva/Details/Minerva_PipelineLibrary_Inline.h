@@ -0,0 +1,34 @@
+#pragma once
+
+namespace Minerva
+{
+	PipelineLibrary::PipelineLibrary(Minerva::Device& _device, uint32_t _threadCount) :
+		m_VKPipelineLibraryHandle{ nullptr }
+	{
+		m_VKPipelineLibraryHandle = std::make_shared<Minerva::Vulkan::PipelineLibrary>(_device.GetVKDeviceHandle(), _threadCount);
+	}
+
+	inline Minerva::Pipeline PipelineLibrary::Request(Minerva::Window& _window,
+		Minerva::Renderpass& _renderpass,
+		const Minerva::Shader* _shaders,
+		int _shaderCount,
+		Minerva::DescriptorSet& _descSet,
+		Minerva::VertexDescriptor& _vertDesc,
+		const Minerva::Pipeline::State& _state)
+	{
+		return Minerva::Pipeline(m_VKPipelineLibraryHandle->Request(_window.GetVKWindowHandle(),
+			_renderpass.GetVKRenderpassHandle(),
+			_shaders,
+			_shaderCount,
+			_descSet.GetVKDescriptorSetHandle(),
+			_vertDesc.GetVKVertexDescriptorHandle(),
+			_state));
+	}
+
+	inline void PipelineLibrary::WaitIdle() { m_VKPipelineLibraryHandle->WaitIdle(); }
+
+	inline size_t PipelineLibrary::GetPipelineCount() const { return m_VKPipelineLibraryHandle->GetPipelineCount(); }
+	inline size_t PipelineLibrary::GetPendingCount() const { return m_VKPipelineLibraryHandle->GetPendingCount(); }
+	inline uint32_t PipelineLibrary::GetDeduplicatedCount() const { return m_VKPipelineLibraryHandle->GetDeduplicatedCount(); }
+	inline uint32_t PipelineLibrary::GetBatchCount() const { return m_VKPipelineLibraryHandle->GetBatchCount(); }
+}
@@ -9,6 +9,18 @@ namespace Minerva
 		int _shaderCount,
 		Minerva::DescriptorSet& _descSet,
 		Minerva::VertexDescriptor& _vertDesc) :
+		Pipeline(_device, _window, _renderpass, _shaders, _shaderCount, _descSet, _vertDesc, State{})
+	{
+	}
+
+	Pipeline::Pipeline(Minerva::Device& _device,
+		Minerva::Window& _window,
+		Minerva::Renderpass& _renderpass,
+		const Minerva::Shader* _shaders,
+		int _shaderCount,
+		Minerva::DescriptorSet& _descSet,
+		Minerva::VertexDescriptor& _vertDesc,
+		const State& _state) :
 		m_VKPipelineHandle{ nullptr }
 	{
 		m_VKPipelineHandle = std::make_shared<Minerva::Vulkan::Pipeline>
@@ -18,8 +30,25 @@ namespace Minerva
 				_shaders,
 				_shaderCount,
 				_descSet.GetVKDescriptorSetHandle(),
-			_vertDesc.GetVKVertexDescriptorHandle());
+				_vertDesc.GetVKVertexDescriptorHandle(),
+				_state);
+	}
+
+	Pipeline::Pipeline(Minerva::Device& _device,
+		const Minerva::Shader& _computeShader,
+		Minerva::DescriptorSet& _descSet) :
+		m_VKPipelineHandle{ nullptr }
+	{
+		m_VKPipelineHandle = std::make_shared<Minerva::Vulkan::Pipeline>
+			(_device.GetVKDeviceHandle(),
+				_computeShader.GetVKShaderHandle(),
+				_descSet.GetVKDescriptorSetHandle(),
+				_computeShader.GetSpecializations());
 	}
 
 	inline std::shared_ptr<Minerva::Vulkan::Pipeline> Pipeline::GetVKPipelineHandle() const { return m_VKPipelineHandle; }
+
+	inline Pipeline::Type Pipeline::GetType() const { return m_VKPipelineHandle->GetType(); }
+
+	inline bool Pipeline::IsReady() const { return m_VKPipelineHandle->IsReady(); }
 }
@@ -0,0 +1,30 @@
+#pragma once
+
+namespace Minerva
+{
+	RenderGraph::RenderGraph(Minerva::Device& _device, Minerva::Window& _window) :
+		m_VKRenderGraphHandle{ nullptr }
+	{
+		m_VKRenderGraphHandle = std::make_shared<Minerva::Vulkan::RenderGraph>(_device.GetVKDeviceHandle(), _window.GetVKWindowHandle());
+	}
+
+	inline RenderGraph::ResourceHandle RenderGraph::CreateImage(std::string_view _name, const ImageDesc& _desc) { return m_VKRenderGraphHandle->CreateImage(_name, _desc); }
+	inline RenderGraph::ResourceHandle RenderGraph::ImportBuffer(std::string_view _name, Minerva::Buffer& _buffer) { return m_VKRenderGraphHandle->ImportBuffer(_name, _buffer.GetVKBufferHandle()); }
+	inline RenderGraph::PassHandle RenderGraph::AddPass(std::string_view _name, PassType _type, ExecuteFunction _function) { return m_VKRenderGraphHandle->AddPass(_name, _type, std::move(_function)); }
+	inline void RenderGraph::Read(PassHandle _pass, ResourceHandle _resource, Access _access) { m_VKRenderGraphHandle->AddAccess(_pass, _resource, _access, false); }
+	inline void RenderGraph::Write(PassHandle _pass, ResourceHandle _resource, Access _access) { m_VKRenderGraphHandle->AddAccess(_pass, _resource, _access, true); }
+	inline void RenderGraph::SetOutput(ResourceHandle _resource) { m_VKRenderGraphHandle->SetOutput(_resource); }
+	inline void RenderGraph::Compile() { m_VKRenderGraphHandle->Compile(); }
+
+	inline void RenderGraph::BindImage(Minerva::DescriptorSet& _descriptorSet, const Minerva::DescriptorSet::Layout& _layout, ResourceHandle _resource)
+	{
+		m_VKRenderGraphHandle->BindImage(_descriptorSet.GetVKDescriptorSetHandle(), _layout, _resource);
+	}
+
+	inline Minerva::Renderpass RenderGraph::GetRenderpass(PassHandle _pass) const { return Minerva::Renderpass(m_VKRenderGraphHandle->GetRenderpass(_pass)); }
+	inline void RenderGraph::Execute(Minerva::CommandBuffer& _computeCmdBuffer) { m_VKRenderGraphHandle->Execute(*_computeCmdBuffer.GetVKCommandBufferHandle()); }
+
+	inline bool RenderGraph::IsPassCulled(PassHandle _pass) const { return m_VKRenderGraphHandle->IsPassCulled(_pass); }
+	inline VkDeviceSize RenderGraph::GetTransientMemorySize() const { return m_VKRenderGraphHandle->GetTransientMemorySize(); }
+	inline uint32_t RenderGraph::GetBarrierBatchCount() const { return m_VKRenderGraphHandle->GetBarrierBatchCount(); }
+}
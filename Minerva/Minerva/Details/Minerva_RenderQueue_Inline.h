@@ -0,0 +1,172 @@
+#pragma once
+
+namespace Minerva
+{
+	inline void RenderQueue::Submit(const Draw& _draw, const void* _pushConstants, uint32_t _pushConstantSize, Minerva::Shader::Type _stage)
+	{
+		if (!_draw.m_Pipeline || !_draw.m_VertexBuffer || _pushConstantSize > 128)
+		{
+			Minerva::Vulkan::Logger::Log_Error("Unable to submit draw to RenderQueue. Pipeline or vertex buffer missing, or push constants exceed 128 bytes.");
+			throw std::runtime_error("Unable to submit draw to RenderQueue. Pipeline or vertex buffer missing, or push constants exceed 128 bytes.");
+		}
+
+		// Pipelines from a PipelineLibrary may still be compiling
+		Minerva::Pipeline* drawPipeline{ _draw.m_Pipeline };
+		if (!drawPipeline->IsReady())
+		{
+			if (!_draw.m_FallbackPipeline || !_draw.m_FallbackPipeline->IsReady()) return;
+			drawPipeline = _draw.m_FallbackPipeline;
+		}
+
+		const uint64_t descriptorSet{ _draw.m_DescriptorSet ? GetId(m_DescriptorSets, _draw.m_DescriptorSet, _draw.m_DescriptorSet->GetVKDescriptorSetHandle().get(), RESOURCE_BITS) : 0u };
+		const uint64_t indexBuffer{ _draw.m_IndexBuffer ? GetId(m_Buffers, _draw.m_IndexBuffer, _draw.m_IndexBuffer->GetVKBufferHandle().get(), RESOURCE_BITS) : 0u };
+		const uint32_t pushConstantOffset{ static_cast<uint32_t>(m_PushConstants.size()) };
+
+		// Both passes of a prepassed draw share everything but their pipeline and vertex stream
+		auto AddDraw = [&](uint64_t _pass, Minerva::Pipeline* _pipeline, Minerva::Buffer* _vertexBuffer)
+		{
+			const uint64_t pipeline{ GetId(m_Pipelines, _pipeline, _pipeline->GetVKPipelineHandle().get(), PIPELINE_BITS) };
+			const uint64_t vertexBuffer{ GetId(m_Buffers, _vertexBuffer, _vertexBuffer->GetVKBufferHandle().get(), RESOURCE_BITS) };
+			const uint64_t state{ (((pipeline << RESOURCE_BITS | descriptorSet) << RESOURCE_BITS | vertexBuffer) << RESOURCE_BITS) | indexBuffer };
+
+			uint64_t key;
+			if (_pass == 2)
+				key = (_pass << PASS_SHIFT) | (((1ull << DEPTH_BITS) - 1 - QuantizeDepth(_draw.m_Depth, DEPTH_BITS)) << STATE_BITS) | state;
+			else
+				key = (_pass << PASS_SHIFT) | (state << DEPTH_BITS) | QuantizeDepth(_draw.m_Depth, DEPTH_BITS);
+
+			m_Keys.push_back(Minerva::Tools::RadixSort::KeyValue{ key, static_cast<uint32_t>(m_Draws.size()) });
+			m_Draws.push_back(DrawData{
+				.m_Pipeline = static_cast<uint16_t>(pipeline),
+				.m_DescriptorSet = static_cast<uint16_t>(descriptorSet),
+				.m_VertexBuffer = static_cast<uint16_t>(vertexBuffer),
+				.m_IndexBuffer = static_cast<uint16_t>(indexBuffer),
+				.m_IndexCount = _draw.m_IndexCount,
+				.m_FirstIndex = _draw.m_FirstIndex,
+				.m_VertexOffset = _draw.m_VertexOffset,
+				.m_InstanceCount = _draw.m_InstanceCount,
+				.m_FirstInstance = _draw.m_FirstInstance,
+				.m_PushConstantOffset = pushConstantOffset,
+				.m_PushConstantSize = _pushConstants ? _pushConstantSize : 0u,
+				.m_PushConstantStage = _stage
+			});
+		};
+
+		if (_draw.m_Transparent)
+			AddDraw(2, drawPipeline, _draw.m_VertexBuffer);
+		else
+		{
+			if (_draw.m_PrepassPipeline && _draw.m_PrepassPipeline->IsReady())
+				AddDraw(0, _draw.m_PrepassPipeline, _draw.m_PrepassVertexBuffer ? _draw.m_PrepassVertexBuffer : _draw.m_VertexBuffer);
+			AddDraw(1, drawPipeline, _draw.m_VertexBuffer);
+		}
+
+		if (_pushConstants && _pushConstantSize > 0)
+		{
+			const uint8_t* bytes{ static_cast<const uint8_t*>(_pushConstants) };
+			m_PushConstants.insert(m_PushConstants.end(), bytes, bytes + _pushConstantSize);
+		}
+	}
+
+	inline void RenderQueue::Sort()
+	{
+		Minerva::Tools::RadixSort::Sort(m_Keys, m_SortScratch);
+	}
+
+	void RenderQueue::Record(Minerva::CommandBuffer& _cmdBuffer, size_t _begin, size_t _end) const
+	{
+		// Ids of the state currently bound. 0xffff forces the first bind of the range
+		uint16_t pipeline{ 0xffff }, descriptorSet{ 0xffff }, vertexBuffer{ 0xffff }, indexBuffer{ 0xffff };
+
+		for (size_t i{ _begin }; i < _end && i < m_Keys.size(); ++i)
+		{
+			const DrawData& draw{ m_Draws[m_Keys[i].m_Value] };
+			Minerva::Pipeline& drawPipeline{ *m_Pipelines[draw.m_Pipeline] };
+
+			if (draw.m_Pipeline != pipeline)
+			{
+				_cmdBuffer.BindGraphicsPipeline(drawPipeline);
+				pipeline = draw.m_Pipeline;
+				descriptorSet = 0xffff; // A different layout may not accept the bound set
+			}
+
+			if (draw.m_DescriptorSet != descriptorSet && draw.m_DescriptorSet != 0)
+			{
+				_cmdBuffer.BindDescriptorSet(drawPipeline, *m_DescriptorSets[draw.m_DescriptorSet]);
+				descriptorSet = draw.m_DescriptorSet;
+			}
+
+			if (draw.m_VertexBuffer != vertexBuffer)
+			{
+				_cmdBuffer.BindVertexBuffer(*m_Buffers[draw.m_VertexBuffer]);
+				vertexBuffer = draw.m_VertexBuffer;
+			}
+
+			if (draw.m_IndexBuffer != indexBuffer && draw.m_IndexBuffer != 0)
+			{
+				_cmdBuffer.BindBuffer(*m_Buffers[draw.m_IndexBuffer]);
+				indexBuffer = draw.m_IndexBuffer;
+			}
+
+			if (draw.m_PushConstantSize > 0)
+				_cmdBuffer.PushConstant(drawPipeline, draw.m_PushConstantStage, 0, draw.m_PushConstantSize, m_PushConstants.data() + draw.m_PushConstantOffset);
+
+			if (draw.m_IndexBuffer != 0)
+				_cmdBuffer.DrawIndexed(draw.m_IndexCount, draw.m_InstanceCount, draw.m_FirstIndex, draw.m_VertexOffset, draw.m_FirstInstance);
+			else
+				_cmdBuffer.Draw(static_cast<int>(draw.m_IndexCount), static_cast<int>(draw.m_InstanceCount), draw.m_VertexOffset, static_cast<int>(draw.m_FirstInstance));
+		}
+	}
+
+	inline void RenderQueue::Record(Minerva::CommandBuffer& _cmdBuffer) const
+	{
+		Record(_cmdBuffer, 0, m_Keys.size());
+	}
+
+	inline void RenderQueue::Flush(Minerva::CommandBuffer& _cmdBuffer)
+	{
+		Sort();
+		Record(_cmdBuffer);
+		Clear();
+	}
+
+	inline void RenderQueue::Clear()
+	{
+		m_Pipelines.clear();
+		m_DescriptorSets.resize(1);
+		m_Buffers.resize(1);
+		m_Ids.clear();
+		m_Draws.clear();
+		m_PushConstants.clear();
+		m_Keys.clear();
+	}
+
+	inline size_t RenderQueue::GetDrawCount() const { return m_Keys.size(); }
+
+	template<typename T>
+	uint16_t RenderQueue::GetId(std::vector<T*>& _objects, T* _object, const void* _handle, uint32_t _bits)
+	{
+		if (auto it{ m_Ids.find(_handle) }; it != m_Ids.end())
+			return it->second;
+
+		if (_objects.size() >= (1u << _bits))
+		{
+			Minerva::Vulkan::Logger::Log_Error("Unable to submit draw to RenderQueue. Too many distinct pipelines, descriptor sets or buffers in one frame.");
+			throw std::runtime_error("Unable to submit draw to RenderQueue. Too many distinct pipelines, descriptor sets or buffers in one frame.");
+		}
+
+		const uint16_t id{ static_cast<uint16_t>(_objects.size()) };
+		_objects.push_back(_object);
+		m_Ids.emplace(_handle, id);
+		return id;
+	}
+
+	uint64_t RenderQueue::QuantizeDepth(float _depth, uint32_t _bits)
+	{
+		// The bit pattern of a non negative float grows with its value, its top bits are an order preserving quantization
+		const float depth{ std::max(_depth, 0.f) };
+		uint32_t bits;
+		std::memcpy(&bits, &depth, sizeof(bits));
+		return bits >> (31 - _bits);
+	}
+}
@@ -2,12 +2,37 @@
 
 namespace Minerva
 {
-	Renderpass::Renderpass(const Minerva::Device& _device, const Minerva::Window& _window, float* _clearColor) :
+	Renderpass::Renderpass(const Minerva::Device& _device, const Minerva::Window& _window, float* _clearColor, bool _depthAttachment, bool _stencil, VkSampleCountFlagBits _samples) :
 		m_VKRenderpassHandle{ nullptr }
 	{
-		m_VKRenderpassHandle = std::make_shared<Minerva::Vulkan::Renderpass>(_device.GetVKDeviceHandle(), _window.GetVKWindowHandle(), _clearColor);
+		m_VKRenderpassHandle = std::make_shared<Minerva::Vulkan::Renderpass>(_device.GetVKDeviceHandle(), _window.GetVKWindowHandle(), _clearColor, _depthAttachment, _stencil,
+			std::span<const VkFormat>{}, _samples);
 	}
 
+	Renderpass::Renderpass(const Minerva::Device& _device, const Minerva::Window& _window, float* _clearColor, std::span<const VkFormat> _gbufferFormats) :
+		m_VKRenderpassHandle{ nullptr }
+	{
+		if (_gbufferFormats.empty())
+		{
+			Minerva::Vulkan::Logger::Log_Error("Unable to create deferred render pass. No G-buffer format given.");
+			throw std::runtime_error("Unable to create deferred render pass. No G-buffer format given.");
+		}
+
+		m_VKRenderpassHandle = std::make_shared<Minerva::Vulkan::Renderpass>(_device.GetVKDeviceHandle(), _window.GetVKWindowHandle(), _clearColor, true, false, _gbufferFormats);
+	}
+
+	inline bool Renderpass::HasDepthAttachment() const { return m_VKRenderpassHandle->HasDepthAttachment(); }
+	inline bool Renderpass::HasStencil() const { return m_VKRenderpassHandle->HasStencil(); }
+	inline VkFormat Renderpass::GetDepthFormat() const { return m_VKRenderpassHandle->GetVKDepthFormat(); }
+	inline uint32_t Renderpass::GetSubpassCount() const { return m_VKRenderpassHandle->GetSubpassCount(); }
+	inline uint32_t Renderpass::GetGBufferCount() const { return m_VKRenderpassHandle->GetGBufferCount(); }
+	inline VkSampleCountFlagBits Renderpass::GetSamples() const { return m_VKRenderpassHandle->GetVKSamples(); }
+
+	inline void Renderpass::SetColorLoadOp(VkAttachmentLoadOp _loadOp) { m_VKRenderpassHandle->SetColorLoadOp(_loadOp); }
+	inline void Renderpass::SetDepthOps(VkAttachmentLoadOp _loadOp, VkAttachmentStoreOp _storeOp) { m_VKRenderpassHandle->SetDepthOps(_loadOp, _storeOp); }
+	inline void Renderpass::SetClearColor(const float* _clearColor) { m_VKRenderpassHandle->SetClearColor(_clearColor); }
+	inline void Renderpass::SetClearDepth(float _depth, uint32_t _stencil) { m_VKRenderpassHandle->SetClearDepth(_depth, _stencil); }
+
 	inline void Renderpass::RecreateRenderpass() { m_VKRenderpassHandle->RecreateRenderpass(); }
 	inline void Renderpass::CleanupRenderpass() { m_VKRenderpassHandle->CleanupRenderpass(); }
 }
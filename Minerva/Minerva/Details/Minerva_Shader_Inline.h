@@ -3,7 +3,7 @@
 namespace Minerva
 {
 	Shader::Shader(Minerva::Device& _device, const std::string_view _filepath, Type _shaderType) :
-		m_VKShaderHandle{ nullptr }
+		m_VKShaderHandle{ nullptr }, m_Specializations{}
 	{
 		m_VKShaderHandle = std::make_shared<Minerva::Vulkan::Shader>(_device.GetVKDeviceHandle(), _filepath, _shaderType);
 	}
@@ -11,4 +11,51 @@ namespace Minerva
 	inline Minerva::Shader::Type Shader::GetShaderType() const { return m_VKShaderHandle->GetShaderType(); }
 
 	inline std::string_view Shader::GetFilepath() const { return m_VKShaderHandle->GetFilepath(); }
+
+	inline const Minerva::Tools::SPIRVReflect::Reflection& Shader::GetReflection() const { return m_VKShaderHandle->GetReflection(); }
+
+	template<typename T>
+	inline void Shader::Specialize(uint32_t _constantID, T _value)
+	{
+		static_assert(std::is_same_v<T, bool> || ((std::is_integral_v<T> || std::is_floating_point_v<T>) && (sizeof(T) == 4 || sizeof(T) == 8)),
+			"Specialization constants are bool or 32 and 64 bit scalars.");
+
+		const std::vector<Minerva::Tools::SPIRVReflect::SpecializationConstant>& constants{ GetReflection().m_SpecializationConstants };
+		auto constant{ std::find_if(constants.begin(), constants.end(), [_constantID](const Minerva::Tools::SPIRVReflect::SpecializationConstant& _constant) { return _constant.m_ConstantID == _constantID; }) };
+		if (constant == constants.end())
+		{
+			std::stringstream ss;
+			ss << "Unable to specialize shader. " << GetFilepath() << " has no specialization constant " << _constantID << ".";
+			Minerva::Vulkan::Logger::Log_Error(ss.str());
+			throw std::runtime_error(ss.str());
+		}
+
+		using ScalarType = Minerva::Tools::SPIRVReflect::ScalarType;
+		const ScalarType type{ std::is_same_v<T, bool> ? ScalarType::BOOL : std::is_floating_point_v<T> ? ScalarType::FLOAT :
+			std::is_signed_v<T> ? ScalarType::INT : ScalarType::UINT };
+		const uint32_t size{ std::is_same_v<T, bool> ? static_cast<uint32_t>(sizeof(VkBool32)) : static_cast<uint32_t>(sizeof(T)) };
+		if (constant->m_Type != type || constant->m_Size != size)
+		{
+			std::stringstream ss;
+			ss << "Unable to specialize shader. Specialization constant " << _constantID << " (" << constant->m_Name << ") of " << GetFilepath()
+				<< " has a different type.";
+			Minerva::Vulkan::Logger::Log_Error(ss.str());
+			throw std::runtime_error(ss.str());
+		}
+
+		// Bools are passed as VkBool32
+		Specialization specialization{ .m_ConstantID = _constantID, .m_Size = size, .m_Value = 0 };
+		if constexpr (std::is_same_v<T, bool>)
+			specialization.m_Value = _value ? VK_TRUE : VK_FALSE;
+		else
+			std::memcpy(&specialization.m_Value, &_value, sizeof(T));
+
+		auto it{ std::lower_bound(m_Specializations.begin(), m_Specializations.end(), _constantID, [](const Specialization& _specialization, uint32_t _id) { return _specialization.m_ConstantID < _id; }) };
+		if (it != m_Specializations.end() && it->m_ConstantID == _constantID)
+			*it = specialization;
+		else
+			m_Specializations.insert(it, specialization);
+	}
+
+	inline std::span<const Shader::Specialization> Shader::GetSpecializations() const { return m_Specializations; }
 }
@@ -48,11 +48,25 @@ namespace Minerva
 
 	inline void Window::SetHeight(int _height) { m_VKWindowHandle->SetHeight(_height); }
 
+	inline uint32_t Window::GetFrameIndex() const { return m_VKWindowHandle->GetFrameIndex(); }
+
+	inline uint32_t Window::GetFrameCount() const { return m_VKWindowHandle->GetFrameCount(); }
+
+    inline Minerva::CommandBuffer Window::GetComputeCommandBuffer()
+    {
+        return m_VKWindowHandle->GetComputeCommandBuffer();
+    }
+
     inline Minerva::CommandBuffer Window::GetCommandBuffer()
     {
         return m_VKWindowHandle->GetCommandBuffer();
     }
 
+    inline Minerva::CommandBuffer Window::GetParallelCommandBuffer()
+    {
+        return m_VKWindowHandle->GetCommandBuffer(VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+    }
+
     inline bool Window::BeginRender(Minerva::Pipeline& _pipeline)
     {
         RenderStatus retval{ m_VKWindowHandle->BeginRender(_pipeline.GetVKPipelineHandle()->GetVKRenderpassHandle())};
@@ -78,6 +92,9 @@ namespace Minerva
 
     inline void Window::PageFlip(Minerva::Pipeline& _pipeline)
     {
+        // End the frame's render pass, begun by GetCommandBuffer
+        m_VKWindowHandle->GetVKRenderpassHandle()->End(m_VKWindowHandle->GetVKFrameCommandBuffer(), static_cast<int>(m_VKWindowHandle->GetImageIndex()));
+
         RenderStatus retval{ m_VKWindowHandle->PageFlip() };
         if (retval == RenderStatus::WINDOW_RESIZED) // Deal with resize
         {
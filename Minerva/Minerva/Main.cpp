@@ -54,6 +54,9 @@ int main(int argc, const char* argv[])
 		Minerva::Input::Initialize();
 
 
+		// Startup is timed up to the render loop, run twice to compare a cold and a warm pipeline cache
+		const auto startupStart{ std::chrono::steady_clock::now() };
+
 		// Create Instance
 		Minerva::Instance instance("Homework 2", 0, true, true, LogWarn, LogError);
 
@@ -65,7 +68,7 @@ int main(int argc, const char* argv[])
 
 		// Setup Renderpass
 		std::array<float, 4> clearColor{ 0.f, 0.f, 0.f, 1.f };
-		Minerva::Renderpass renderpass(device, window, clearColor.data());
+		Minerva::Renderpass renderpass(device, window, clearColor.data(), true);
 
 		// Setup Attributes
 		std::array<Minerva::VertexDescriptor::Attribute, 3> attributes{
@@ -93,33 +96,18 @@ int main(int argc, const char* argv[])
 		shaders.emplace_back(device, "Assets\\Shaders\\vert.spv", Minerva::Shader::Type::VERTEX);
 		shaders.emplace_back(device, "Assets\\Shaders\\frag.spv", Minerva::Shader::Type::FRAGMENT);
 
-		// Setup Descriptor Set Layout
-		//! Only require Sampler in this module.
-		//! If intending to use UBOs, need to make changes to how descriptor sets work as each FFI will require their own Descriptor Sets
-		//! In this case, since samplers are not required to be updated, we can do it this way...
-		std::vector<Minerva::DescriptorSet::Layout> descriptorLayouts{
-			{
-				1, // Binding point
-				Minerva::DescriptorSet::DescriptorType::COMBINED_IMAGE_SAMPLER, // Descriptor type
-				//todo << DDS requires multiple textures. Will putting into 1 array work? (Talking about the line below) >>
-				1, // Descriptor count -> Can try and add more for multiple textures
-				Minerva::Shader::Type::FRAGMENT // Shader stage
-			}
-		};
-
-		// Create actual descriptor set
+		// Create actual descriptor set, its layouts are reflected from the shaders (a combined image sampler at binding 1 of the fragment shader)
 		//! FFI Considerations - If we plan to do this for Frames In Flight, descriptorSets will be stored in Window (kinda weird and ugly tbh), then:
 		//!		window.createDescriptorSets(descriptorLayout)
-		Minerva::DescriptorSet descriptorSet(device, descriptorLayouts);
+		Minerva::DescriptorSet descriptorSet(device, shaders.data(), static_cast<int>(shaders.size()));
 
 		// Setup Pipeline
-		//todo DEPTH BUFFER DONT FORGET PLS
+		//! The render pass has a depth attachment for depth testing, see Minerva::Pipeline::State for depth prepasses
 		Minerva::Pipeline pipeline(device, window, renderpass, shaders.data(), shaders.size(), descriptorSet, vertexDescriptor);
 
 
-		//todo This to be replaced with model loading
-		//todo Look towards a mesh class
 		// Vertices and Indices raw data
+		//! Models can be imported with Minerva::Mesh(device, "Assets\\Models\\model.obj"), which picks 16/32-bit indices itself
 		//const std::vector<Vertex> vertices{
 		//	// front
 		//	{ {-0.5f, -0.5f,  0.5f}, {1.f, 0.f, 0.f}, },
@@ -189,7 +177,7 @@ int main(int argc, const char* argv[])
 		textures.emplace_back(device, "Assets\\Textures\\Stone_Wall 01_1K_Normal.dds");
 
 		// Write texture to descriptor set
-		descriptorSet.Update(descriptorLayouts[0], textures);
+		descriptorSet.Update(descriptorSet.GetLayout(1), textures);
 		//! FFI Considerations - window.updateDescriptorSet(descriptorLayout[1], textures.data(), textures.size()) -> Texture
 
 		//! FFI Considerations - To write UBOs
@@ -216,6 +204,12 @@ int main(int argc, const char* argv[])
 		glm::vec3 rotationStaticVal{0.f};
 		glm::mat4 rotationStaticMat(1.f);
 
+		// Draws are submitted in any order and sorted by state before recording
+		Minerva::RenderQueue renderQueue;
+
+		std::cout << "Startup: " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startupStart).count() << " ms, pipelines: "
+			<< device.GetPipelineCreationTime() << " ms (" << (device.IsPipelineCacheWarm() ? "warm" : "cold") << " pipeline cache)\n";
+
 		// Render loop
 		while (window.ProcessInput())
 		{
@@ -223,12 +217,16 @@ int main(int argc, const char* argv[])
 			// Start render
 			if (!window.BeginRender(pipeline)) continue; // Skip if minimized
 				
-			// Bind Commands
 			Minerva::CommandBuffer cmdBuffer{ window.GetCommandBuffer() };
-			cmdBuffer.BindGraphicsPipeline(pipeline);
-			cmdBuffer.BindBuffer(vertexBuffer);
-			cmdBuffer.BindBuffer(indexBuffer);
-			cmdBuffer.BindDescriptorSet(pipeline, descriptorSet);
+
+			// Both cubes share all state, only their push constants differ
+			Minerva::RenderQueue::Draw cubeDraw{
+				.m_Pipeline = &pipeline,
+				.m_DescriptorSet = &descriptorSet,
+				.m_VertexBuffer = &vertexBuffer,
+				.m_IndexBuffer = &indexBuffer,
+				.m_IndexCount = static_cast<uint32_t>(indices.size())
+			};
 
 			// "Logic"
 
@@ -298,18 +296,20 @@ int main(int argc, const char* argv[])
 				// calculate final mesh matrix and update constant
 				constants.MVP = projection * view * model;
 
-				cmdBuffer.PushConstant(pipeline, Minerva::Shader::Type::VERTEX, 0, sizeof(PushConstant), &constants);
-				cmdBuffer.DrawIndexed(static_cast<uint32_t>(indices.size()), 1, 0, 0, 0);
+				cubeDraw.m_Depth = glm::length(glm::vec3{ view * model[3] });
+				renderQueue.Submit(cubeDraw, &constants, sizeof(PushConstant));
 			}
 
 			// Static cube
 			{
 				glm::mat4 model = glm::translate(glm::mat4(1.f), { 1.f, 0.f, 0.f }) * rotationStaticMat;
 				constants.MVP = projection * view * model;
-				cmdBuffer.PushConstant(pipeline, Minerva::Shader::Type::VERTEX, 0, sizeof(PushConstant), &constants);
-				cmdBuffer.DrawIndexed(static_cast<uint32_t>(indices.size()), 1, 0, 0, 0);
+				cubeDraw.m_Depth = glm::length(glm::vec3{ view * model[3] });
+				renderQueue.Submit(cubeDraw, &constants, sizeof(PushConstant));
 			}
-				
+
+			// Sort and record the frame's draws
+			renderQueue.Flush(cmdBuffer);
 				
 			// Page flip
 			window.PageFlip(pipeline);
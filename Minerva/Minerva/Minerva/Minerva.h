@@ -7,6 +7,8 @@
 #include <array>
 #include <algorithm>
 #include <fstream>
+#include <filesystem>
+#include <chrono>
 #include <iostream>
 #include <string_view>
 #include <source_location>
@@ -14,6 +16,14 @@
 #include <sstream>
 #include <string>
 #include <memory>
+#include <functional>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <cstring>
 #include <unordered_map>
 #include <limits>
 #include <vector>
@@ -36,9 +46,36 @@
 #define TINYDDSLOADER_IMPLEMENTATION
 #include <tinyddsloader.h>
 
+//! In-house job helpers
+#include <Minerva_Parallel.h>
+
 //! In-house DDS Loader
 #include <Minerva_DDSLoader.h>
 
+//! In-house Mesh Loader
+#include <Minerva_MeshLoader.h>
+
+//! In-house Meshlet Builder
+#include <Minerva_Meshlet.h>
+
+//! In-house Mesh Simplifier
+#include <Minerva_Simplifier.h>
+
+//! In-house Skeletal Animation
+#include <Minerva_Animation.h>
+
+//! In-house Radix Sort
+#include <Minerva_RadixSort.h>
+
+//! In-house Masked Occlusion Culling
+#include <Minerva_MaskedOcclusion.h>
+
+//! In-house Bounding Volume Hierarchy
+#include <Minerva_BVH.h>
+
+//! In-house SPIR-V Reflection
+#include <Minerva_SPIRVReflect.h>
+
 
 //! Forward declaration of private interface
 namespace Minerva::Vulkan
@@ -53,8 +90,11 @@ namespace Minerva::Vulkan
 	class Texture;
 	class DescriptorSet;
 	class Pipeline;
+	class PipelineLibrary;
 	class Buffer;
 	class CommandBuffer;
+	class DepthPyramid;
+	class RenderGraph;
 }
 
 //! Public Interface
@@ -66,10 +106,20 @@ namespace Minerva::Vulkan
 #include "Minerva_Shader.h"
 #include "Minerva_Vertex_Descriptor.h"
 #include "Minerva_Texture.h"
+#include "Minerva_Buffer.h"
 #include "Minerva_DescriptorSet.h"
 #include "Minerva_Pipeline.h"
-#include "Minerva_Buffer.h"
+#include "Minerva_PipelineLibrary.h"
 #include "Minerva_CmdBuffer.h"
+#include "Minerva_Mesh.h"
+#include "Minerva_MeshletCuller.h"
+#include "Minerva_GeometryPool.h"
+#include "Minerva_JointPalette.h"
+#include "Minerva_ComputeSkinner.h"
+#include "Minerva_RenderQueue.h"
+#include "Minerva_ObjectCuller.h"
+#include "Minerva_OcclusionCuller.h"
+#include "Minerva_RenderGraph.h"
 
 //! Private Interface
 #include "../Details/MinervaVulkan/minerva_vulkan.h"
@@ -85,6 +135,16 @@ namespace Minerva::Vulkan
 #include "../Details/Minerva_Texture_Inline.h"
 #include "../Details/Minerva_DescriptorSet_Inline.h"
 #include "../Details/Minerva_Pipeline_Inline.h"
+#include "../Details/Minerva_PipelineLibrary_Inline.h"
 #include "../Details/Minerva_Buffer_Inline.h"
 #include "../Details/Minerva_CmdBuffer_Inline.h"
+#include "../Details/Minerva_Mesh_Inline.h"
+#include "../Details/Minerva_MeshletCuller_Inline.h"
+#include "../Details/Minerva_GeometryPool_Inline.h"
+#include "../Details/Minerva_JointPalette_Inline.h"
+#include "../Details/Minerva_ComputeSkinner_Inline.h"
+#include "../Details/Minerva_RenderQueue_Inline.h"
+#include "../Details/Minerva_ObjectCuller_Inline.h"
+#include "../Details/Minerva_OcclusionCuller_Inline.h"
+#include "../Details/Minerva_RenderGraph_Inline.h"
 
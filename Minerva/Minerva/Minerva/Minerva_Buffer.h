@@ -11,11 +11,27 @@ namespace Minerva
 			INDEX,
 			UNIFORM,
 			TRANSFER_SRC,
+			STORAGE,         // Compute read/write. Can also be bound as a vertex, index or indirect argument buffer
+			DYNAMIC_STORAGE, // Storage buffer kept mapped in host visible memory, for data rewritten by the CPU every frame
+			INDIRECT,        // Draw arguments (and draw counts) for the indirect draws. Filled through Upload or written by compute
 		};
 
-		Buffer(Minerva::Device& _device, Type _type, const void* _data, uint32_t _size);
+		// Width of the indices stored in an INDEX buffer
+		enum class IndexType : uint8_t
+		{
+			UINT16,
+			UINT32
+		};
+
+		// _data may be nullptr for buffers that are filled later through Upload or written on the GPU
+		Buffer(Minerva::Device& _device, Type _type, const void* _data, uint32_t _size, IndexType _indexType = IndexType::UINT16);
+
+		// Copies _size bytes of _data to _offset. Blocks until the copy has completed.
+		// DYNAMIC_STORAGE buffers are written directly, the caller must make sure the GPU is no longer reading the range
+		inline void Upload(const void* _data, uint32_t _offset, uint32_t _size);
 		inline std::shared_ptr<Minerva::Vulkan::Buffer> GetVKBufferHandle() const;
 		inline VkBuffer GetVKBuffer() const;
+		inline IndexType GetIndexType() const;
 
 	private:
 		std::shared_ptr<Minerva::Vulkan::Buffer> m_VKBufferHandle;
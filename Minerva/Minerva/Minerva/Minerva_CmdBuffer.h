@@ -5,15 +5,73 @@ namespace Minerva
 	class CommandBuffer
 	{
 	public:
-		CommandBuffer(std::shared_ptr<Minerva::Vulkan::Renderpass> _renderpass, VkCommandBuffer _vkCommandBuffer, VkExtent2D _extent, int _index);
+		// Bind and dynamic state calls recorded, and calls skipped because the state was already set
+		struct Statistics
+		{
+			uint32_t m_PipelineBinds{ 0 };
+			uint32_t m_DescriptorSetBinds{ 0 };
+			uint32_t m_VertexBufferBinds{ 0 };
+			uint32_t m_IndexBufferBinds{ 0 };
+			uint32_t m_DynamicStateSets{ 0 }; // Viewport and scissor
+			uint32_t m_SkippedPipelineBinds{ 0 };
+			uint32_t m_SkippedDescriptorSetBinds{ 0 };
+			uint32_t m_SkippedVertexBufferBinds{ 0 };
+			uint32_t m_SkippedIndexBufferBinds{ 0 };
+			uint32_t m_SkippedDynamicStateSets{ 0 };
+			uint32_t m_PipelineBarriers{ 0 }; // Batches recorded by resource state tracking
 
+			inline Statistics& operator+=(const Statistics& _other);
+		};
+
+		CommandBuffer(std::shared_ptr<Minerva::Vulkan::Renderpass> _renderpass, VkCommandBuffer _vkCommandBuffer, VkExtent2D _extent, int _index, bool _isRecording = false);
+		explicit CommandBuffer(std::shared_ptr<Minerva::Vulkan::CommandBuffer> _vkCommandBufferHandle);
+
+		// Splits [0, _count) into contiguous ranges recorded on worker threads, _function(secondaryCmdBuffer, begin, end) per range.
+		// Each worker records into a secondary command buffer from its own per frame pool, the secondaries are then executed in range order,
+		// so draw order is preserved. Only valid on command buffers from Window::GetParallelCommandBuffer.
+		// Bound pipelines, buffers and descriptor sets are not inherited, every range must bind its own state
+		template<typename T_FUNCTION>
+		inline void RecordParallel(size_t _count, size_t _minBatchSize, T_FUNCTION&& _function);
+
+		// Ends the render pass, e.g. to run compute over its depth, and continues it without clearing.
+		// A suspended render pass must be resumed before Window::PageFlip
+		inline void SuspendRenderpass();
+		inline void ResumeRenderpass();
+		// Moves to the next subpass of a deferred render pass, e.g. from the G-buffer to the lighting subpass.
+		// Pipelines drawing in it are created with a matching Pipeline::State::m_Subpass
+		inline void NextSubpass();
+
+		// Throws for pipelines that are not ready yet, see Pipeline::IsReady
 		inline void BindGraphicsPipeline(Minerva::Pipeline& _pipeline);
+		inline void BindComputePipeline(Minerva::Pipeline& _pipeline);
 		inline void BindBuffer(Minerva::Buffer& _buffer);
+		inline void BindVertexBuffer(Minerva::Buffer& _buffer, uint32_t _offset = 0); // Binds any vertex capable buffer, e.g. compute output, to binding 0
 		inline void BindDescriptorSet(Minerva::Pipeline& _pipeline, Minerva::DescriptorSet& _descriptorSet);
 		inline void Draw(int _vertexCount, int _instanceCount, int _firstIndex, int _firstInstance);
 		inline void DrawIndexed(uint32_t _indexCount, uint32_t _instanceCount, uint32_t _firstIndex, int32_t _vertexOffset, uint32_t _firstInstance);
+
+		// Indirect draws read _drawCount VkDrawIndirectCommand / VkDrawIndexedIndirectCommand from _buffer (INDIRECT or STORAGE) at _offset, _stride bytes apart.
+		// The Count variants read the draw count as a uint32_t from _countBuffer at _countOffset, clamped to _maxDrawCount
+		inline void DrawIndirect(Minerva::Buffer& _buffer, uint32_t _offset, uint32_t _drawCount, uint32_t _stride = sizeof(VkDrawIndirectCommand));
+		inline void DrawIndexedIndirect(Minerva::Buffer& _buffer, uint32_t _offset, uint32_t _drawCount, uint32_t _stride = sizeof(VkDrawIndexedIndirectCommand));
+		inline void DrawIndirectCount(Minerva::Buffer& _buffer, uint32_t _offset, Minerva::Buffer& _countBuffer, uint32_t _countOffset, uint32_t _maxDrawCount,
+			uint32_t _stride = sizeof(VkDrawIndirectCommand));
+		inline void DrawIndexedIndirectCount(Minerva::Buffer& _buffer, uint32_t _offset, Minerva::Buffer& _countBuffer, uint32_t _countOffset, uint32_t _maxDrawCount,
+			uint32_t _stride = sizeof(VkDrawIndexedIndirectCommand));
+
+		// Dispatches need a bound compute pipeline and are recorded outside of render passes
+		inline void Dispatch(uint32_t _groupCountX, uint32_t _groupCountY, uint32_t _groupCountZ);
+		// Reads a VkDispatchIndirectCommand from _buffer (INDIRECT or STORAGE) at _offset, a multiple of 4. The group counts may be written by an earlier dispatch
+		inline void DispatchIndirect(Minerva::Buffer& _buffer, uint32_t _offset = 0);
+		inline void UpdateBuffer(Minerva::Buffer& _buffer, uint32_t _offset, uint32_t _size, const void* _pData);
+		// Pushed to every stage reading the pipeline's push constant block. Bytes past the end of the block are not pushed. _stage must be one of those stages
 		inline void PushConstant(Minerva::Pipeline& _pipeline, Minerva::Shader::Type _stage, uint32_t _offset, uint32_t _size, const void* _pValue);
 
+		// Counts for everything recorded through this object, including secondary command buffers of RecordParallel
+		inline const Statistics& GetStatistics() const;
+
+		inline std::shared_ptr<Minerva::Vulkan::CommandBuffer> GetVKCommandBufferHandle() const;
+
 
 	private:
 		std::shared_ptr<Minerva::Vulkan::CommandBuffer> m_VKCommandBufferHandle;
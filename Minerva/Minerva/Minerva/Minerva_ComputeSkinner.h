@@ -0,0 +1,48 @@
+#pragma once
+
+namespace Minerva
+{
+	// Skins a mesh for many characters in a compute pre-pass. The output holds one world space copy of the mesh per instance
+	// in Minerva::Mesh::Vertex layout, so skinned characters render with the same pipeline as static meshes.
+	// Worth it over vertex shader skinning when the skinned vertices are drawn more than once per frame (shadow passes, depth prepass)
+	class ComputeSkinner
+	{
+	public:
+		// Push constant block of Assets/Shaders/skin.comp
+		struct SkinData
+		{
+			uint32_t m_VertexCount;
+			uint32_t m_InstanceCount;
+			uint32_t m_JointCount;
+			uint32_t m_FirstMatrix; // Instance i reads palette matrices [m_FirstMatrix + i * m_JointCount, ...)
+		};
+
+		// _skinShader is the compiled skin.comp. Every instance uses _jointCount consecutive matrices of _palette
+		ComputeSkinner(Minerva::Device& _device, Minerva::Window& _window, Minerva::JointPalette& _palette,
+			std::span<const Minerva::JointPalette::SkinnedVertex> _vertices, uint32_t _jointCount, uint32_t _maxInstanceCount,
+			const Minerva::Shader& _skinShader);
+
+		// Records the skinning pass for the frame being recorded. _computeCmdBuffer must come from Window::GetComputeCommandBuffer
+		inline void Skin(Minerva::CommandBuffer& _computeCmdBuffer, uint32_t _instanceCount, uint32_t _firstMatrix = 0);
+
+		// Draws every instance skinned by the last Skin call. _indexBuffer indexes the source vertices
+		inline void Draw(Minerva::CommandBuffer& _cmdBuffer, Minerva::Buffer& _indexBuffer, uint32_t _indexCount);
+
+		inline Minerva::Buffer& GetOutputBuffer();
+		inline uint32_t GetVertexCount() const;
+
+	private:
+		std::shared_ptr<Minerva::Vulkan::Window> m_VKWindowHandle;
+		std::array<Minerva::DescriptorSet::Layout, 3> m_Layouts;
+		Minerva::Buffer m_SourceBuffer;
+		std::vector<Minerva::Buffer> m_OutputBuffers;         // One per frame in flight
+		std::vector<Minerva::DescriptorSet> m_DescriptorSets; // One per frame in flight
+		Minerva::Pipeline m_Pipeline;
+		uint32_t m_VertexCount;
+		uint32_t m_JointCount;
+		uint32_t m_MaxInstanceCount;
+		uint32_t m_InstanceCount;
+
+		static std::vector<Minerva::DescriptorSet> CreateDescriptorSets(Minerva::Device& _device, Minerva::Window& _window, std::span<Minerva::DescriptorSet::Layout> _layouts);
+	};
+}
@@ -30,11 +30,24 @@ namespace Minerva
 		};
 
 		DescriptorSet(Minerva::Device &_device, std::span<Minerva::DescriptorSet::Layout> _layouts);
+		// Layouts reflected from the shaders of the pipelines using the set, see ReflectLayouts
+		DescriptorSet(Minerva::Device& _device, const Minerva::Shader* _shaders, int _shaderCount);
 		~DescriptorSet();
 
 		inline std::shared_ptr<Minerva::Vulkan::DescriptorSet> GetVKDescriptorSetHandle() const;
+		inline std::span<const Layout> GetLayouts() const;
+		// Layout of _bindingPoint. Throws if the set has no such binding
+		inline const Layout& GetLayout(uint32_t _bindingPoint) const;
+
+		// Bindings of set 0 declared by _shaders, sorted by binding point. Bindings read by several graphics stages become ALL_GRAPHICS,
+		// runtime sized arrays get a single descriptor
+		static inline std::vector<Layout> ReflectLayouts(const Minerva::Shader* _shaders, int _shaderCount);
 
 		inline void Update(const Layout& _layout, std::span<Minerva::Texture> _textures);
+		inline void Update(const Layout& _layout, std::span<Minerva::Buffer> _buffers);
+		// INPUT_ATTACHMENT binding reading input attachment _attachment of a deferred render pass' lighting subpass,
+		// G-buffer attachments first and the depth last. Rewritten whenever the render pass is recreated
+		inline void Update(const Layout& _layout, Minerva::Renderpass& _renderpass, uint32_t _attachment);
 
 	private:
 		std::shared_ptr<Minerva::Vulkan::DescriptorSet> m_VKDescriptorSetHandle;
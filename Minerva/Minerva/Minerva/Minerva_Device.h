@@ -21,12 +21,29 @@ namespace Minerva
 			, NON_DISCRETE_ONLY
 		};
 
-		Device(const Minerva::Instance& _instance, QueueFamily _queueFamily, Type _type);
+		// Pipelines are compiled through a cache loaded from _pipelineCachePath and written back on destruction.
+		// Data from another device or driver version is discarded. An empty path disables the file
+		Device(const Minerva::Instance& _instance, QueueFamily _queueFamily, Type _type, std::string_view _pipelineCachePath = "pipeline_cache.bin");
 
 		inline std::shared_ptr<Minerva::Vulkan::Device> GetVKDeviceHandle() const;
 		inline QueueFamily GetQueueFamily() const;
 		inline Type GetDeviceType() const;
 
+		// Without multi draw indirect, indirect draws of more than one command are split into one call per command.
+		// The indirect count draws need draw indirect count support
+		inline bool IsMultiDrawIndirectSupported() const;
+		inline bool IsDrawIndirectCountSupported() const;
+
+		// Dynamic rendering (core in Vulkan 1.3, VK_KHR_dynamic_rendering before) is used whenever the device supports it.
+		// Render passes then begin rendering directly on image views and pipelines only declare attachment formats,
+		// so resizing the window recreates neither render pass objects, framebuffers nor pipelines
+		inline bool IsDynamicRenderingEnabled() const;
+
+		// Saves the cache now, e.g. after loading a level, so a crash does not lose the pipelines compiled since startup
+		inline void SavePipelineCache();
+		inline bool IsPipelineCacheWarm() const;        // Cache data was loaded from disk
+		inline double GetPipelineCreationTime() const;  // Milliseconds spent creating pipelines so far, to compare cold and warm starts
+
 		//inline void CopyBuffer(Minerva::Buffer& _src, Minerva::Buffer& _dst);
 
 	private:
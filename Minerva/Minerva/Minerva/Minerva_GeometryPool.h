@@ -0,0 +1,45 @@
+#pragma once
+
+namespace Minerva
+{
+	// Packs many meshes into one vertex buffer and one index buffer so they can be drawn without rebinding.
+	// Indices stay local to their mesh and are offset with the draw's vertexOffset, so 16-bit pools work as long as
+	// every single mesh has at most 65535 vertices, see Tools::MeshLoader::RequiresUInt32Indices. Capacity is fixed at creation
+	class GeometryPool
+	{
+	public:
+		// Location of one mesh inside the pool, in vertices and indices
+		struct Range
+		{
+			uint32_t m_FirstIndex;
+			uint32_t m_IndexCount;
+			int32_t m_VertexOffset;
+			uint32_t m_VertexCount;
+		};
+
+		GeometryPool(Minerva::Device& _device, uint32_t _vertexStride, uint32_t _maxVertexCount, uint32_t _maxIndexCount,
+			Minerva::Buffer::IndexType _indexType = Minerva::Buffer::IndexType::UINT32);
+
+		// Uploads one mesh. _vertices holds _vertexCount vertices of the pool's stride
+		Range Add(const void* _vertices, uint32_t _vertexCount, std::span<const uint32_t> _indices);
+		inline Range Add(const Minerva::Tools::MeshLoader::MeshData& _meshData);
+
+		// Binds the pool's vertex and index buffers. Every range can then be drawn with Draw
+		inline void Bind(Minerva::CommandBuffer& _cmdBuffer);
+		inline void Draw(Minerva::CommandBuffer& _cmdBuffer, const Range& _range, uint32_t _instanceCount = 1, uint32_t _firstInstance = 0);
+
+		inline Minerva::Buffer& GetVertexBuffer();
+		inline Minerva::Buffer& GetIndexBuffer();
+		inline uint32_t GetVertexCount() const;
+		inline uint32_t GetIndexCount() const;
+
+	private:
+		Minerva::Buffer m_VertexBuffer;
+		Minerva::Buffer m_IndexBuffer;
+		uint32_t m_VertexStride;
+		uint32_t m_MaxVertexCount;
+		uint32_t m_MaxIndexCount;
+		uint32_t m_VertexCount;
+		uint32_t m_IndexCount;
+	};
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+namespace Minerva
+{
+	// Per frame joint matrix buffers for skinned characters. Update evaluates the animation of every character on worker threads
+	// and writes the palettes into the buffer of the frame being recorded, so frames in flight never see a partial update.
+	// Palettes are in world space (the character's model matrix is baked in), which lets many characters share one instanced draw
+	class JointPalette
+	{
+	public:
+		using Character = Minerva::Tools::Animation::Character;
+		using SkinnedVertex = Minerva::Tools::Animation::SkinnedVertex;
+
+		JointPalette(Minerva::Device& _device, Minerva::Window& _window, uint32_t _maxMatrixCount);
+
+		// Call once per frame after Window::BeginRender. Every character writes its joints at its m_PaletteOffset
+		void Update(std::span<const Character> _characters);
+
+		// Writes the buffer of frame i into _descriptorSets[i] at _layout, one set per frame in flight (Window::GetFrameCount)
+		inline void WriteDescriptors(std::span<Minerva::DescriptorSet> _descriptorSets, const Minerva::DescriptorSet::Layout& _layout);
+
+		inline Minerva::Buffer& GetBuffer(uint32_t _frame);
+		inline Minerva::Buffer& GetCurrentBuffer();
+		inline uint32_t GetMaxMatrixCount() const;
+
+		// Attributes matching SkinnedVertex, for use with Minerva::VertexDescriptor and Assets/Shaders/skinned.vert
+		static inline std::array<Minerva::VertexDescriptor::Attribute, 5> GetVertexAttributes();
+
+	private:
+		std::shared_ptr<Minerva::Vulkan::Window> m_VKWindowHandle;
+		std::vector<Minerva::Buffer> m_Buffers; // One per frame in flight
+		std::vector<glm::mat4> m_Matrices;      // Evaluated in cached memory, mapped memory is write combined
+	};
+}
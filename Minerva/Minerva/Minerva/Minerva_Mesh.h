@@ -0,0 +1,52 @@
+#pragma once
+
+namespace Minerva
+{
+	class Mesh
+	{
+	public:
+		using Vertex = Minerva::Tools::MeshLoader::Vertex;
+
+		// Imports an .obj or .glb file. Index width is picked from the vertex count.
+		// With _lodCount > 1 simplified levels of detail are generated into the same index buffer, see SelectLOD
+		Mesh(Minerva::Device& _device, std::string_view _filepath, uint32_t _lodCount = 1);
+		Mesh(Minerva::Device& _device, const Minerva::Tools::MeshLoader::MeshData& _meshData, uint32_t _lodCount = 1);
+
+		inline Minerva::Buffer& GetVertexBuffer();
+		inline Minerva::Buffer& GetIndexBuffer();
+		inline Minerva::Buffer& GetPositionBuffer(); // Tightly packed positions, the vertex stream of depth prepasses
+		inline uint32_t GetVertexCount() const;
+		inline uint32_t GetIndexCount() const;
+		inline Minerva::Buffer::IndexType GetIndexType() const;
+
+		// Index range of each level, finest first. Draw with DrawIndexed(lod.m_IndexCount, 1, lod.m_FirstIndex, 0, 0)
+		inline uint32_t GetLODCount() const;
+		inline const Minerva::Tools::Simplifier::LOD& GetLOD(uint32_t _lod) const;
+
+		// Coarsest level whose simplification error stays under _pixelError pixels on screen for an instance drawn with _model
+		inline uint32_t SelectLOD(const glm::mat4& _model, const glm::vec3& _cameraPosition, float _fovY, float _screenHeight, float _pixelError = 1.f) const;
+
+		// Attributes matching Minerva::Mesh::Vertex, for use with Minerva::VertexDescriptor
+		static inline std::array<Minerva::VertexDescriptor::Attribute, 3> GetVertexAttributes();
+
+		// Attribute of the position buffer, vertices are sizeof(glm::vec3) bytes
+		static inline std::array<Minerva::VertexDescriptor::Attribute, 1> GetPositionAttributes();
+
+	private:
+		Minerva::Buffer m_VertexBuffer;
+		Minerva::Buffer m_IndexBuffer;
+		Minerva::Buffer m_PositionBuffer;
+		uint32_t m_VertexCount;
+		uint32_t m_IndexCount;
+		std::vector<Minerva::Tools::Simplifier::LOD> m_LODs;
+		glm::vec3 m_BoundsCenter;
+		float m_BoundsRadius;
+
+		Mesh(Minerva::Device& _device, const Minerva::Tools::MeshLoader::MeshData& _meshData, Minerva::Tools::Simplifier::LODChain&& _lodChain);
+
+		static Minerva::Tools::MeshLoader::MeshData LoadMeshData(std::string_view _filepath);
+		static Minerva::Tools::Simplifier::LODChain BuildLODChain(const Minerva::Tools::MeshLoader::MeshData& _meshData, uint32_t _lodCount);
+		static Minerva::Buffer CreatePositionBuffer(Minerva::Device& _device, const Minerva::Tools::MeshLoader::MeshData& _meshData);
+		static Minerva::Buffer CreateIndexBuffer(Minerva::Device& _device, std::span<const uint32_t> _indices, size_t _vertexCount);
+	};
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+namespace Minerva
+{
+	// Splits a mesh into meshlets and culls them on the GPU against the view frustum and their normal cones.
+	// Visible meshlets are compacted into a 32-bit index buffer drawn with a single indirect draw, using the mesh's vertex buffer.
+	class MeshletCuller
+	{
+	public:
+		// Push constant block of Assets/Shaders/meshlet_cull.comp
+		struct CullData
+		{
+			std::array<glm::vec4, 6> m_FrustumPlanes;
+			glm::vec3 m_CameraPosition;
+			uint32_t m_MeshletCount;
+		};
+
+		// _cullShader is the compiled meshlet_cull.comp
+		MeshletCuller(Minerva::Device& _device, const Minerva::Tools::MeshLoader::MeshData& _meshData, const Minerva::Shader& _cullShader);
+
+		// Records the culling pass. Both arguments are in the mesh's object space.
+		// _computeCmdBuffer must come from Window::GetComputeCommandBuffer
+		inline void Cull(Minerva::CommandBuffer& _computeCmdBuffer, const glm::mat4& _modelViewProjection, const glm::vec3& _cameraPosition);
+
+		// Draws the meshlets that survived Cull. The mesh's vertex buffer must be bound
+		inline void Draw(Minerva::CommandBuffer& _cmdBuffer);
+
+		inline uint32_t GetMeshletCount() const;
+
+	private:
+		// std430 layout of a meshlet in meshlet_cull.comp
+		struct GPUMeshlet
+		{
+			glm::vec4 m_Sphere; // xyz center, w radius
+			glm::vec4 m_Cone;   // xyz axis, w cutoff
+			uint32_t m_IndexOffset;
+			uint32_t m_IndexCount;
+			uint32_t m_Padding[2];
+		};
+
+		struct ClusterData
+		{
+			std::vector<GPUMeshlet> m_Meshlets;
+			std::vector<uint32_t> m_Indices; // Mesh vertex indices in meshlet order
+		};
+
+		std::array<Minerva::DescriptorSet::Layout, 4> m_Layouts;
+		Minerva::Buffer m_MeshletBuffer;
+		Minerva::Buffer m_MeshletIndexBuffer;
+		Minerva::Buffer m_CulledIndexBuffer;
+		Minerva::Buffer m_DrawCommandBuffer;
+		Minerva::DescriptorSet m_DescriptorSet;
+		Minerva::Pipeline m_Pipeline;
+		uint32_t m_MeshletCount;
+
+		MeshletCuller(Minerva::Device& _device, const ClusterData& _clusterData, const Minerva::Shader& _cullShader);
+
+		static ClusterData BuildClusterData(const Minerva::Tools::MeshLoader::MeshData& _meshData);
+	};
+}
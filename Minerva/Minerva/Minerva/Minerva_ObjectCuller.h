@@ -0,0 +1,63 @@
+#pragma once
+
+namespace Minerva
+{
+	// Frustum culls whole objects on the GPU. Objects live in a device local storage buffer, a compute pass tests their
+	// bounding spheres and writes one indexed indirect draw per visible object, so the CPU cost does not grow with the object count.
+	// Visible draws are compacted behind an atomic counter when the device supports drawIndirectCount, otherwise every object keeps
+	// its slot and culled ones are drawn with zero instances.
+	// Every draw uses firstInstance = object index, vertex shaders fetch their model matrix through gl_InstanceIndex (see Assets/Shaders/object.vert)
+	class ObjectCuller
+	{
+	public:
+		// std430 layout of an object in object_cull.comp and object.vert
+		struct Object
+		{
+			glm::mat4 m_Model;
+			glm::vec4 m_Sphere;     // Object space bounding sphere, xyz center, w radius
+			uint32_t m_FirstIndex;  // Index range, e.g. a GeometryPool::Range
+			uint32_t m_IndexCount;
+			int32_t m_VertexOffset;
+			uint32_t m_Padding{ 0 };
+		};
+
+		// Push constant block of Assets/Shaders/object_cull.comp
+		struct CullData
+		{
+			std::array<glm::vec4, 6> m_FrustumPlanes;
+			uint32_t m_ObjectCount;
+			uint32_t m_Compact;
+		};
+
+		// _cullShader is the compiled object_cull.comp
+		ObjectCuller(Minerva::Device& _device, const Minerva::Shader& _cullShader, uint32_t _maxObjectCount);
+
+		// Uploads _objects to [_firstObject, _firstObject + _objects.size()). Blocks until the copy has completed,
+		// only the objects that changed need to be uploaded again
+		void SetObjects(std::span<const Object> _objects, uint32_t _firstObject = 0);
+
+		// Records the culling pass over the first _objectCount objects. _computeCmdBuffer must come from Window::GetComputeCommandBuffer
+		inline void Cull(Minerva::CommandBuffer& _computeCmdBuffer, const glm::mat4& _viewProjection, uint32_t _objectCount);
+
+		// Draws the objects that survived Cull. The vertex and index buffers the objects refer to must be bound
+		inline void Draw(Minerva::CommandBuffer& _cmdBuffer);
+
+		// Storage buffer holding the objects, bound to the vertex stage to read the model matrices
+		inline Minerva::Buffer& GetObjectBuffer();
+		inline uint32_t GetMaxObjectCount() const;
+
+		// Sphere around the axis aligned bounds of a mesh
+		static glm::vec4 ComputeBoundingSphere(const Minerva::Tools::MeshLoader::MeshData& _meshData);
+
+	private:
+		std::array<Minerva::DescriptorSet::Layout, 3> m_Layouts;
+		Minerva::Buffer m_ObjectBuffer;
+		Minerva::Buffer m_DrawCommandBuffer;
+		Minerva::Buffer m_DrawCountBuffer;
+		Minerva::DescriptorSet m_DescriptorSet;
+		Minerva::Pipeline m_Pipeline;
+		uint32_t m_MaxObjectCount;
+		uint32_t m_ObjectCount; // Objects culled by the last Cull
+		bool m_Compact;
+	};
+}
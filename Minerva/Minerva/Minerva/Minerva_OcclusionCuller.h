@@ -0,0 +1,77 @@
+#pragma once
+
+namespace Minerva
+{
+	// Frustum and hierarchical-Z occlusion culling on the GPU, in two phases per frame:
+	// - CullEarly tests every object against the frustum and against last frame's depth pyramid, reprojected with last frame's view projection.
+	//   Objects that pass are drawn by DrawEarly, occluded ones are kept for a re-test.
+	// - CullLate suspends the render pass, builds the depth pyramid from what DrawEarly rendered and re-tests the occluded objects against it.
+	//   Objects that became visible (disocclusion, camera motion) are drawn by DrawLate, so nothing pops in for a frame.
+	// The render pass must have a depth attachment. Objects and draws follow ObjectCuller (see Assets/Shaders/object.vert)
+	class OcclusionCuller
+	{
+	public:
+		// std430 layout of the per frame view data in occlusion_cull.comp
+		struct ViewData
+		{
+			glm::mat4 m_ViewProjection;
+			glm::mat4 m_PreviousViewProjection;
+			std::array<glm::vec4, 6> m_FrustumPlanes;
+			glm::vec2 m_PyramidSize;
+			uint32_t m_PreviousPyramidValid;
+			uint32_t m_Padding{ 0 };
+		};
+
+		// Push constant block of Assets/Shaders/occlusion_cull.comp
+		struct CullData
+		{
+			uint32_t m_ObjectCount;
+			uint32_t m_Phase; // 0 early, 1 late
+			uint32_t m_Compact;
+			uint32_t m_MaxObjectCount;
+		};
+
+		// _pyramidShader is the compiled hiz_build.comp, _cullShader the compiled occlusion_cull.comp
+		OcclusionCuller(Minerva::Device& _device, const Minerva::Renderpass& _renderpass, const Minerva::Shader& _pyramidShader,
+			const Minerva::Shader& _cullShader, uint32_t _maxObjectCount);
+
+		// Uploads _objects to [_firstObject, _firstObject + _objects.size()). Blocks until the copy has completed
+		void SetObjects(std::span<const Minerva::ObjectCuller::Object> _objects, uint32_t _firstObject = 0);
+
+		// Records the first phase over the first _objectCount objects. _computeCmdBuffer must come from Window::GetComputeCommandBuffer
+		void CullEarly(Minerva::CommandBuffer& _computeCmdBuffer, const glm::mat4& _viewProjection, uint32_t _objectCount);
+
+		// Draws the objects that passed CullEarly
+		inline void DrawEarly(Minerva::CommandBuffer& _cmdBuffer);
+
+		// Records the depth pyramid build and the second phase. _cmdBuffer is the frame's primary command buffer, inside its render pass,
+		// with every occluder drawn. Leaves the render pass resumed, bound graphics state is kept
+		void CullLate(Minerva::CommandBuffer& _cmdBuffer);
+
+		// Draws the objects that passed CullLate
+		inline void DrawLate(Minerva::CommandBuffer& _cmdBuffer);
+
+		// Storage buffer holding the objects, bound to the vertex stage to read the model matrices
+		inline Minerva::Buffer& GetObjectBuffer();
+		inline uint32_t GetMaxObjectCount() const;
+
+	private:
+		std::array<Minerva::DescriptorSet::Layout, 6> m_Layouts;
+		Minerva::Buffer m_ObjectBuffer;
+		Minerva::Buffer m_VisibilityBuffer;  // Per object: 0 outside the frustum, 1 drawn early, 2 occluded in the early phase
+		Minerva::Buffer m_DrawCommandBuffer; // Early draws, then late draws, m_MaxObjectCount each
+		Minerva::Buffer m_DrawCountBuffer;   // Early count, late count
+		Minerva::Buffer m_ViewBuffer;
+		Minerva::DescriptorSet m_DescriptorSet;
+		Minerva::Pipeline m_Pipeline;
+		std::shared_ptr<Minerva::Vulkan::DepthPyramid> m_VKDepthPyramidHandle;
+		glm::mat4 m_PreviousViewProjection;
+		uint32_t m_MaxObjectCount;
+		uint32_t m_ObjectCount; // Objects culled by the last CullEarly
+		bool m_PreviousPyramidValid;
+		bool m_Compact;
+
+		// Helper function
+		void WritePyramidDescriptor();
+	};
+}
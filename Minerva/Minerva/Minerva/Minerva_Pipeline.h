@@ -8,7 +8,28 @@ namespace Minerva
 
 		enum class Type : uint8_t
 		{
-			GRAPHICS
+			GRAPHICS,
+			COMPUTE
+		};
+
+		// Fixed function state of graphics pipelines. The defaults are opaque, back face culled, depth tested and written geometry
+		struct State
+		{
+			VkCullModeFlags m_CullMode{ VK_CULL_MODE_BACK_BIT };
+			VkPolygonMode m_PolygonMode{ VK_POLYGON_MODE_FILL };
+			VkCompareOp m_DepthCompareOp{ VK_COMPARE_OP_LESS_OR_EQUAL };
+			bool m_DepthTest{ true };  // Ignored without a depth attachment
+			bool m_DepthWrite{ true };
+			bool m_Blend{ false };     // Alpha blending, source over destination
+			bool m_ColorWrite{ true }; // Off for depth only pipelines
+			uint32_t m_Subpass{ 0 };   // Subpass of the render pass the pipeline draws in, see Renderpass::GetSubpassCount
+
+			// Depth prepass: writes depth only. Created with a vertex shader alone, fed by a positions only vertex stream
+			static State DepthPrepass() { return State{ .m_ColorWrite = false }; }
+
+			// Color pass after a depth prepass. Only the visible fragment of each pixel passes, so every pixel is shaded once.
+			// Its vertex shader must compute gl_Position exactly like the prepass one, declare it invariant in both
+			static State AfterDepthPrepass() { return State{ .m_DepthCompareOp = VK_COMPARE_OP_EQUAL, .m_DepthWrite = false }; }
 		};
 
 		Pipeline(Minerva::Device& _device,
@@ -19,7 +40,26 @@ namespace Minerva
 			Minerva::DescriptorSet& _descSet,
 			Minerva::VertexDescriptor& _vertDesc);
 
+		Pipeline(Minerva::Device& _device,
+			Minerva::Window& _window,
+			Minerva::Renderpass& _renderpass,
+			const Minerva::Shader* _shaders,
+			int _shaderCount,
+			Minerva::DescriptorSet& _descSet,
+			Minerva::VertexDescriptor& _vertDesc,
+			const State& _state);
+
+		// Compute pipeline. Push constants are available to the compute stage up to 128 bytes
+		Pipeline(Minerva::Device& _device,
+			const Minerva::Shader& _computeShader,
+			Minerva::DescriptorSet& _descSet);
+
+		explicit Pipeline(std::shared_ptr<Minerva::Vulkan::Pipeline> _pipeline) : m_VKPipelineHandle{ _pipeline } {}
+
 		inline std::shared_ptr<Minerva::Vulkan::Pipeline> GetVKPipelineHandle() const;
+		inline Type GetType() const;
+		// False while a PipelineLibrary compiles the pipeline in the background. Pipelines created directly are always ready
+		inline bool IsReady() const;
 
 	private:
 		std::shared_ptr<Minerva::Vulkan::Pipeline> m_VKPipelineHandle;
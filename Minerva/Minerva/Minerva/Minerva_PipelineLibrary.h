@@ -0,0 +1,36 @@
+#pragma once
+
+namespace Minerva
+{
+	// Graphics pipelines compiled on background threads. Requests with the same description (shaders, vertex input,
+	// fixed function state, render pass and descriptor set bindings) return the same pipeline, so each variant compiles once.
+	// Pending pipelines are compiled in batches of up to 16 per vkCreateGraphicsPipelines call, through the device's pipeline cache.
+	// A returned pipeline is not ready until compiled: skip its draws or draw with a fallback meanwhile (see RenderQueue::Draw).
+	// Render passes and vertex descriptors must stay alive and unchanged while their pipelines compile, call WaitIdle before recreating them
+	class PipelineLibrary
+	{
+	public:
+		PipelineLibrary(Minerva::Device& _device, uint32_t _threadCount = 1);
+
+		inline Minerva::Pipeline Request(Minerva::Window& _window,
+			Minerva::Renderpass& _renderpass,
+			const Minerva::Shader* _shaders,
+			int _shaderCount,
+			Minerva::DescriptorSet& _descSet,
+			Minerva::VertexDescriptor& _vertDesc,
+			const Minerva::Pipeline::State& _state = {});
+
+		// Blocks until every requested pipeline is compiled, e.g. behind a loading screen
+		inline void WaitIdle();
+
+		inline size_t GetPipelineCount() const;       // Unique pipelines
+		inline size_t GetPendingCount() const;        // Not compiled yet
+		inline uint32_t GetDeduplicatedCount() const; // Requests answered by an existing pipeline
+		inline uint32_t GetBatchCount() const;        // vkCreateGraphicsPipelines calls
+
+		inline std::shared_ptr<Minerva::Vulkan::PipelineLibrary> GetVKPipelineLibraryHandle() const { return m_VKPipelineLibraryHandle; }
+
+	private:
+		std::shared_ptr<Minerva::Vulkan::PipelineLibrary> m_VKPipelineLibraryHandle;
+	};
+}
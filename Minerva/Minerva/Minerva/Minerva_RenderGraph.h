@@ -0,0 +1,78 @@
+#pragma once
+
+namespace Minerva
+{
+	// Frame graph of passes declaring what they read and write. Compile, once after the graph is declared:
+	// - culls passes whose results never reach an output or an imported buffer
+	// - creates the transient images, aliasing the memory of images whose lifetimes do not overlap
+	// - creates an offscreen render pass per graphics pass, clearing attachments on first use and storing them only when read later
+	// - derives one batch of barriers per pass from the declared accesses, no barrier between two reads in the same layout
+	// Execute then records every pass on the frame's compute command buffer, outside of the window render pass.
+	// Outputs end in a shader read layout, so they can be sampled by the window render pass
+	class RenderGraph
+	{
+	public:
+		enum class PassType : uint8_t
+		{
+			GRAPHICS = 0, // Records inside a render pass over its attachments
+			COMPUTE,
+			TRANSFER
+		};
+
+		enum class Access : uint8_t
+		{
+			COLOR_ATTACHMENT = 0, // Write, graphics passes only
+			DEPTH_ATTACHMENT,     // Write, graphics passes only. Depth tested and written
+			SAMPLED,              // Read, images through a combined image sampler. Depth images are sampled in their read only layout
+			STORAGE_READ,         // Read, storage images and buffers
+			STORAGE_WRITE,        // Write, storage images and buffers
+			INDIRECT_READ,        // Read, draw arguments and counts
+			VERTEX_READ,          // Read, vertex and index buffers
+			TRANSFER_READ,        // Read, copy source
+			TRANSFER_WRITE        // Write, copy destination
+		};
+
+		struct ImageDesc
+		{
+			VkFormat m_Format;      // Color or depth only, formats with a stencil aspect are not supported
+			uint32_t m_Width{ 0 };  // 0 follows the window, the image is recreated on resize
+			uint32_t m_Height{ 0 };
+			glm::vec4 m_ClearColor{ 0.f }; // Color images, depth is cleared to 1
+		};
+
+		using ResourceHandle = uint32_t;
+		using PassHandle = uint32_t;
+		using ExecuteFunction = std::function<void(Minerva::CommandBuffer&)>;
+
+		RenderGraph(Minerva::Device& _device, Minerva::Window& _window);
+
+		// Declaration, only valid before Compile
+		inline ResourceHandle CreateImage(std::string_view _name, const ImageDesc& _desc);
+		inline ResourceHandle ImportBuffer(std::string_view _name, Minerva::Buffer& _buffer); // Passes writing imported buffers are never culled
+		inline PassHandle AddPass(std::string_view _name, PassType _type, ExecuteFunction _function);
+		inline void Read(PassHandle _pass, ResourceHandle _resource, Access _access);
+		inline void Write(PassHandle _pass, ResourceHandle _resource, Access _access);
+		inline void SetOutput(ResourceHandle _resource);
+		inline void Compile();
+
+		// Writes the image to _layout's binding and rewrites it whenever the image is recreated.
+		// STORAGE_IMAGE bindings use the general layout, others the read only layout and a graph owned sampler
+		inline void BindImage(Minerva::DescriptorSet& _descriptorSet, const Minerva::DescriptorSet::Layout& _layout, ResourceHandle _resource);
+
+		// Render pass of a graphics pass, to create its pipelines. Only valid after Compile
+		inline Minerva::Renderpass GetRenderpass(PassHandle _pass) const;
+
+		// Records every pass that was not culled. _computeCmdBuffer must come from Window::GetComputeCommandBuffer.
+		// Resizes window sized images first, so Execute must precede any use of their descriptor sets in the frame
+		inline void Execute(Minerva::CommandBuffer& _computeCmdBuffer);
+
+		inline bool IsPassCulled(PassHandle _pass) const;
+		inline VkDeviceSize GetTransientMemorySize() const; // Memory of all transient images after aliasing
+		inline uint32_t GetBarrierBatchCount() const;        // vkCmdPipelineBarrier calls recorded by the last Execute
+
+		inline std::shared_ptr<Minerva::Vulkan::RenderGraph> GetVKRenderGraphHandle() const { return m_VKRenderGraphHandle; }
+
+	private:
+		std::shared_ptr<Minerva::Vulkan::RenderGraph> m_VKRenderGraphHandle;
+	};
+}
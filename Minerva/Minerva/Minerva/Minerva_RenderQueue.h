@@ -0,0 +1,98 @@
+#pragma once
+
+namespace Minerva
+{
+	// Collects draws in any order and records them sorted by a 64-bit key, so draws sharing state end up next to each other.
+	// Depth prepass draws come first, then opaque draws, both grouped by pipeline, descriptor set, vertex buffer and index buffer, then front to back.
+	// Transparent draws follow, back to front, using the same state bits to break ties.
+	// Referenced objects must stay alive until the queue is recorded
+	class RenderQueue
+	{
+	public:
+		struct Draw
+		{
+			Minerva::Pipeline* m_Pipeline;
+			Minerva::Pipeline* m_FallbackPipeline{ nullptr };     // Optional, drawn with while m_Pipeline is compiling. Without it the draw is skipped
+			Minerva::DescriptorSet* m_DescriptorSet{ nullptr }; // Optional
+			Minerva::Buffer* m_VertexBuffer;
+			Minerva::Buffer* m_IndexBuffer{ nullptr };           // Optional, without it m_IndexCount vertices are drawn
+			uint32_t m_IndexCount;
+			uint32_t m_FirstIndex{ 0 };
+			int32_t m_VertexOffset{ 0 };
+			uint32_t m_InstanceCount{ 1 };
+			uint32_t m_FirstInstance{ 0 };
+			float m_Depth{ 0.f };                                // View space distance, only its order matters
+			bool m_Transparent{ false };
+			Minerva::Pipeline* m_PrepassPipeline{ nullptr };     // Optional, opaque draws only. Depth only pipeline drawn before all color draws
+			Minerva::Buffer* m_PrepassVertexBuffer{ nullptr };   // Positions only stream of the prepass, m_VertexBuffer without it
+		};
+
+		RenderQueue() = default;
+
+		// _pushConstants (_pushConstantSize bytes, at most 128) are copied and pushed to _stage before the draw.
+		// Draws whose pipeline (and fallback) are not ready yet are dropped.
+		// With m_PrepassPipeline the draw is recorded twice, once in the prepass and once in the color pass, sharing the descriptor set and push constants.
+		// The prepass is skipped while its pipeline compiles, so m_Pipeline should then fall back to a pipeline that writes depth
+		inline void Submit(const Draw& _draw, const void* _pushConstants = nullptr, uint32_t _pushConstantSize = 0, Minerva::Shader::Type _stage = Minerva::Shader::Type::VERTEX);
+
+		// Sorts the submitted draws. Record replays them in that order
+		inline void Sort();
+
+		// Records sorted draws [_begin, _end), binding only the state that changes between them.
+		// Ranges can be recorded on worker threads with CommandBuffer::RecordParallel
+		void Record(Minerva::CommandBuffer& _cmdBuffer, size_t _begin, size_t _end) const;
+		inline void Record(Minerva::CommandBuffer& _cmdBuffer) const;
+
+		// Sort, Record and Clear in one call
+		inline void Flush(Minerva::CommandBuffer& _cmdBuffer);
+
+		// Drops all draws and registered objects, call once per frame after recording
+		inline void Clear();
+
+		inline size_t GetDrawCount() const;
+
+	private:
+		// Key layout, most significant first
+		//   Prepass:     2 pass (0) | 8 pipeline | 10 descriptor set | 10 vertex buffer | 10 index buffer | 24 depth
+		//   Opaque:      2 pass (1) | 8 pipeline | 10 descriptor set | 10 vertex buffer | 10 index buffer | 24 depth
+		//   Transparent: 2 pass (2) | 24 inverted depth | 8 pipeline | 10 descriptor set | 10 vertex buffer | 10 index buffer
+		static constexpr uint32_t PIPELINE_BITS{ 8 };
+		static constexpr uint32_t RESOURCE_BITS{ 10 };
+		static constexpr uint32_t STATE_BITS{ PIPELINE_BITS + 3 * RESOURCE_BITS };
+		static constexpr uint32_t DEPTH_BITS{ 24 };
+		static constexpr uint32_t PASS_SHIFT{ 62 };
+
+		// Per draw data the key points to
+		struct DrawData
+		{
+			uint16_t m_Pipeline;
+			uint16_t m_DescriptorSet;
+			uint16_t m_VertexBuffer;
+			uint16_t m_IndexBuffer;
+			uint32_t m_IndexCount;
+			uint32_t m_FirstIndex;
+			int32_t m_VertexOffset;
+			uint32_t m_InstanceCount;
+			uint32_t m_FirstInstance;
+			uint32_t m_PushConstantOffset;
+			uint32_t m_PushConstantSize;
+			Minerva::Shader::Type m_PushConstantStage;
+		};
+
+		// Objects referenced by this frame's draws, indexed by the ids in DrawData. Id 0 is "none" for optional objects
+		std::vector<Minerva::Pipeline*> m_Pipelines;
+		std::vector<Minerva::DescriptorSet*> m_DescriptorSets{ nullptr };
+		std::vector<Minerva::Buffer*> m_Buffers{ nullptr };
+		std::unordered_map<const void*, uint16_t> m_Ids;
+
+		std::vector<DrawData> m_Draws;
+		std::vector<uint8_t> m_PushConstants;
+		std::vector<Minerva::Tools::RadixSort::KeyValue> m_Keys;
+		std::vector<Minerva::Tools::RadixSort::KeyValue> m_SortScratch;
+
+		template<typename T>
+		uint16_t GetId(std::vector<T*>& _objects, T* _object, const void* _handle, uint32_t _bits);
+
+		static uint64_t QuantizeDepth(float _depth, uint32_t _bits);
+	};
+}
@@ -5,9 +5,39 @@ namespace Minerva
 	class Renderpass
 	{
 	public:
-		Renderpass(const Minerva::Device& _device, const Minerva::Window& _window, float* _clearColor);
+		// With _depthAttachment every framebuffer gets a depth buffer, cleared to 1 and depth tested by its pipelines.
+		// Its format is the most precise one the device supports, with _stencil a combined depth/stencil format cleared to 0.
+		// _samples above 1 enables MSAA: color and depth are transient multisampled images, lazily allocated where the device
+		// allows, and the color is resolved into the window at the end of the pass. The depth is then not readable afterwards
+		// (no DepthPyramid or OcclusionCuller) and the pass cannot be suspended. Pipelines pick up the sample count
+		Renderpass(const Minerva::Device& _device, const Minerva::Window& _window, float* _clearColor, bool _depthAttachment = false, bool _stencil = false,
+			VkSampleCountFlagBits _samples = VK_SAMPLE_COUNT_1_BIT);
+
+		// Deferred render pass over _window with two subpasses. The G-buffer subpass writes one color attachment per format in
+		// _gbufferFormats plus a depth attachment, the lighting subpass reads them as input attachments (G-buffer first, depth last,
+		// see DescriptorSet::Update) and writes the window. The G-buffer is never stored, so it stays in tile memory where possible.
+		// Pipelines pick their subpass with Pipeline::State::m_Subpass, CommandBuffer::NextSubpass moves between them
+		Renderpass(const Minerva::Device& _device, const Minerva::Window& _window, float* _clearColor, std::span<const VkFormat> _gbufferFormats);
+
+		// Wraps a render pass created by the engine, e.g. the offscreen pass of a RenderGraph
+		explicit Renderpass(std::shared_ptr<Minerva::Vulkan::Renderpass> _renderpass) : m_VKRenderpassHandle{ _renderpass } {}
 
 		inline std::shared_ptr<Minerva::Vulkan::Renderpass> GetVKRenderpassHandle() const { return m_VKRenderpassHandle; }
+		inline bool HasDepthAttachment() const;
+		inline bool HasStencil() const;
+		inline VkFormat GetDepthFormat() const; // VK_FORMAT_UNDEFINED without a depth attachment
+		inline uint32_t GetSubpassCount() const;
+		inline uint32_t GetGBufferCount() const; // 0 unless deferred
+		inline VkSampleCountFlagBits GetSamples() const;
+
+		// Attachment operations of the window attachments, CLEAR and STORE by default. DONT_CARE loads skip the clear of a target
+		// every pixel of which is drawn, e.g. by a full screen pass. A DONT_CARE depth store saves writing the depth out when
+		// nothing reads it after the pass: no DepthPyramid or OcclusionCuller, no SuspendRenderpass. The color is always stored.
+		// Render pass objects are cached by the device, so switching between operations does not create new ones or rebuild pipelines
+		inline void SetColorLoadOp(VkAttachmentLoadOp _loadOp);
+		inline void SetDepthOps(VkAttachmentLoadOp _loadOp, VkAttachmentStoreOp _storeOp);
+		inline void SetClearColor(const float* _clearColor);
+		inline void SetClearDepth(float _depth, uint32_t _stencil = 0);
 
 		inline void RecreateRenderpass();
 		inline void CleanupRenderpass();
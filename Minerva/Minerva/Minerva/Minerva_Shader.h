@@ -11,18 +11,40 @@ namespace Minerva
 			FRAGMENT,
 			TESSELLATION,
 			COMPUTE,
+			ALL_GRAPHICS, // Descriptor layouts only, bindings read by more than one graphics stage
 			ENUM_COUNT
 		};
 
+		// Value of a specialization constant, raw bits of the constant's reflected size
+		struct Specialization
+		{
+			uint32_t m_ConstantID;
+			uint32_t m_Size;
+			uint64_t m_Value;
+		};
+
 		Shader(Minerva::Device& _device, const std::string_view _filepath, Type _shaderType);
 
 		inline std::shared_ptr<Minerva::Vulkan::Shader> GetVKShaderHandle() const { return m_VKShaderHandle; }
 
 		inline Minerva::Shader::Type GetShaderType() const;
 		inline std::string_view GetFilepath() const;
+		// Descriptor bindings, push constant block, vertex inputs and specialization constants of the module
+		inline const Minerva::Tools::SPIRVReflect::Reflection& GetReflection() const;
+
+		// Overrides a specialization constant (layout(constant_id = N) const) in pipelines created with this shader.
+		// Copies share the module, so one SPIR-V file gives a variant per pipeline by specializing copies differently.
+		// T must match the constant's type: bool, int32_t, uint32_t, float, int64_t, uint64_t or double
+		template<typename T>
+		inline void Specialize(uint32_t _constantID, T _value);
+		// Sorted by constant id. Constants not specialized keep their default
+		inline std::span<const Specialization> GetSpecializations() const;
 
 	private:
 		// Private interface handle
 		std::shared_ptr<Minerva::Vulkan::Shader> m_VKShaderHandle;
+
+		// Minerva properties
+		std::vector<Specialization> m_Specializations;
 	};
 }
@@ -13,7 +13,8 @@ namespace Minerva
 			FLOAT_3D,
 			FLOAT_4D,
 			UINT8_1D_NORMALIZED,
-			UINT8_4D_NORMALIZED
+			UINT8_4D_NORMALIZED,
+			UINT8_4D             // Integer input (uvec4), e.g. skinning joint indices
 		};
 
 		enum class Topology : uint8_t
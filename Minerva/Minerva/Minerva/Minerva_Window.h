@@ -28,7 +28,17 @@ namespace Minerva
 		inline void SetWidth(int _width);
 		inline void SetHeight(int _height);
 
+		// Frame in flight being recorded, valid after BeginRender. Per frame resources are indexed with it
+		inline uint32_t GetFrameIndex() const;
+		inline uint32_t GetFrameCount() const;
+
+		// Compute work must be recorded before GetCommandBuffer begins the render pass
+		inline Minerva::CommandBuffer GetComputeCommandBuffer();
 		inline Minerva::CommandBuffer GetCommandBuffer();
+
+		// Render pass command buffer whose contents are recorded on worker threads with CommandBuffer::RecordParallel.
+		// Draws cannot be recorded on it directly. Use either this or GetCommandBuffer within a frame
+		inline Minerva::CommandBuffer GetParallelCommandBuffer();
 		inline bool BeginRender(Minerva::Pipeline& _pipeline);
 		inline void PageFlip(Minerva::Pipeline& _pipeline);
 
@@ -0,0 +1,301 @@
+#include "Minerva_Animation.h"
+#include "Minerva_Parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <xmmintrin.h>
+
+namespace Minerva::Tools::Animation
+{
+	namespace
+	{
+		// Channel offsets inside a pose, in units of Pose::m_Stride
+		constexpr uint32_t TX{ 0 }, TY{ 1 }, TZ{ 2 };
+		constexpr uint32_t QX{ 3 }, QY{ 4 }, QZ{ 5 }, QW{ 6 };
+		constexpr uint32_t SX{ 7 }, SY{ 8 }, SZ{ 9 };
+
+		// Characters per worker batch, a palette is a few microseconds of work
+		constexpr size_t CHARACTER_BATCH_SIZE{ 8 };
+
+		// Identity transform in every channel, so padding lanes never produce NaNs
+		void ResetChannels(float* _channels, uint32_t _stride)
+		{
+			std::fill(_channels, _channels + Pose::CHANNEL_COUNT * _stride, 0.f);
+			std::fill(_channels + QW * _stride, _channels + (QW + 1) * _stride, 1.f);
+			std::fill(_channels + SX * _stride, _channels + (SZ + 1) * _stride, 1.f);
+		}
+
+		void WriteJoint(float* _channels, uint32_t _stride, uint32_t _joint, const glm::vec3& _t, const glm::quat& _q, const glm::vec3& _s)
+		{
+			_channels[TX * _stride + _joint] = _t.x; _channels[TY * _stride + _joint] = _t.y; _channels[TZ * _stride + _joint] = _t.z;
+			_channels[QX * _stride + _joint] = _q.x; _channels[QY * _stride + _joint] = _q.y; _channels[QZ * _stride + _joint] = _q.z; _channels[QW * _stride + _joint] = _q.w;
+			_channels[SX * _stride + _joint] = _s.x; _channels[SY * _stride + _joint] = _s.y; _channels[SZ * _stride + _joint] = _s.z;
+		}
+
+		glm::vec3 Interpolate(const glm::vec3& _a, const glm::vec3& _b, float _t) { return glm::mix(_a, _b, _t); }
+		glm::quat Interpolate(const glm::quat& _a, const glm::quat& _b, float _t) { return glm::slerp(_a, _b, _t); }
+
+		template<typename T>
+		T SampleKeyframes(const Keyframes<T>& _keys, float _time)
+		{
+			const size_t count{ std::min(_keys.m_Times.size(), _keys.m_Values.size()) };
+			if (count == 1 || _time <= _keys.m_Times[0]) return _keys.m_Values[0];
+			if (_time >= _keys.m_Times[count - 1]) return _keys.m_Values[count - 1];
+
+			const size_t next{ static_cast<size_t>(std::upper_bound(_keys.m_Times.begin(), _keys.m_Times.begin() + count, _time) - _keys.m_Times.begin()) };
+			const float start{ _keys.m_Times[next - 1] };
+			const float length{ _keys.m_Times[next] - start };
+			return Interpolate(_keys.m_Values[next - 1], _keys.m_Values[next], length > 0.f ? (_time - start) / length : 0.f);
+		}
+
+		template<typename T>
+		bool HasKeyframes(const Keyframes<T>& _keys) { return !_keys.m_Times.empty() && !_keys.m_Values.empty(); }
+
+		// _out = lerp(_a, _b, _weight) for 4 joints at a time. Quaternions take the shortest path and are renormalized (nlerp),
+		// which is indistinguishable from slerp between neighbouring frames or for blending poses of the same skeleton
+		void InterpolateChannels(float* _out, const float* _a, const float* _b, uint32_t _stride, float _weight)
+		{
+			const __m128 weight{ _mm_set1_ps(_weight) };
+			const __m128 signMask{ _mm_set1_ps(-0.f) };
+
+			for (uint32_t j{ 0 }; j < _stride; j += 4)
+			{
+				for (uint32_t channel : { TX, TY, TZ, SX, SY, SZ })
+				{
+					const __m128 a{ _mm_loadu_ps(_a + channel * _stride + j) };
+					const __m128 b{ _mm_loadu_ps(_b + channel * _stride + j) };
+					_mm_storeu_ps(_out + channel * _stride + j, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), weight)));
+				}
+
+				__m128 a[4], b[4];
+				for (uint32_t c{ 0 }; c < 4; ++c)
+				{
+					a[c] = _mm_loadu_ps(_a + (QX + c) * _stride + j);
+					b[c] = _mm_loadu_ps(_b + (QX + c) * _stride + j);
+				}
+
+				// Flip _b where the quaternions lie in opposite hemispheres
+				const __m128 dot{ _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], b[0]), _mm_mul_ps(a[1], b[1])), _mm_add_ps(_mm_mul_ps(a[2], b[2]), _mm_mul_ps(a[3], b[3]))) };
+				const __m128 flip{ _mm_and_ps(dot, signMask) };
+
+				__m128 q[4];
+				for (uint32_t c{ 0 }; c < 4; ++c)
+					q[c] = _mm_add_ps(a[c], _mm_mul_ps(_mm_sub_ps(_mm_xor_ps(b[c], flip), a[c]), weight));
+
+				const __m128 lengthSq{ _mm_add_ps(_mm_add_ps(_mm_mul_ps(q[0], q[0]), _mm_mul_ps(q[1], q[1])), _mm_add_ps(_mm_mul_ps(q[2], q[2]), _mm_mul_ps(q[3], q[3]))) };
+				const __m128 invLength{ _mm_div_ps(_mm_set1_ps(1.f), _mm_sqrt_ps(lengthSq)) };
+				for (uint32_t c{ 0 }; c < 4; ++c)
+					_mm_storeu_ps(_out + (QX + c) * _stride + j, _mm_mul_ps(q[c], invLength));
+			}
+		}
+
+		// Column major _a * _b
+		void MultiplyMatrix(float* _out, const float* _a, const float* _b)
+		{
+			const __m128 a0{ _mm_loadu_ps(_a + 0) };
+			const __m128 a1{ _mm_loadu_ps(_a + 4) };
+			const __m128 a2{ _mm_loadu_ps(_a + 8) };
+			const __m128 a3{ _mm_loadu_ps(_a + 12) };
+
+			__m128 columns[4];
+			for (uint32_t c{ 0 }; c < 4; ++c)
+			{
+				const float* b{ _b + c * 4 };
+				columns[c] = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(a0, _mm_set1_ps(b[0])), _mm_mul_ps(a1, _mm_set1_ps(b[1]))),
+					_mm_add_ps(_mm_mul_ps(a2, _mm_set1_ps(b[2])), _mm_mul_ps(a3, _mm_set1_ps(b[3]))));
+			}
+
+			// Stored last so _out may alias _a or _b
+			for (uint32_t c{ 0 }; c < 4; ++c)
+				_mm_storeu_ps(_out + c * 4, columns[c]);
+		}
+
+		// Local joint matrices from the SoA translation/rotation/scale channels, 4 joints at a time
+		void ComputeLocalMatrices(std::span<glm::mat4> _matrices, const Pose& _pose, uint32_t _jointCount)
+		{
+			const float* channels{ _pose.m_Channels.data() };
+			const uint32_t stride{ _pose.m_Stride };
+			const __m128 one{ _mm_set1_ps(1.f) };
+			const __m128 two{ _mm_set1_ps(2.f) };
+			const __m128 zero{ _mm_setzero_ps() };
+
+			for (uint32_t j{ 0 }; j < _jointCount; j += 4)
+			{
+				auto Load = [&](uint32_t _channel) { return _mm_loadu_ps(channels + _channel * stride + j); };
+
+				const __m128 x{ Load(QX) }, y{ Load(QY) }, z{ Load(QZ) }, w{ Load(QW) };
+				const __m128 sx{ Load(SX) }, sy{ Load(SY) }, sz{ Load(SZ) };
+
+				const __m128 xx{ _mm_mul_ps(x, x) }, yy{ _mm_mul_ps(y, y) }, zz{ _mm_mul_ps(z, z) };
+				const __m128 xy{ _mm_mul_ps(x, y) }, xz{ _mm_mul_ps(x, z) }, yz{ _mm_mul_ps(y, z) };
+				const __m128 wx{ _mm_mul_ps(w, x) }, wy{ _mm_mul_ps(w, y) }, wz{ _mm_mul_ps(w, z) };
+
+				// Rows are matrix columns, lanes are joints
+				__m128 columns[4][4]{
+					{
+						_mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx),
+						_mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), sx),
+						_mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), sx),
+						zero
+					},
+					{
+						_mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), sy),
+						_mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy),
+						_mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), sy),
+						zero
+					},
+					{
+						_mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), sz),
+						_mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), sz),
+						_mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz),
+						zero
+					},
+					{ Load(TX), Load(TY), Load(TZ), one }
+				};
+
+				// Transpose so each register holds one column of one joint
+				for (auto& column : columns)
+					_MM_TRANSPOSE4_PS(column[0], column[1], column[2], column[3]);
+
+				const uint32_t count{ std::min(4u, _jointCount - j) };
+				for (uint32_t lane{ 0 }; lane < count; ++lane)
+				{
+					float* matrix{ &_matrices[j + lane][0][0] };
+					for (uint32_t c{ 0 }; c < 4; ++c)
+						_mm_storeu_ps(matrix + c * 4, columns[c][lane]);
+				}
+			}
+		}
+	}
+
+	void ResizePose(Pose& _pose, uint32_t _jointCount)
+	{
+		if (_pose.m_JointCount == _jointCount && !_pose.m_Channels.empty()) return;
+
+		_pose.m_JointCount = _jointCount;
+		_pose.m_Stride = (_jointCount + 3) & ~3u;
+		_pose.m_Channels.resize(Pose::CHANNEL_COUNT * _pose.m_Stride);
+		ResetChannels(_pose.m_Channels.data(), _pose.m_Stride);
+	}
+
+	void BuildClip(Clip& _clip, const Skeleton& _skeleton, std::span<const JointTrack> _tracks, float _duration, float _sampleRate)
+	{
+		const uint32_t jointCount{ static_cast<uint32_t>(_skeleton.m_Parents.size()) };
+
+		_clip.m_Duration = std::max(0.f, _duration);
+		_clip.m_SampleRate = std::max(1.f, _sampleRate);
+		_clip.m_FrameCount = static_cast<uint32_t>(std::ceil(_clip.m_Duration * _clip.m_SampleRate)) + 1;
+		_clip.m_JointCount = jointCount;
+		_clip.m_Stride = (jointCount + 3) & ~3u;
+
+		const size_t frameSize{ Pose::CHANNEL_COUNT * _clip.m_Stride };
+		_clip.m_Frames.resize(frameSize * _clip.m_FrameCount);
+
+		for (uint32_t f{ 0 }; f < _clip.m_FrameCount; ++f)
+		{
+			const float time{ std::min(_clip.m_Duration, static_cast<float>(f) / _clip.m_SampleRate) };
+			float* frame{ _clip.m_Frames.data() + f * frameSize };
+			ResetChannels(frame, _clip.m_Stride);
+
+			for (uint32_t j{ 0 }; j < jointCount; ++j)
+			{
+				glm::vec3 translation{ j < _skeleton.m_BindTranslations.size() ? _skeleton.m_BindTranslations[j] : glm::vec3{ 0.f } };
+				glm::quat rotation{ j < _skeleton.m_BindRotations.size() ? _skeleton.m_BindRotations[j] : glm::quat{ 1.f, 0.f, 0.f, 0.f } };
+				glm::vec3 scale{ j < _skeleton.m_BindScales.size() ? _skeleton.m_BindScales[j] : glm::vec3{ 1.f } };
+
+				if (j < _tracks.size())
+				{
+					const JointTrack& track{ _tracks[j] };
+					if (HasKeyframes(track.m_Translation)) translation = SampleKeyframes(track.m_Translation, time);
+					if (HasKeyframes(track.m_Rotation)) rotation = glm::normalize(SampleKeyframes(track.m_Rotation, time));
+					if (HasKeyframes(track.m_Scale)) scale = SampleKeyframes(track.m_Scale, time);
+				}
+
+				WriteJoint(frame, _clip.m_Stride, j, translation, rotation, scale);
+			}
+		}
+	}
+
+	void SamplePose(Pose& _pose, const Clip& _clip, float _time, bool _loop)
+	{
+		ResizePose(_pose, _clip.m_JointCount);
+		if (_clip.m_FrameCount == 0) return;
+
+		float time{ _time };
+		if (_loop && _clip.m_Duration > 0.f)
+		{
+			time = std::fmod(time, _clip.m_Duration);
+			if (time < 0.f) time += _clip.m_Duration;
+		}
+		else
+		{
+			time = std::clamp(time, 0.f, _clip.m_Duration);
+		}
+
+		const float frame{ time * _clip.m_SampleRate };
+		const uint32_t frame0{ std::min(static_cast<uint32_t>(frame), _clip.m_FrameCount - 1) };
+		const uint32_t frame1{ std::min(frame0 + 1, _clip.m_FrameCount - 1) };
+		const float weight{ std::clamp(frame - static_cast<float>(frame0), 0.f, 1.f) };
+
+		const size_t frameSize{ Pose::CHANNEL_COUNT * _clip.m_Stride };
+		InterpolateChannels(_pose.m_Channels.data(), _clip.m_Frames.data() + frame0 * frameSize, _clip.m_Frames.data() + frame1 * frameSize, _clip.m_Stride, weight);
+	}
+
+	void BlendPoses(Pose& _pose, const Pose& _a, const Pose& _b, float _weight)
+	{
+		// _pose may be _a or _b, the kernel is element wise
+		const uint32_t jointCount{ std::min(_a.m_JointCount, _b.m_JointCount) };
+		if (&_pose != &_a && &_pose != &_b) ResizePose(_pose, jointCount);
+		if (_pose.m_Stride != _a.m_Stride || _pose.m_Stride != _b.m_Stride) return;
+
+		InterpolateChannels(_pose.m_Channels.data(), _a.m_Channels.data(), _b.m_Channels.data(), _pose.m_Stride, std::clamp(_weight, 0.f, 1.f));
+	}
+
+	void ComputePalette(std::span<glm::mat4> _palette, const Skeleton& _skeleton, const Pose& _pose, const glm::mat4& _model)
+	{
+		const uint32_t jointCount{ std::min({ _pose.m_JointCount, static_cast<uint32_t>(_skeleton.m_Parents.size()), static_cast<uint32_t>(_palette.size()) }) };
+		if (jointCount == 0) return;
+
+		// The palette holds local, then model, then skinning matrices, so no scratch memory is needed
+		ComputeLocalMatrices(_palette, _pose, jointCount);
+
+		// Parents come before their children, so their model matrix is already final
+		for (uint32_t j{ 0 }; j < jointCount; ++j)
+		{
+			const int32_t parent{ _skeleton.m_Parents[j] };
+			const float* parentMatrix{ parent >= 0 && static_cast<uint32_t>(parent) < j ? &_palette[parent][0][0] : &_model[0][0] };
+			MultiplyMatrix(&_palette[j][0][0], parentMatrix, &_palette[j][0][0]);
+		}
+
+		const uint32_t bindCount{ std::min(jointCount, static_cast<uint32_t>(_skeleton.m_InverseBindMatrices.size())) };
+		for (uint32_t j{ 0 }; j < bindCount; ++j)
+			MultiplyMatrix(&_palette[j][0][0], &_palette[j][0][0], &_skeleton.m_InverseBindMatrices[j][0][0]);
+	}
+
+	void EvaluatePalettes(std::span<const Character> _characters, std::span<glm::mat4> _palettes)
+	{
+		Parallel::ForRange(_characters.size(), CHARACTER_BATCH_SIZE, [&](size_t _begin, size_t _end, size_t)
+		{
+			// Scratch poses reused by every character of the range
+			Pose pose, blendPose;
+
+			for (size_t i{ _begin }; i < _end; ++i)
+			{
+				const Character& character{ _characters[i] };
+				if (!character.m_Skeleton || !character.m_Clip) continue;
+
+				const size_t jointCount{ character.m_Skeleton->m_Parents.size() };
+				if (character.m_PaletteOffset + jointCount > _palettes.size()) continue;
+
+				SamplePose(pose, *character.m_Clip, character.m_Time, character.m_Loop);
+				if (character.m_BlendClip && character.m_BlendWeight > 0.f)
+				{
+					SamplePose(blendPose, *character.m_BlendClip, character.m_BlendTime, character.m_Loop);
+					BlendPoses(pose, pose, blendPose, character.m_BlendWeight);
+				}
+
+				ComputePalette(_palettes.subspan(character.m_PaletteOffset, jointCount), *character.m_Skeleton, pose, character.m_Model);
+			}
+		});
+	}
+}
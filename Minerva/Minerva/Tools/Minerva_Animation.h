@@ -0,0 +1,98 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Minerva::Tools::Animation
+{
+	// Vertex layout for skinned meshes. Joint indices are read as UINT8_4D, weights as UINT8_4D_NORMALIZED
+	struct SkinnedVertex
+	{
+		glm::vec3 m_Position;
+		glm::vec3 m_Normal;
+		glm::vec2 m_TexCoord;
+		std::array<uint8_t, 4> m_Joints;
+		std::array<uint8_t, 4> m_Weights; // Sum to 255
+	};
+
+	// Joints are ordered so that every parent comes before its children
+	struct Skeleton
+	{
+		std::vector<int32_t> m_Parents; // -1 for roots
+		std::vector<glm::mat4> m_InverseBindMatrices;
+		std::vector<glm::vec3> m_BindTranslations; // Local bind pose, used by joints without animation
+		std::vector<glm::quat> m_BindRotations;
+		std::vector<glm::vec3> m_BindScales;
+	};
+
+	// Local joint transforms in structure of arrays layout: one channel per component (tx, ty, tz, qx, qy, qz, qw, sx, sy, sz),
+	// each padded to a multiple of 4 joints so they can be processed 4 joints at a time
+	struct Pose
+	{
+		static constexpr uint32_t CHANNEL_COUNT{ 10 };
+
+		uint32_t m_JointCount{ 0 };
+		uint32_t m_Stride{ 0 }; // Floats per channel
+		std::vector<float> m_Channels;
+	};
+
+	template<typename T>
+	struct Keyframes
+	{
+		std::vector<float> m_Times; // Seconds, ascending
+		std::vector<T> m_Values;
+	};
+
+	// Animation of one joint. Empty channels keep the bind pose
+	struct JointTrack
+	{
+		Keyframes<glm::vec3> m_Translation;
+		Keyframes<glm::quat> m_Rotation;
+		Keyframes<glm::vec3> m_Scale;
+	};
+
+	// Clip resampled at a fixed rate, so sampling never searches for keyframes
+	struct Clip
+	{
+		float m_Duration{ 0.f };
+		float m_SampleRate{ 30.f };
+		uint32_t m_FrameCount{ 0 };
+		uint32_t m_JointCount{ 0 };
+		uint32_t m_Stride{ 0 };
+		std::vector<float> m_Frames; // m_FrameCount poses back to back
+	};
+
+	// One animated instance. Its palette is written to _palettes[m_PaletteOffset, m_PaletteOffset + joint count)
+	struct Character
+	{
+		const Skeleton* m_Skeleton;
+		const Clip* m_Clip;
+		float m_Time;
+		const Clip* m_BlendClip{ nullptr }; // Optional second clip, mixed in by m_BlendWeight
+		float m_BlendTime{ 0.f };
+		float m_BlendWeight{ 0.f };
+		bool m_Loop{ true };
+		glm::mat4 m_Model{ 1.f };           // Baked into the palette, so the palette is in world space
+		uint32_t m_PaletteOffset{ 0 };
+	};
+
+	void ResizePose(Pose& _pose, uint32_t _jointCount);
+
+	// Resamples _tracks (one per joint) at _sampleRate frames per second
+	void BuildClip(Clip& _clip, const Skeleton& _skeleton, std::span<const JointTrack> _tracks, float _duration, float _sampleRate = 30.f);
+
+	// Interpolates the two frames around _time
+	void SamplePose(Pose& _pose, const Clip& _clip, float _time, bool _loop);
+
+	// _pose = lerp(_a, _b, _weight), rotations normalized along the shortest path
+	void BlendPoses(Pose& _pose, const Pose& _a, const Pose& _b, float _weight);
+
+	// Walks the hierarchy and writes _model * jointModel * inverseBind for every joint
+	void ComputePalette(std::span<glm::mat4> _palette, const Skeleton& _skeleton, const Pose& _pose, const glm::mat4& _model);
+
+	// Samples, blends and builds the palettes of all characters on worker threads
+	void EvaluatePalettes(std::span<const Character> _characters, std::span<glm::mat4> _palettes);
+}
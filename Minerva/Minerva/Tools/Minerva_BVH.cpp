@@ -0,0 +1,286 @@
+#include "Minerva_BVH.h"
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <xmmintrin.h>
+
+namespace Minerva::Tools::BVH
+{
+	namespace
+	{
+		constexpr uint32_t CHILD_COUNT{ 4 };
+
+		struct TraversalEntry
+		{
+			uint32_t m_Node;
+			uint32_t m_TestViews;   // Views the node intersects
+			uint32_t m_InsideViews; // Views containing the node
+		};
+
+		AABB Merge(const AABB& _a, const AABB& _b)
+		{
+			return AABB{ glm::min(_a.m_Min, _b.m_Min), glm::max(_a.m_Max, _b.m_Max) };
+		}
+
+		AABB GetChildBounds(const Node& _node, uint32_t _child)
+		{
+			return AABB{
+				glm::vec3{ _node.m_MinX[_child], _node.m_MinY[_child], _node.m_MinZ[_child] },
+				glm::vec3{ _node.m_MaxX[_child], _node.m_MaxY[_child], _node.m_MaxZ[_child] } };
+		}
+
+		void SetChildBounds(Node& _node, uint32_t _child, const AABB& _bounds)
+		{
+			_node.m_MinX[_child] = _bounds.m_Min.x; _node.m_MinY[_child] = _bounds.m_Min.y; _node.m_MinZ[_child] = _bounds.m_Min.z;
+			_node.m_MaxX[_child] = _bounds.m_Max.x; _node.m_MaxY[_child] = _bounds.m_Max.y; _node.m_MaxZ[_child] = _bounds.m_Max.z;
+		}
+
+		AABB GetNodeBounds(const Node& _node)
+		{
+			AABB bounds{ GetChildBounds(_node, 0) };
+			for (uint32_t child{ 1 }; child < _node.m_ChildCount; ++child)
+				bounds = Merge(bounds, GetChildBounds(_node, child));
+			return bounds;
+		}
+
+		// Splits _objects in two halves around the median centroid of the longest axis
+		void SplitMedian(std::span<uint32_t> _objects, const std::vector<AABB>& _bounds)
+		{
+			glm::vec3 minimum{ std::numeric_limits<float>::max() }, maximum{ std::numeric_limits<float>::lowest() };
+			for (uint32_t object : _objects)
+			{
+				const glm::vec3 center{ _bounds[object].m_Min + _bounds[object].m_Max };
+				minimum = glm::min(minimum, center);
+				maximum = glm::max(maximum, center);
+			}
+
+			const glm::vec3 extent{ maximum - minimum };
+			const int axis{ extent.x > extent.y && extent.x > extent.z ? 0 : (extent.y > extent.z ? 1 : 2) };
+
+			std::nth_element(_objects.begin(), _objects.begin() + _objects.size() / 2, _objects.end(), [&](uint32_t _a, uint32_t _b)
+			{
+				return _bounds[_a].m_Min[axis] + _bounds[_a].m_Max[axis] < _bounds[_b].m_Min[axis] + _bounds[_b].m_Max[axis];
+			});
+		}
+
+		uint32_t BuildNode(Hierarchy& _hierarchy, std::span<uint32_t> _objects, int32_t _parent)
+		{
+			const uint32_t nodeIndex{ static_cast<uint32_t>(_hierarchy.m_Nodes.size()) };
+			_hierarchy.m_Nodes.push_back(Node{});
+			_hierarchy.m_Nodes[nodeIndex].m_Parent = _parent;
+
+			// Up to four groups: the objects themselves, or the quarters of two median splits
+			std::array<std::span<uint32_t>, CHILD_COUNT> groups;
+			uint32_t groupCount{ 0 };
+			if (_objects.size() <= CHILD_COUNT)
+			{
+				for (size_t i{ 0 }; i < _objects.size(); ++i)
+					groups[groupCount++] = _objects.subspan(i, 1);
+			}
+			else
+			{
+				SplitMedian(_objects, _hierarchy.m_Bounds);
+				const size_t half{ _objects.size() / 2 };
+				for (std::span<uint32_t> side : { _objects.first(half), _objects.subspan(half) })
+				{
+					SplitMedian(side, _hierarchy.m_Bounds);
+					groups[groupCount++] = side.first(side.size() / 2);
+					groups[groupCount++] = side.subspan(side.size() / 2);
+				}
+			}
+
+			uint32_t childCount{ 0 };
+			for (uint32_t group{ 0 }; group < groupCount; ++group)
+			{
+				if (groups[group].empty()) continue;
+
+				if (groups[group].size() == 1)
+				{
+					const uint32_t object{ groups[group][0] };
+					_hierarchy.m_Nodes[nodeIndex].m_Children[childCount] = ~static_cast<int32_t>(object);
+					SetChildBounds(_hierarchy.m_Nodes[nodeIndex], childCount, _hierarchy.m_Bounds[object]);
+					_hierarchy.m_ObjectNodes[object] = nodeIndex;
+				}
+				else
+				{
+					// The vector may grow, so the node is indexed again afterwards
+					const uint32_t child{ BuildNode(_hierarchy, groups[group], static_cast<int32_t>(nodeIndex)) };
+					_hierarchy.m_Nodes[nodeIndex].m_Children[childCount] = static_cast<int32_t>(child);
+					SetChildBounds(_hierarchy.m_Nodes[nodeIndex], childCount, GetNodeBounds(_hierarchy.m_Nodes[child]));
+				}
+				++childCount;
+			}
+
+			_hierarchy.m_Nodes[nodeIndex].m_ChildCount = childCount;
+			return nodeIndex;
+		}
+	}
+
+	Frustum ExtractFrustum(const glm::mat4& _viewProjection)
+	{
+		auto Row = [&](int _row) { return glm::vec4{ _viewProjection[0][_row], _viewProjection[1][_row], _viewProjection[2][_row], _viewProjection[3][_row] }; };
+
+		Frustum frustum{ {
+			Row(3) + Row(0), // Left
+			Row(3) - Row(0), // Right
+			Row(3) + Row(1), // Bottom
+			Row(3) - Row(1), // Top
+			Row(2),          // Near
+			Row(3) - Row(2)  // Far
+		} };
+
+		for (glm::vec4& plane : frustum.m_Planes)
+			plane /= glm::length(glm::vec3{ plane });
+		return frustum;
+	}
+
+	void Build(Hierarchy& _hierarchy, std::span<const AABB> _bounds)
+	{
+		_hierarchy.m_Nodes.clear();
+		_hierarchy.m_Bounds.assign(_bounds.begin(), _bounds.end());
+		_hierarchy.m_ObjectNodes.assign(_bounds.size(), 0);
+		_hierarchy.m_Dirty = false;
+
+		if (_bounds.empty())
+		{
+			_hierarchy.m_DirtyNodes.clear();
+			return;
+		}
+
+		std::vector<uint32_t> objects(_bounds.size());
+		for (uint32_t i{ 0 }; i < objects.size(); ++i)
+			objects[i] = i;
+
+		// Every node has at least two children, so there are fewer nodes than objects
+		_hierarchy.m_Nodes.reserve(objects.size());
+		BuildNode(_hierarchy, objects, -1);
+		_hierarchy.m_DirtyNodes.assign(_hierarchy.m_Nodes.size(), 0);
+	}
+
+	void UpdateObject(Hierarchy& _hierarchy, uint32_t _object, const AABB& _bounds)
+	{
+		if (_object >= _hierarchy.m_Bounds.size()) return;
+
+		_hierarchy.m_Bounds[_object] = _bounds;
+		_hierarchy.m_DirtyNodes[_hierarchy.m_ObjectNodes[_object]] = 1;
+		_hierarchy.m_Dirty = true;
+	}
+
+	void Refit(Hierarchy& _hierarchy)
+	{
+		if (!_hierarchy.m_Dirty) return;
+
+		// Children come after their parents, so walking backwards refits every child before its parent
+		for (size_t i{ _hierarchy.m_Nodes.size() }; i-- > 0;)
+		{
+			if (!_hierarchy.m_DirtyNodes[i]) continue;
+			_hierarchy.m_DirtyNodes[i] = 0;
+
+			Node& node{ _hierarchy.m_Nodes[i] };
+			for (uint32_t child{ 0 }; child < node.m_ChildCount; ++child)
+			{
+				const int32_t index{ node.m_Children[child] };
+				SetChildBounds(node, child, index < 0 ? _hierarchy.m_Bounds[~index] : GetNodeBounds(_hierarchy.m_Nodes[index]));
+			}
+
+			if (node.m_Parent >= 0)
+				_hierarchy.m_DirtyNodes[node.m_Parent] = 1;
+		}
+
+		_hierarchy.m_Dirty = false;
+	}
+
+	void Cull(const Hierarchy& _hierarchy, std::span<const Frustum> _frustums, std::span<std::vector<uint32_t>> _visible)
+	{
+		const uint32_t viewCount{ static_cast<uint32_t>(std::min<size_t>({ _frustums.size(), _visible.size(), MAX_VIEW_COUNT })) };
+		if (_hierarchy.m_Nodes.empty() || viewCount == 0) return;
+
+		const uint32_t allViews{ viewCount == 32 ? ~0u : (1u << viewCount) - 1 };
+
+		// Appends every object below _node to the views in _views
+		auto AppendSubtree = [&](uint32_t _node, uint32_t _views, auto& _self) -> void
+		{
+			const Node& node{ _hierarchy.m_Nodes[_node] };
+			for (uint32_t child{ 0 }; child < node.m_ChildCount; ++child)
+			{
+				const int32_t index{ node.m_Children[child] };
+				if (index >= 0)
+				{
+					_self(static_cast<uint32_t>(index), _views, _self);
+					continue;
+				}
+
+				for (uint32_t views{ _views }; views; views &= views - 1)
+					_visible[std::countr_zero(views)].push_back(static_cast<uint32_t>(~index));
+			}
+		};
+
+		std::vector<TraversalEntry> stack;
+		stack.reserve(64);
+		stack.push_back(TraversalEntry{ 0, allViews, 0 });
+
+		while (!stack.empty())
+		{
+			const TraversalEntry entry{ stack.back() };
+			stack.pop_back();
+
+			const Node& node{ _hierarchy.m_Nodes[entry.m_Node] };
+			const __m128 minX{ _mm_load_ps(node.m_MinX) }, minY{ _mm_load_ps(node.m_MinY) }, minZ{ _mm_load_ps(node.m_MinZ) };
+			const __m128 maxX{ _mm_load_ps(node.m_MaxX) }, maxY{ _mm_load_ps(node.m_MaxY) }, maxZ{ _mm_load_ps(node.m_MaxZ) };
+			const int childMask{ (1 << node.m_ChildCount) - 1 };
+
+			// Per child, the views it intersects and the views containing it
+			std::array<uint32_t, CHILD_COUNT> testViews{}, insideViews{};
+			for (uint32_t views{ entry.m_TestViews }; views; views &= views - 1)
+			{
+				const uint32_t view{ static_cast<uint32_t>(std::countr_zero(views)) };
+				__m128 outside{ _mm_setzero_ps() };
+				__m128 crossing{ _mm_setzero_ps() };
+
+				// The corner farthest along the plane normal decides if a box is outside, the nearest one if it is inside
+				for (const glm::vec4& plane : _frustums[view].m_Planes)
+				{
+					const __m128 nx{ _mm_set1_ps(plane.x) }, ny{ _mm_set1_ps(plane.y) }, nz{ _mm_set1_ps(plane.z) }, d{ _mm_set1_ps(plane.w) };
+					const __m128 farDistance{ _mm_add_ps(
+						_mm_add_ps(_mm_mul_ps(nx, plane.x > 0.f ? maxX : minX), _mm_mul_ps(ny, plane.y > 0.f ? maxY : minY)),
+						_mm_add_ps(_mm_mul_ps(nz, plane.z > 0.f ? maxZ : minZ), d)) };
+					const __m128 nearDistance{ _mm_add_ps(
+						_mm_add_ps(_mm_mul_ps(nx, plane.x > 0.f ? minX : maxX), _mm_mul_ps(ny, plane.y > 0.f ? minY : maxY)),
+						_mm_add_ps(_mm_mul_ps(nz, plane.z > 0.f ? minZ : maxZ), d)) };
+
+					outside = _mm_or_ps(outside, _mm_cmplt_ps(farDistance, _mm_setzero_ps()));
+					crossing = _mm_or_ps(crossing, _mm_cmplt_ps(nearDistance, _mm_setzero_ps()));
+				}
+
+				const int visibleMask{ ~_mm_movemask_ps(outside) & childMask };
+				const int insideMask{ visibleMask & ~_mm_movemask_ps(crossing) };
+				for (uint32_t child{ 0 }; child < node.m_ChildCount; ++child)
+				{
+					if (insideMask & (1 << child))
+						insideViews[child] |= 1u << view;
+					else if (visibleMask & (1 << child))
+						testViews[child] |= 1u << view;
+				}
+			}
+
+			for (uint32_t child{ 0 }; child < node.m_ChildCount; ++child)
+			{
+				const uint32_t inside{ insideViews[child] | entry.m_InsideViews };
+				const uint32_t test{ testViews[child] & ~inside };
+				if (!inside && !test) continue;
+
+				const int32_t index{ node.m_Children[child] };
+				if (index < 0)
+				{
+					// Objects are children themselves, so a visible child is a visible object
+					for (uint32_t views{ inside | test }; views; views &= views - 1)
+						_visible[std::countr_zero(views)].push_back(static_cast<uint32_t>(~index));
+				}
+				else if (!test)
+					AppendSubtree(static_cast<uint32_t>(index), inside, AppendSubtree);
+				else
+					stack.push_back(TraversalEntry{ static_cast<uint32_t>(index), test, inside });
+			}
+		}
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Minerva::Tools::BVH
+{
+	// Views culled in one traversal, e.g. the main camera and its shadow cascades
+	constexpr uint32_t MAX_VIEW_COUNT{ 32 };
+
+	struct AABB
+	{
+		glm::vec3 m_Min;
+		glm::vec3 m_Max;
+	};
+
+	// Clip space planes, xyz normal pointing inside, w distance
+	struct Frustum
+	{
+		std::array<glm::vec4, 6> m_Planes;
+	};
+
+	// Four children per node, their bounds stored as structure of arrays so a node is tested in one SIMD pass.
+	// A child is another node (>= 0) or a single object (~objectIndex)
+	struct alignas(16) Node
+	{
+		float m_MinX[4], m_MinY[4], m_MinZ[4];
+		float m_MaxX[4], m_MaxY[4], m_MaxZ[4];
+		int32_t m_Children[4];
+		uint32_t m_ChildCount;
+		int32_t m_Parent;  // -1 for the root
+	};
+
+	// Nodes are stored parents first, so refitting walks them backwards
+	struct Hierarchy
+	{
+		std::vector<Node> m_Nodes;
+		std::vector<AABB> m_Bounds;       // Per object
+		std::vector<uint32_t> m_ObjectNodes; // Node holding each object
+		std::vector<uint8_t> m_DirtyNodes;
+		bool m_Dirty{ false };
+	};
+
+	// Frustum of a view projection, depth is [0, 1]. Planes are normalized, so w is a distance in world units.
+	// Shared by the GPU cullers, which test bounding spheres against the planes
+	Frustum ExtractFrustum(const glm::mat4& _viewProjection);
+
+	// Top down median split on the longest centroid axis, two levels per node
+	void Build(Hierarchy& _hierarchy, std::span<const AABB> _bounds);
+
+	// Moves an object. The node bounds stay stale until Refit
+	void UpdateObject(Hierarchy& _hierarchy, uint32_t _object, const AABB& _bounds);
+
+	// Recomputes the bounds of the nodes above moved objects. The tree shape is kept, so rebuild when objects moved far
+	void Refit(Hierarchy& _hierarchy);
+
+	// Appends the objects intersecting _frustums[i] to _visible[i]. Subtrees fully inside a view are appended without further tests
+	void Cull(const Hierarchy& _hierarchy, std::span<const Frustum> _frustums, std::span<std::vector<uint32_t>> _visible);
+}
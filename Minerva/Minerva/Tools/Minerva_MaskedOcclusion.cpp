@@ -0,0 +1,464 @@
+#include "Minerva_MaskedOcclusion.h"
+#include "Minerva_Parallel.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// AVX2 functions are compiled next to the SSE2 ones and picked at runtime, so the project does not need /arch:AVX2
+#if defined(_MSC_VER)
+#define MINERVA_TARGET_AVX2
+#else
+#define MINERVA_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace Minerva::Tools::MaskedOcclusion
+{
+	namespace
+	{
+		// Occluder triangles per worker batch during setup
+		constexpr size_t TRIANGLE_BATCH_SIZE{ 256 };
+
+		// Boxes per worker batch, a test touches a handful of tiles
+		constexpr size_t AABB_BATCH_SIZE{ 64 };
+
+		constexpr int32_t LEFT_EDGE{ 0 }, RIGHT_EDGE{ 1 }, HORIZONTAL_EDGE{ 2 };
+
+		// Pixel space vertex, z is depth
+		void SetupTriangle(std::vector<ScreenTriangle>& _triangles, glm::vec3 _v0, glm::vec3 _v1, glm::vec3 _v2, const DepthBuffer& _buffer)
+		{
+			float area{ (_v1.x - _v0.x) * (_v2.y - _v0.y) - (_v1.y - _v0.y) * (_v2.x - _v0.x) };
+			if (std::abs(area) < 1e-6f) return;
+
+			// Both windings are rasterized, flip to positive area so the inside is always on the same side of every edge
+			if (area < 0.f)
+			{
+				std::swap(_v1, _v2);
+				area = -area;
+			}
+
+			const glm::vec3 minimum{ glm::min(_v0, glm::min(_v1, _v2)) };
+			const glm::vec3 maximum{ glm::max(_v0, glm::max(_v1, _v2)) };
+
+			const glm::ivec4 bounds{
+				static_cast<int32_t>(std::clamp(std::floor(minimum.x), 0.f, static_cast<float>(_buffer.m_Width))),
+				static_cast<int32_t>(std::clamp(std::ceil(maximum.x), 0.f, static_cast<float>(_buffer.m_Width))),
+				static_cast<int32_t>(std::clamp(std::floor(minimum.y), 0.f, static_cast<float>(_buffer.m_Height))),
+				static_cast<int32_t>(std::clamp(std::ceil(maximum.y), 0.f, static_cast<float>(_buffer.m_Height)))
+			};
+			if (bounds.x >= bounds.y || bounds.z >= bounds.w) return;
+
+			ScreenTriangle triangle{};
+			triangle.m_Bounds = bounds;
+			triangle.m_MinDepth = minimum.z;
+			triangle.m_MaxDepth = maximum.z;
+
+			// Inside of edge (a, b) is where (b - a) x (p - a) >= 0. Solved for x per row, the edge bounds the span on the left or the right
+			const std::array<glm::vec3, 3> vertices{ _v0, _v1, _v2 };
+			for (int edge{ 0 }; edge < 3; ++edge)
+			{
+				const glm::vec3& a{ vertices[edge] };
+				const glm::vec3& b{ vertices[(edge + 1) % 3] };
+				const float dx{ b.x - a.x };
+				const float dy{ b.y - a.y };
+
+				if (dy == 0.f)
+				{
+					// Inside when dx * (y - a.y) >= 0
+					triangle.m_EdgeTypes[edge] = HORIZONTAL_EDGE;
+					triangle.m_EdgeSlopes[edge] = dx;
+					triangle.m_EdgeOffsets[edge] = a.y;
+				}
+				else
+				{
+					triangle.m_EdgeTypes[edge] = dy < 0.f ? LEFT_EDGE : RIGHT_EDGE;
+					triangle.m_EdgeSlopes[edge] = dx / dy;
+					triangle.m_EdgeOffsets[edge] = a.x - (dx / dy) * a.y;
+				}
+			}
+
+			// Depth plane through the three vertices
+			const float dz1{ _v1.z - _v0.z }, dz2{ _v2.z - _v0.z };
+			triangle.m_DepthPlane.x = (dz1 * (_v2.y - _v0.y) - dz2 * (_v1.y - _v0.y)) / area;
+			triangle.m_DepthPlane.y = (dz2 * (_v1.x - _v0.x) - dz1 * (_v2.x - _v0.x)) / area;
+			triangle.m_DepthPlane.z = _v0.z - triangle.m_DepthPlane.x * _v0.x - triangle.m_DepthPlane.y * _v0.y;
+
+			_triangles.push_back(triangle);
+		}
+
+		// Clips against the near plane (z >= 0 in clip space) and appends the resulting triangles
+		void AddTriangle(std::vector<ScreenTriangle>& _triangles, const std::array<glm::vec4, 3>& _clip, const DepthBuffer& _buffer)
+		{
+			if (_clip[0].z < 0.f && _clip[1].z < 0.f && _clip[2].z < 0.f) return;
+
+			std::array<glm::vec4, 4> polygon;
+			uint32_t vertexCount{ 0 };
+			for (uint32_t i{ 0 }; i < 3; ++i)
+			{
+				const glm::vec4& a{ _clip[i] };
+				const glm::vec4& b{ _clip[(i + 1) % 3] };
+				if (a.z >= 0.f)
+					polygon[vertexCount++] = a;
+				if ((a.z >= 0.f) != (b.z >= 0.f))
+					polygon[vertexCount++] = glm::mix(a, b, a.z / (a.z - b.z));
+			}
+
+			std::array<glm::vec3, 4> screen;
+			for (uint32_t i{ 0 }; i < vertexCount; ++i)
+			{
+				const glm::vec3 ndc{ glm::vec3{ polygon[i] } / polygon[i].w };
+				screen[i] = glm::vec3{
+					(ndc.x * 0.5f + 0.5f) * static_cast<float>(_buffer.m_Width),
+					(ndc.y * 0.5f + 0.5f) * static_cast<float>(_buffer.m_Height),
+					std::clamp(ndc.z, 0.f, 1.f) };
+			}
+
+			SetupTriangle(_triangles, screen[0], screen[1], screen[2], _buffer);
+			if (vertexCount == 4)
+				SetupTriangle(_triangles, screen[0], screen[2], screen[3], _buffer);
+		}
+
+		// Farthest depth of the triangle plane inside the tile
+		float TileDepth(const ScreenTriangle& _triangle, uint32_t _tileX, uint32_t _tileY)
+		{
+			const float x0{ static_cast<float>(_tileX * TILE_WIDTH) }, x1{ x0 + TILE_WIDTH };
+			const float y0{ static_cast<float>(_tileY * TILE_HEIGHT) }, y1{ y0 + TILE_HEIGHT };
+			const float depth{ _triangle.m_DepthPlane.z
+				+ std::max(_triangle.m_DepthPlane.x * x0, _triangle.m_DepthPlane.x * x1)
+				+ std::max(_triangle.m_DepthPlane.y * y0, _triangle.m_DepthPlane.y * y1) };
+			return std::clamp(depth, _triangle.m_MinDepth, _triangle.m_MaxDepth);
+		}
+
+		// Merges the coverage of a triangle no farther than _depth into the working layer
+		void UpdateTile(Tile& _tile, const uint32_t* _masks, float _depth)
+		{
+			bool full{ true };
+			for (uint32_t row{ 0 }; row < TILE_HEIGHT; ++row)
+			{
+				_tile.m_Masks[row] |= _masks[row];
+				full = full && _tile.m_Masks[row] == ~0u;
+			}
+			_tile.m_WorkingDepth = std::max(_tile.m_WorkingDepth, _depth);
+
+			// The working layer covers the whole tile and is nearer than the reference layer, which it replaces
+			if (full)
+			{
+				_tile.m_ReferenceDepth = _tile.m_WorkingDepth;
+				_tile.m_WorkingDepth = 0.f;
+				std::fill(std::begin(_tile.m_Masks), std::end(_tile.m_Masks), 0u);
+			}
+		}
+
+		// Rasterizes one triangle into one row of tiles, 4 pixel rows at a time
+		void RasterizeTileRowSSE(DepthBuffer& _buffer, const ScreenTriangle& _triangle, uint32_t _tileY)
+		{
+			const __m128 minX{ _mm_set1_ps(static_cast<float>(_triangle.m_Bounds.x)) };
+			const __m128 maxX{ _mm_set1_ps(static_cast<float>(_triangle.m_Bounds.y)) };
+			const __m128 half{ _mm_set1_ps(0.5f) };
+
+			alignas(16) int32_t spanStarts[TILE_HEIGHT];
+			alignas(16) int32_t spanEnds[TILE_HEIGHT];
+
+			for (uint32_t rows{ 0 }; rows < TILE_HEIGHT; rows += 4)
+			{
+				// Pixel centers
+				const __m128 y{ _mm_add_ps(_mm_set1_ps(static_cast<float>(_tileY * TILE_HEIGHT + rows) + 0.5f), _mm_setr_ps(0.f, 1.f, 2.f, 3.f)) };
+				__m128 start{ minX };
+				__m128 end{ maxX };
+
+				for (int edge{ 0 }; edge < 3; ++edge)
+				{
+					const __m128 slope{ _mm_set1_ps(_triangle.m_EdgeSlopes[edge]) };
+					const __m128 offset{ _mm_set1_ps(_triangle.m_EdgeOffsets[edge]) };
+					if (_triangle.m_EdgeTypes[edge] == HORIZONTAL_EDGE)
+					{
+						const __m128 inside{ _mm_cmpge_ps(_mm_mul_ps(slope, _mm_sub_ps(y, offset)), _mm_setzero_ps()) };
+						end = _mm_or_ps(_mm_and_ps(inside, end), _mm_andnot_ps(inside, minX));
+						continue;
+					}
+
+					const __m128 bound{ _mm_add_ps(_mm_mul_ps(slope, y), offset) };
+					if (_triangle.m_EdgeTypes[edge] == LEFT_EDGE)
+						start = _mm_max_ps(start, bound);
+					else
+						end = _mm_min_ps(end, bound);
+				}
+
+				// First and one past last pixel whose center is inside, truncation is a floor since both are positive
+				start = _mm_min_ps(start, maxX);
+				end = _mm_max_ps(end, minX);
+				_mm_store_si128(reinterpret_cast<__m128i*>(spanStarts + rows), _mm_cvttps_epi32(_mm_add_ps(start, half)));
+				_mm_store_si128(reinterpret_cast<__m128i*>(spanEnds + rows), _mm_cvttps_epi32(_mm_add_ps(end, half)));
+			}
+
+			const uint32_t firstTile{ static_cast<uint32_t>(_triangle.m_Bounds.x) / TILE_WIDTH };
+			const uint32_t lastTile{ static_cast<uint32_t>(_triangle.m_Bounds.y - 1) / TILE_WIDTH };
+			for (uint32_t tileX{ firstTile }; tileX <= lastTile; ++tileX)
+			{
+				Tile& tile{ _buffer.m_Tiles[_tileY * _buffer.m_TileCountX + tileX] };
+				const float depth{ TileDepth(_triangle, tileX, _tileY) };
+				if (depth >= tile.m_ReferenceDepth) continue;
+
+				const int32_t base{ static_cast<int32_t>(tileX * TILE_WIDTH) };
+				uint32_t masks[TILE_HEIGHT];
+				uint32_t coverage{ 0 };
+				for (uint32_t row{ 0 }; row < TILE_HEIGHT; ++row)
+				{
+					const int32_t start{ std::clamp(spanStarts[row] - base, 0, 32) };
+					const int32_t end{ std::clamp(spanEnds[row] - base, 0, 32) };
+					masks[row] = start < end ? static_cast<uint32_t>((~0ull << start) & ((1ull << end) - 1)) : 0u;
+					coverage |= masks[row];
+				}
+
+				if (coverage)
+					UpdateTile(tile, masks, depth);
+			}
+		}
+
+		// Rasterizes one triangle into one row of tiles, all 8 pixel rows at once
+		MINERVA_TARGET_AVX2 void RasterizeTileRowAVX2(DepthBuffer& _buffer, const ScreenTriangle& _triangle, uint32_t _tileY)
+		{
+			const __m256 minX{ _mm256_set1_ps(static_cast<float>(_triangle.m_Bounds.x)) };
+			const __m256 maxX{ _mm256_set1_ps(static_cast<float>(_triangle.m_Bounds.y)) };
+			const __m256 half{ _mm256_set1_ps(0.5f) };
+
+			// Pixel centers
+			const __m256 y{ _mm256_add_ps(_mm256_set1_ps(static_cast<float>(_tileY * TILE_HEIGHT) + 0.5f), _mm256_setr_ps(0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f)) };
+			__m256 start{ minX };
+			__m256 end{ maxX };
+
+			for (int edge{ 0 }; edge < 3; ++edge)
+			{
+				const __m256 slope{ _mm256_set1_ps(_triangle.m_EdgeSlopes[edge]) };
+				const __m256 offset{ _mm256_set1_ps(_triangle.m_EdgeOffsets[edge]) };
+				if (_triangle.m_EdgeTypes[edge] == HORIZONTAL_EDGE)
+				{
+					const __m256 inside{ _mm256_cmp_ps(_mm256_mul_ps(slope, _mm256_sub_ps(y, offset)), _mm256_setzero_ps(), _CMP_GE_OQ) };
+					end = _mm256_blendv_ps(minX, end, inside);
+					continue;
+				}
+
+				const __m256 bound{ _mm256_add_ps(_mm256_mul_ps(slope, y), offset) };
+				if (_triangle.m_EdgeTypes[edge] == LEFT_EDGE)
+					start = _mm256_max_ps(start, bound);
+				else
+					end = _mm256_min_ps(end, bound);
+			}
+
+			// First and one past last pixel whose center is inside, truncation is a floor since both are positive
+			const __m256i spanStarts{ _mm256_cvttps_epi32(_mm256_add_ps(_mm256_min_ps(start, maxX), half)) };
+			const __m256i spanEnds{ _mm256_cvttps_epi32(_mm256_add_ps(_mm256_max_ps(end, minX), half)) };
+
+			const __m256i ones{ _mm256_set1_epi32(-1) };
+			const __m256i zero{ _mm256_setzero_si256() };
+			const __m256i width{ _mm256_set1_epi32(static_cast<int32_t>(TILE_WIDTH)) };
+
+			const uint32_t firstTile{ static_cast<uint32_t>(_triangle.m_Bounds.x) / TILE_WIDTH };
+			const uint32_t lastTile{ static_cast<uint32_t>(_triangle.m_Bounds.y - 1) / TILE_WIDTH };
+			for (uint32_t tileX{ firstTile }; tileX <= lastTile; ++tileX)
+			{
+				Tile& tile{ _buffer.m_Tiles[_tileY * _buffer.m_TileCountX + tileX] };
+				const float depth{ TileDepth(_triangle, tileX, _tileY) };
+				if (depth >= tile.m_ReferenceDepth) continue;
+
+				// Variable shifts by 32 or more give 0, so empty spans need no special case
+				const __m256i base{ _mm256_set1_epi32(static_cast<int32_t>(tileX * TILE_WIDTH)) };
+				const __m256i first{ _mm256_max_epi32(_mm256_sub_epi32(spanStarts, base), zero) };
+				const __m256i last{ _mm256_min_epi32(_mm256_sub_epi32(spanEnds, base), width) };
+				const __m256i masks{ _mm256_and_si256(_mm256_sllv_epi32(ones, first), _mm256_srlv_epi32(ones, _mm256_sub_epi32(width, last))) };
+				if (_mm256_testz_si256(masks, masks)) continue;
+
+				alignas(32) uint32_t rowMasks[TILE_HEIGHT];
+				_mm256_store_si256(reinterpret_cast<__m256i*>(rowMasks), masks);
+				UpdateTile(tile, rowMasks, depth);
+			}
+		}
+
+		using RasterizeFunction = void(*)(DepthBuffer&, const ScreenTriangle&, uint32_t);
+
+		bool TestRect(const DepthBuffer& _buffer, const glm::ivec4& _rect, float _minDepth)
+		{
+			for (uint32_t tileY{ static_cast<uint32_t>(_rect.z) / TILE_HEIGHT }; tileY <= static_cast<uint32_t>(_rect.w - 1) / TILE_HEIGHT; ++tileY)
+			{
+				for (uint32_t tileX{ static_cast<uint32_t>(_rect.x) / TILE_WIDTH }; tileX <= static_cast<uint32_t>(_rect.y - 1) / TILE_WIDTH; ++tileX)
+				{
+					const Tile& tile{ _buffer.m_Tiles[tileY * _buffer.m_TileCountX + tileX] };
+
+					// Nearer than both layers, or behind both
+					if (_minDepth < tile.m_WorkingDepth) return true;
+					if (_minDepth >= tile.m_ReferenceDepth) continue;
+
+					// Between the layers: visible where the rect reaches pixels of the reference layer
+					const int32_t baseX{ static_cast<int32_t>(tileX * TILE_WIDTH) };
+					const int32_t start{ std::clamp(_rect.x - baseX, 0, 32) };
+					const int32_t end{ std::clamp(_rect.y - baseX, 0, 32) };
+					const uint32_t rectMask{ static_cast<uint32_t>((~0ull << start) & ((1ull << end) - 1)) };
+
+					for (uint32_t row{ 0 }; row < TILE_HEIGHT; ++row)
+					{
+						const int32_t y{ static_cast<int32_t>(tileY * TILE_HEIGHT + row) };
+						if (y >= _rect.z && y < _rect.w && (rectMask & ~tile.m_Masks[row]))
+							return true;
+					}
+				}
+			}
+
+			return false;
+		}
+	}
+
+	bool IsAVX2Supported()
+	{
+		static const bool Supported{ []()
+		{
+#if defined(_MSC_VER)
+			int info[4];
+			__cpuid(info, 0);
+			if (info[0] < 7) return false;
+
+			// The OS must save the YMM registers
+			__cpuid(info, 1);
+			if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0) return false;
+			if ((_xgetbv(0) & 6) != 6) return false;
+
+			__cpuidex(info, 7, 0);
+			return (info[1] & (1 << 5)) != 0;
+#else
+			return __builtin_cpu_supports("avx2") != 0;
+#endif
+		}() };
+		return Supported;
+	}
+
+	void Resize(DepthBuffer& _buffer, uint32_t _width, uint32_t _height)
+	{
+		_buffer.m_TileCountX = (std::max(_width, 1u) + TILE_WIDTH - 1) / TILE_WIDTH;
+		_buffer.m_TileCountY = (std::max(_height, 1u) + TILE_HEIGHT - 1) / TILE_HEIGHT;
+		_buffer.m_Width = _buffer.m_TileCountX * TILE_WIDTH;
+		_buffer.m_Height = _buffer.m_TileCountY * TILE_HEIGHT;
+		_buffer.m_Tiles.resize(static_cast<size_t>(_buffer.m_TileCountX) * _buffer.m_TileCountY);
+		Clear(_buffer);
+	}
+
+	void Clear(DepthBuffer& _buffer)
+	{
+		for (Tile& tile : _buffer.m_Tiles)
+		{
+			std::fill(std::begin(tile.m_Masks), std::end(tile.m_Masks), 0u);
+			tile.m_ReferenceDepth = 1.f;
+			tile.m_WorkingDepth = 0.f;
+		}
+	}
+
+	void RenderOccluders(DepthBuffer& _buffer, std::span<const Occluder> _occluders, const glm::mat4& _viewProjection)
+	{
+		if (_buffer.m_Tiles.empty() || _occluders.empty()) return;
+
+		// Triangle offsets of the occluders, so setup can be split by triangle instead of by occluder
+		std::vector<size_t> firstTriangles(_occluders.size() + 1, 0);
+		std::vector<glm::mat4> transforms(_occluders.size());
+		for (size_t i{ 0 }; i < _occluders.size(); ++i)
+		{
+			firstTriangles[i + 1] = firstTriangles[i] + _occluders[i].m_Indices.size() / 3;
+			transforms[i] = _viewProjection * _occluders[i].m_Model;
+		}
+
+		_buffer.m_Triangles.resize(Parallel::GetWorkerCount());
+		for (auto& triangles : _buffer.m_Triangles)
+			triangles.clear();
+
+		Parallel::ForRange(firstTriangles.back(), TRIANGLE_BATCH_SIZE, [&](size_t _begin, size_t _end, size_t _worker)
+		{
+			std::vector<ScreenTriangle>& triangles{ _buffer.m_Triangles[_worker] };
+			size_t occluderIndex{ static_cast<size_t>(std::upper_bound(firstTriangles.begin(), firstTriangles.end(), _begin) - firstTriangles.begin()) - 1 };
+
+			for (size_t i{ _begin }; i < _end; ++i)
+			{
+				while (i >= firstTriangles[occluderIndex + 1])
+					++occluderIndex;
+
+				const Occluder& occluder{ _occluders[occluderIndex] };
+				const size_t triangle{ i - firstTriangles[occluderIndex] };
+
+				std::array<glm::vec4, 3> clip;
+				bool valid{ true };
+				for (size_t corner{ 0 }; corner < 3; ++corner)
+				{
+					const uint32_t index{ occluder.m_Indices[triangle * 3 + corner] };
+					valid = valid && index < occluder.m_Positions.size();
+					if (valid)
+						clip[corner] = transforms[occluderIndex] * glm::vec4{ occluder.m_Positions[index], 1.f };
+				}
+
+				if (valid)
+					AddTriangle(triangles, clip, _buffer);
+			}
+		});
+
+		// Every worker owns a band of tile rows, so no tile is written by two threads
+		const RasterizeFunction Rasterize{ IsAVX2Supported() ? &RasterizeTileRowAVX2 : &RasterizeTileRowSSE };
+		Parallel::ForRange(_buffer.m_TileCountY, 1, [&](size_t _begin, size_t _end, size_t)
+		{
+			for (const auto& triangles : _buffer.m_Triangles)
+			{
+				for (const ScreenTriangle& triangle : triangles)
+				{
+					const size_t firstRow{ std::max(_begin, static_cast<size_t>(triangle.m_Bounds.z) / TILE_HEIGHT) };
+					const size_t lastRow{ std::min(_end, static_cast<size_t>(triangle.m_Bounds.w - 1) / TILE_HEIGHT + 1) };
+					for (size_t tileY{ firstRow }; tileY < lastRow; ++tileY)
+						Rasterize(_buffer, triangle, static_cast<uint32_t>(tileY));
+				}
+			}
+		});
+	}
+
+	bool TestAABB(const DepthBuffer& _buffer, const AABB& _aabb, const glm::mat4& _viewProjection)
+	{
+		if (_buffer.m_Tiles.empty()) return true;
+
+		glm::vec2 minimum{ std::numeric_limits<float>::max() };
+		glm::vec2 maximum{ std::numeric_limits<float>::lowest() };
+		float minDepth{ 1.f };
+
+		for (uint32_t corner{ 0 }; corner < 8; ++corner)
+		{
+			const glm::vec3 position{
+				(corner & 1) ? _aabb.m_Max.x : _aabb.m_Min.x,
+				(corner & 2) ? _aabb.m_Max.y : _aabb.m_Min.y,
+				(corner & 4) ? _aabb.m_Max.z : _aabb.m_Min.z };
+			const glm::vec4 clip{ _viewProjection * glm::vec4{ position, 1.f } };
+
+			// Crosses the near plane, cannot be bounded on screen
+			if (clip.w <= 1e-6f || clip.z < 0.f) return true;
+
+			const glm::vec3 ndc{ glm::vec3{ clip } / clip.w };
+			minimum = glm::min(minimum, glm::vec2{ ndc });
+			maximum = glm::max(maximum, glm::vec2{ ndc });
+			minDepth = std::min(minDepth, ndc.z);
+		}
+
+		// Every pixel the box touches
+		const glm::ivec4 rect{
+			static_cast<int32_t>(std::clamp(std::floor((minimum.x * 0.5f + 0.5f) * _buffer.m_Width), 0.f, static_cast<float>(_buffer.m_Width))),
+			static_cast<int32_t>(std::clamp(std::ceil((maximum.x * 0.5f + 0.5f) * _buffer.m_Width), 0.f, static_cast<float>(_buffer.m_Width))),
+			static_cast<int32_t>(std::clamp(std::floor((minimum.y * 0.5f + 0.5f) * _buffer.m_Height), 0.f, static_cast<float>(_buffer.m_Height))),
+			static_cast<int32_t>(std::clamp(std::ceil((maximum.y * 0.5f + 0.5f) * _buffer.m_Height), 0.f, static_cast<float>(_buffer.m_Height)))
+		};
+		if (rect.x >= rect.y || rect.z >= rect.w) return false;
+
+		return TestRect(_buffer, rect, minDepth);
+	}
+
+	void TestAABBs(const DepthBuffer& _buffer, std::span<const AABB> _aabbs, const glm::mat4& _viewProjection, std::span<uint8_t> _visible)
+	{
+		Parallel::ForRange(std::min(_aabbs.size(), _visible.size()), AABB_BATCH_SIZE, [&](size_t _begin, size_t _end, size_t)
+		{
+			for (size_t i{ _begin }; i < _end; ++i)
+				_visible[i] = TestAABB(_buffer, _aabbs[i], _viewProjection) ? 1 : 0;
+		});
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Minerva::Tools::MaskedOcclusion
+{
+	// Pixels per tile. A tile row of 32 pixels is one bit mask, so a tile is 8 masks
+	constexpr uint32_t TILE_WIDTH{ 32 };
+	constexpr uint32_t TILE_HEIGHT{ 8 };
+
+	// Masked depth of one tile. Covered pixels belong to the working layer and are no farther than m_WorkingDepth,
+	// all others are no farther than m_ReferenceDepth. Once the working layer covers the tile it becomes the reference layer
+	struct alignas(32) Tile
+	{
+		uint32_t m_Masks[TILE_HEIGHT];
+		float m_ReferenceDepth;
+		float m_WorkingDepth;
+	};
+
+	// Occluder triangle in pixel space, prepared by RenderOccluders
+	struct ScreenTriangle
+	{
+		glm::vec3 m_EdgeSlopes;   // Per edge: x = slope * y + offset
+		glm::vec3 m_EdgeOffsets;
+		glm::ivec3 m_EdgeTypes;   // 0 left bound, 1 right bound, 2 horizontal
+		glm::vec3 m_DepthPlane;   // depth = x * dx + y * dy + c
+		float m_MinDepth;
+		float m_MaxDepth;
+		glm::ivec4 m_Bounds;      // Pixel bounds, [x0, x1) x [y0, y1)
+	};
+
+	// Low resolution depth in Vulkan conventions: depth 0 near, 1 far, row 0 at the top (NDC y = -1)
+	struct DepthBuffer
+	{
+		uint32_t m_Width{ 0 };      // Multiple of TILE_WIDTH
+		uint32_t m_Height{ 0 };     // Multiple of TILE_HEIGHT
+		uint32_t m_TileCountX{ 0 };
+		uint32_t m_TileCountY{ 0 };
+		std::vector<Tile> m_Tiles;
+		std::vector<std::vector<ScreenTriangle>> m_Triangles; // Scratch, one list per worker
+	};
+
+	// Occluder mesh. Should be a simplified, slightly shrunk version of the render mesh, since it must not cover more than it
+	struct Occluder
+	{
+		std::span<const glm::vec3> m_Positions;
+		std::span<const uint32_t> m_Indices;
+		glm::mat4 m_Model{ 1.f };
+	};
+
+	struct AABB
+	{
+		glm::vec3 m_Min;
+		glm::vec3 m_Max;
+	};
+
+	// True when the AVX2 path is used, otherwise SSE2
+	bool IsAVX2Supported();
+
+	// Sizes are rounded up to whole tiles. Clears the buffer
+	void Resize(DepthBuffer& _buffer, uint32_t _width, uint32_t _height);
+
+	// Everything at the far plane
+	void Clear(DepthBuffer& _buffer);
+
+	// Transforms and clips the occluders on worker threads, then rasterizes them with every worker owning a band of tile rows.
+	// Both triangle windings are rasterized
+	void RenderOccluders(DepthBuffer& _buffer, std::span<const Occluder> _occluders, const glm::mat4& _viewProjection);
+
+	// False when every pixel under the projected box is covered by a nearer occluder or the box is off screen.
+	// Boxes crossing the near plane are always visible
+	bool TestAABB(const DepthBuffer& _buffer, const AABB& _aabb, const glm::mat4& _viewProjection);
+
+	// Writes TestAABB of every box to _visible (1 visible, 0 occluded) on worker threads
+	void TestAABBs(const DepthBuffer& _buffer, std::span<const AABB> _aabbs, const glm::mat4& _viewProjection, std::span<uint8_t> _visible);
+}
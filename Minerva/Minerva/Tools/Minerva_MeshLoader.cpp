@@ -0,0 +1,878 @@
+#include "Minerva_MeshLoader.h"
+#include "Minerva_Parallel.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <span>
+#include <unordered_map>
+
+namespace Minerva::Tools::MeshLoader
+{
+	namespace
+	{
+		MeshError ReadFile(std::vector<char>& _buffer, std::string_view _fileName)
+		{
+			std::ifstream ifs(std::string{ _fileName }, std::ios::ate | std::ios::binary);
+			if (!ifs.is_open())
+				return MeshError::ERROR_FILE_OPEN;
+
+			const auto fileSize{ static_cast<std::streamsize>(ifs.tellg()) };
+			if (fileSize <= 0)
+				return MeshError::ERROR_READ;
+
+			_buffer.resize(static_cast<size_t>(fileSize));
+			ifs.seekg(0);
+			if (!ifs.read(_buffer.data(), fileSize))
+				return MeshError::ERROR_READ;
+
+			return MeshError::SUCCESS;
+		}
+
+		// FNV-1a over raw bytes
+		inline size_t HashBytes(const void* _data, size_t _size)
+		{
+			const auto* bytes{ static_cast<const unsigned char*>(_data) };
+			uint64_t hash{ 14695981039346656037ull };
+			for (size_t i{ 0 }; i < _size; ++i)
+			{
+				hash ^= bytes[i];
+				hash *= 1099511628211ull;
+			}
+			return static_cast<size_t>(hash);
+		}
+
+		// Area weighted smooth normals for the vertices flagged in _missing
+		void GenerateNormals(std::span<Vertex> _vertices, std::span<const uint32_t> _indices, const std::vector<bool>& _missing)
+		{
+			for (size_t i{ 0 }; i < _vertices.size(); ++i)
+				if (_missing[i]) _vertices[i].m_Normal = glm::vec3{ 0.f };
+
+			for (size_t i{ 0 }; i + 2 < _indices.size(); i += 3)
+			{
+				const uint32_t i0{ _indices[i] }, i1{ _indices[i + 1] }, i2{ _indices[i + 2] };
+				const glm::vec3 faceNormal{ glm::cross(_vertices[i1].m_Position - _vertices[i0].m_Position, _vertices[i2].m_Position - _vertices[i0].m_Position) };
+
+				for (uint32_t index : { i0, i1, i2 })
+					if (_missing[index]) _vertices[index].m_Normal += faceNormal;
+			}
+
+			for (size_t i{ 0 }; i < _vertices.size(); ++i)
+			{
+				if (!_missing[i]) continue;
+				const float length{ glm::length(_vertices[i].m_Normal) };
+				_vertices[i].m_Normal = length > 0.f ? _vertices[i].m_Normal / length : glm::vec3{ 0.f, 1.f, 0.f };
+			}
+		}
+
+		//! OBJ
+		// Index triplet of a face corner. Relative (negative) OBJ indices are stored chunk-local and fixed up after all chunks are parsed
+		struct OBJCorner
+		{
+			int32_t m_Position;
+			int32_t m_TexCoord;
+			int32_t m_Normal;
+			uint8_t m_RelativeMask;
+		};
+
+		struct OBJKey
+		{
+			int32_t m_Position;
+			int32_t m_TexCoord;
+			int32_t m_Normal;
+
+			bool operator==(const OBJKey&) const = default;
+		};
+
+		struct OBJKeyHash
+		{
+			size_t operator()(const OBJKey& _key) const { return HashBytes(&_key, sizeof(OBJKey)); }
+		};
+
+		struct OBJChunk
+		{
+			std::vector<glm::vec3> m_Positions;
+			std::vector<glm::vec2> m_TexCoords;
+			std::vector<glm::vec3> m_Normals;
+			std::vector<OBJCorner> m_Corners; // 3 per triangle
+			bool m_Valid{ true };
+		};
+
+		constexpr int32_t OBJ_NO_INDEX{ -1 };
+		constexpr uint8_t OBJ_RELATIVE_POSITION{ 1 << 0 };
+		constexpr uint8_t OBJ_RELATIVE_TEXCOORD{ 1 << 1 };
+		constexpr uint8_t OBJ_RELATIVE_NORMAL{ 1 << 2 };
+
+		inline const char* SkipSpaces(const char* _p, const char* _end)
+		{
+			while (_p < _end && (*_p == ' ' || *_p == '\t')) ++_p;
+			return _p;
+		}
+
+		template<typename T>
+		bool ParseNumber(const char*& _p, const char* _end, T& _out)
+		{
+			_p = SkipSpaces(_p, _end);
+			if (_p < _end && *_p == '+') ++_p; // from_chars does not accept a leading '+'
+
+			auto [ptr, ec] { std::from_chars(_p, _end, _out) };
+			if (ec != std::errc{}) return false;
+
+			_p = ptr;
+			return true;
+		}
+
+		// Converts a 1-based (or negative, relative) OBJ index into a 0-based one
+		bool ResolveOBJIndex(int64_t _index, size_t _localCount, int32_t& _out, uint8_t& _relativeMask, uint8_t _relativeBit)
+		{
+			if (_index > 0 && _index <= std::numeric_limits<int32_t>::max())
+			{
+				_out = static_cast<int32_t>(_index - 1);
+				return true;
+			}
+			if (_index < 0)
+			{
+				_out = static_cast<int32_t>(static_cast<int64_t>(_localCount) + _index);
+				_relativeMask |= _relativeBit;
+				return true;
+			}
+			return false;
+		}
+
+		bool ParseOBJFace(const char* _p, const char* _end, OBJChunk& _chunk)
+		{
+			std::array<OBJCorner, 3> fan{};
+			size_t cornerCount{ 0 };
+
+			while ((_p = SkipSpaces(_p, _end)) < _end)
+			{
+				OBJCorner corner{ OBJ_NO_INDEX, OBJ_NO_INDEX, OBJ_NO_INDEX, 0 };
+				int64_t index{ 0 };
+
+				// Position is mandatory
+				if (!ParseNumber(_p, _end, index) || !ResolveOBJIndex(index, _chunk.m_Positions.size(), corner.m_Position, corner.m_RelativeMask, OBJ_RELATIVE_POSITION))
+					return false;
+
+				// Optional texcoord and normal: v/vt, v//vn, v/vt/vn
+				if (_p < _end && *_p == '/')
+				{
+					++_p;
+					if (_p < _end && *_p != '/')
+					{
+						if (!ParseNumber(_p, _end, index) || !ResolveOBJIndex(index, _chunk.m_TexCoords.size(), corner.m_TexCoord, corner.m_RelativeMask, OBJ_RELATIVE_TEXCOORD))
+							return false;
+					}
+					if (_p < _end && *_p == '/')
+					{
+						++_p;
+						if (!ParseNumber(_p, _end, index) || !ResolveOBJIndex(index, _chunk.m_Normals.size(), corner.m_Normal, corner.m_RelativeMask, OBJ_RELATIVE_NORMAL))
+							return false;
+					}
+				}
+
+				// Triangulate polygon as a fan around the first corner
+				if (cornerCount < 3)
+					fan[cornerCount] = corner;
+				else
+				{
+					fan[1] = fan[2];
+					fan[2] = corner;
+				}
+
+				if (++cornerCount >= 3)
+					_chunk.m_Corners.insert(_chunk.m_Corners.end(), fan.begin(), fan.end());
+			}
+
+			return cornerCount >= 3;
+		}
+
+		// Parses every line that starts inside [_begin, _end). The last line may run past _end
+		void ParseOBJChunk(const char* _begin, const char* _end, const char* _fileEnd, OBJChunk& _chunk)
+		{
+			const char* p{ _begin };
+			while (p < _end)
+			{
+				const char* lineEnd{ static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(_fileEnd - p))) };
+				if (!lineEnd) lineEnd = _fileEnd;
+				const char* next{ lineEnd + (lineEnd < _fileEnd ? 1 : 0) };
+				if (lineEnd > p && lineEnd[-1] == '\r') --lineEnd;
+
+				p = SkipSpaces(p, lineEnd);
+				if (lineEnd - p >= 2 && p[0] == 'v' && (p[1] == ' ' || p[1] == '\t'))
+				{
+					glm::vec3 position{};
+					p += 1;
+					if (!ParseNumber(p, lineEnd, position.x) || !ParseNumber(p, lineEnd, position.y) || !ParseNumber(p, lineEnd, position.z))
+						_chunk.m_Valid = false;
+					_chunk.m_Positions.push_back(position);
+				}
+				else if (lineEnd - p >= 3 && p[0] == 'v' && p[1] == 't' && (p[2] == ' ' || p[2] == '\t'))
+				{
+					glm::vec2 texCoord{};
+					p += 2;
+					if (!ParseNumber(p, lineEnd, texCoord.x))
+						_chunk.m_Valid = false;
+					ParseNumber(p, lineEnd, texCoord.y); // v is optional
+					texCoord.y = 1.f - texCoord.y; // OBJ origin is bottom left, Vulkan is top left
+					_chunk.m_TexCoords.push_back(texCoord);
+				}
+				else if (lineEnd - p >= 3 && p[0] == 'v' && p[1] == 'n' && (p[2] == ' ' || p[2] == '\t'))
+				{
+					glm::vec3 normal{};
+					p += 2;
+					if (!ParseNumber(p, lineEnd, normal.x) || !ParseNumber(p, lineEnd, normal.y) || !ParseNumber(p, lineEnd, normal.z))
+						_chunk.m_Valid = false;
+					_chunk.m_Normals.push_back(normal);
+				}
+				else if (lineEnd - p >= 2 && p[0] == 'f' && (p[1] == ' ' || p[1] == '\t'))
+				{
+					if (!ParseOBJFace(p + 1, lineEnd, _chunk))
+						_chunk.m_Valid = false;
+				}
+				// Everything else (comments, groups, materials, smoothing groups) is ignored
+
+				p = next;
+			}
+		}
+
+		//! GLB
+		constexpr uint32_t GLB_MAGIC{ 0x46546C67 };      // "glTF"
+		constexpr uint32_t GLB_CHUNK_JSON{ 0x4E4F534A }; // "JSON"
+		constexpr uint32_t GLB_CHUNK_BIN{ 0x004E4942 };  // "BIN\0"
+
+		// Minimal JSON DOM, only what the glTF importer needs
+		struct JSONValue
+		{
+			enum class Type : uint8_t
+			{
+				NUL,
+				BOOLEAN,
+				NUMBER,
+				STRING,
+				ARRAY,
+				OBJECT
+			};
+
+			Type m_Type{ Type::NUL };
+			bool m_Boolean{ false };
+			double m_Number{ 0.0 };
+			std::string m_String;
+			std::vector<JSONValue> m_Values;     // Array elements or object values
+			std::vector<std::string> m_Keys;     // Object keys, parallel to m_Values
+
+			const JSONValue* Find(std::string_view _key) const
+			{
+				if (m_Type != Type::OBJECT) return nullptr;
+				for (size_t i{ 0 }; i < m_Keys.size(); ++i)
+					if (m_Keys[i] == _key) return &m_Values[i];
+				return nullptr;
+			}
+
+			const JSONValue* At(size_t _index) const
+			{
+				return (m_Type == Type::ARRAY && _index < m_Values.size()) ? &m_Values[_index] : nullptr;
+			}
+
+			double GetNumber(std::string_view _key, double _default) const
+			{
+				const JSONValue* value{ Find(_key) };
+				return (value && value->m_Type == Type::NUMBER) ? value->m_Number : _default;
+			}
+		};
+
+		class JSONParser
+		{
+		public:
+			JSONParser(const char* _begin, const char* _end) : m_P{ _begin }, m_End{ _end } {}
+
+			bool Parse(JSONValue& _value)
+			{
+				if (!ParseValue(_value, 0)) return false;
+				SkipWhitespace();
+				return m_P == m_End;
+			}
+
+		private:
+			const char* m_P;
+			const char* m_End;
+
+			static constexpr int MAX_DEPTH{ 64 };
+
+			void SkipWhitespace()
+			{
+				while (m_P < m_End && (*m_P == ' ' || *m_P == '\t' || *m_P == '\n' || *m_P == '\r')) ++m_P;
+			}
+
+			bool Consume(std::string_view _literal)
+			{
+				if (static_cast<size_t>(m_End - m_P) < _literal.size() || std::string_view{ m_P, _literal.size() } != _literal)
+					return false;
+				m_P += _literal.size();
+				return true;
+			}
+
+			bool ParseValue(JSONValue& _value, int _depth)
+			{
+				if (_depth > MAX_DEPTH) return false;
+
+				SkipWhitespace();
+				if (m_P >= m_End) return false;
+
+				switch (*m_P)
+				{
+				case '{': return ParseObject(_value, _depth);
+				case '[': return ParseArray(_value, _depth);
+				case '"': _value.m_Type = JSONValue::Type::STRING; return ParseString(_value.m_String);
+				case 't': _value.m_Type = JSONValue::Type::BOOLEAN; _value.m_Boolean = true; return Consume("true");
+				case 'f': _value.m_Type = JSONValue::Type::BOOLEAN; _value.m_Boolean = false; return Consume("false");
+				case 'n': _value.m_Type = JSONValue::Type::NUL; return Consume("null");
+				default:
+				{
+					_value.m_Type = JSONValue::Type::NUMBER;
+					auto [ptr, ec] { std::from_chars(m_P, m_End, _value.m_Number) };
+					if (ec != std::errc{}) return false;
+					m_P = ptr;
+					return true;
+				}
+				}
+			}
+
+			bool ParseObject(JSONValue& _value, int _depth)
+			{
+				_value.m_Type = JSONValue::Type::OBJECT;
+				++m_P; // '{'
+
+				SkipWhitespace();
+				if (m_P < m_End && *m_P == '}') { ++m_P; return true; }
+
+				while (m_P < m_End)
+				{
+					SkipWhitespace();
+					std::string& key{ _value.m_Keys.emplace_back() };
+					if (m_P >= m_End || *m_P != '"' || !ParseString(key)) return false;
+
+					SkipWhitespace();
+					if (m_P >= m_End || *m_P != ':') return false;
+					++m_P;
+
+					if (!ParseValue(_value.m_Values.emplace_back(), _depth + 1)) return false;
+
+					SkipWhitespace();
+					if (m_P < m_End && *m_P == ',') { ++m_P; continue; }
+					if (m_P < m_End && *m_P == '}') { ++m_P; return true; }
+					return false;
+				}
+				return false;
+			}
+
+			bool ParseArray(JSONValue& _value, int _depth)
+			{
+				_value.m_Type = JSONValue::Type::ARRAY;
+				++m_P; // '['
+
+				SkipWhitespace();
+				if (m_P < m_End && *m_P == ']') { ++m_P; return true; }
+
+				while (m_P < m_End)
+				{
+					if (!ParseValue(_value.m_Values.emplace_back(), _depth + 1)) return false;
+
+					SkipWhitespace();
+					if (m_P < m_End && *m_P == ',') { ++m_P; continue; }
+					if (m_P < m_End && *m_P == ']') { ++m_P; return true; }
+					return false;
+				}
+				return false;
+			}
+
+			bool ParseString(std::string& _out)
+			{
+				++m_P; // '"'
+				while (m_P < m_End && *m_P != '"')
+				{
+					if (*m_P != '\\')
+					{
+						_out.push_back(*m_P++);
+						continue;
+					}
+
+					if (++m_P >= m_End) return false;
+					switch (*m_P++)
+					{
+					case '"':  _out.push_back('"'); break;
+					case '\\': _out.push_back('\\'); break;
+					case '/':  _out.push_back('/'); break;
+					case 'b':  _out.push_back('\b'); break;
+					case 'f':  _out.push_back('\f'); break;
+					case 'n':  _out.push_back('\n'); break;
+					case 'r':  _out.push_back('\r'); break;
+					case 't':  _out.push_back('\t'); break;
+					case 'u':
+					{
+						uint32_t codepoint{ 0 };
+						if (m_End - m_P < 4) return false;
+						auto [ptr, ec] { std::from_chars(m_P, m_P + 4, codepoint, 16) };
+						if (ec != std::errc{} || ptr != m_P + 4) return false;
+						m_P += 4;
+
+						// UTF-8 encode (surrogate pairs are kept as-is, names we look up are ASCII)
+						if (codepoint < 0x80) _out.push_back(static_cast<char>(codepoint));
+						else if (codepoint < 0x800)
+						{
+							_out.push_back(static_cast<char>(0xC0 | (codepoint >> 6)));
+							_out.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+						}
+						else
+						{
+							_out.push_back(static_cast<char>(0xE0 | (codepoint >> 12)));
+							_out.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+							_out.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+						}
+					} break;
+					default: return false;
+					}
+				}
+
+				if (m_P >= m_End) return false;
+				++m_P; // '"'
+				return true;
+			}
+		};
+
+		// Strided view into the binary chunk described by a glTF accessor
+		struct AccessorView
+		{
+			const std::byte* m_Data;
+			size_t m_Stride;
+			size_t m_Count;
+			uint32_t m_ComponentType;
+			uint32_t m_ComponentCount;
+			bool m_Normalized;
+		};
+
+		constexpr uint32_t GLTF_BYTE{ 5120 };
+		constexpr uint32_t GLTF_UNSIGNED_BYTE{ 5121 };
+		constexpr uint32_t GLTF_SHORT{ 5122 };
+		constexpr uint32_t GLTF_UNSIGNED_SHORT{ 5123 };
+		constexpr uint32_t GLTF_UNSIGNED_INT{ 5125 };
+		constexpr uint32_t GLTF_FLOAT{ 5126 };
+		constexpr uint32_t GLTF_TRIANGLES{ 4 };
+
+		size_t ComponentSize(uint32_t _componentType)
+		{
+			switch (_componentType)
+			{
+			case GLTF_BYTE:
+			case GLTF_UNSIGNED_BYTE:	return 1;
+			case GLTF_SHORT:
+			case GLTF_UNSIGNED_SHORT:	return 2;
+			case GLTF_UNSIGNED_INT:
+			case GLTF_FLOAT:			return 4;
+			default:					return 0;
+			}
+		}
+
+		uint32_t ComponentCount(const std::string& _type)
+		{
+			if (_type == "SCALAR") return 1;
+			if (_type == "VEC2") return 2;
+			if (_type == "VEC3") return 3;
+			if (_type == "VEC4") return 4;
+			return 0;
+		}
+
+		// JSON numbers are doubles. Casting a negative, fractional or huge one to an unsigned type is undefined, they are rejected instead
+		bool ToSize(double _number, size_t& _out)
+		{
+			constexpr double MAX_EXACT_INTEGER{ 9007199254740992.0 }; // 2^53
+			if (!(_number >= 0.0 && _number <= MAX_EXACT_INTEGER)) return false;
+			_out = static_cast<size_t>(_number);
+			return static_cast<double>(_out) == _number;
+		}
+
+		MeshError GetAccessor(const JSONValue& _root, double _index, std::span<const std::byte> _bin, AccessorView& _view)
+		{
+			const JSONValue* accessors{ _root.Find("accessors") };
+			const JSONValue* bufferViews{ _root.Find("bufferViews") };
+			size_t accessorIndex{ 0 };
+			if (!accessors || !bufferViews || !ToSize(_index, accessorIndex)) return MeshError::ERROR_NOT_VALID_DATA;
+
+			const JSONValue* accessor{ accessors->At(accessorIndex) };
+			if (!accessor) return MeshError::ERROR_NOT_VALID_DATA;
+			if (accessor->Find("sparse")) return MeshError::ERROR_NO_SUPPORT;
+
+			const JSONValue* type{ accessor->Find("type") };
+			const JSONValue* normalized{ accessor->Find("normalized") };
+			size_t componentType{ 0 };
+			if (!ToSize(accessor->GetNumber("componentType", 0), componentType) || !ToSize(accessor->GetNumber("count", 0), _view.m_Count))
+				return MeshError::ERROR_NOT_VALID_DATA;
+			_view.m_ComponentType = static_cast<uint32_t>(std::min<size_t>(componentType, std::numeric_limits<uint32_t>::max()));
+			_view.m_ComponentCount = type ? ComponentCount(type->m_String) : 0;
+			_view.m_Normalized = normalized && normalized->m_Boolean;
+
+			const size_t elementSize{ ComponentSize(_view.m_ComponentType) * _view.m_ComponentCount };
+			if (elementSize == 0) return MeshError::ERROR_NOT_VALID_DATA;
+
+			// Accessors without a buffer view are all zeros, which is not useful for geometry
+			if (!accessor->Find("bufferView")) return MeshError::ERROR_NO_SUPPORT;
+			size_t bufferViewIndex{ 0 };
+			if (!ToSize(accessor->GetNumber("bufferView", -1), bufferViewIndex)) return MeshError::ERROR_NOT_VALID_DATA;
+			const JSONValue* bufferView{ bufferViews->At(bufferViewIndex) };
+			if (!bufferView) return MeshError::ERROR_NOT_VALID_DATA;
+			if (bufferView->GetNumber("buffer", 0) != 0) return MeshError::ERROR_NO_SUPPORT;
+
+			size_t viewOffset{ 0 };
+			size_t viewLength{ 0 };
+			size_t accessorOffset{ 0 };
+			if (!ToSize(bufferView->GetNumber("byteOffset", 0), viewOffset) || !ToSize(bufferView->GetNumber("byteLength", 0), viewLength) ||
+				!ToSize(accessor->GetNumber("byteOffset", 0), accessorOffset) || !ToSize(bufferView->GetNumber("byteStride", 0), _view.m_Stride))
+				return MeshError::ERROR_NOT_VALID_DATA;
+			// glTF limits the stride to 252 bytes, which also keeps the bounds check below from overflowing
+			if (_view.m_Stride > 252) return MeshError::ERROR_NOT_VALID_DATA;
+			if (_view.m_Stride == 0) _view.m_Stride = elementSize;
+
+			// Bounds check against both the buffer view and the binary chunk
+			if (viewOffset + viewLength > _bin.size()) return MeshError::ERROR_NOT_VALID_DATA;
+			if (_view.m_Count && accessorOffset + _view.m_Stride * (_view.m_Count - 1) + elementSize > viewLength)
+				return MeshError::ERROR_NOT_VALID_DATA;
+
+			_view.m_Data = _bin.data() + viewOffset + accessorOffset;
+			return MeshError::SUCCESS;
+		}
+
+		float ReadFloat(const AccessorView& _view, size_t _element, uint32_t _component)
+		{
+			const std::byte* src{ _view.m_Data + _view.m_Stride * _element + ComponentSize(_view.m_ComponentType) * _component };
+			switch (_view.m_ComponentType)
+			{
+			case GLTF_FLOAT:			{ float v; std::memcpy(&v, src, sizeof(v)); return v; }
+			case GLTF_UNSIGNED_BYTE:	{ uint8_t v; std::memcpy(&v, src, sizeof(v)); return _view.m_Normalized ? v / 255.f : static_cast<float>(v); }
+			case GLTF_UNSIGNED_SHORT:	{ uint16_t v; std::memcpy(&v, src, sizeof(v)); return _view.m_Normalized ? v / 65535.f : static_cast<float>(v); }
+			case GLTF_BYTE:				{ int8_t v; std::memcpy(&v, src, sizeof(v)); return _view.m_Normalized ? std::max(v / 127.f, -1.f) : static_cast<float>(v); }
+			case GLTF_SHORT:			{ int16_t v; std::memcpy(&v, src, sizeof(v)); return _view.m_Normalized ? std::max(v / 32767.f, -1.f) : static_cast<float>(v); }
+			default:					return 0.f;
+			}
+		}
+
+		uint32_t ReadIndex(const AccessorView& _view, size_t _element)
+		{
+			const std::byte* src{ _view.m_Data + _view.m_Stride * _element };
+			switch (_view.m_ComponentType)
+			{
+			case GLTF_UNSIGNED_BYTE:	{ uint8_t v; std::memcpy(&v, src, sizeof(v)); return v; }
+			case GLTF_UNSIGNED_SHORT:	{ uint16_t v; std::memcpy(&v, src, sizeof(v)); return v; }
+			case GLTF_UNSIGNED_INT:		{ uint32_t v; std::memcpy(&v, src, sizeof(v)); return v; }
+			default:					return 0;
+			}
+		}
+
+		struct VertexHash
+		{
+			size_t operator()(const Vertex& _vertex) const { return HashBytes(&_vertex, sizeof(Vertex)); }
+		};
+
+		struct VertexEqual
+		{
+			bool operator()(const Vertex& _a, const Vertex& _b) const { return std::memcmp(&_a, &_b, sizeof(Vertex)) == 0; }
+		};
+
+		// Minimum number of elements per worker. Smaller workloads are not worth a thread
+		constexpr size_t PARALLEL_BATCH_SIZE{ 16 * 1024 };
+		constexpr size_t OBJ_PARALLEL_CHUNK_SIZE{ 1024 * 1024 };
+	}
+
+	std::string GetErrorMessage(MeshError _code)
+	{
+		switch (_code)
+		{
+		case MeshError::SUCCESS:
+			return std::string{ "SUCCESS" };
+		case MeshError::ERROR_FILE_OPEN:
+			return std::string{ "ERROR_FILE_OPEN" };
+		case MeshError::ERROR_READ:
+			return std::string{ "ERROR_READ" };
+		case MeshError::ERROR_MAGIC_WORD:
+			return std::string{ "ERROR_MAGIC_WORD" };
+		case MeshError::ERROR_NO_SUPPORT:
+			return std::string{ "ERROR_NOT_SUPPORTED" };
+		case MeshError::ERROR_NOT_VALID_DATA:
+			return std::string{ "ERROR_INVALID_DATA" };
+		default:
+			return std::string{ "UNKNOWN_ERROR" };
+		}
+	}
+
+	MeshError LoadOBJ(MeshData& _mesh, std::string_view _fileName)
+	{
+		std::vector<char> file;
+		if (auto Err{ ReadFile(file, _fileName) }; Err != MeshError::SUCCESS)
+			return Err;
+
+		// Parse chunks of the file in parallel. Each worker owns the lines that start inside its byte range
+		const char* fileBegin{ file.data() };
+		const char* fileEnd{ file.data() + file.size() };
+		std::vector<OBJChunk> chunks(Minerva::Tools::Parallel::GetWorkerCount());
+
+		Minerva::Tools::Parallel::ForRange(file.size(), OBJ_PARALLEL_CHUNK_SIZE, [&](size_t _begin, size_t _end, size_t _worker)
+			{
+				const char* begin{ fileBegin + _begin };
+
+				// Skip the partial line, it belongs to the previous worker
+				if (_begin != 0 && begin[-1] != '\n')
+				{
+					const char* lineEnd{ static_cast<const char*>(std::memchr(begin, '\n', static_cast<size_t>(fileEnd - begin))) };
+					begin = lineEnd ? lineEnd + 1 : fileEnd;
+				}
+
+				ParseOBJChunk(begin, std::max(begin, fileBegin + _end), fileEnd, chunks[_worker]);
+			});
+
+		// Global offsets of every chunk, in file order
+		size_t positionCount{ 0 }, texCoordCount{ 0 }, normalCount{ 0 }, cornerCount{ 0 };
+		for (const auto& chunk : chunks)
+		{
+			if (!chunk.m_Valid) return MeshError::ERROR_NOT_VALID_DATA;
+			positionCount += chunk.m_Positions.size();
+			texCoordCount += chunk.m_TexCoords.size();
+			normalCount += chunk.m_Normals.size();
+			cornerCount += chunk.m_Corners.size();
+		}
+
+		if (positionCount == 0 || cornerCount == 0)
+			return MeshError::ERROR_NOT_VALID_DATA;
+
+		std::vector<glm::vec3> positions; positions.reserve(positionCount);
+		std::vector<glm::vec2> texCoords; texCoords.reserve(texCoordCount);
+		std::vector<glm::vec3> normals; normals.reserve(normalCount);
+
+		// Deduplicate vertices on their index triplet
+		std::unordered_map<OBJKey, uint32_t, OBJKeyHash> vertexMap;
+		vertexMap.reserve(cornerCount / 2);
+
+		_mesh.m_Vertices.clear();
+		_mesh.m_Indices.clear();
+		_mesh.m_Indices.reserve(cornerCount);
+
+		std::vector<OBJKey> uniqueKeys;
+		for (const auto& chunk : chunks)
+		{
+			const int32_t positionBase{ static_cast<int32_t>(positions.size()) };
+			const int32_t texCoordBase{ static_cast<int32_t>(texCoords.size()) };
+			const int32_t normalBase{ static_cast<int32_t>(normals.size()) };
+
+			positions.insert(positions.end(), chunk.m_Positions.begin(), chunk.m_Positions.end());
+			texCoords.insert(texCoords.end(), chunk.m_TexCoords.begin(), chunk.m_TexCoords.end());
+			normals.insert(normals.end(), chunk.m_Normals.begin(), chunk.m_Normals.end());
+
+			for (const auto& corner : chunk.m_Corners)
+			{
+				const OBJKey key{
+					corner.m_Position + ((corner.m_RelativeMask & OBJ_RELATIVE_POSITION) ? positionBase : 0),
+					corner.m_TexCoord + ((corner.m_RelativeMask & OBJ_RELATIVE_TEXCOORD) ? texCoordBase : 0),
+					corner.m_Normal + ((corner.m_RelativeMask & OBJ_RELATIVE_NORMAL) ? normalBase : 0)
+				};
+
+				auto [it, inserted] { vertexMap.try_emplace(key, static_cast<uint32_t>(uniqueKeys.size())) };
+				if (inserted) uniqueKeys.push_back(key);
+				_mesh.m_Indices.push_back(it->second);
+			}
+		}
+
+		// Build the unique vertices. Forward references are only resolvable once every chunk is merged
+		_mesh.m_Vertices.resize(uniqueKeys.size());
+		std::vector<bool> missingNormals(uniqueKeys.size(), false);
+		bool anyMissingNormal{ false };
+
+		for (size_t i{ 0 }; i < uniqueKeys.size(); ++i)
+		{
+			const OBJKey& key{ uniqueKeys[i] };
+			if (key.m_Position < 0 || key.m_Position >= static_cast<int32_t>(positions.size())
+				|| key.m_TexCoord >= static_cast<int32_t>(texCoords.size()) || key.m_TexCoord < OBJ_NO_INDEX
+				|| key.m_Normal >= static_cast<int32_t>(normals.size()) || key.m_Normal < OBJ_NO_INDEX)
+			{
+				return MeshError::ERROR_NOT_VALID_DATA;
+			}
+
+			Vertex& vertex{ _mesh.m_Vertices[i] };
+			vertex.m_Position = positions[key.m_Position];
+			vertex.m_TexCoord = key.m_TexCoord != OBJ_NO_INDEX ? texCoords[key.m_TexCoord] : glm::vec2{ 0.f };
+			vertex.m_Normal = key.m_Normal != OBJ_NO_INDEX ? normals[key.m_Normal] : glm::vec3{ 0.f };
+
+			missingNormals[i] = key.m_Normal == OBJ_NO_INDEX;
+			anyMissingNormal |= missingNormals[i];
+		}
+
+		if (anyMissingNormal)
+			GenerateNormals(_mesh.m_Vertices, _mesh.m_Indices, missingNormals);
+
+		return MeshError::SUCCESS;
+	}
+
+	MeshError LoadGLB(MeshData& _mesh, std::string_view _fileName)
+	{
+		std::vector<char> file;
+		if (auto Err{ ReadFile(file, _fileName) }; Err != MeshError::SUCCESS)
+			return Err;
+
+		auto ReadU32 = [&](size_t _offset)
+		{
+			uint32_t value{ 0 };
+			std::memcpy(&value, file.data() + _offset, sizeof(value));
+			return value;
+		};
+
+		// Header: magic, version, length
+		if (file.size() < 20) return MeshError::ERROR_READ;
+		if (ReadU32(0) != GLB_MAGIC) return MeshError::ERROR_MAGIC_WORD;
+		if (ReadU32(4) != 2) return MeshError::ERROR_NO_SUPPORT;
+		if (ReadU32(8) > file.size()) return MeshError::ERROR_READ;
+
+		// Chunks: JSON first, then an optional BIN chunk
+		const size_t fileLength{ ReadU32(8) };
+		const size_t jsonLength{ ReadU32(12) };
+		if (ReadU32(16) != GLB_CHUNK_JSON || 20 + jsonLength > fileLength) return MeshError::ERROR_NOT_VALID_DATA;
+
+		std::span<const std::byte> bin{};
+		const size_t binHeader{ 20 + jsonLength };
+		if (binHeader + 8 <= fileLength && ReadU32(binHeader + 4) == GLB_CHUNK_BIN)
+		{
+			const size_t binLength{ ReadU32(binHeader) };
+			if (binHeader + 8 + binLength > fileLength) return MeshError::ERROR_NOT_VALID_DATA;
+			bin = { reinterpret_cast<const std::byte*>(file.data() + binHeader + 8), binLength };
+		}
+
+		JSONValue root;
+		if (!JSONParser(file.data() + 20, file.data() + 20 + jsonLength).Parse(root))
+			return MeshError::ERROR_NOT_VALID_DATA;
+
+		// Only the embedded binary chunk is supported, external .bin/data URIs are not
+		if (const JSONValue* buffers{ root.Find("buffers") }; buffers && buffers->At(0) && buffers->At(0)->Find("uri"))
+			return MeshError::ERROR_NO_SUPPORT;
+
+		const JSONValue* meshes{ root.Find("meshes") };
+		if (!meshes || meshes->m_Type != JSONValue::Type::ARRAY) return MeshError::ERROR_NOT_VALID_DATA;
+
+		std::vector<Vertex> vertices;
+		std::vector<uint32_t> indices;
+		std::vector<bool> missingNormals;
+
+		for (const JSONValue& mesh : meshes->m_Values)
+		{
+			const JSONValue* primitives{ mesh.Find("primitives") };
+			if (!primitives) continue;
+
+			for (const JSONValue& primitive : primitives->m_Values)
+			{
+				if (primitive.GetNumber("mode", GLTF_TRIANGLES) != GLTF_TRIANGLES) continue;
+
+				const JSONValue* attributes{ primitive.Find("attributes") };
+				if (!attributes || !attributes->Find("POSITION")) return MeshError::ERROR_NOT_VALID_DATA;
+
+				AccessorView positionView{}, normalView{}, texCoordView{}, indexView{};
+				if (auto Err{ GetAccessor(root, attributes->GetNumber("POSITION", -1), bin, positionView) }; Err != MeshError::SUCCESS)
+					return Err;
+				if (positionView.m_ComponentCount != 3) return MeshError::ERROR_NOT_VALID_DATA;
+
+				const bool hasNormals{ attributes->Find("NORMAL") != nullptr };
+				const bool hasTexCoords{ attributes->Find("TEXCOORD_0") != nullptr };
+				const bool hasIndices{ primitive.Find("indices") != nullptr };
+
+				if (hasNormals)
+				{
+					if (auto Err{ GetAccessor(root, attributes->GetNumber("NORMAL", -1), bin, normalView) }; Err != MeshError::SUCCESS)
+						return Err;
+					if (normalView.m_Count != positionView.m_Count || normalView.m_ComponentCount != 3) return MeshError::ERROR_NOT_VALID_DATA;
+				}
+				if (hasTexCoords)
+				{
+					if (auto Err{ GetAccessor(root, attributes->GetNumber("TEXCOORD_0", -1), bin, texCoordView) }; Err != MeshError::SUCCESS)
+						return Err;
+					if (texCoordView.m_Count != positionView.m_Count || texCoordView.m_ComponentCount != 2) return MeshError::ERROR_NOT_VALID_DATA;
+				}
+				if (hasIndices)
+				{
+					if (auto Err{ GetAccessor(root, primitive.GetNumber("indices", -1), bin, indexView) }; Err != MeshError::SUCCESS)
+						return Err;
+					if (indexView.m_ComponentCount != 1 || indexView.m_ComponentType == GLTF_FLOAT) return MeshError::ERROR_NOT_VALID_DATA;
+				}
+
+				// Decode attributes in parallel
+				const size_t vertexBase{ vertices.size() };
+				vertices.resize(vertexBase + positionView.m_Count);
+				missingNormals.resize(vertexBase + positionView.m_Count, !hasNormals);
+
+				Minerva::Tools::Parallel::ForRange(positionView.m_Count, PARALLEL_BATCH_SIZE, [&](size_t _begin, size_t _end, size_t)
+					{
+						for (size_t i{ _begin }; i < _end; ++i)
+						{
+							Vertex& vertex{ vertices[vertexBase + i] };
+							vertex.m_Position = { ReadFloat(positionView, i, 0), ReadFloat(positionView, i, 1), ReadFloat(positionView, i, 2) };
+							vertex.m_Normal = hasNormals ? glm::vec3{ ReadFloat(normalView, i, 0), ReadFloat(normalView, i, 1), ReadFloat(normalView, i, 2) } : glm::vec3{ 0.f };
+							vertex.m_TexCoord = hasTexCoords ? glm::vec2{ ReadFloat(texCoordView, i, 0), ReadFloat(texCoordView, i, 1) } : glm::vec2{ 0.f };
+						}
+					});
+
+				// Indices, or an implicit 0..n-1 list
+				const size_t indexCount{ hasIndices ? indexView.m_Count : positionView.m_Count };
+				const size_t indexBase{ indices.size() };
+				indices.resize(indexBase + indexCount);
+
+				bool indicesValid{ true };
+				for (size_t i{ 0 }; i < indexCount; ++i)
+				{
+					const uint32_t index{ hasIndices ? ReadIndex(indexView, i) : static_cast<uint32_t>(i) };
+					indicesValid &= index < positionView.m_Count;
+					indices[indexBase + i] = static_cast<uint32_t>(vertexBase) + index;
+				}
+				if (!indicesValid || indexCount % 3) return MeshError::ERROR_NOT_VALID_DATA;
+			}
+		}
+
+		if (vertices.empty() || indices.empty())
+			return MeshError::ERROR_NOT_VALID_DATA;
+
+		// Normals have to exist before deduplication, they are part of the vertex identity
+		if (std::find(missingNormals.begin(), missingNormals.end(), true) != missingNormals.end())
+			GenerateNormals(vertices, indices, missingNormals);
+
+		// Deduplicate vertices on their content (glTF exporters often split vertices per primitive)
+		std::unordered_map<Vertex, uint32_t, VertexHash, VertexEqual> vertexMap;
+		vertexMap.reserve(vertices.size());
+		std::vector<uint32_t> remap(vertices.size());
+
+		_mesh.m_Vertices.clear();
+		_mesh.m_Vertices.reserve(vertices.size());
+		for (size_t i{ 0 }; i < vertices.size(); ++i)
+		{
+			auto [it, inserted] { vertexMap.try_emplace(vertices[i], static_cast<uint32_t>(_mesh.m_Vertices.size())) };
+			if (inserted) _mesh.m_Vertices.push_back(vertices[i]);
+			remap[i] = it->second;
+		}
+
+		_mesh.m_Indices.resize(indices.size());
+		for (size_t i{ 0 }; i < indices.size(); ++i)
+			_mesh.m_Indices[i] = remap[indices[i]];
+
+		return MeshError::SUCCESS;
+	}
+
+	MeshError LoadMesh(MeshData& _mesh, std::string_view _fileName)
+	{
+		auto HasExtension = [&](std::string_view _extension)
+		{
+			if (_fileName.size() < _extension.size()) return false;
+			return std::equal(_extension.begin(), _extension.end(), _fileName.end() - _extension.size(),
+				[](char _a, char _b) { return _a == std::tolower(static_cast<unsigned char>(_b)); });
+		};
+
+		if (HasExtension(".obj"))
+			return LoadOBJ(_mesh, _fileName);
+		if (HasExtension(".glb"))
+			return LoadGLB(_mesh, _fileName);
+
+		return MeshError::ERROR_NO_SUPPORT;
+	}
+}
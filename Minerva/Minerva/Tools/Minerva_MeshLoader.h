@@ -0,0 +1,47 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Minerva::Tools::MeshLoader
+{
+	enum class MeshError : uint8_t
+	{
+		SUCCESS = 0,
+		ERROR_FILE_OPEN,
+		ERROR_READ,
+		ERROR_MAGIC_WORD,
+		ERROR_NO_SUPPORT,
+		ERROR_NOT_VALID_DATA
+	};
+
+	// Vertex layout produced by the importer
+	struct Vertex
+	{
+		glm::vec3 m_Position;
+		glm::vec3 m_Normal;
+		glm::vec2 m_TexCoord;
+	};
+
+	struct MeshData
+	{
+		std::vector<Vertex> m_Vertices;
+		std::vector<uint32_t> m_Indices; // Triangle list
+	};
+
+	// Index buffers can only be 16-bit when every vertex is addressable with 16 bits
+	inline bool RequiresUInt32Indices(size_t _vertexCount) { return _vertexCount > 0xffff; }
+
+	std::string GetErrorMessage(MeshError _code);
+
+	// Wavefront OBJ. Faces are triangulated as fans, vertices deduplicated on their position/uv/normal index triplet
+	MeshError LoadOBJ(MeshData& _mesh, std::string_view _fileName);
+
+	// Binary glTF 2.0. All triangle primitives of all meshes are merged, node transforms are not applied
+	MeshError LoadGLB(MeshData& _mesh, std::string_view _fileName);
+
+	// Picks the importer from the file extension (.obj or .glb)
+	MeshError LoadMesh(MeshData& _mesh, std::string_view _fileName);
+}
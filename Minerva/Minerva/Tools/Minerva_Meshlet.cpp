@@ -0,0 +1,254 @@
+#include "Minerva_Meshlet.h"
+#include "Minerva_Parallel.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace Minerva::Tools::Meshlet
+{
+	namespace
+	{
+		constexpr uint8_t NOT_IN_MESHLET{ 0xff };
+
+		// Triangles per chunk when building in parallel. Meshlets never cross a chunk boundary
+		constexpr size_t TRIANGLES_PER_CHUNK{ 1u << 14 };
+
+		// Vertex -> triangle adjacency in compressed rows
+		struct Adjacency
+		{
+			std::vector<uint32_t> m_Offsets;
+			std::vector<uint32_t> m_Triangles;
+		};
+
+		void BuildAdjacency(Adjacency& _adjacency, size_t _vertexCount, std::span<const uint32_t> _indices)
+		{
+			_adjacency.m_Offsets.assign(_vertexCount + 1, 0);
+			for (uint32_t index : _indices)
+				++_adjacency.m_Offsets[index + 1];
+
+			for (size_t i{ 0 }; i < _vertexCount; ++i)
+				_adjacency.m_Offsets[i + 1] += _adjacency.m_Offsets[i];
+
+			std::vector<uint32_t> cursor(_adjacency.m_Offsets.begin(), _adjacency.m_Offsets.end() - 1);
+			_adjacency.m_Triangles.resize(_indices.size());
+			for (size_t i{ 0 }; i < _indices.size(); ++i)
+				_adjacency.m_Triangles[cursor[_indices[i]]++] = static_cast<uint32_t>(i / 3);
+		}
+
+		// Builds the meshlets of the triangles [_begin, _end). _localSlot must be NOT_IN_MESHLET for every vertex and is restored on return
+		void BuildChunk(MeshletData& _out, std::span<const uint32_t> _indices, const Adjacency& _adjacency,
+			std::vector<uint8_t>& _used, std::vector<uint8_t>& _localSlot, uint32_t _begin, uint32_t _end)
+		{
+			Meshlet current{ 0, 0, 0, 0 };
+			std::vector<uint32_t> candidates;
+			uint32_t cursor{ _begin };
+
+			auto NewVertexCount = [&](uint32_t _triangle)
+			{
+				uint32_t count{ 0 };
+				for (uint32_t k{ 0 }; k < 3; ++k)
+					count += _localSlot[_indices[_triangle * 3 + k]] == NOT_IN_MESHLET;
+				return count;
+			};
+
+			auto Flush = [&]()
+			{
+				if (current.m_TriangleCount == 0) return;
+
+				for (uint32_t i{ 0 }; i < current.m_VertexCount; ++i)
+					_localSlot[_out.m_Vertices[current.m_VertexOffset + i]] = NOT_IN_MESHLET;
+
+				_out.m_Meshlets.push_back(current);
+				current = Meshlet{ static_cast<uint32_t>(_out.m_Vertices.size()), static_cast<uint32_t>(_out.m_Triangles.size()), 0, 0 };
+				candidates.clear();
+			};
+
+			auto AddTriangle = [&](uint32_t _triangle)
+			{
+				_used[_triangle] = 1;
+				for (uint32_t k{ 0 }; k < 3; ++k)
+				{
+					const uint32_t vertex{ _indices[_triangle * 3 + k] };
+					if (_localSlot[vertex] == NOT_IN_MESHLET)
+					{
+						_localSlot[vertex] = static_cast<uint8_t>(current.m_VertexCount++);
+						_out.m_Vertices.push_back(vertex);
+
+						// Unused triangles around the new vertex become candidates
+						for (uint32_t a{ _adjacency.m_Offsets[vertex] }; a < _adjacency.m_Offsets[vertex + 1]; ++a)
+						{
+							const uint32_t neighbour{ _adjacency.m_Triangles[a] };
+							if (neighbour >= _begin && neighbour < _end && !_used[neighbour])
+								candidates.push_back(neighbour);
+						}
+					}
+					_out.m_Triangles.push_back(_localSlot[vertex]);
+				}
+				++current.m_TriangleCount;
+			};
+
+			current.m_VertexOffset = static_cast<uint32_t>(_out.m_Vertices.size());
+			current.m_TriangleOffset = static_cast<uint32_t>(_out.m_Triangles.size());
+
+			while (true)
+			{
+				// Candidate adding the fewest new vertices, stopping early on one that adds none
+				uint32_t best{ UINT32_MAX }, bestCost{ 4 };
+				for (size_t i{ 0 }; i < candidates.size();)
+				{
+					const uint32_t triangle{ candidates[i] };
+					if (_used[triangle])
+					{
+						candidates[i] = candidates.back();
+						candidates.pop_back();
+						continue;
+					}
+
+					const uint32_t cost{ NewVertexCount(triangle) };
+					if (cost < bestCost)
+					{
+						best = triangle;
+						bestCost = cost;
+						if (cost == 0) break;
+					}
+					++i;
+				}
+
+				// Meshlet has no connected triangles left, continue with the next unused triangle in index order
+				if (best == UINT32_MAX)
+				{
+					while (cursor < _end && _used[cursor]) ++cursor;
+					if (cursor == _end) break;
+					best = cursor;
+					bestCost = NewVertexCount(best);
+				}
+
+				if (current.m_VertexCount + bestCost > MAX_VERTICES || current.m_TriangleCount + 1 > MAX_TRIANGLES)
+				{
+					Flush();
+					bestCost = 3;
+				}
+
+				AddTriangle(best);
+			}
+
+			Flush();
+		}
+	}
+
+	void BuildMeshlets(MeshletData& _meshlets, std::span<const glm::vec3> _positions, std::span<const uint32_t> _indices)
+	{
+		_meshlets = MeshletData{};
+
+		const size_t triangleCount{ _indices.size() / 3 };
+		if (triangleCount == 0) return;
+
+		Adjacency adjacency;
+		BuildAdjacency(adjacency, _positions.size(), _indices.first(triangleCount * 3));
+
+		std::vector<uint8_t> used(triangleCount, 0);
+
+		const size_t chunkCount{ (triangleCount + TRIANGLES_PER_CHUNK - 1) / TRIANGLES_PER_CHUNK };
+		std::vector<MeshletData> chunks(chunkCount);
+
+		Parallel::ForRange(chunkCount, 1, [&](size_t _begin, size_t _end, size_t)
+		{
+			// One slot table per worker, reused across its chunks
+			std::vector<uint8_t> localSlot(_positions.size(), NOT_IN_MESHLET);
+			for (size_t chunk{ _begin }; chunk < _end; ++chunk)
+			{
+				const auto first{ static_cast<uint32_t>(chunk * TRIANGLES_PER_CHUNK) };
+				const auto last{ static_cast<uint32_t>(std::min(triangleCount, (chunk + 1) * TRIANGLES_PER_CHUNK)) };
+				BuildChunk(chunks[chunk], _indices, adjacency, used, localSlot, first, last);
+			}
+		});
+
+		// Concatenate chunks
+		size_t meshletCount{ 0 }, vertexCount{ 0 }, triangleIndexCount{ 0 };
+		for (const auto& chunk : chunks)
+		{
+			meshletCount += chunk.m_Meshlets.size();
+			vertexCount += chunk.m_Vertices.size();
+			triangleIndexCount += chunk.m_Triangles.size();
+		}
+
+		_meshlets.m_Meshlets.reserve(meshletCount);
+		_meshlets.m_Vertices.reserve(vertexCount);
+		_meshlets.m_Triangles.reserve(triangleIndexCount);
+
+		for (const auto& chunk : chunks)
+		{
+			const auto vertexBase{ static_cast<uint32_t>(_meshlets.m_Vertices.size()) };
+			const auto triangleBase{ static_cast<uint32_t>(_meshlets.m_Triangles.size()) };
+
+			for (Meshlet meshlet : chunk.m_Meshlets)
+			{
+				meshlet.m_VertexOffset += vertexBase;
+				meshlet.m_TriangleOffset += triangleBase;
+				_meshlets.m_Meshlets.push_back(meshlet);
+			}
+			_meshlets.m_Vertices.insert(_meshlets.m_Vertices.end(), chunk.m_Vertices.begin(), chunk.m_Vertices.end());
+			_meshlets.m_Triangles.insert(_meshlets.m_Triangles.end(), chunk.m_Triangles.begin(), chunk.m_Triangles.end());
+		}
+
+		ComputeBounds(_meshlets, _positions);
+	}
+
+	void ComputeBounds(MeshletData& _meshlets, std::span<const glm::vec3> _positions)
+	{
+		_meshlets.m_Bounds.resize(_meshlets.m_Meshlets.size());
+
+		Parallel::ForRange(_meshlets.m_Meshlets.size(), 256, [&](size_t _begin, size_t _end, size_t)
+		{
+			for (size_t m{ _begin }; m < _end; ++m)
+			{
+				const Meshlet& meshlet{ _meshlets.m_Meshlets[m] };
+				Bounds& bounds{ _meshlets.m_Bounds[m] };
+
+				auto Position = [&](uint32_t _local) { return _positions[_meshlets.m_Vertices[meshlet.m_VertexOffset + _local]]; };
+
+				// Sphere around the box center
+				glm::vec3 min{ Position(0) }, max{ Position(0) };
+				for (uint32_t v{ 1 }; v < meshlet.m_VertexCount; ++v)
+				{
+					min = glm::min(min, Position(v));
+					max = glm::max(max, Position(v));
+				}
+
+				bounds.m_Center = (min + max) * 0.5f;
+				bounds.m_Radius = 0.f;
+				for (uint32_t v{ 0 }; v < meshlet.m_VertexCount; ++v)
+					bounds.m_Radius = std::max(bounds.m_Radius, glm::length(Position(v) - bounds.m_Center));
+
+				// Normal cone from the average triangle normal and the widest deviation from it
+				std::array<glm::vec3, MAX_TRIANGLES> normals;
+				uint32_t normalCount{ 0 };
+				glm::vec3 axis{ 0.f };
+				for (uint32_t t{ 0 }; t < meshlet.m_TriangleCount; ++t)
+				{
+					const uint8_t* triangle{ &_meshlets.m_Triangles[meshlet.m_TriangleOffset + t * 3] };
+					const glm::vec3 normal{ glm::cross(Position(triangle[1]) - Position(triangle[0]), Position(triangle[2]) - Position(triangle[0])) };
+					const float length{ glm::length(normal) };
+					if (length <= 0.f) continue; // Degenerate
+
+					normals[normalCount] = normal / length;
+					axis += normals[normalCount++];
+				}
+
+				const float axisLength{ glm::length(axis) };
+				bounds.m_ConeAxis = axisLength > 0.f ? axis / axisLength : glm::vec3{ 0.f, 0.f, 1.f };
+				bounds.m_ConeCutoff = 1.f;
+
+				if (normalCount == 0 || axisLength <= 0.f) continue;
+
+				float minDot{ 1.f };
+				for (uint32_t n{ 0 }; n < normalCount; ++n)
+					minDot = std::min(minDot, glm::dot(normals[n], bounds.m_ConeAxis));
+
+				// Cones wider than ~84 degrees are never culled
+				if (minDot > 0.1f)
+					bounds.m_ConeCutoff = std::sqrt(1.f - minDot * minDot);
+			}
+		});
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Minerva::Tools::Meshlet
+{
+	// Limits matching the common mesh shader / cluster culling budgets
+	constexpr uint32_t MAX_VERTICES{ 64 };
+	constexpr uint32_t MAX_TRIANGLES{ 124 };
+
+	struct Meshlet
+	{
+		uint32_t m_VertexOffset;   // First entry in MeshletData::m_Vertices
+		uint32_t m_TriangleOffset; // First entry in MeshletData::m_Triangles (3 entries per triangle)
+		uint32_t m_VertexCount;
+		uint32_t m_TriangleCount;
+	};
+
+	// Bounding sphere and normal cone of a meshlet.
+	// The meshlet is backfacing for a camera when dot(m_Center - camera, m_ConeAxis) >= m_ConeCutoff * length(m_Center - camera) + m_Radius
+	struct Bounds
+	{
+		glm::vec3 m_Center;
+		float m_Radius;
+		glm::vec3 m_ConeAxis;
+		float m_ConeCutoff; // 1 when the cone is too wide to ever be culled
+	};
+
+	struct MeshletData
+	{
+		std::vector<Meshlet> m_Meshlets;
+		std::vector<Bounds> m_Bounds;
+		std::vector<uint32_t> m_Vertices; // Meshlet local vertex -> mesh vertex index
+		std::vector<uint8_t> m_Triangles; // Meshlet local vertex indices, 3 per triangle
+	};
+
+	// Splits a triangle list into meshlets of at most MAX_VERTICES vertices and MAX_TRIANGLES triangles.
+	// Triangles are grouped greedily by shared vertices. Large meshes are split into chunks that are built in parallel.
+	void BuildMeshlets(MeshletData& _meshlets, std::span<const glm::vec3> _positions, std::span<const uint32_t> _indices);
+
+	// Fills _meshlets.m_Bounds for every meshlet
+	void ComputeBounds(MeshletData& _meshlets, std::span<const glm::vec3> _positions);
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Minerva::Tools::Parallel
+{
+	// Number of threads used for parallel work, including the calling thread
+	inline uint32_t GetWorkerCount()
+	{
+		static const uint32_t WorkerCount{ std::max(1u, std::thread::hardware_concurrency()) };
+		return WorkerCount;
+	}
+
+	// Splits [0, _count) into contiguous ranges and runs _function(begin, end, workerIndex) on each range.
+	// The calling thread processes the last range. Exceptions thrown by any worker are rethrown on the calling thread.
+	template<typename T_FUNCTION>
+	void ForRange(size_t _count, size_t _minBatchSize, T_FUNCTION&& _function)
+	{
+		if (_count == 0) return;
+
+		const size_t maxWorkers{ std::max<size_t>(1, _count / std::max<size_t>(1, _minBatchSize)) };
+		const size_t workerCount{ std::min<size_t>(GetWorkerCount(), maxWorkers) };
+		const size_t batchSize{ (_count + workerCount - 1) / workerCount };
+
+		// Single range, no need to spawn threads
+		if (workerCount == 1)
+		{
+			_function(size_t{ 0 }, _count, size_t{ 0 });
+			return;
+		}
+
+		std::exception_ptr exception{ nullptr };
+		std::mutex exceptionLock;
+		auto RunRange = [&](size_t _worker)
+		{
+			const size_t begin{ _worker * batchSize };
+			const size_t end{ std::min(_count, begin + batchSize) };
+			if (begin >= end) return;
+
+			try
+			{
+				_function(begin, end, _worker);
+			}
+			catch (...)
+			{
+				std::scoped_lock lock{ exceptionLock };
+				if (!exception) exception = std::current_exception();
+			}
+		};
+
+		std::vector<std::thread> workers;
+		workers.reserve(workerCount - 1);
+		for (size_t i{ 0 }; i < workerCount - 1; ++i)
+			workers.emplace_back(RunRange, i);
+
+		RunRange(workerCount - 1);
+
+		for (auto& worker : workers)
+			worker.join();
+
+		if (exception)
+			std::rethrow_exception(exception);
+	}
+}
@@ -0,0 +1,74 @@
+#include "Minerva_RadixSort.h"
+#include <array>
+#include <cstddef>
+#include <utility>
+
+namespace Minerva::Tools::RadixSort
+{
+	namespace
+	{
+		constexpr uint32_t PASS_COUNT{ 8 };
+		constexpr uint32_t BUCKET_COUNT{ 256 };
+
+		// Below this insertion sort beats the histogram setup
+		constexpr size_t INSERTION_SORT_THRESHOLD{ 64 };
+
+		void InsertionSort(std::vector<KeyValue>& _items)
+		{
+			for (size_t i{ 1 }; i < _items.size(); ++i)
+			{
+				const KeyValue item{ _items[i] };
+				size_t j{ i };
+				for (; j > 0 && _items[j - 1].m_Key > item.m_Key; --j)
+					_items[j] = _items[j - 1];
+				_items[j] = item;
+			}
+		}
+	}
+
+	void Sort(std::vector<KeyValue>& _items, std::vector<KeyValue>& _scratch)
+	{
+		const size_t count{ _items.size() };
+		if (count < INSERTION_SORT_THRESHOLD)
+		{
+			InsertionSort(_items);
+			return;
+		}
+
+		// Histograms of all passes in a single read of the keys
+		std::array<std::array<uint32_t, BUCKET_COUNT>, PASS_COUNT> histograms{};
+		for (const KeyValue& item : _items)
+			for (uint32_t pass{ 0 }; pass < PASS_COUNT; ++pass)
+				++histograms[pass][(item.m_Key >> (pass * 8)) & 0xff];
+
+		_scratch.resize(count);
+		std::vector<KeyValue>* source{ &_items };
+		std::vector<KeyValue>* destination{ &_scratch };
+
+		for (uint32_t pass{ 0 }; pass < PASS_COUNT; ++pass)
+		{
+			std::array<uint32_t, BUCKET_COUNT>& histogram{ histograms[pass] };
+
+			// Every key has the same byte, the pass would not move anything
+			const uint8_t firstByte{ static_cast<uint8_t>(((*source)[0].m_Key >> (pass * 8)) & 0xff) };
+			if (histogram[firstByte] == count) continue;
+
+			// Exclusive prefix sum turns counts into output offsets
+			uint32_t offset{ 0 };
+			for (uint32_t& bucket : histogram)
+			{
+				const uint32_t bucketCount{ bucket };
+				bucket = offset;
+				offset += bucketCount;
+			}
+
+			for (const KeyValue& item : *source)
+				(*destination)[histogram[(item.m_Key >> (pass * 8)) & 0xff]++] = item;
+
+			std::swap(source, destination);
+		}
+
+		if (source != &_items)
+			_items.swap(_scratch);
+	}
+}
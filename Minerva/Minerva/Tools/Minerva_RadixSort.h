@@ -0,0 +1,16 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace Minerva::Tools::RadixSort
+{
+	struct KeyValue
+	{
+		uint64_t m_Key;
+		uint32_t m_Value;
+	};
+
+	// Stable LSD radix sort on m_Key, 8 bits per pass. Passes whose byte is the same for every key are skipped,
+	// so keys that only use a few bits sort in a few passes. _scratch is resized as needed and can be reused across calls
+	void Sort(std::vector<KeyValue>& _items, std::vector<KeyValue>& _scratch);
+}
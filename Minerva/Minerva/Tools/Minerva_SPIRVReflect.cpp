@@ -0,0 +1,517 @@
+#include "Minerva_SPIRVReflect.h"
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace Minerva::Tools::SPIRVReflect
+{
+	namespace
+	{
+		constexpr uint32_t MAGIC_NUMBER{ 0x07230203 };
+		constexpr size_t HEADER_WORDS{ 5 };
+		constexpr uint32_t NONE{ UINT32_MAX };
+
+		// Subset of the SPIR-V specification the reflection reads
+		enum Opcode : uint32_t
+		{
+			OP_NAME = 5,
+			OP_ENTRY_POINT = 15,
+			OP_EXECUTION_MODE = 16,
+			OP_TYPE_BOOL = 20,
+			OP_TYPE_INT = 21,
+			OP_TYPE_FLOAT = 22,
+			OP_TYPE_VECTOR = 23,
+			OP_TYPE_MATRIX = 24,
+			OP_TYPE_IMAGE = 25,
+			OP_TYPE_SAMPLER = 26,
+			OP_TYPE_SAMPLED_IMAGE = 27,
+			OP_TYPE_ARRAY = 28,
+			OP_TYPE_RUNTIME_ARRAY = 29,
+			OP_TYPE_STRUCT = 30,
+			OP_TYPE_POINTER = 32,
+			OP_CONSTANT = 43,
+			OP_SPEC_CONSTANT_TRUE = 48,
+			OP_SPEC_CONSTANT_FALSE = 49,
+			OP_SPEC_CONSTANT = 50,
+			OP_VARIABLE = 59,
+			OP_DECORATE = 71,
+			OP_MEMBER_DECORATE = 72
+		};
+
+		enum Decoration : uint32_t
+		{
+			DECORATION_SPEC_ID = 1,
+			DECORATION_BUFFER_BLOCK = 3,
+			DECORATION_ARRAY_STRIDE = 6,
+			DECORATION_MATRIX_STRIDE = 7,
+			DECORATION_BUILT_IN = 11,
+			DECORATION_LOCATION = 30,
+			DECORATION_BINDING = 33,
+			DECORATION_DESCRIPTOR_SET = 34,
+			DECORATION_OFFSET = 35
+		};
+
+		enum StorageClass : uint32_t
+		{
+			STORAGE_UNIFORM_CONSTANT = 0,
+			STORAGE_INPUT = 1,
+			STORAGE_UNIFORM = 2,
+			STORAGE_PUSH_CONSTANT = 9,
+			STORAGE_STORAGE_BUFFER = 12
+		};
+
+		constexpr uint32_t EXECUTION_MODE_LOCAL_SIZE{ 17 };
+		constexpr uint32_t DIM_BUFFER{ 5 };
+		constexpr uint32_t DIM_SUBPASS_DATA{ 6 };
+		constexpr uint32_t IMAGE_STORAGE{ 2 }; // "Sampled" operand of images used without a sampler
+
+		struct Decorations
+		{
+			uint32_t m_Set{ NONE };
+			uint32_t m_Binding{ NONE };
+			uint32_t m_Location{ NONE };
+			uint32_t m_SpecId{ NONE };
+			uint32_t m_ArrayStride{ 0 };
+			bool m_BufferBlock{ false };
+			bool m_BuiltIn{ false };
+		};
+
+		struct MemberDecorations
+		{
+			uint32_t m_Offset{ 0 };
+			uint32_t m_MatrixStride{ 0 };
+		};
+
+		// Instructions are kept as spans into the code, word 0 holds the opcode
+		struct Module
+		{
+			std::unordered_map<uint32_t, std::span<const uint32_t>> m_Definitions; // Types, constants and variables by result id
+			std::unordered_map<uint32_t, Decorations> m_Decorations;
+			std::unordered_map<uint32_t, std::vector<MemberDecorations>> m_MemberDecorations;
+			std::unordered_map<uint32_t, std::string> m_Names;
+			std::vector<uint32_t> m_Variables;
+			std::vector<uint32_t> m_SpecializationConstants;
+		};
+
+		// Shortest valid form of each instruction the reflection reads operands of
+		uint32_t GetMinimumWordCount(uint32_t _opcode)
+		{
+			switch (_opcode)
+			{
+			case OP_NAME:                 return 3;
+			case OP_ENTRY_POINT:          return 4;
+			case OP_EXECUTION_MODE:       return 3;
+			case OP_TYPE_BOOL:            return 2;
+			case OP_TYPE_INT:             return 4;
+			case OP_TYPE_FLOAT:           return 3;
+			case OP_TYPE_VECTOR:          return 4;
+			case OP_TYPE_MATRIX:          return 4;
+			case OP_TYPE_IMAGE:           return 9;
+			case OP_TYPE_SAMPLER:         return 2;
+			case OP_TYPE_SAMPLED_IMAGE:   return 3;
+			case OP_TYPE_ARRAY:           return 4;
+			case OP_TYPE_RUNTIME_ARRAY:   return 3;
+			case OP_TYPE_STRUCT:          return 2;
+			case OP_TYPE_POINTER:         return 4;
+			case OP_CONSTANT:             return 4;
+			case OP_SPEC_CONSTANT_TRUE:   return 3;
+			case OP_SPEC_CONSTANT_FALSE:  return 3;
+			case OP_SPEC_CONSTANT:        return 4;
+			case OP_VARIABLE:             return 4;
+			case OP_DECORATE:             return 3;
+			case OP_MEMBER_DECORATE:      return 4;
+			default:                      return 1;
+			}
+		}
+
+		// Literal strings are nul terminated and packed 4 characters per word
+		std::string ReadString(std::span<const uint32_t> _words)
+		{
+			std::string string(_words.size() * sizeof(uint32_t), '\0');
+			std::memcpy(string.data(), _words.data(), string.size());
+			string.resize(std::strlen(string.c_str()));
+			return string;
+		}
+
+		std::span<const uint32_t> Find(const Module& _module, uint32_t _id)
+		{
+			auto it{ _module.m_Definitions.find(_id) };
+			return it != _module.m_Definitions.end() ? it->second : std::span<const uint32_t>{};
+		}
+
+		// Array lengths are constants, or specialization constants reflected with their default
+		uint32_t GetConstantValue(const Module& _module, uint32_t _id)
+		{
+			std::span<const uint32_t> constant{ Find(_module, _id) };
+			if (constant.empty() || ((constant[0] & 0xffff) != OP_CONSTANT && (constant[0] & 0xffff) != OP_SPEC_CONSTANT))
+				return 1;
+			return constant[3];
+		}
+
+		// Size in bytes of a type inside an explicitly laid out block
+		uint32_t GetTypeSize(const Module& _module, uint32_t _id, uint32_t _matrixStride)
+		{
+			std::span<const uint32_t> type{ Find(_module, _id) };
+			if (type.empty()) return 0;
+
+			switch (type[0] & 0xffff)
+			{
+			case OP_TYPE_BOOL:
+				return 4;
+			case OP_TYPE_INT:
+			case OP_TYPE_FLOAT:
+				return type[2] / 8;
+			case OP_TYPE_VECTOR:
+				return type[3] * GetTypeSize(_module, type[2], 0);
+			case OP_TYPE_MATRIX:
+				// Columns are padded to the stride, e.g. mat3 columns take 16 bytes in std140
+				return type[3] * (_matrixStride ? _matrixStride : GetTypeSize(_module, type[2], 0));
+			case OP_TYPE_ARRAY:
+			{
+				const uint32_t length{ GetConstantValue(_module, type[3]) };
+				auto decorations{ _module.m_Decorations.find(_id) };
+				const uint32_t stride{ decorations != _module.m_Decorations.end() && decorations->second.m_ArrayStride ?
+					decorations->second.m_ArrayStride : GetTypeSize(_module, type[2], _matrixStride) };
+				return length * stride;
+			}
+			case OP_TYPE_STRUCT:
+			{
+				auto members{ _module.m_MemberDecorations.find(_id) };
+				uint32_t size{ 0 };
+				for (size_t i{ 2 }; i < type.size(); ++i)
+				{
+					const MemberDecorations decorations{ members != _module.m_MemberDecorations.end() && i - 2 < members->second.size() ?
+						members->second[i - 2] : MemberDecorations{} };
+					size = std::max(size, decorations.m_Offset + GetTypeSize(_module, type[i], decorations.m_MatrixStride));
+				}
+				return size;
+			}
+			default:
+				return 0;
+			}
+		}
+
+		ReflectError ParseModule(Module& _module, Reflection& _reflection, std::span<const uint32_t> _code)
+		{
+			bool entryPoint{ false };
+
+			for (size_t i{ HEADER_WORDS }; i < _code.size();)
+			{
+				const uint32_t wordCount{ _code[i] >> 16 };
+				const uint32_t opcode{ _code[i] & 0xffff };
+				if (wordCount == 0 || i + wordCount > _code.size() || wordCount < GetMinimumWordCount(opcode))
+					return ReflectError::ERROR_NOT_VALID_DATA;
+
+				const std::span<const uint32_t> instruction{ _code.subspan(i, wordCount) };
+				i += wordCount;
+
+				switch (opcode)
+				{
+				case OP_NAME:
+					_module.m_Names[instruction[1]] = ReadString(instruction.subspan(2));
+					break;
+
+				case OP_ENTRY_POINT:
+					// Execution models past GLCompute are ray tracing and mesh shading stages
+					if (entryPoint) break;
+					if (instruction[1] > static_cast<uint32_t>(Stage::COMPUTE))
+						return ReflectError::ERROR_NO_SUPPORT;
+					_reflection.m_Stage = static_cast<Stage>(instruction[1]);
+					entryPoint = true;
+					break;
+
+				case OP_EXECUTION_MODE:
+					if (instruction[2] == EXECUTION_MODE_LOCAL_SIZE && instruction.size() >= 6)
+					{
+						_reflection.m_LocalSize[0] = instruction[3];
+						_reflection.m_LocalSize[1] = instruction[4];
+						_reflection.m_LocalSize[2] = instruction[5];
+					}
+					break;
+
+				case OP_DECORATE:
+				{
+					Decorations& decorations{ _module.m_Decorations[instruction[1]] };
+					const uint32_t value{ instruction.size() > 3 ? instruction[3] : 0 };
+					switch (instruction[2])
+					{
+					case DECORATION_SPEC_ID:        decorations.m_SpecId = value; break;
+					case DECORATION_BUFFER_BLOCK:   decorations.m_BufferBlock = true; break;
+					case DECORATION_ARRAY_STRIDE:   decorations.m_ArrayStride = value; break;
+					case DECORATION_BUILT_IN:       decorations.m_BuiltIn = true; break;
+					case DECORATION_LOCATION:       decorations.m_Location = value; break;
+					case DECORATION_BINDING:        decorations.m_Binding = value; break;
+					case DECORATION_DESCRIPTOR_SET: decorations.m_Set = value; break;
+					default: break;
+					}
+					break;
+				}
+
+				case OP_MEMBER_DECORATE:
+				{
+					std::vector<MemberDecorations>& members{ _module.m_MemberDecorations[instruction[1]] };
+					if (members.size() <= instruction[2])
+						members.resize(instruction[2] + 1);
+
+					const uint32_t value{ instruction.size() > 4 ? instruction[4] : 0 };
+					if (instruction[3] == DECORATION_OFFSET)
+						members[instruction[2]].m_Offset = value;
+					else if (instruction[3] == DECORATION_MATRIX_STRIDE)
+						members[instruction[2]].m_MatrixStride = value;
+					break;
+				}
+
+				case OP_TYPE_BOOL:
+				case OP_TYPE_INT:
+				case OP_TYPE_FLOAT:
+				case OP_TYPE_VECTOR:
+				case OP_TYPE_MATRIX:
+				case OP_TYPE_IMAGE:
+				case OP_TYPE_SAMPLER:
+				case OP_TYPE_SAMPLED_IMAGE:
+				case OP_TYPE_ARRAY:
+				case OP_TYPE_RUNTIME_ARRAY:
+				case OP_TYPE_STRUCT:
+				case OP_TYPE_POINTER:
+					_module.m_Definitions[instruction[1]] = instruction;
+					break;
+
+				case OP_CONSTANT:
+					_module.m_Definitions[instruction[2]] = instruction;
+					break;
+
+				case OP_SPEC_CONSTANT_TRUE:
+				case OP_SPEC_CONSTANT_FALSE:
+				case OP_SPEC_CONSTANT:
+					_module.m_Definitions[instruction[2]] = instruction;
+					_module.m_SpecializationConstants.push_back(instruction[2]);
+					break;
+
+				case OP_VARIABLE:
+					_module.m_Definitions[instruction[2]] = instruction;
+					_module.m_Variables.push_back(instruction[2]);
+					break;
+
+				default:
+					break;
+				}
+			}
+
+			return entryPoint ? ReflectError::SUCCESS : ReflectError::ERROR_NOT_VALID_DATA;
+		}
+
+		bool GetScalarType(const Module& _module, uint32_t _id, ScalarType& _type, uint32_t& _components)
+		{
+			std::span<const uint32_t> type{ Find(_module, _id) };
+			if (type.empty()) return false;
+
+			_components = 1;
+			if ((type[0] & 0xffff) == OP_TYPE_VECTOR)
+			{
+				_components = type[3];
+				type = Find(_module, type[2]);
+				if (type.empty()) return false;
+			}
+
+			switch (type[0] & 0xffff)
+			{
+			case OP_TYPE_BOOL:  _type = ScalarType::BOOL; return true;
+			case OP_TYPE_INT:   _type = type[3] ? ScalarType::INT : ScalarType::UINT; return true;
+			case OP_TYPE_FLOAT: _type = ScalarType::FLOAT; return true;
+			default:            return false;
+			}
+		}
+
+		void ReflectBinding(const Module& _module, Reflection& _reflection, uint32_t _variable, uint32_t _storageClass, uint32_t _typeId, const Decorations& _decorations)
+		{
+			Binding binding{ .m_Set = _decorations.m_Set == NONE ? 0 : _decorations.m_Set, .m_Binding = _decorations.m_Binding, .m_Type = DescriptorType::UNIFORM_BUFFER, .m_Count = 1, .m_Name = {} };
+
+			// Arrays of descriptors, a runtime array leaves the count to the application
+			std::span<const uint32_t> type{ Find(_module, _typeId) };
+			while (!type.empty() && ((type[0] & 0xffff) == OP_TYPE_ARRAY || (type[0] & 0xffff) == OP_TYPE_RUNTIME_ARRAY))
+			{
+				binding.m_Count = (type[0] & 0xffff) == OP_TYPE_ARRAY ? binding.m_Count * GetConstantValue(_module, type[3]) : 0;
+				_typeId = type[2];
+				type = Find(_module, _typeId);
+			}
+			if (type.empty()) return;
+
+			switch (type[0] & 0xffff)
+			{
+			case OP_TYPE_SAMPLER:
+				binding.m_Type = DescriptorType::SAMPLER;
+				break;
+			case OP_TYPE_SAMPLED_IMAGE:
+				binding.m_Type = DescriptorType::COMBINED_IMAGE_SAMPLER;
+				break;
+			case OP_TYPE_IMAGE:
+				if (type[3] == DIM_SUBPASS_DATA)
+					binding.m_Type = DescriptorType::INPUT_ATTACHMENT;
+				else if (type[3] == DIM_BUFFER)
+					binding.m_Type = type[7] == IMAGE_STORAGE ? DescriptorType::STORAGE_TEXEL_BUFFER : DescriptorType::UNIFORM_TEXEL_BUFFER;
+				else
+					binding.m_Type = type[7] == IMAGE_STORAGE ? DescriptorType::STORAGE_IMAGE : DescriptorType::SAMPLED_IMAGE;
+				break;
+			case OP_TYPE_STRUCT:
+			{
+				// Storage buffers are BufferBlock decorated Uniform blocks before SPIR-V 1.3
+				auto decorations{ _module.m_Decorations.find(_typeId) };
+				const bool bufferBlock{ decorations != _module.m_Decorations.end() && decorations->second.m_BufferBlock };
+				binding.m_Type = _storageClass == STORAGE_STORAGE_BUFFER || bufferBlock ? DescriptorType::STORAGE_BUFFER : DescriptorType::UNIFORM_BUFFER;
+				break;
+			}
+			default:
+				return;
+			}
+
+			// Blocks are often declared without an instance name, fall back to the block name
+			auto name{ _module.m_Names.find(_variable) };
+			if (name == _module.m_Names.end() || name->second.empty())
+				name = _module.m_Names.find(_typeId);
+			if (name != _module.m_Names.end())
+				binding.m_Name = name->second;
+
+			_reflection.m_Bindings.push_back(std::move(binding));
+		}
+
+		void ReflectPushConstants(const Module& _module, Reflection& _reflection, uint32_t _typeId)
+		{
+			std::span<const uint32_t> type{ Find(_module, _typeId) };
+			if (type.empty() || (type[0] & 0xffff) != OP_TYPE_STRUCT || type.size() < 3) return;
+
+			// Only the bytes between the first and the end of the last member are read by the stage
+			auto members{ _module.m_MemberDecorations.find(_typeId) };
+			uint32_t begin{ UINT32_MAX }, end{ 0 };
+			for (size_t i{ 2 }; i < type.size(); ++i)
+			{
+				const MemberDecorations decorations{ members != _module.m_MemberDecorations.end() && i - 2 < members->second.size() ?
+					members->second[i - 2] : MemberDecorations{} };
+				begin = std::min(begin, decorations.m_Offset);
+				end = std::max(end, decorations.m_Offset + GetTypeSize(_module, type[i], decorations.m_MatrixStride));
+			}
+
+			// Push constant ranges are multiples of 4 bytes
+			_reflection.m_PushConstants = PushConstantBlock{ .m_Offset = begin & ~3u, .m_Size = ((end + 3) & ~3u) - (begin & ~3u) };
+		}
+
+		void ReflectSpecializationConstant(const Module& _module, Reflection& _reflection, uint32_t _constant)
+		{
+			// Composite specialization constants have no id of their own
+			auto decorations{ _module.m_Decorations.find(_constant) };
+			if (decorations == _module.m_Decorations.end() || decorations->second.m_SpecId == NONE) return;
+
+			std::span<const uint32_t> constant{ Find(_module, _constant) };
+			SpecializationConstant specialization{ .m_ConstantID = decorations->second.m_SpecId, .m_Type = ScalarType::BOOL, .m_Size = 4, .m_DefaultValue = 0, .m_Name = {} };
+
+			uint32_t components{ 0 };
+			if (!GetScalarType(_module, constant[1], specialization.m_Type, components))
+				return;
+
+			switch (constant[0] & 0xffff)
+			{
+			case OP_SPEC_CONSTANT_TRUE:
+				specialization.m_DefaultValue = 1;
+				break;
+			case OP_SPEC_CONSTANT:
+				specialization.m_Size = GetTypeSize(_module, constant[1], 0);
+				specialization.m_DefaultValue = constant[3];
+				if (specialization.m_Size == 8 && constant.size() > 4)
+					specialization.m_DefaultValue |= static_cast<uint64_t>(constant[4]) << 32;
+				break;
+			default:
+				break;
+			}
+
+			auto name{ _module.m_Names.find(_constant) };
+			if (name != _module.m_Names.end())
+				specialization.m_Name = name->second;
+
+			_reflection.m_SpecializationConstants.push_back(std::move(specialization));
+		}
+	}
+
+	std::string GetErrorMessage(ReflectError _code)
+	{
+		switch (_code)
+		{
+		case ReflectError::SUCCESS:
+			return std::string{ "SUCCESS" };
+		case ReflectError::ERROR_SIZE:
+			return std::string{ "ERROR_SIZE" };
+		case ReflectError::ERROR_MAGIC_WORD:
+			return std::string{ "ERROR_MAGIC_WORD" };
+		case ReflectError::ERROR_NO_SUPPORT:
+			return std::string{ "ERROR_NOT_SUPPORTED" };
+		case ReflectError::ERROR_NOT_VALID_DATA:
+			return std::string{ "ERROR_INVALID_DATA" };
+		default:
+			return std::string{ "UNKNOWN_ERROR" };
+		}
+	}
+
+	ReflectError Reflect(Reflection& _reflection, std::span<const uint32_t> _code)
+	{
+		_reflection = Reflection{};
+
+		if (_code.size() < HEADER_WORDS)
+			return ReflectError::ERROR_SIZE;
+		if (_code[0] != MAGIC_NUMBER)
+			return ReflectError::ERROR_MAGIC_WORD;
+
+		Module module{};
+		if (ReflectError error{ ParseModule(module, _reflection, _code) }; error != ReflectError::SUCCESS)
+			return error;
+
+		for (uint32_t variable : module.m_Variables)
+		{
+			std::span<const uint32_t> instruction{ Find(module, variable) };
+			std::span<const uint32_t> pointer{ Find(module, instruction[1]) };
+			if (pointer.empty() || (pointer[0] & 0xffff) != OP_TYPE_POINTER) continue;
+
+			const uint32_t storageClass{ instruction[3] };
+			const uint32_t typeId{ pointer[3] };
+			const Decorations decorations{ module.m_Decorations.contains(variable) ? module.m_Decorations.at(variable) : Decorations{} };
+
+			switch (storageClass)
+			{
+			case STORAGE_UNIFORM_CONSTANT:
+			case STORAGE_UNIFORM:
+			case STORAGE_STORAGE_BUFFER:
+				if (decorations.m_Binding != NONE)
+					ReflectBinding(module, _reflection, variable, storageClass, typeId, decorations);
+				break;
+
+			case STORAGE_PUSH_CONSTANT:
+				ReflectPushConstants(module, _reflection, typeId);
+				break;
+
+			case STORAGE_INPUT:
+			{
+				if (_reflection.m_Stage != Stage::VERTEX || decorations.m_BuiltIn || decorations.m_Location == NONE) break;
+
+				VertexInput input{ .m_Location = decorations.m_Location, .m_Type = ScalarType::BOOL, .m_Components = 0, .m_Name = {} };
+				if (!GetScalarType(module, typeId, input.m_Type, input.m_Components)) break;
+				if (auto name{ module.m_Names.find(variable) }; name != module.m_Names.end())
+					input.m_Name = name->second;
+				_reflection.m_VertexInputs.push_back(std::move(input));
+				break;
+			}
+
+			default:
+				break;
+			}
+		}
+
+		for (uint32_t constant : module.m_SpecializationConstants)
+			ReflectSpecializationConstant(module, _reflection, constant);
+
+		std::sort(_reflection.m_Bindings.begin(), _reflection.m_Bindings.end(), [](const Binding& _a, const Binding& _b)
+			{ return _a.m_Set != _b.m_Set ? _a.m_Set < _b.m_Set : _a.m_Binding < _b.m_Binding; });
+		std::sort(_reflection.m_VertexInputs.begin(), _reflection.m_VertexInputs.end(), [](const VertexInput& _a, const VertexInput& _b)
+			{ return _a.m_Location < _b.m_Location; });
+		std::sort(_reflection.m_SpecializationConstants.begin(), _reflection.m_SpecializationConstants.end(), [](const SpecializationConstant& _a, const SpecializationConstant& _b)
+			{ return _a.m_ConstantID < _b.m_ConstantID; });
+
+		return ReflectError::SUCCESS;
+	}
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Minerva::Tools::SPIRVReflect
+{
+	enum class ReflectError : uint8_t
+	{
+		SUCCESS = 0,
+		ERROR_SIZE,
+		ERROR_MAGIC_WORD,
+		ERROR_NO_SUPPORT,
+		ERROR_NOT_VALID_DATA
+	};
+
+	enum class Stage : uint8_t
+	{
+		VERTEX,
+		TESSELLATION_CONTROL,
+		TESSELLATION_EVALUATION,
+		GEOMETRY,
+		FRAGMENT,
+		COMPUTE
+	};
+
+	// Same order as VkDescriptorType
+	enum class DescriptorType : uint8_t
+	{
+		SAMPLER = 0,
+		COMBINED_IMAGE_SAMPLER,
+		SAMPLED_IMAGE,
+		STORAGE_IMAGE,
+		UNIFORM_TEXEL_BUFFER,
+		STORAGE_TEXEL_BUFFER,
+		UNIFORM_BUFFER,
+		STORAGE_BUFFER,
+		UNIFORM_BUFFER_DYNAMIC,
+		STORAGE_BUFFER_DYNAMIC,
+		INPUT_ATTACHMENT
+	};
+
+	enum class ScalarType : uint8_t
+	{
+		BOOL,
+		INT,
+		UINT,
+		FLOAT
+	};
+
+	struct Binding
+	{
+		uint32_t m_Set;
+		uint32_t m_Binding;
+		DescriptorType m_Type;
+		uint32_t m_Count; // Array length, 0 for runtime sized arrays
+		std::string m_Name;
+	};
+
+	// Bytes [m_Offset, m_Offset + m_Size) of the push constant block the stage reads
+	struct PushConstantBlock
+	{
+		uint32_t m_Offset;
+		uint32_t m_Size;
+	};
+
+	struct VertexInput
+	{
+		uint32_t m_Location;
+		ScalarType m_Type;
+		uint32_t m_Components;
+		std::string m_Name;
+	};
+
+	struct SpecializationConstant
+	{
+		uint32_t m_ConstantID;
+		ScalarType m_Type;
+		uint32_t m_Size;         // Bytes, 4 for bool as Vulkan expects a VkBool32
+		uint64_t m_DefaultValue; // Raw bits of the default
+		std::string m_Name;
+	};
+
+	struct Reflection
+	{
+		Stage m_Stage;
+		std::vector<Binding> m_Bindings;                               // Sorted by set, then binding
+		PushConstantBlock m_PushConstants;                             // Empty (size 0) if the stage reads none
+		std::vector<VertexInput> m_VertexInputs;                       // Vertex stage only, sorted by location
+		std::vector<SpecializationConstant> m_SpecializationConstants; // Sorted by constant id
+		uint32_t m_LocalSize[3];                                       // Compute stage only
+	};
+
+	std::string GetErrorMessage(ReflectError _code);
+
+	// Reflects the first entry point of a SPIR-V module
+	ReflectError Reflect(Reflection& _reflection, std::span<const uint32_t> _code);
+}
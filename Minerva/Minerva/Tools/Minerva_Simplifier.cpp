@@ -0,0 +1,348 @@
+#include "Minerva_Simplifier.h"
+#include "Minerva_Parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace Minerva::Tools::Simplifier
+{
+	namespace
+	{
+		// Collapses whose new triangle normal turns further than this from the old one are rejected
+		constexpr double MIN_NORMAL_DOT{ 0.25 };
+
+		// Symmetric 4x4 plane quadric, weighted by triangle area
+		struct Quadric
+		{
+			double m_A00{ 0 }, m_A01{ 0 }, m_A02{ 0 }, m_A11{ 0 }, m_A12{ 0 }, m_A22{ 0 };
+			double m_B0{ 0 }, m_B1{ 0 }, m_B2{ 0 };
+			double m_C{ 0 };
+			double m_Weight{ 0 };
+
+			static Quadric FromPlane(const glm::dvec3& _normal, double _distance, double _weight)
+			{
+				Quadric q;
+				q.m_A00 = _normal.x * _normal.x * _weight; q.m_A01 = _normal.x * _normal.y * _weight; q.m_A02 = _normal.x * _normal.z * _weight;
+				q.m_A11 = _normal.y * _normal.y * _weight; q.m_A12 = _normal.y * _normal.z * _weight; q.m_A22 = _normal.z * _normal.z * _weight;
+				q.m_B0 = _normal.x * _distance * _weight; q.m_B1 = _normal.y * _distance * _weight; q.m_B2 = _normal.z * _distance * _weight;
+				q.m_C = _distance * _distance * _weight;
+				q.m_Weight = _weight;
+				return q;
+			}
+
+			Quadric& operator+=(const Quadric& _other)
+			{
+				m_A00 += _other.m_A00; m_A01 += _other.m_A01; m_A02 += _other.m_A02;
+				m_A11 += _other.m_A11; m_A12 += _other.m_A12; m_A22 += _other.m_A22;
+				m_B0 += _other.m_B0; m_B1 += _other.m_B1; m_B2 += _other.m_B2;
+				m_C += _other.m_C;
+				m_Weight += _other.m_Weight;
+				return *this;
+			}
+
+			// Area weighted sum of squared plane distances of _p
+			double Evaluate(const glm::dvec3& _p) const
+			{
+				const double rx{ m_A00 * _p.x + m_A01 * _p.y + m_A02 * _p.z };
+				const double ry{ m_A01 * _p.x + m_A11 * _p.y + m_A12 * _p.z };
+				const double rz{ m_A02 * _p.x + m_A12 * _p.y + m_A22 * _p.z };
+				const double result{ _p.x * rx + _p.y * ry + _p.z * rz + 2.0 * (m_B0 * _p.x + m_B1 * _p.y + m_B2 * _p.z) + m_C };
+				return std::max(0.0, result);
+			}
+		};
+
+		struct Collapse
+		{
+			uint32_t m_From;
+			uint32_t m_To;
+			double m_Error; // Squared, relative to the mesh extent
+		};
+
+		// Marks vertices that must not move: vertices sharing their position with another vertex and vertices on open edges
+		void FindLockedVertices(std::vector<uint8_t>& _locked, std::span<const glm::dvec3> _positions, std::span<const uint32_t> _indices)
+		{
+			const size_t vertexCount{ _positions.size() };
+
+			// Weld vertices with identical positions
+			std::vector<uint32_t> order(vertexCount);
+			std::iota(order.begin(), order.end(), 0u);
+			std::sort(order.begin(), order.end(), [&](uint32_t _a, uint32_t _b)
+			{
+				const glm::dvec3& a{ _positions[_a] };
+				const glm::dvec3& b{ _positions[_b] };
+				if (a.x != b.x) return a.x < b.x;
+				if (a.y != b.y) return a.y < b.y;
+				return a.z < b.z;
+			});
+
+			std::vector<uint32_t> weld(vertexCount);
+			std::vector<uint32_t> weldSize(vertexCount, 0);
+			for (size_t i{ 0 }; i < vertexCount;)
+			{
+				size_t j{ i };
+				while (j < vertexCount && _positions[order[j]] == _positions[order[i]])
+					weld[order[j++]] = order[i];
+				weldSize[order[i]] = static_cast<uint32_t>(j - i);
+				i = j;
+			}
+
+			// Open edges of the welded mesh have no opposite half edge
+			std::vector<uint64_t> halfEdges;
+			halfEdges.reserve(_indices.size());
+			for (size_t i{ 0 }; i < _indices.size(); i += 3)
+			{
+				for (uint32_t k{ 0 }; k < 3; ++k)
+				{
+					const uint64_t a{ weld[_indices[i + k]] };
+					const uint64_t b{ weld[_indices[i + (k + 1) % 3]] };
+					halfEdges.push_back(a << 32 | b);
+				}
+			}
+			std::sort(halfEdges.begin(), halfEdges.end());
+
+			std::vector<uint8_t> border(vertexCount, 0);
+			for (uint64_t edge : halfEdges)
+			{
+				const uint64_t reverse{ (edge << 32) | (edge >> 32) };
+				if (!std::binary_search(halfEdges.begin(), halfEdges.end(), reverse))
+				{
+					border[edge >> 32] = 1;
+					border[edge & 0xffffffff] = 1;
+				}
+			}
+
+			_locked.resize(vertexCount);
+			for (size_t v{ 0 }; v < vertexCount; ++v)
+				_locked[v] = weldSize[weld[v]] > 1 || border[weld[v]];
+		}
+
+		glm::dvec3 TriangleNormal(const glm::dvec3& _a, const glm::dvec3& _b, const glm::dvec3& _c)
+		{
+			return glm::cross(_b - _a, _c - _a);
+		}
+	}
+
+	float Simplify(std::vector<uint32_t>& _result, std::span<const glm::vec3> _positions, std::span<const uint32_t> _indices,
+		size_t _targetIndexCount, float _maxError)
+	{
+		_result.assign(_indices.begin(), _indices.begin() + _indices.size() / 3 * 3);
+		if (_result.size() <= _targetIndexCount || _positions.empty()) return 0.f;
+
+		const size_t vertexCount{ _positions.size() };
+
+		// Work in a unit box so errors are relative to the mesh extent
+		glm::vec3 min{ _positions[0] }, max{ _positions[0] };
+		for (const glm::vec3& position : _positions)
+		{
+			min = glm::min(min, position);
+			max = glm::max(max, position);
+		}
+		const glm::vec3 size{ max - min };
+		const double extent{ std::max({ size.x, size.y, size.z }) };
+		const double scale{ extent > 0.0 ? 1.0 / extent : 1.0 };
+
+		std::vector<glm::dvec3> positions(vertexCount);
+		for (size_t v{ 0 }; v < vertexCount; ++v)
+			positions[v] = (glm::dvec3{ _positions[v] } - glm::dvec3{ min }) * scale;
+
+		std::vector<uint8_t> locked;
+		FindLockedVertices(locked, positions, _result);
+
+		std::vector<Quadric> quadrics(vertexCount);
+		for (size_t i{ 0 }; i < _result.size(); i += 3)
+		{
+			const uint32_t a{ _result[i] }, b{ _result[i + 1] }, c{ _result[i + 2] };
+			const glm::dvec3 normal{ TriangleNormal(positions[a], positions[b], positions[c]) };
+			const double length{ glm::length(normal) };
+			if (length <= 0.0) continue;
+
+			const glm::dvec3 unitNormal{ normal / length };
+			const Quadric plane{ Quadric::FromPlane(unitNormal, -glm::dot(unitNormal, positions[a]), length * 0.5) };
+			quadrics[a] += plane;
+			quadrics[b] += plane;
+			quadrics[c] += plane;
+		}
+
+		const double maxError{ static_cast<double>(_maxError) * _maxError };
+		double resultError{ 0.0 };
+
+		std::vector<uint32_t> adjacencyOffsets;
+		std::vector<uint32_t> adjacency;
+		std::vector<Collapse> collapses;
+		std::vector<uint32_t> remap(vertexCount);
+		std::vector<uint8_t> touched(vertexCount);
+
+		while (_result.size() > _targetIndexCount)
+		{
+			const size_t triangleCount{ _result.size() / 3 };
+
+			// Vertex -> triangle adjacency in compressed rows
+			adjacencyOffsets.assign(vertexCount + 1, 0);
+			for (uint32_t index : _result)
+				++adjacencyOffsets[index + 1];
+			for (size_t v{ 0 }; v < vertexCount; ++v)
+				adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+
+			adjacency.resize(_result.size());
+			std::vector<uint32_t> cursor(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+			for (size_t i{ 0 }; i < _result.size(); ++i)
+				adjacency[cursor[_result[i]]++] = static_cast<uint32_t>(i / 3);
+
+			// Every half edge starting at a movable vertex is a collapse candidate
+			collapses.clear();
+			for (size_t i{ 0 }; i < _result.size(); i += 3)
+			{
+				for (uint32_t k{ 0 }; k < 3; ++k)
+				{
+					const uint32_t from{ _result[i + k] };
+					const uint32_t to{ _result[i + (k + 1) % 3] };
+					if (!locked[from]) collapses.push_back(Collapse{ from, to, 0.0 });
+				}
+			}
+
+			Parallel::ForRange(collapses.size(), 4096, [&](size_t _begin, size_t _end, size_t)
+			{
+				for (size_t c{ _begin }; c < _end; ++c)
+				{
+					Collapse& collapse{ collapses[c] };
+					Quadric quadric{ quadrics[collapse.m_From] };
+					quadric += quadrics[collapse.m_To];
+					collapse.m_Error = quadric.m_Weight > 0.0 ? quadric.Evaluate(positions[collapse.m_To]) / quadric.m_Weight : 0.0;
+				}
+			});
+
+			std::sort(collapses.begin(), collapses.end(), [](const Collapse& _a, const Collapse& _b) { return _a.m_Error < _b.m_Error; });
+
+			// Each collapse removes about two triangles
+			const size_t targetTriangleCount{ _targetIndexCount / 3 };
+			const size_t collapseBudget{ std::max<size_t>(1, (triangleCount - targetTriangleCount) / 2) };
+
+			std::iota(remap.begin(), remap.end(), 0u);
+			std::fill(touched.begin(), touched.end(), uint8_t{ 0 });
+
+			// Triangles around the collapsed vertex must not flip. Compared with the triangles as earlier collapses of this pass
+			// left them, a neighbour may already have moved
+			auto KeepsOrientation = [&](uint32_t _from, uint32_t _to)
+			{
+				for (uint32_t a{ adjacencyOffsets[_from] }; a < adjacencyOffsets[_from + 1]; ++a)
+				{
+					const uint32_t* source{ &_result[adjacency[a] * 3] };
+					const uint32_t triangle[3]{ remap[source[0]], remap[source[1]], remap[source[2]] };
+					if (triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[2] == triangle[0]) continue; // Already removed
+					if (triangle[0] == _to || triangle[1] == _to || triangle[2] == _to) continue; // Removed by the collapse
+
+					glm::dvec3 corners[3]{ positions[triangle[0]], positions[triangle[1]], positions[triangle[2]] };
+					const glm::dvec3 before{ TriangleNormal(corners[0], corners[1], corners[2]) };
+					for (uint32_t k{ 0 }; k < 3; ++k)
+						if (triangle[k] == _from) corners[k] = positions[_to];
+					const glm::dvec3 after{ TriangleNormal(corners[0], corners[1], corners[2]) };
+
+					const double lengths{ glm::length(before) * glm::length(after) };
+					if (lengths <= 0.0 || glm::dot(before, after) < MIN_NORMAL_DOT * lengths)
+						return false;
+				}
+				return true;
+			};
+
+			size_t collapseCount{ 0 };
+			for (const Collapse& collapse : collapses)
+			{
+				if (collapse.m_Error > maxError) break;
+				if (touched[collapse.m_From] || touched[collapse.m_To]) continue;
+				if (!KeepsOrientation(collapse.m_From, collapse.m_To)) continue;
+
+				remap[collapse.m_From] = collapse.m_To;
+				quadrics[collapse.m_To] += quadrics[collapse.m_From];
+				touched[collapse.m_From] = 1;
+				touched[collapse.m_To] = 1;
+				resultError = std::max(resultError, collapse.m_Error);
+
+				if (++collapseCount >= collapseBudget) break;
+			}
+
+			if (collapseCount == 0) break;
+
+			// Apply the collapses and drop the triangles that became degenerate
+			size_t writeIndex{ 0 };
+			for (size_t i{ 0 }; i < _result.size(); i += 3)
+			{
+				const uint32_t a{ remap[_result[i]] }, b{ remap[_result[i + 1]] }, c{ remap[_result[i + 2]] };
+				if (a == b || b == c || c == a) continue;
+
+				_result[writeIndex++] = a;
+				_result[writeIndex++] = b;
+				_result[writeIndex++] = c;
+			}
+			_result.resize(writeIndex);
+		}
+
+		return static_cast<float>(std::sqrt(resultError));
+	}
+
+	void BuildLODChain(LODChain& _chain, std::span<const glm::vec3> _positions, std::span<const uint32_t> _indices,
+		uint32_t _maxLODCount, float _reduction, float _maxError)
+	{
+		_chain = LODChain{};
+
+		const std::span<const uint32_t> indices{ _indices.first(_indices.size() / 3 * 3) };
+		_chain.m_Indices.assign(indices.begin(), indices.end());
+		_chain.m_LODs.push_back(LOD{ 0, static_cast<uint32_t>(indices.size()), 0.f });
+
+		if (_positions.empty())
+		{
+			_chain.m_Center = glm::vec3{ 0.f };
+			_chain.m_Radius = 0.f;
+			return;
+		}
+
+		glm::vec3 min{ _positions[0] }, max{ _positions[0] };
+		for (const glm::vec3& position : _positions)
+		{
+			min = glm::min(min, position);
+			max = glm::max(max, position);
+		}
+		const glm::vec3 size{ max - min };
+		const float extent{ std::max({ size.x, size.y, size.z }) };
+
+		_chain.m_Center = (min + max) * 0.5f;
+		_chain.m_Radius = 0.f;
+		for (const glm::vec3& position : _positions)
+			_chain.m_Radius = std::max(_chain.m_Radius, glm::length(position - _chain.m_Center));
+
+		std::vector<uint32_t> current(indices.begin(), indices.end());
+		std::vector<uint32_t> next;
+		float error{ 0.f };
+
+		while (_chain.m_LODs.size() < _maxLODCount && error < _maxError)
+		{
+			const size_t target{ static_cast<size_t>(current.size() / 3 * _reduction) * 3 };
+
+			// Each level is simplified from the previous one, so errors add up along the chain
+			const float levelError{ Simplify(next, _positions, current, target, _maxError - error) };
+
+			// Not worth another level when barely anything was removed
+			if (next.empty() || next.size() > current.size() * 95 / 100) break;
+
+			error += levelError;
+			_chain.m_LODs.push_back(LOD{ static_cast<uint32_t>(_chain.m_Indices.size()), static_cast<uint32_t>(next.size()), error * extent });
+			_chain.m_Indices.insert(_chain.m_Indices.end(), next.begin(), next.end());
+			std::swap(current, next);
+		}
+	}
+
+	uint32_t SelectLOD(std::span<const LOD> _lods, float _distance, float _projectionScale, float _pixelError)
+	{
+		if (_lods.empty()) return 0;
+
+		// Inside the bounds every level would project too large
+		if (_distance <= 0.f) return 0;
+
+		uint32_t selected{ 0 };
+		for (uint32_t i{ 1 }; i < _lods.size(); ++i)
+		{
+			if (_lods[i].m_Error * _projectionScale / _distance > _pixelError) break;
+			selected = i;
+		}
+		return selected;
+	}
+}
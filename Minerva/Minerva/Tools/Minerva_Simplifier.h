@@ -0,0 +1,40 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Minerva::Tools::Simplifier
+{
+	// One level of detail inside LODChain::m_Indices
+	struct LOD
+	{
+		uint32_t m_FirstIndex;
+		uint32_t m_IndexCount;
+		float m_Error; // Deviation from the full resolution mesh, in mesh units
+	};
+
+	struct LODChain
+	{
+		std::vector<uint32_t> m_Indices; // All levels back to back, finest first. Every level indexes the same vertices
+		std::vector<LOD> m_LODs;
+		glm::vec3 m_Center;              // Bounding sphere used for LOD selection
+		float m_Radius;
+	};
+
+	// Quadric error edge collapse. Vertices only collapse onto a neighbour, so the result indexes the original vertices.
+	// Border vertices and vertices sharing a position with another vertex (uv/normal seams) are never moved.
+	// Stops once the index count reaches _targetIndexCount or the next collapse exceeds _maxError.
+	// Errors are relative to the mesh extent. Returns the error of the result
+	float Simplify(std::vector<uint32_t>& _result, std::span<const glm::vec3> _positions, std::span<const uint32_t> _indices,
+		size_t _targetIndexCount, float _maxError);
+
+	// Level 0 is _indices, each following level keeps about _reduction of the previous level's triangles.
+	// The chain ends early when a level can no longer be reduced within _maxError (relative to the mesh extent)
+	void BuildLODChain(LODChain& _chain, std::span<const glm::vec3> _positions, std::span<const uint32_t> _indices,
+		uint32_t _maxLODCount = 4, float _reduction = 0.5f, float _maxError = 0.05f);
+
+	// Coarsest level whose error projects to at most _pixelError pixels.
+	// _projectionScale is screenHeight / (2 * tan(fovY / 2)), _distance the distance from the camera to the object surface
+	uint32_t SelectLOD(std::span<const LOD> _lods, float _distance, float _projectionScale, float _pixelError = 1.f);
+}